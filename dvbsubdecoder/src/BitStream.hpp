@@ -21,6 +21,9 @@
 #ifndef DVBSUBDECODER_BITSTREAM_HPP_
 #define DVBSUBDECODER_BITSTREAM_HPP_
 
+#include <cstddef>
+#include <cstdint>
+
 #include "PesPacketReader.hpp"
 
 namespace dvbsubdecoder
@@ -28,6 +31,11 @@ namespace dvbsubdecoder
 
 /**
  * Reader for stream of bits.
+ *
+ * Bytes are prefetched into a 64-bit buffer so that codes could be peeked
+ * and decoded without touching the reader for every few bits. The reader
+ * given in constructor is moved forward only by the bytes actually
+ * consumed (rounded up to full bytes) when the stream is destroyed.
  */
 class BitStream
 {
@@ -40,12 +48,75 @@ public:
      */
     BitStream(PesPacketReader& reader) :
             m_reader(reader),
+            m_data(nullptr),
+            m_dataLeft(0),
+            m_bitsValues(0),
             m_bitsLeft(0),
-            m_bitsValues(0)
+            m_bytesTaken(0)
     {
         // noop
     }
 
+    /**
+     * Destructor.
+     *
+     * Moves the reader past the consumed bytes.
+     */
+    ~BitStream()
+    {
+        // partially consumed byte is skipped too, cannot fail as the bytes
+        // were already taken from the reader
+        m_reader.skip(m_bytesTaken - m_dataLeft - m_bitsLeft / 8);
+    }
+
+    BitStream(const BitStream&) = delete;
+    BitStream& operator=(const BitStream&) = delete;
+
+    /**
+     * Peeks number of bits from the stream.
+     *
+     * Bits beyond the end of the data are returned as zeros, the caller
+     * shall verify the length of the decoded code using skip().
+     *
+     * @param count
+     *      Number of bits to peek (1..32).
+     *
+     * @return
+     *      The value peeked (stored on lowest bits).
+     */
+    std::uint32_t peek(std::uint8_t count)
+    {
+        if (m_bitsLeft < count)
+        {
+            refill();
+        }
+        return static_cast<std::uint32_t>(m_bitsValues >> (64 - count));
+    }
+
+    /**
+     * Skips number of bits.
+     *
+     * @param count
+     *      Number of bits to skip (at most 32).
+     *
+     * @throw PesPacketReader::Exception
+     *      if there is not enough data.
+     */
+    void skip(std::uint8_t count)
+    {
+        if (m_bitsLeft < count)
+        {
+            refill();
+            if (m_bitsLeft < count)
+            {
+                throw PesPacketReader::Exception("No more bytes available");
+            }
+        }
+
+        m_bitsValues <<= count;
+        m_bitsLeft -= count;
+    }
+
     /**
      * Reads number of bits from the stream.
      *
@@ -55,6 +126,9 @@ public:
      * @return
      *      The value read (stored on lowest bits).
      *
+     * @throw PesPacketReader::Exception
+     *      if there is not enough data.
+     *
      * @tparam LEN
      *      Number of bits to read.
      */
@@ -63,26 +137,104 @@ public:
     {
         static_assert((LEN > 0) && (LEN <= 8), "Unsupported length");
 
-        static const std::uint32_t MASK = (1 << LEN) - 1;
-
         if (m_bitsLeft < LEN)
         {
-            m_bitsValues <<= 8;
-            m_bitsValues |= m_reader.readUint8();
-            m_bitsLeft += 8;
+            refill();
+            if (m_bitsLeft < LEN)
+            {
+                throw PesPacketReader::Exception("No more bytes available");
+            }
         }
 
+        const auto value = static_cast<std::uint8_t>(m_bitsValues >> (64 - LEN));
+        m_bitsValues <<= LEN;
         m_bitsLeft -= LEN;
-        return static_cast<std::uint8_t>((m_bitsValues >> m_bitsLeft) & MASK);
+        return value;
     }
 
 private:
+    /**
+     * Fills the internal buffer with as many bytes as possible.
+     */
+    void refill()
+    {
+        if (m_dataLeft >= 8)
+        {
+            // load whole word, bits below the accounted bytes are the next
+            // bytes of the block so they will be or'ed again with same value
+            const std::uint64_t word =
+                    (static_cast<std::uint64_t>(m_data[0]) << 56)
+                    | (static_cast<std::uint64_t>(m_data[1]) << 48)
+                    | (static_cast<std::uint64_t>(m_data[2]) << 40)
+                    | (static_cast<std::uint64_t>(m_data[3]) << 32)
+                    | (static_cast<std::uint64_t>(m_data[4]) << 24)
+                    | (static_cast<std::uint64_t>(m_data[5]) << 16)
+                    | (static_cast<std::uint64_t>(m_data[6]) << 8)
+                    | (static_cast<std::uint64_t>(m_data[7]));
+            const std::uint32_t count = (63 - m_bitsLeft) / 8;
+
+            m_bitsValues |= word >> m_bitsLeft;
+            m_data += count;
+            m_dataLeft -= count;
+            m_bitsLeft += count * 8;
+        }
+        else
+        {
+            refillBytes();
+        }
+    }
+
+    /**
+     * Fills the internal buffer byte by byte.
+     *
+     * Used at the end of data blocks.
+     */
+    void refillBytes()
+    {
+        while (m_bitsLeft <= 56)
+        {
+            if (m_dataLeft == 0)
+            {
+                nextBlock();
+                if (m_dataLeft == 0)
+                {
+                    break;
+                }
+            }
+
+            m_bitsValues |= static_cast<std::uint64_t>(*m_data++)
+                    << (56 - m_bitsLeft);
+            --m_dataLeft;
+            m_bitsLeft += 8;
+        }
+    }
+
+    /**
+     * Takes next contiguous block of data from the reader.
+     */
+    void nextBlock()
+    {
+        // position is derived from number of bytes taken, the reader itself
+        // is moved only when the stream is destroyed
+        PesPacketReader source(m_reader);
+        source.skip(m_bytesTaken);
+        m_dataLeft = source.peekBlock(m_data);
+
+        m_bytesTaken += m_dataLeft;
+    }
+
     /** Reader from which bytes of data are read. */
     PesPacketReader& m_reader;
+    /** Current block of prefetched data. */
+    const std::uint8_t* m_data;
+    /** Number of bytes left in current block. */
+    std::size_t m_dataLeft;
+    /** Internal buffer with bits (stored on highest bits). */
+    std::uint64_t m_bitsValues;
     /** Number of bits left in the internal buffer. */
-    std::uint8_t m_bitsLeft;
-    /** Internal buffer with bits. */
-    std::uint32_t m_bitsValues;
+    std::uint32_t m_bitsLeft;
+    /** Number of bytes taken from the reader. */
+    std::size_t m_bytesTaken;
 };
 
 } // namespace dvbsubdecoder
@@ -20,6 +20,8 @@
 
 #include "ObjectParser.hpp"
 
+#include <array>
+
 #include <subttxrend/common/Logger.hpp>
 
 #include "PesPacketReader.hpp"
@@ -45,6 +47,261 @@ const std::uint8_t DATA_TYPE_2_TO_8_BIT_MAP_TABLE_DATA = 0x21;
 const std::uint8_t DATA_TYPE_4_TO_8_BIT_MAP_TABLE_DATA = 0x22;
 const std::uint8_t DATA_TYPE_END_OF_OBJECT_LINE_CODE = 0xF0;
 
+/**
+ * Type of pixel code.
+ */
+enum class CodeType : std::uint8_t
+{
+    /** Run of pixels, fully described by the table entry. */
+    RUN,
+    /** End of pixel code string. */
+    END,
+    /** Run of pixels of known length, pixel code follows. */
+    RUN_WITH_CODE,
+    /** Run with 4-bit length field, pixel code follows. */
+    RUN_4BIT_LENGTH,
+    /** Run with 8-bit length field, pixel code follows. */
+    RUN_8BIT_LENGTH
+};
+
+/**
+ * Pixel code table entry.
+ *
+ * Describes the code that starts with the bits used as the table index.
+ */
+struct CodeEntry
+{
+    /** Number of bits of the code covered by the entry. */
+    std::uint8_t m_length;
+    /** Code type. */
+    CodeType m_type;
+    /** Pixel code (for RUN). */
+    std::uint8_t m_pixelCode;
+    /** Run length (for RUN and RUN_WITH_CODE) or length base. */
+    std::uint16_t m_runLength;
+};
+
+/** Number of bits used to index the code tables. */
+const std::uint8_t CODE_TABLE_BITS = 8;
+
+/** Pixel code table. */
+using CodeTable = std::array<CodeEntry, 1 << CODE_TABLE_BITS>;
+
+/**
+ * Builds decoding table for 2-bit pixel code strings.
+ *
+ * @return
+ *      Built table.
+ */
+CodeTable buildCodeTable2bit()
+{
+    CodeTable table;
+
+    for (std::uint32_t i = 0; i < table.size(); ++i)
+    {
+        const std::uint8_t bits = static_cast<std::uint8_t>(i);
+
+        if ((bits >> 6) != 0)
+        {
+            // 01 - one pixel in colour 1
+            // 10 - one pixel in colour 2
+            // 11 - one pixel in colour 3
+            table[i] = CodeEntry{2, CodeType::RUN,
+                    static_cast<std::uint8_t>(bits >> 6), 1};
+        }
+        else if ((bits >> 5) == 1)
+        {
+            // 00 1L LL CC - L pixels (3..10) in colour C
+            table[i] = CodeEntry{8, CodeType::RUN,
+                    static_cast<std::uint8_t>(bits & 0x03),
+                    static_cast<std::uint16_t>(3 + ((bits >> 2) & 0x07))};
+        }
+        else if ((bits >> 4) == 1)
+        {
+            // 00 01 - one pixel in colour 0
+            table[i] = CodeEntry{4, CodeType::RUN, 0, 1};
+        }
+        else
+        {
+            switch ((bits >> 2) & 0x03)
+            {
+            case 0:
+                // 00 00 00 - end of 2-bit/pixel_code_string
+                table[i] = CodeEntry{6, CodeType::END, 0, 0};
+                break;
+            case 1:
+                // 00 00 01 - two pixels in colour 0
+                table[i] = CodeEntry{6, CodeType::RUN, 0, 2};
+                break;
+            case 2:
+                // 00 00 10 LL LL CC - L pixels (12..27) in colour C
+                table[i] = CodeEntry{6, CodeType::RUN_4BIT_LENGTH, 0, 12};
+                break;
+            default:
+                // 00 00 11 LL LL LL LL CC - L pixels (29..284) in colour C
+                table[i] = CodeEntry{6, CodeType::RUN_8BIT_LENGTH, 0, 29};
+                break;
+            }
+        }
+    }
+
+    return table;
+}
+
+/**
+ * Builds decoding table for 4-bit pixel code strings.
+ *
+ * @return
+ *      Built table.
+ */
+CodeTable buildCodeTable4bit()
+{
+    CodeTable table;
+
+    for (std::uint32_t i = 0; i < table.size(); ++i)
+    {
+        const std::uint8_t bits = static_cast<std::uint8_t>(i);
+
+        if ((bits >> 4) != 0)
+        {
+            // 0001 - one pixel in colour 1
+            // to to
+            // 1111 - one pixel in colour 15
+            table[i] = CodeEntry{4, CodeType::RUN,
+                    static_cast<std::uint8_t>(bits >> 4), 1};
+        }
+        else if ((bits & 0x08) == 0)
+        {
+            if ((bits & 0x07) != 0)
+            {
+                // 0000 0LLL - L pixels (3..9) in colour 0 (L>0)
+                table[i] = CodeEntry{8, CodeType::RUN, 0,
+                        static_cast<std::uint16_t>((bits & 0x07) + 2)};
+            }
+            else
+            {
+                // 0000 0000 - end of 4-bit/pixel_code_string
+                table[i] = CodeEntry{8, CodeType::END, 0, 0};
+            }
+        }
+        else if ((bits & 0x04) == 0)
+        {
+            // 0000 10LL CCCC - L pixels (4..7) in colour C
+            table[i] = CodeEntry{8, CodeType::RUN_WITH_CODE, 0,
+                    static_cast<std::uint16_t>((bits & 0x03) + 4)};
+        }
+        else
+        {
+            switch (bits & 0x03)
+            {
+            case 0:
+                // 0000 1100 one pixel in colour 0
+                table[i] = CodeEntry{8, CodeType::RUN, 0, 1};
+                break;
+            case 1:
+                // 0000 1101 two pixels in colour 0
+                table[i] = CodeEntry{8, CodeType::RUN, 0, 2};
+                break;
+            case 2:
+                // 0000 1110 LLLL CCCC - L pixels (9..24) in colour C
+                table[i] = CodeEntry{8, CodeType::RUN_4BIT_LENGTH, 0, 9};
+                break;
+            default:
+                // 0000 1111 LLLL LLLL CCCC - L pixels (25..280) in colour C
+                table[i] = CodeEntry{8, CodeType::RUN_8BIT_LENGTH, 0, 25};
+                break;
+            }
+        }
+    }
+
+    return table;
+}
+
+/** Decoding table for 2-bit pixel code strings. */
+const CodeTable CODE_TABLE_2BIT = buildCodeTable2bit();
+
+/** Decoding table for 4-bit pixel code strings. */
+const CodeTable CODE_TABLE_4BIT = buildCodeTable4bit();
+
+/**
+ * Decodes pixel code string using the code table.
+ *
+ * Common codes are decoded with a single table lookup, only the long
+ * runs need the length and pixel code fields read separately.
+ *
+ * @param bitStream
+ *      Stream to read from.
+ * @param table
+ *      Code table to use.
+ * @param setPixels
+ *      Functor called with pixel code and count for each decoded run.
+ *
+ * @throw PesPacketReader::Exception
+ *      if the string is truncated.
+ *
+ * @tparam CODE_BITS
+ *      Number of bits of the pixel code.
+ */
+template<std::uint8_t CODE_BITS, typename SetPixels>
+void decodePixelCodeString(BitStream& bitStream,
+                           const CodeTable& table,
+                           SetPixels setPixels)
+{
+    for (;;)
+    {
+        const auto bits = bitStream.peek(CODE_TABLE_BITS);
+
+        // single pixel codes are the most common ones, constant length
+        // skip keeps the table lookup out of the dependency chain
+        const std::uint8_t pixelCode = bits >> (CODE_TABLE_BITS - CODE_BITS);
+        if (pixelCode != 0)
+        {
+            bitStream.skip(CODE_BITS);
+            setPixels(pixelCode, 1);
+            continue;
+        }
+
+        const auto& entry = table[bits];
+        bitStream.skip(entry.m_length);
+
+        if (entry.m_type == CodeType::RUN)
+        {
+            setPixels(entry.m_pixelCode, entry.m_runLength);
+            continue;
+        }
+
+        switch (entry.m_type)
+        {
+        case CodeType::END:
+            return;
+
+        case CodeType::RUN_WITH_CODE:
+        {
+            auto pixelCode = bitStream.read<CODE_BITS>();
+            setPixels(pixelCode, entry.m_runLength);
+            break;
+        }
+
+        case CodeType::RUN_4BIT_LENGTH:
+        {
+            auto runLength = bitStream.read<4>();
+            auto pixelCode = bitStream.read<CODE_BITS>();
+            setPixels(pixelCode, entry.m_runLength + runLength);
+            break;
+        }
+
+        case CodeType::RUN_8BIT_LENGTH:
+        default:
+        {
+            auto runLength = bitStream.read<8>();
+            auto pixelCode = bitStream.read<CODE_BITS>();
+            setPixels(pixelCode, entry.m_runLength + runLength);
+            break;
+        }
+        }
+    }
+}
+
 } // namespace <anonmymous>
 
 ObjectParser::ObjectParser(PesPacketReader& reader,
@@ -147,70 +404,11 @@ void ObjectParser::parse2bitPixelCodeString()
 
     BitStream bitStream(m_reader);
 
-    for (;;)
-    {
-        auto nextBits = bitStream.read<2>();
-        if (nextBits != 0)
-        {
-            // 01 - one pixel in colour 1
-            // 10 - one pixel in colour 2
-            // 11 - one pixel in colour 3
-            auto pixelCode = nextBits;
-            setPixels(pixelCode, 1);
-        }
-        else
-        {
-            // 00 x
-            auto switch1 = bitStream.read<1>();
-
-            if (switch1 == 1)
+    decodePixelCodeString<2>(bitStream, CODE_TABLE_2BIT,
+            [this](std::uint8_t pixelCode, std::uint32_t count)
             {
-                // 00 1L LL CC - L pixels (3..10) in colour C
-                auto runLength3_10 = bitStream.read<3>();
-                auto pixelCode = bitStream.read<2>();
-                setPixels(pixelCode, 3 + runLength3_10);
-            }
-            else
-            {
-                // 00 0x
-                auto switch2 = bitStream.read<1>();
-                if (switch2 == 0)
-                {
-                    // 00 00 xx
-                    auto switch3 = bitStream.read<2>();
-                    if (switch3 == 0)
-                    {
-                        // 00 00 00 - end of 2-bit/pixel_code_string
-                        break;
-                    }
-                    else if (switch3 == 1)
-                    {
-                        // 00 00 01 - two pixels in colour 0
-                        setPixels(0, 2);
-                    }
-                    else if (switch3 == 2)
-                    {
-                        // 00 00 10 LL LL CC - L pixels (12..27) in colour C
-                        auto runLength12_27 = bitStream.read<4>();
-                        auto pixelCode = bitStream.read<2>();
-                        setPixels(pixelCode, runLength12_27 + 12);
-                    }
-                    else // if (switch3 == 3)
-                    {
-                        // 00 00 11 LL LL LL LL CC - L pixels (29..284) in colour C
-                        auto runLength29_284 = bitStream.read<8>();
-                        auto pixelCode = bitStream.read<2>();
-                        setPixels(pixelCode, runLength29_284 + 29);
-                    }
-                }
-                else
-                {
-                    // 00 01 - one pixel in colour 0
-                    setPixels(0, 1);
-                }
-            }
-        }
-    }
+                setPixels(pixelCode, count);
+            });
 }
 
 void ObjectParser::parse4bitPixelCodeString()
@@ -235,80 +433,11 @@ void ObjectParser::parse4bitPixelCodeString()
 
     BitStream bitStream(m_reader);
 
-    for (;;)
-    {
-        auto nextBits1 = bitStream.read<4>();
-        if (nextBits1 != 0)
-        {
-            // 0001 - one pixel in colour 1
-            // to to
-            // 1111 - one pixel in colour 15
-            auto pixelCode = nextBits1;
-            setPixels(pixelCode, 1);
-        }
-        else
-        {
-            // 0000 x
-            auto switch1 = bitStream.read<1>();
-            if (switch1 == 0)
-            {
-                // 0000 0xxx
-                auto nextBits2 = bitStream.read<3>();
-                if (nextBits2 != 0)
-                {
-                    // 0000 0LLL - L pixels (3..9) in colour 0 (L>0)
-                    auto runLength3_9 = nextBits2;
-                    setPixels(0, runLength3_9 + 2);
-                }
-                else
-                {
-                    // 0000 0000 - end of 4-bit/pixel_code_string
-                    break;
-                }
-            }
-            else
+    decodePixelCodeString<4>(bitStream, CODE_TABLE_4BIT,
+            [this](std::uint8_t pixelCode, std::uint32_t count)
             {
-                // 0000 1x
-                auto switch2 = bitStream.read<1>();
-                if (switch2 == 0)
-                {
-                    // 0000 10LL CCCC - L pixels (4..7) in colour C
-                    auto runLength4_7 = bitStream.read<2>();
-                    auto pixelCode = bitStream.read<4>();
-                    setPixels(pixelCode, runLength4_7 + 4);
-                }
-                else
-                {
-                    // 0000 11xx
-                    auto switch3 = bitStream.read<2>();
-                    if (switch3 == 0)
-                    {
-                        // 0000 1100 one pixel in colour 0
-                        setPixels(0, 1);
-                    }
-                    else if (switch3 == 1)
-                    {
-                        // 0000 1101 two pixels in colour 0
-                        setPixels(0, 2);
-                    }
-                    else if (switch3 == 2)
-                    {
-                        // 0000 1110 LLLL CCCC - L pixels (9..24) in colour C
-                        auto runLength9_24 = bitStream.read<4>();
-                        auto pixelCode = bitStream.read<4>();
-                        setPixels(pixelCode, runLength9_24 + 9);
-                    }
-                    else // if (switch3 == 3)
-                    {
-                        // 0000 1111 LLLL LLLL CCCC - L pixels (25..280) in colour C
-                        auto runLength25_280 = bitStream.read<8>();
-                        auto pixelCode = bitStream.read<4>();
-                        setPixels(pixelCode, runLength25_280 + 25);
-                    }
-                }
-            }
-        }
-    }
+                setPixels(pixelCode, count);
+            });
 }
 
 void ObjectParser::parse8bitPixelCodeString()
@@ -433,7 +562,8 @@ void ObjectParser::setPixels(std::uint8_t pixelCode,
         pixelCode = m_currentMap[pixelCode];
     }
 
-    m_writer.setPixels(pixelCode, count);
+    // codes read from the string (or map tables) always fit the depth
+    m_writer.setPixelRun(pixelCode, count);
 }
 
 } // namespace dvbsubdecoder
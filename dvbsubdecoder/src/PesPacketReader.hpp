@@ -221,6 +221,26 @@ public:
      */
     void skip(std::size_t count);
 
+    /**
+     * Peeks contiguous block of data (does not move pointer).
+     * @param data
+     *      Pointer to the data available without crossing the chunk
+     *      boundary (output).
+     * @return
+     *      Number of bytes available at data, zero if no more data.
+     */
+    std::size_t peekBlock(const std::uint8_t*& data) const
+    {
+        if (m_chunkLen1 > 0)
+        {
+            data = m_chunkData1;
+            return m_chunkLen1;
+        }
+
+        data = m_chunkData2;
+        return m_chunkLen2;
+    }
+
     /**
      * Returns number of bytes left in the buffer.
      *
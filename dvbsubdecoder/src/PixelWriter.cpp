@@ -78,32 +78,7 @@ void PixelWriter::setPixels(std::uint8_t pixelCode,
         throw std::invalid_argument("pixelCode");
     }
 
-    if (m_nonModifyingColourFlag && (pixelCode == 1))
-    {
-        if (m_lineEndPtr - m_currentPtr <= static_cast<std::ptrdiff_t>(count))
-        {
-            m_currentPtr = nullptr;
-        }
-        else
-        {
-            m_currentPtr += count;
-        }
-    }
-    else
-    {
-        while (count-- > 0)
-        {
-            if (m_currentPtr < m_lineEndPtr)
-            {
-                *m_currentPtr++ = pixelCode;
-            }
-            else
-            {
-                m_currentPtr = nullptr;
-                break;
-            }
-        }
-    }
+    setPixelRun(pixelCode, count);
 }
 
 void PixelWriter::endLine()
@@ -22,6 +22,7 @@
 #define DVBSUBDECODER_PIXELWRITER_HPP_
 
 #include <cstdint>
+#include <cstring>
 
 #include "Pixmap.hpp"
 
@@ -79,6 +80,64 @@ public:
     void setPixels(std::uint8_t pixelCode,
                    std::uint32_t count);
 
+    /**
+     * Sets run of pixmap pixels.
+     *
+     * Fast path for the object parser: the pixel code is not validated
+     * and the run is clamped to the line end once and filled at once.
+     *
+     * @param pixelCode
+     *      Code of the pixel(s) to write (CLUT index).
+     *      Must be in range defined by pixmap depth.
+     * @param count
+     *      Number of pixels to store.
+     */
+    void setPixelRun(std::uint8_t pixelCode,
+                     std::uint32_t count)
+    {
+        if (!m_currentPtr)
+        {
+            return;
+        }
+
+        const auto available = static_cast<std::uint32_t>(m_lineEndPtr
+                - m_currentPtr);
+
+        if (m_nonModifyingColourFlag && (pixelCode == 1))
+        {
+            if (available <= count)
+            {
+                m_currentPtr = nullptr;
+            }
+            else
+            {
+                m_currentPtr += count;
+            }
+        }
+        else if (count == 1)
+        {
+            if (available > 0)
+            {
+                *m_currentPtr++ = pixelCode;
+            }
+            else
+            {
+                m_currentPtr = nullptr;
+            }
+        }
+        else if (count <= available)
+        {
+            std::memset(m_currentPtr, pixelCode, count);
+            m_currentPtr += count;
+        }
+        else
+        {
+            // pixels beyond the line end are dropped
+            std::memset(m_currentPtr, pixelCode, available);
+            m_currentPtr = nullptr;
+        }
+    }
+
     /**
      * Ends current line.
      *
@@ -30,6 +30,10 @@ class BitStreamTest : public CppUnit::TestFixture
 CPPUNIT_TEST_SUITE( BitStreamTest );
     CPPUNIT_TEST(testReadSimple);
     CPPUNIT_TEST(testReadRandom);
+    CPPUNIT_TEST(testPeekSkip);
+    CPPUNIT_TEST(testTwoChunks);
+    CPPUNIT_TEST(testReaderPosition);
+    CPPUNIT_TEST(testTruncated);
 CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -174,6 +178,103 @@ public:
             CPPUNIT_ASSERT_EQUAL((int )expected[i], (int )read[i]);
         }
     }
+
+    void testPeekSkip()
+    {
+        const std::uint8_t data[] =
+        { 0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0x0F, 0xED };
+
+        PesPacketReader reader(data, sizeof(data), nullptr, 0U);
+        BitStream bitStream(reader);
+
+        CPPUNIT_ASSERT_EQUAL(0x1234U, bitStream.peek(16));
+        CPPUNIT_ASSERT_EQUAL(0x12345678U, bitStream.peek(32));
+        bitStream.skip(4);
+        CPPUNIT_ASSERT_EQUAL(0x23456789U, bitStream.peek(32));
+        bitStream.skip(28);
+        bitStream.skip(3);
+        CPPUNIT_ASSERT_EQUAL(0x1AU, bitStream.peek(5));
+        CPPUNIT_ASSERT_EQUAL(0x1A, static_cast<int>(bitStream.read<5>()));
+        CPPUNIT_ASSERT_EQUAL(0xBCDEF00FU, bitStream.peek(32));
+        bitStream.skip(32);
+
+        // bits beyond the end are zeros
+        CPPUNIT_ASSERT_EQUAL(0xED00U, bitStream.peek(16));
+        CPPUNIT_ASSERT_EQUAL(0xED, static_cast<int>(bitStream.read<8>()));
+        CPPUNIT_ASSERT_EQUAL(0U, bitStream.peek(8));
+    }
+
+    void testTwoChunks()
+    {
+        std::vector<std::uint8_t> data;
+        for (int i = 0; i < 40; ++i)
+        {
+            data.push_back(static_cast<std::uint8_t>(i * 37 + 11));
+        }
+
+        for (std::size_t split = 0; split <= data.size(); ++split)
+        {
+            PesPacketReader reader(data.data(), split, data.data() + split,
+                    data.size() - split);
+            BitStream bitStream(reader);
+
+            for (std::size_t i = 0; i < data.size(); ++i)
+            {
+                // odd reads to cross the byte boundaries
+                const std::uint8_t high = bitStream.read<3>();
+                const std::uint8_t low = bitStream.read<5>();
+                CPPUNIT_ASSERT_EQUAL(static_cast<int>(data[i]),
+                        (high << 5) | low);
+            }
+            CPPUNIT_ASSERT_THROW(bitStream.read<1>(),
+                    PesPacketReader::Exception);
+        }
+    }
+
+    void testReaderPosition()
+    {
+        const std::uint8_t data[] =
+        { 0xFF, 0xFF, 0xFF, 0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0,
+          0x11, 0x22 };
+
+        PesPacketReader reader(data, sizeof(data), nullptr, 0U);
+
+        {
+            BitStream bitStream(reader);
+            CPPUNIT_ASSERT_EQUAL(0x7, static_cast<int>(bitStream.read<3>()));
+        }
+        // partially consumed byte is skipped
+        CPPUNIT_ASSERT_EQUAL(sizeof(data) - 1, reader.getBytesLeft());
+
+        {
+            BitStream bitStream(reader);
+            bitStream.skip(16);
+            bitStream.peek(32);
+        }
+        // peeked bits are not consumed
+        CPPUNIT_ASSERT_EQUAL(sizeof(data) - 3, reader.getBytesLeft());
+        CPPUNIT_ASSERT_EQUAL(0x12, static_cast<int>(reader.readUint8()));
+
+        {
+            BitStream bitStream(reader);
+        }
+        CPPUNIT_ASSERT_EQUAL(0x34, static_cast<int>(reader.readUint8()));
+    }
+
+    void testTruncated()
+    {
+        const std::uint8_t data[] =
+        { 0xA5 };
+
+        PesPacketReader reader(data, sizeof(data), nullptr, 0U);
+        BitStream bitStream(reader);
+
+        CPPUNIT_ASSERT_THROW(bitStream.skip(9), PesPacketReader::Exception);
+        CPPUNIT_ASSERT_EQUAL(0xA, static_cast<int>(bitStream.read<4>()));
+        CPPUNIT_ASSERT_THROW(bitStream.read<5>(), PesPacketReader::Exception);
+        CPPUNIT_ASSERT_EQUAL(0x5, static_cast<int>(bitStream.read<4>()));
+        CPPUNIT_ASSERT_THROW(bitStream.skip(1), PesPacketReader::Exception);
+    }
 };
 
 // Registers the fixture into the 'registry'
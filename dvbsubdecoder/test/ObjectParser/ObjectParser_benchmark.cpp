@@ -0,0 +1,209 @@
+/*****************************************************************************
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:
+*
+* Copyright 2021 Liberty Global Service B.V.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*****************************************************************************/
+
+/*
+ * Micro-benchmark of the object data bit parsing.
+ *
+ * Measures BitStream reads and decoding of 2-bit and 4-bit pixel code
+ * strings with the pixels written outside of the pixmap (dropped), so only
+ * the bit parsing is measured. Not a unit test,
+ * run manually: ObjectParser_Benchmark [iterations]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "BitStream.hpp"
+#include "ObjectParser.hpp"
+#include "PesPacketReader.hpp"
+#include "PixelWriter.hpp"
+#include "Pixmap.hpp"
+
+#include "PixelStringWriter.hpp"
+
+using namespace dvbsubdecoder;
+
+namespace
+{
+
+/** Number of code strings in the test object. */
+const std::size_t STRING_COUNT = 1000;
+
+/** Number of pixels in single code string. */
+const std::uint32_t STRING_PIXELS = 960;
+
+/**
+ * Builds test object with pixel code strings.
+ *
+ * Run lengths are mostly short (glyph strokes) with some longer runs
+ * (gaps between glyphs and words).
+ */
+std::vector<std::uint8_t> makeObject(int depth)
+{
+    PixelStringWriter writer;
+
+    const std::uint8_t maxColor = (1 << depth) - 1;
+    std::uint32_t seed = 12345;
+
+    for (std::size_t line = 0; line < STRING_COUNT; ++line)
+    {
+        if (depth == 2)
+        {
+            writer.start2bitPixelCodeString();
+        }
+        else
+        {
+            writer.start4bitPixelCodeString();
+        }
+
+        std::uint32_t pixels = 0;
+        while (pixels < STRING_PIXELS)
+        {
+            seed = seed * 1103515245 + 12345;
+            const std::uint32_t r = (seed >> 16) & 0x7FFF;
+
+            const std::uint8_t color = r % (maxColor + 1);
+            const std::uint32_t count = std::min(((r % 8) == 0) ? 10 + r % 100
+                                                                : 1 + r % 4,
+                                                 STRING_PIXELS - pixels);
+            if (depth == 2)
+            {
+                writer.write2bitPixels(color, count);
+            }
+            else
+            {
+                writer.write4bitPixels(color, count);
+            }
+            pixels += count;
+        }
+
+        if (depth == 2)
+        {
+            writer.end2bitPixelCodeString();
+        }
+        else
+        {
+            writer.end4bitPixelCodeString();
+        }
+    }
+
+    return std::vector<std::uint8_t>(writer.data(),
+            writer.data() + writer.size());
+}
+
+template<typename Function>
+double measure(std::size_t iterations,
+               Function function)
+{
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < iterations; ++i)
+    {
+        function();
+    }
+    const auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count();
+}
+
+void benchmarkBitStream(std::size_t iterations)
+{
+    std::vector<std::uint8_t> data(64 * 1024);
+    std::uint32_t seed = 54321;
+    for (auto& value : data)
+    {
+        seed = seed * 1103515245 + 12345;
+        value = static_cast<std::uint8_t>(seed >> 16);
+    }
+
+    volatile std::uint32_t sink = 0;
+
+    const double ns2 = measure(iterations, [&]()
+    {
+        PesPacketReader reader(data.data(), data.size(), nullptr, 0);
+        BitStream bitStream(reader);
+        std::uint32_t sum = 0;
+        for (std::size_t i = 0; i < data.size() * 4; ++i)
+        {
+            sum += bitStream.read<2>();
+        }
+        sink = sum;
+    });
+
+    const double ns4 = measure(iterations, [&]()
+    {
+        PesPacketReader reader(data.data(), data.size(), nullptr, 0);
+        BitStream bitStream(reader);
+        std::uint32_t sum = 0;
+        for (std::size_t i = 0; i < data.size() * 2; ++i)
+        {
+            sum += bitStream.read<4>();
+        }
+        sink = sum;
+    });
+
+    (void)sink;
+
+    std::printf("BitStream read<2>: %.3f ns/read\n",
+            ns2 / iterations / (data.size() * 4));
+    std::printf("BitStream read<4>: %.3f ns/read\n",
+            ns4 / iterations / (data.size() * 2));
+}
+
+void benchmarkDecode(int depth,
+                     std::size_t iterations)
+{
+    const auto object = makeObject(depth);
+
+    // writer positioned outside of the pixmap drops all pixels
+    std::vector<std::uint8_t> buffer(16);
+    Pixmap pixmap;
+    pixmap.init(4, 4, buffer.data());
+
+    const double ns = measure(iterations, [&]()
+    {
+        PesPacketReader reader(object.data(), object.size(), nullptr, 0);
+        PixelWriter writer(false, depth, pixmap, 4, 0);
+        ObjectParser parser(reader, writer);
+        parser.parse();
+    });
+
+    std::printf("%d-bit strings: %zu bytes, %.3f ns/byte, %.3f ns/pixel\n",
+            depth, object.size(), ns / iterations / object.size(),
+            ns / iterations / (STRING_COUNT * STRING_PIXELS));
+}
+
+} // namespace
+
+int main(int argc,
+         char* argv[])
+{
+    std::size_t iterations = 50;
+    if (argc > 1)
+    {
+        iterations = std::strtoul(argv[1], nullptr, 10);
+    }
+
+    benchmarkBitStream(iterations);
+    benchmarkDecode(2, iterations);
+    benchmarkDecode(4, iterations);
+
+    return EXIT_SUCCESS;
+}
@@ -20,6 +20,8 @@
 
 #include <cppunit/extensions/HelperMacros.h>
 
+#include <vector>
+
 #include <subttxrend/common/Logger.hpp>
 
 #include "ObjectParser.hpp"
@@ -60,6 +62,8 @@ CPPUNIT_TEST_SUITE( PixelWriterTest );
     CPPUNIT_TEST(testDoubleString4);
     CPPUNIT_TEST(testDoubleString8);
     CPPUNIT_TEST(testMultiline);
+    CPPUNIT_TEST(testMixedRuns);
+    CPPUNIT_TEST(testTruncatedStrings);
     CPPUNIT_TEST_SUITE_END()
     ;
 
@@ -787,6 +791,120 @@ public:
         }
     }
 
+    void testMixedRuns()
+    {
+        for (auto depth : { 2, 4 })
+        {
+            std::vector<std::uint8_t> expected;
+            const auto stream = buildMixedRuns(depth, expected);
+
+            m_pixmap.clear(0xFF);
+
+            PesPacketReader reader(stream.data(), stream.size(), nullptr, 0);
+            PixelWriter writer(false, depth, m_pixmap, 0, 0);
+            ObjectParser parser(reader, writer);
+
+            CPPUNIT_ASSERT_NO_THROW(parser.parse());
+
+            auto line = m_pixmap.getLine(0);
+            for (std::size_t i = 0; i < expected.size(); ++i)
+            {
+                CPPUNIT_ASSERT_EQUAL(static_cast<int>(expected[i]),
+                        static_cast<int>(line[i]));
+            }
+            for (auto i = static_cast<std::int32_t>(expected.size()); i < WIDTH;
+                    ++i)
+            {
+                CPPUNIT_ASSERT_EQUAL(0xFF, static_cast<int>(line[i]));
+            }
+        }
+    }
+
+    void testTruncatedStrings()
+    {
+        for (auto depth : { 2, 4 })
+        {
+            std::vector<std::uint8_t> expected;
+            const auto stream = buildMixedRuns(depth, expected);
+
+            for (std::size_t size = 1; size < stream.size(); ++size)
+            {
+                PesPacketReader reader(stream.data(), size, nullptr, 0);
+                PixelWriter writer(false, depth, m_pixmap, 0, 0);
+                ObjectParser parser(reader, writer);
+
+                CPPUNIT_ASSERT_THROW(parser.parse(),
+                        PesPacketReader::Exception);
+            }
+        }
+    }
+
+private:
+    /**
+     * Builds pixel code string using all kinds of codes.
+     *
+     * @param depth
+     *      Pixel code string depth (2 or 4).
+     * @param expected
+     *      Expected pixels (output).
+     *
+     * @return
+     *      Built data.
+     */
+    std::vector<std::uint8_t> buildMixedRuns(int depth,
+                                             std::vector<std::uint8_t>& expected)
+    {
+        // lengths covering the one pixel, short, long and longest codes
+        const int lengths[] =
+        { 1, 2, 3, 4, 5, 7, 9, 10, 11, 12, 20, 24, 25, 27, 28, 29, 100, 280 };
+        const int colorCount = 1 << depth;
+
+        PixelStringWriter stringWriter;
+        if (depth == 2)
+        {
+            stringWriter.start2bitPixelCodeString();
+        }
+        else
+        {
+            stringWriter.start4bitPixelCodeString();
+        }
+
+        expected.clear();
+
+        int colorIndex = 0;
+        for (auto length : lengths)
+        {
+            if (expected.size() + length > static_cast<std::size_t>(WIDTH))
+            {
+                break;
+            }
+
+            if (depth == 2)
+            {
+                stringWriter.write2bitPixels(colorIndex, length);
+            }
+            else
+            {
+                stringWriter.write4bitPixels(colorIndex, length);
+            }
+            expected.insert(expected.end(), length, colorIndex);
+
+            colorIndex = (colorIndex + 1) % colorCount;
+        }
+
+        if (depth == 2)
+        {
+            stringWriter.end2bitPixelCodeString();
+        }
+        else
+        {
+            stringWriter.end4bitPixelCodeString();
+        }
+
+        return std::vector<std::uint8_t>(stringWriter.data(),
+                stringWriter.data() + stringWriter.size());
+    }
+
 private:
     static const std::int32_t WIDTH = 512;
     static const std::int32_t HEIGHT = 100;
@@ -0,0 +1,171 @@
+/*****************************************************************************
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:
+*
+* Copyright 2021 Liberty Global Service B.V.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*****************************************************************************/
+
+/*
+ * Micro-benchmark of the object pixel decoding (ObjectParser + PixelWriter).
+ *
+ * Decodes HD sized objects coded with 2-bit, 4-bit and 8-bit pixel code
+ * strings and reports the decoding time per pixel. Not a unit test,
+ * run manually: PixelWriter_Benchmark [iterations]
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "ObjectParser.hpp"
+#include "PesPacketReader.hpp"
+#include "PixelWriter.hpp"
+#include "Pixmap.hpp"
+
+#include "PixelStringWriter.hpp"
+
+using namespace dvbsubdecoder;
+
+namespace
+{
+
+const std::int32_t WIDTH = 1920;
+const std::int32_t HEIGHT = 1080;
+
+/**
+ * Builds object resembling subtitle text: long transparent runs around
+ * the text area and short runs of glyph colours inside it.
+ */
+PixelStringWriter makeObject(int depth)
+{
+    PixelStringWriter writer;
+
+    const std::uint8_t maxColor = (1 << depth) - 1;
+    std::uint32_t seed = 12345;
+
+    for (std::int32_t y = 0; y < HEIGHT; ++y)
+    {
+        switch (depth)
+        {
+        case 2:
+            writer.start2bitPixelCodeString();
+            break;
+        case 4:
+            writer.start4bitPixelCodeString();
+            break;
+        default:
+            writer.start8bitPixelCodeString();
+            break;
+        }
+
+        std::int32_t x = 0;
+        while (x < WIDTH)
+        {
+            seed = seed * 1103515245 + 12345;
+            const std::uint32_t r = (seed >> 16) & 0x7FFF;
+
+            std::uint8_t color = 0;
+            std::int32_t count = 0;
+            if ((x < WIDTH / 4) || (x >= WIDTH * 3 / 4) || ((r % 8) == 0))
+            {
+                count = 1 + r % 200;
+            }
+            else
+            {
+                color = 1 + (r % maxColor);
+                count = 1 + r % 6;
+            }
+            if (count > WIDTH - x)
+            {
+                count = WIDTH - x;
+            }
+
+            switch (depth)
+            {
+            case 2:
+                writer.write2bitPixels(color, count);
+                break;
+            case 4:
+                writer.write4bitPixels(color, count);
+                break;
+            default:
+                writer.write8bitPixels(color, count);
+                break;
+            }
+            x += count;
+        }
+
+        switch (depth)
+        {
+        case 2:
+            writer.end2bitPixelCodeString();
+            break;
+        case 4:
+            writer.end4bitPixelCodeString();
+            break;
+        default:
+            writer.end8bitPixelCodeString();
+            break;
+        }
+        writer.writeEndOfLine();
+    }
+
+    return writer;
+}
+
+void benchmarkDecode(int depth,
+                     std::size_t iterations)
+{
+    const auto object = makeObject(depth);
+
+    std::vector<std::uint8_t> buffer(WIDTH * HEIGHT);
+    Pixmap pixmap;
+    pixmap.init(WIDTH, HEIGHT, buffer.data());
+
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < iterations; ++i)
+    {
+        PesPacketReader reader(object.data(), object.size(), nullptr, 0);
+        PixelWriter writer(false, 8, pixmap, 0, 0);
+        ObjectParser parser(reader, writer);
+        parser.parse();
+    }
+    const auto end = std::chrono::steady_clock::now();
+
+    const double pixels = static_cast<double>(WIDTH) * HEIGHT * iterations;
+    const double ns = std::chrono::duration<double, std::nano>(end - start).count();
+
+    std::printf("%d-bit object: %zu bytes, %.3f ns/pixel, %.3f ms/object\n",
+            depth, object.size(), ns / pixels, ns / iterations / 1000000.0);
+}
+
+} // namespace
+
+int main(int argc,
+         char* argv[])
+{
+    std::size_t iterations = 20;
+    if (argc > 1)
+    {
+        iterations = std::strtoul(argv[1], nullptr, 10);
+    }
+
+    benchmarkDecode(2, iterations);
+    benchmarkDecode(4, iterations);
+    benchmarkDecode(8, iterations);
+
+    return EXIT_SUCCESS;
+}
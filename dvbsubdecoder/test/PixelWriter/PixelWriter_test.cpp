@@ -37,6 +37,7 @@ CPPUNIT_TEST_SUITE( PixelWriterTest );
     CPPUNIT_TEST(testNonModifyingColor);
     CPPUNIT_TEST(testBounds);
     CPPUNIT_TEST(testStartPos);
+    CPPUNIT_TEST(testPixelRunLineEnd);
 CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -317,6 +318,38 @@ public:
         }
     }
 
+    void testPixelRunLineEnd()
+    {
+        PixelWriter writer(false, 8, m_pixmap, WIDTH - 10, 0);
+
+        // run exactly to the line end, following pixels are dropped
+        writer.setPixelRun(0x11, 5);
+        writer.setPixelRun(0x22, 1);
+        writer.setPixelRun(0x33, 4);
+        writer.setPixelRun(0x44, 3);
+        writer.endLine();
+
+        // run crossing the line end is clamped
+        writer.setPixelRun(0x55, 1000);
+        writer.setPixelRun(0x66, 1);
+        writer.endLine();
+
+        for (auto x = 0; x < WIDTH; ++x)
+        {
+            int expected0 = 0;
+            int expected2 = 0;
+            if (x >= WIDTH - 10)
+            {
+                expected0 = (x < WIDTH - 5) ? 0x11 : (x == WIDTH - 5) ? 0x22 : 0x33;
+                expected2 = 0x55;
+            }
+            CPPUNIT_ASSERT_EQUAL(expected0, static_cast<int>(m_pixmap.getLine(0)[x]));
+            CPPUNIT_ASSERT_EQUAL(0, static_cast<int>(m_pixmap.getLine(1)[x]));
+            CPPUNIT_ASSERT_EQUAL(expected2, static_cast<int>(m_pixmap.getLine(2)[x]));
+            CPPUNIT_ASSERT_EQUAL(0, static_cast<int>(m_pixmap.getLine(4)[x]));
+        }
+    }
+
 private:
     static const std::int32_t WIDTH = 100;
     static const std::int32_t HEIGHT = 50;
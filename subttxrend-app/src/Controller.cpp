@@ -70,16 +70,25 @@ void forAllControllers(Ctrls const& ctrls, Packet const& packet, void (ctrl::Con
 
 constexpr const std::chrono::milliseconds connection_status_check_timeout{1000};
 
+/** Every n-th dropped data packet is logged. */
+constexpr const std::size_t DROPPED_PACKETS_LOG_INTERVAL{100};
+
 } /* namespace  */
 
 Controller::Controller(ctrl::Configuration const& config, gfx::EnginePtr gfxEngine, gfx::WindowPtr gfxWindow)
     : m_config(config)
     , m_gfxEngine(gfxEngine)
     , m_gfxWindow(gfxWindow)
-    , m_fontCache{std::make_shared<gfx::PrerenderedFontCache>()}
+    , m_fontCache{std::make_shared<gfx::PrerenderedFontCache>(config.getFontCacheSize())}
     , m_stcProvider()
     , m_logger("App", "Controller", this)
+    , m_dataQueue(config.getMainContextDataQueueSize())
+    , m_prewarmFonts(config.getGlyphPrewarmFonts())
+    , m_prewarmCodepoints(config.getGlyphPrewarmCodepoints())
     , m_endpoint{std::make_unique<common::WsEndpoint>()}
+    , m_renderLoop([this]() {return isRenderingActive();},
+                   [this]() {return processStep();},
+                   [this]() {onRenderingIdle();})
 {
     m_asClient = std::make_unique<common::AsClient>(connection_status_check_timeout,
                std::make_unique<common::WsConnection>("subttxrend-app", *m_endpoint));
@@ -94,11 +103,7 @@ Controller::Controller(ctrl::Configuration const& config, gfx::EnginePtr gfxEngi
 void Controller::startAsync()
 {
     m_logger.osinfo(__LOGGER_FUNC__);
-    {
-        LockGuard lock{m_renderMutex};
-        m_quitRenderThread = false;
-    }
-    m_renderThread = std::thread(&Controller::processLoop, this);
+    m_renderLoop.start();
 }
 
 void Controller::stop()
@@ -106,44 +111,39 @@ void Controller::stop()
     m_logger.osinfo(__LOGGER_FUNC__);
 
     m_logger.osinfo(__LOGGER_FUNC__, " stopping render thread");
-    {
-        LockGuard lock{m_renderMutex};
-        m_quitRenderThread = true;
-    }
-    m_renderCond.notify_one();
+    m_renderLoop.stop();
 
-    if (m_renderThread.joinable()) {
-        m_logger.osinfo(__LOGGER_FUNC__, " waiting for render thread to finish");
-        m_renderThread.join();
-    }
+    logDataQueueStatistics();
+    logGlyphPrewarmStatistics();
+    logFontCacheStatistics();
 
     LockGuard lock{m_mutex};
 
-    m_dataqueue.clear();
+    m_dataQueue.clear();
     m_activeControllers.clear();
+    m_renderingActive = false;
 }
 
 std::chrono::milliseconds Controller::processData()
 {
     auto waitTime = std::chrono::milliseconds::zero();
     {
-        bool shouldStop = false;
-        UniqueLock lock{m_mutex};
-        while (!shouldStop)
+        DataQueue::Batch batch;
+        auto const batchGeneration = m_dataQueue.takeAll(batch);
+
+        for (auto& buffer : batch)
         {
-            if(m_dataqueue.empty())
-            {
-                shouldStop = true;  //even if dataqueue is empty, we need to run controller->process() and then finish the loop
-            }
-            else
+            // parse without holding the lock, packets are only passed to controllers under it
+            auto const& packet = m_parser.parse(std::move(buffer));
+
+            UniqueLock lock{m_mutex};
+            if (m_dataQueue.getGeneration() != batchGeneration)
             {
-                auto const& packet = m_parser.parse(std::move(m_dataqueue.front()));
-                {
-                    auto t = m_logger.timing("doOnPacketReceived");
-                    doOnPacketReceived(lock, packet);
-                }
-                m_dataqueue.pop_front();
+                m_logger.osdebug(__LOGGER_FUNC__, " data queue cleared, dropping rest of the batch");
+                break;
             }
+            auto t = m_logger.timing("doOnPacketReceived");
+            doOnPacketReceived(lock, packet);
         }
     }
     {
@@ -176,11 +176,15 @@ void Controller::addBuffer(common::DataBufferPtr buffer)
     const bool renderingActive = isRenderingActive();
     if(renderingActive)
     {
+        if (m_dataQueue.push(std::move(buffer)))
         {
-            LockGuard lock{m_mutex};
-            m_dataqueue.emplace_back(std::move(buffer));
+            auto const stats = m_dataQueue.getStatistics();
+            if ((stats.m_dropped % DROPPED_PACKETS_LOG_INTERVAL) == 1)
+            {
+                m_logger.oswarning(__LOGGER_FUNC__, " data queue full, packets dropped: ", stats.m_dropped);
+            }
         }
-        m_renderCond.notify_one();
+        m_renderLoop.wakeup();
     }
     else
     {
@@ -195,7 +199,7 @@ void Controller::onPacketReceived(protocol::Packet const& packet)
         UniqueLock lock{m_mutex};
         doOnPacketReceived(lock, packet);
     }
-    m_renderCond.notify_one();
+    m_renderLoop.wakeup();
 }
 
 void Controller::doOnPacketReceived(UniqueLock& lock, const protocol::Packet& packet)
@@ -350,6 +354,7 @@ void Controller::processCcSubtitleSelection(const protocol::PacketSubtitleSelect
     m_logger.osinfo("Selecting CC Subtitles: ", packet.getChannelId());
     deactivateController();
     pushController(std::make_shared<ctrl::MutexedController<ctrl::CcSubController>>(packet, m_gfxWindow, m_fontCache));
+    prewarmGlyphs();
 }
 
 void Controller::processTtxSubtitleSelection(const protocol::PacketSubtitleSelection& packet)
@@ -381,7 +386,8 @@ void Controller::processTtmlSelection(const protocol::PacketTtmlSelection& packe
         m_logger.oserror(__LOGGER_FUNC__, " exception: ", e.what());
     }
 
-    pushController(std::make_shared<ctrl::TtmlController>(packet, m_config.getTtmlConfig(), m_gfxWindow, properties));
+    pushController(std::make_shared<ctrl::TtmlController>(packet, m_config.getTtmlConfig(), m_gfxWindow, properties, m_fontCache));
+    prewarmGlyphs();
 }
 
 void Controller::processWebvttSelection(const protocol::PacketWebvttSelection& packet)
@@ -389,7 +395,19 @@ void Controller::processWebvttSelection(const protocol::PacketWebvttSelection& p
     auto timing = m_logger.timing(__LOGGER_FUNC__);
     m_logger.osinfo("Selecting WebVTT Subtitles: ", packet.getChannelId());
     deactivateController();
-    pushController(std::make_shared<ctrl::WebvttController>(packet, m_config.getWebvttConfig(), m_gfxWindow));
+    pushController(std::make_shared<ctrl::WebvttController>(packet, m_config.getWebvttConfig(), m_gfxWindow, m_fontCache));
+    prewarmGlyphs();
+}
+
+void Controller::prewarmGlyphs()
+{
+    if (m_prewarmFonts.empty())
+    {
+        return;
+    }
+
+    m_logger.osinfo(__LOGGER_FUNC__, " fonts: ", m_prewarmFonts.size(), " characters: ", m_prewarmCodepoints.size());
+    m_fontCache->prewarm(m_prewarmFonts, m_prewarmCodepoints);
 }
 
 using namespace std::string_literals;
@@ -429,9 +447,9 @@ void Controller::processResetAll(UniqueLock& lock, const protocol::PacketResetAl
 
 void Controller::resetAll()
 {
-    m_dataqueue.clear();
+    m_dataQueue.clear();
     m_activeControllers.clear();
-
+    m_renderingActive = false;
 }
 
 void Controller::processDataPacket(const protocol::PacketData& packet)
@@ -465,8 +483,7 @@ void Controller::processFlushPacket(const protocol::PacketChannelSpecific& packe
 {
     auto timing = m_logger.timing(__LOGGER_FUNC__);
     forAllControllers(m_activeControllers, packet, &ctrl::ControllerInterface::flush);
-    m_dataqueue.clear();
-    m_renderCond.notify_one();
+    m_dataQueue.clear();
 }
 
 void Controller::processPausePacket(const protocol::PacketChannelSpecific& packet)
@@ -496,6 +513,7 @@ void Controller::processUnmutePacket(const protocol::PacketUnmute& packet)
 void Controller::pushController(std::shared_ptr<ctrl::ControllerInterface> controller)
 {
     m_activeControllers.emplace_back(std::move(controller));
+    m_renderingActive = true;
 }
 
 void Controller::deactivateController()
@@ -505,6 +523,7 @@ void Controller::deactivateController()
         m_logger.osinfo("deactivate controller");
         top->deactivate();
         m_activeControllers.pop_back();
+        m_renderingActive = !m_activeControllers.empty();
     }
 }
 
@@ -517,6 +536,7 @@ void Controller::popNullController()
         poped = true;
         m_activeControllers.pop_back();
     }
+    m_renderingActive = !m_activeControllers.empty();
     if (poped) {
         auto top = topController();
         if (top) {
@@ -537,37 +557,62 @@ std::shared_ptr<ctrl::ControllerInterface> Controller::topController()
 
 bool Controller::isRenderingActive() const
 {
-    LockGuard lock{m_mutex};
-    return (! m_activeControllers.empty());
+    return m_renderingActive;
 }
 
-bool Controller::isDataQueued() const
+void Controller::logDataQueueStatistics()
 {
-    LockGuard lock{m_mutex};
-    return ! m_dataqueue.empty();
+    auto const stats = m_dataQueue.getStatistics();
+
+    m_logger.osinfo(__LOGGER_FUNC__,
+            " depth: ", stats.m_depth,
+            " max depth: ", stats.m_maxDepth,
+            " added: ", stats.m_added,
+            " dropped: ", stats.m_dropped);
 }
 
-void Controller::processLoop()
+void Controller::logGlyphPrewarmStatistics()
 {
-    m_logger.osinfo(__LOGGER_FUNC__, " starting process loop");
+    auto const stats = m_fontCache->getPrewarmStatistics();
 
-    UniqueLock lock(m_renderMutex);
-    while (! m_quitRenderThread) {
-        m_renderCond.wait(lock, [this]() {return m_quitRenderThread || (isRenderingActive() && isDataQueued());});
-        m_logger.osinfo("woken up, quit=", m_quitRenderThread, " isRenderingActive=", isRenderingActive());
+    m_logger.osinfo(__LOGGER_FUNC__,
+            " requests: ", stats.requests,
+            " completed: ", stats.completed,
+            " last fonts: ", stats.fonts,
+            " last glyphs: ", stats.glyphs,
+            " last time: ", stats.duration.count(), "ms");
+}
 
-        while (isRenderingActive() && !m_quitRenderThread) {
-            auto const processWaitTime = processData();
-            m_gfxEngine->execute();
+void Controller::logFontCacheStatistics()
+{
+    for (auto const& stats : m_fontCache->getStatistics())
+    {
+        m_logger.osinfo(__LOGGER_FUNC__,
+                " font: '", stats.fontName, "'",
+                " height: ", stats.faceHeight,
+                " strict: ", stats.strictHeight,
+                " italics: ", stats.italics,
+                " pages: ", stats.atlasPages,
+                " bytes: ", stats.memoryUsage);
+    }
 
-            if (processWaitTime == std::chrono::milliseconds::zero()) {
-                break;
-            }
-            m_renderCond.wait_for(lock, processWaitTime, [this]() {return m_quitRenderThread;});
-        }
-                m_logger.osdebug(__LOGGER_FUNC__, " no active controller, clearing the data queue");
-                UniqueLock lock{m_mutex};
-                m_dataqueue.clear();
+    m_logger.osinfo(__LOGGER_FUNC__, " total bytes: ", m_fontCache->getMemoryUsage());
+}
+
+std::chrono::milliseconds Controller::processStep()
+{
+    auto const waitTime = processData();
+    m_gfxEngine->execute();
+    return waitTime;
+}
+
+void Controller::onRenderingIdle()
+{
+    // packets are dropped only when no controller could take them, paused
+    // controllers (zero wait time) still get the data queued meanwhile
+    if (!isRenderingActive()) {
+        m_logger.osdebug(__LOGGER_FUNC__, " no active controller, clearing the data queue");
+        m_dataQueue.clear();
     }
 }
 
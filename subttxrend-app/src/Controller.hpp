@@ -19,6 +19,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <cstdint>
 #include <memory>
 #include <mutex>
@@ -60,6 +61,9 @@
 
 #include <subttxrend/gfx/Engine.hpp>
 
+#include "DataQueue.hpp"
+#include "RenderLoop.hpp"
+
 namespace subttxrend {
 namespace app {
 
@@ -207,6 +211,12 @@ private:
      */
     void processWebvttSelection(const protocol::PacketWebvttSelection& packet);
 
+    /**
+     * Starts prerendering of configured glyphs in background, so the first
+     * captions after selection do not wait for glyph rasterization.
+     */
+    void prewarmGlyphs();
+
 
     /**
      * Processes subtitle reset channel packet.
@@ -324,9 +334,34 @@ private:
     std::shared_ptr<ctrl::ControllerInterface> topController();
 
     bool isRenderingActive() const;
-    bool isDataQueued() const;
 
-    void processLoop();
+    /**
+     * Logs data queue statistics.
+     */
+    void logDataQueueStatistics();
+
+    /**
+     * Logs glyph prewarming statistics.
+     */
+    void logGlyphPrewarmStatistics();
+
+    /**
+     * Logs memory used by cached fonts.
+     */
+    void logFontCacheStatistics();
+
+    /**
+     * Performs one rendering step: processes data and executes graphics engine.
+     *
+     * @return
+     *      Amount of time until next action is required.
+     */
+    std::chrono::milliseconds processStep();
+
+    /**
+     * Called by render loop when rendering stopped being active.
+     */
+    void onRenderingIdle();
 
     ctrl::Configuration const& m_config;
 
@@ -341,25 +376,34 @@ private:
     /** Logger object. */
     common::Logger m_logger;
 
-    /** Rendering thread. */
-    std::thread m_renderThread;
-    std::mutex m_renderMutex;
-    std::condition_variable m_renderCond;
-    bool m_quitRenderThread{false};
-
     using UniqueLock = std::unique_lock<std::mutex>;
     using LockGuard = std::lock_guard<std::mutex>;
 
     protocol::PacketParser m_parser;
-    std::deque<common::DataBufferPtr> m_dataqueue;
+
+    /** Data packets waiting for the rendering thread. */
+    DataQueue m_dataQueue;
+
+    /** Set if there is any active controller (readable without the lock). */
+    std::atomic_bool m_renderingActive{false};
+
     mutable std::mutex m_mutex;
     std::condition_variable m_cond;
     bool m_inuse{false};
     std::shared_ptr<gfx::PrerenderedFontCache> m_fontCache;
 
+    /** Fonts to prewarm on selection. */
+    std::vector<gfx::PrerenderedFontCache::PrewarmFont> m_prewarmFonts;
+
+    /** Characters to prewarm on selection. */
+    std::vector<std::uint32_t> m_prewarmCodepoints;
+
     std::unique_ptr<common::AsListener> m_asLstnr;
     std::unique_ptr<common::WsEndpoint> m_endpoint;
     std::unique_ptr<common::AsClient> m_asClient;
+
+    /** Rendering thread (last, so it is stopped before other members are destroyed). */
+    RenderLoop m_renderLoop;
 };
 
 using ControllerPtr = std::unique_ptr<Controller>;
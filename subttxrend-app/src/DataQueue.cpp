@@ -0,0 +1,96 @@
+/*****************************************************************************
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:
+*
+* Copyright 2021 Liberty Global Service B.V.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*****************************************************************************/
+
+#include "DataQueue.hpp"
+
+#include <algorithm>
+
+namespace subttxrend {
+namespace app {
+
+DataQueue::DataQueue(std::size_t capacity) :
+        m_capacity(std::max<std::size_t>(capacity, 1)),
+        m_generation(0)
+{
+    // noop
+}
+
+bool DataQueue::push(common::DataBufferPtr buffer)
+{
+    common::DataBufferPtr droppedBuffer;
+
+    std::lock_guard<std::mutex> lock{m_mutex};
+
+    if (m_buffers.size() >= m_capacity) {
+        // released after the lock is dropped (buffer could be pooled)
+        droppedBuffer = std::move(m_buffers.front());
+        m_buffers.pop_front();
+        ++m_statistics.m_dropped;
+    }
+
+    m_buffers.emplace_back(std::move(buffer));
+    ++m_statistics.m_added;
+
+    m_statistics.m_depth = m_buffers.size();
+    m_statistics.m_maxDepth = std::max(m_statistics.m_maxDepth, m_statistics.m_depth);
+
+    return static_cast<bool>(droppedBuffer);
+}
+
+std::uint64_t DataQueue::takeAll(Batch& batch)
+{
+    batch.clear();
+
+    std::lock_guard<std::mutex> lock{m_mutex};
+    batch.swap(m_buffers);
+    m_statistics.m_depth = 0;
+
+    return m_generation;
+}
+
+void DataQueue::clear()
+{
+    Batch buffers;
+
+    std::lock_guard<std::mutex> lock{m_mutex};
+    buffers.swap(m_buffers);
+    m_statistics.m_depth = 0;
+    ++m_generation;
+}
+
+bool DataQueue::isEmpty() const
+{
+    std::lock_guard<std::mutex> lock{m_mutex};
+    return m_buffers.empty();
+}
+
+std::uint64_t DataQueue::getGeneration() const
+{
+    std::lock_guard<std::mutex> lock{m_mutex};
+    return m_generation;
+}
+
+DataQueue::Statistics DataQueue::getStatistics() const
+{
+    std::lock_guard<std::mutex> lock{m_mutex};
+    return m_statistics;
+}
+
+} // namespace app
+} // namespace subttxrend
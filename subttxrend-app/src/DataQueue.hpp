@@ -0,0 +1,144 @@
+/*****************************************************************************
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:
+*
+* Copyright 2021 Liberty Global Service B.V.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*****************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+
+#include <subttxrend/common/DataBuffer.hpp>
+
+namespace subttxrend {
+namespace app {
+
+/**
+ * Bounded queue of data packets waiting for the rendering thread.
+ *
+ * Only data packets (PES, CC, TTML, WebVTT) are queued - control packets
+ * are handled immediately when received so they are never delayed or
+ * dropped. When the queue is full the oldest packet is dropped.
+ *
+ * The queue has its own lock held only for the time of queue operations,
+ * so adding packets never waits for packet processing.
+ */
+class DataQueue
+{
+public:
+    /** Batch of packets taken from the queue. */
+    using Batch = std::deque<common::DataBufferPtr>;
+
+    /** Queue statistics. */
+    struct Statistics
+    {
+        /** Number of packets currently queued. */
+        std::size_t m_depth{};
+
+        /** Maximum number of packets queued at once. */
+        std::size_t m_maxDepth{};
+
+        /** Number of packets added. */
+        std::size_t m_added{};
+
+        /** Number of packets dropped because the queue was full. */
+        std::size_t m_dropped{};
+    };
+
+    /**
+     * Constructor.
+     *
+     * @param capacity
+     *      Maximum number of queued packets (at least one).
+     */
+    explicit DataQueue(std::size_t capacity);
+
+    /**
+     * Adds packet to the queue.
+     *
+     * @param buffer
+     *      Packet data.
+     *
+     * @return
+     *      True if the oldest packet was dropped to make room.
+     */
+    bool push(common::DataBufferPtr buffer);
+
+    /**
+     * Moves all queued packets to the batch.
+     *
+     * @param batch
+     *      Batch to fill (previous contents are discarded).
+     *
+     * @return
+     *      Generation of the queue the batch was taken from.
+     */
+    std::uint64_t takeAll(Batch& batch);
+
+    /**
+     * Removes all queued packets.
+     *
+     * Starts new generation so that batches already taken can be
+     * recognized as outdated.
+     */
+    void clear();
+
+    /**
+     * Checks if there are packets queued.
+     *
+     * @return
+     *      True if queue is empty.
+     */
+    bool isEmpty() const;
+
+    /**
+     * Returns current generation.
+     *
+     * @return
+     *      Generation number (incremented by clear()).
+     */
+    std::uint64_t getGeneration() const;
+
+    /**
+     * Returns statistics.
+     *
+     * @return
+     *      Current statistics.
+     */
+    Statistics getStatistics() const;
+
+private:
+    /** Maximum number of queued packets. */
+    const std::size_t m_capacity;
+
+    /** Mutex protecting the queue. */
+    mutable std::mutex m_mutex;
+
+    /** Queued packets. */
+    std::deque<common::DataBufferPtr> m_buffers;
+
+    /** Queue generation. */
+    std::uint64_t m_generation;
+
+    /** Statistics. */
+    Statistics m_statistics;
+};
+
+} // namespace app
+} // namespace subttxrend
@@ -0,0 +1,105 @@
+/*****************************************************************************
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:
+*
+* Copyright 2021 Liberty Global Service B.V.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*****************************************************************************/
+
+#include "RenderLoop.hpp"
+
+#include <utility>
+
+namespace subttxrend {
+namespace app {
+
+RenderLoop::RenderLoop(ActiveCheck isActive,
+                       ProcessStep process,
+                       IdleCallback onIdle) :
+        m_isActive(std::move(isActive)),
+        m_process(std::move(process)),
+        m_onIdle(std::move(onIdle))
+{
+    // noop
+}
+
+RenderLoop::~RenderLoop()
+{
+    stop();
+}
+
+void RenderLoop::start()
+{
+    {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        m_quit = false;
+    }
+    m_thread = std::thread(&RenderLoop::run, this);
+}
+
+void RenderLoop::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        m_quit = true;
+    }
+    m_cond.notify_one();
+
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+void RenderLoop::wakeup()
+{
+    {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        m_wakeupRequested = true;
+    }
+    m_cond.notify_one();
+}
+
+void RenderLoop::run()
+{
+    auto const woken = [this]() {return m_quit || m_wakeupRequested || !m_isActive();};
+
+    std::unique_lock<std::mutex> lock{m_mutex};
+    while (!m_quit) {
+        m_cond.wait(lock, [this]() {return m_quit || (m_wakeupRequested && m_isActive());});
+        m_wakeupRequested = false;
+
+        while (m_isActive() && !m_quit) {
+            lock.unlock();
+            auto const waitTime = m_process();
+            lock.lock();
+
+            if (waitTime == std::chrono::milliseconds::zero()) {
+                // nothing scheduled, data or control packets arriving wake the thread up
+                m_cond.wait(lock, woken);
+            } else {
+                m_cond.wait_for(lock, waitTime, woken);
+            }
+            m_wakeupRequested = false;
+        }
+
+        if (!m_quit) {
+            lock.unlock();
+            m_onIdle();
+            lock.lock();
+        }
+    }
+}
+
+} // namespace app
+} // namespace subttxrend
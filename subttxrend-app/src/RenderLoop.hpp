@@ -0,0 +1,125 @@
+/*****************************************************************************
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:
+*
+* Copyright 2021 Liberty Global Service B.V.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*****************************************************************************/
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include <subttxrend/common/NonCopyable.hpp>
+
+namespace subttxrend {
+namespace app {
+
+/**
+ * Rendering thread scheduling.
+ *
+ * The thread sleeps until it is woken up while rendering is active, then
+ * runs the processing step repeatedly, each time waiting for the time the
+ * step returned or until woken up again. Zero wait time means nothing is
+ * scheduled (e.g. playback is paused) - the thread then sleeps until woken
+ * up, it does not stop processing. The idle callback is called only after
+ * rendering becomes inactive.
+ *
+ * Processing is done without the loop lock held so wakeups requested
+ * meanwhile (new data, control packets) are not blocked or lost.
+ */
+class RenderLoop : private common::NonCopyable
+{
+public:
+    /** Checks if rendering is active. */
+    using ActiveCheck = std::function<bool()>;
+
+    /** Processing step, returns time until next step is required (zero - none scheduled). */
+    using ProcessStep = std::function<std::chrono::milliseconds()>;
+
+    /** Called when rendering stopped being active. */
+    using IdleCallback = std::function<void()>;
+
+    /**
+     * Constructor.
+     *
+     * @param isActive
+     *      Rendering active check, may be called with no other lock held.
+     * @param process
+     *      Processing step.
+     * @param onIdle
+     *      Called after rendering became inactive.
+     */
+    RenderLoop(ActiveCheck isActive,
+               ProcessStep process,
+               IdleCallback onIdle);
+
+    /**
+     * Destructor. Stops the thread.
+     */
+    ~RenderLoop();
+
+    /**
+     * Starts the rendering thread.
+     */
+    void start();
+
+    /**
+     * Stops the rendering thread and waits for it to finish.
+     */
+    void stop();
+
+    /**
+     * Wakes up the rendering thread to process new data or state change
+     * (timestamp, pause, resume...) before current wait time elapses.
+     */
+    void wakeup();
+
+private:
+    /**
+     * Rendering thread loop.
+     */
+    void run();
+
+    /** Rendering active check. */
+    const ActiveCheck m_isActive;
+
+    /** Processing step. */
+    const ProcessStep m_process;
+
+    /** Inactive rendering callback. */
+    const IdleCallback m_onIdle;
+
+    /** Rendering thread. */
+    std::thread m_thread;
+
+    /** Mutex protecting the flags. */
+    std::mutex m_mutex;
+
+    /** Rendering thread wakeup condition. */
+    std::condition_variable m_cond;
+
+    /** Set when the thread should finish. */
+    bool m_quit{false};
+
+    /** Set when the thread should process before its wait time elapses. */
+    bool m_wakeupRequested{false};
+};
+
+} // namespace app
+} // namespace subttxrend
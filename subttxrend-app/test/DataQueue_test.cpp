@@ -0,0 +1,236 @@
+/*****************************************************************************
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:
+*
+* Copyright 2021 Liberty Global Service B.V.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*****************************************************************************/
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "DataQueue.hpp"
+
+using namespace subttxrend::app;
+using subttxrend::common::DataBuffer;
+using subttxrend::common::DataBufferPtr;
+
+class DataQueueTest : public CppUnit::TestFixture
+{
+CPPUNIT_TEST_SUITE( DataQueueTest );
+    CPPUNIT_TEST(packetsTakenInOrder);
+    CPPUNIT_TEST(oldestDroppedWhenFull);
+    CPPUNIT_TEST(statisticsCounters);
+    CPPUNIT_TEST(clearStartsNewGeneration);
+    CPPUNIT_TEST(zeroCapacityHoldsOnePacket);
+    CPPUNIT_TEST(concurrentPushAndTake);
+CPPUNIT_TEST_SUITE_END();
+
+public:
+    void setUp()
+    {
+        // noop
+    }
+
+    void tearDown()
+    {
+        // noop
+    }
+
+    void packetsTakenInOrder()
+    {
+        DataQueue queue(4);
+        CPPUNIT_ASSERT(queue.isEmpty());
+
+        CPPUNIT_ASSERT(!queue.push(makePacket("a")));
+        CPPUNIT_ASSERT(!queue.push(makePacket("b")));
+        CPPUNIT_ASSERT(!queue.isEmpty());
+
+        DataQueue::Batch batch;
+        batch.push_back(makePacket("stale"));
+        queue.takeAll(batch);
+
+        CPPUNIT_ASSERT(toStrings(batch) == std::vector<std::string>({"a", "b"}));
+        CPPUNIT_ASSERT(queue.isEmpty());
+
+        queue.takeAll(batch);
+        CPPUNIT_ASSERT(batch.empty());
+    }
+
+    void oldestDroppedWhenFull()
+    {
+        DataQueue queue(3);
+
+        CPPUNIT_ASSERT(!queue.push(makePacket("a")));
+        CPPUNIT_ASSERT(!queue.push(makePacket("b")));
+        CPPUNIT_ASSERT(!queue.push(makePacket("c")));
+        CPPUNIT_ASSERT(queue.push(makePacket("d")));
+        CPPUNIT_ASSERT(queue.push(makePacket("e")));
+
+        DataQueue::Batch batch;
+        queue.takeAll(batch);
+
+        CPPUNIT_ASSERT(toStrings(batch) == std::vector<std::string>({"c", "d", "e"}));
+
+        // room again after the batch was taken
+        CPPUNIT_ASSERT(!queue.push(makePacket("f")));
+    }
+
+    void statisticsCounters()
+    {
+        DataQueue queue(3);
+
+        for (auto text : {"a", "b"})
+        {
+            queue.push(makePacket(text));
+        }
+
+        auto statistics = queue.getStatistics();
+        CPPUNIT_ASSERT_EQUAL(std::size_t(2), statistics.m_depth);
+        CPPUNIT_ASSERT_EQUAL(std::size_t(2), statistics.m_maxDepth);
+        CPPUNIT_ASSERT_EQUAL(std::size_t(2), statistics.m_added);
+        CPPUNIT_ASSERT_EQUAL(std::size_t(0), statistics.m_dropped);
+
+        for (auto text : {"c", "d", "e", "f"})
+        {
+            queue.push(makePacket(text));
+        }
+
+        statistics = queue.getStatistics();
+        CPPUNIT_ASSERT_EQUAL(std::size_t(3), statistics.m_depth);
+        CPPUNIT_ASSERT_EQUAL(std::size_t(3), statistics.m_maxDepth);
+        CPPUNIT_ASSERT_EQUAL(std::size_t(6), statistics.m_added);
+        CPPUNIT_ASSERT_EQUAL(std::size_t(3), statistics.m_dropped);
+
+        DataQueue::Batch batch;
+        queue.takeAll(batch);
+        queue.push(makePacket("g"));
+
+        // maximum depth and counters are kept, depth follows the queue
+        statistics = queue.getStatistics();
+        CPPUNIT_ASSERT_EQUAL(std::size_t(1), statistics.m_depth);
+        CPPUNIT_ASSERT_EQUAL(std::size_t(3), statistics.m_maxDepth);
+        CPPUNIT_ASSERT_EQUAL(std::size_t(7), statistics.m_added);
+        CPPUNIT_ASSERT_EQUAL(std::size_t(3), statistics.m_dropped);
+
+        queue.clear();
+        CPPUNIT_ASSERT_EQUAL(std::size_t(0), queue.getStatistics().m_depth);
+    }
+
+    void clearStartsNewGeneration()
+    {
+        DataQueue queue(4);
+
+        queue.push(makePacket("a"));
+        queue.push(makePacket("b"));
+
+        DataQueue::Batch batch;
+        const auto batchGeneration = queue.takeAll(batch);
+        CPPUNIT_ASSERT_EQUAL(batchGeneration, queue.getGeneration());
+
+        // packets queued before clear() are dropped
+        queue.push(makePacket("c"));
+        queue.clear();
+        CPPUNIT_ASSERT(queue.isEmpty());
+
+        // batch taken before clear() is recognized as outdated (the way
+        // Controller::processData() drops the rest of it)
+        CPPUNIT_ASSERT(queue.getGeneration() != batchGeneration);
+
+        queue.push(makePacket("d"));
+
+        DataQueue::Batch newBatch;
+        const auto newGeneration = queue.takeAll(newBatch);
+
+        CPPUNIT_ASSERT(newGeneration != batchGeneration);
+        CPPUNIT_ASSERT_EQUAL(newGeneration, queue.getGeneration());
+        CPPUNIT_ASSERT(toStrings(newBatch) == std::vector<std::string>({"d"}));
+
+        // taking packets does not change the generation
+        queue.takeAll(newBatch);
+        CPPUNIT_ASSERT_EQUAL(newGeneration, queue.getGeneration());
+    }
+
+    void zeroCapacityHoldsOnePacket()
+    {
+        DataQueue queue(0);
+
+        CPPUNIT_ASSERT(!queue.push(makePacket("a")));
+        CPPUNIT_ASSERT(queue.push(makePacket("b")));
+
+        DataQueue::Batch batch;
+        queue.takeAll(batch);
+
+        CPPUNIT_ASSERT(toStrings(batch) == std::vector<std::string>({"b"}));
+    }
+
+    void concurrentPushAndTake()
+    {
+        const std::size_t PACKETS = 20000;
+
+        DataQueue queue(8);
+        std::size_t taken = 0;
+        std::size_t lastIndex = 0;
+        bool ordered = true;
+
+        std::thread producer([&]() {
+            for (std::size_t i = 1; i <= PACKETS; ++i)
+            {
+                queue.push(makePacket(std::to_string(i)));
+            }
+        });
+
+        DataQueue::Batch batch;
+        while ((taken + queue.getStatistics().m_dropped < PACKETS) || !queue.isEmpty())
+        {
+            queue.takeAll(batch);
+            for (const auto& text : toStrings(batch))
+            {
+                const std::size_t index = std::stoul(text);
+                ordered = ordered && (index > lastIndex);
+                lastIndex = index;
+                ++taken;
+            }
+        }
+
+        producer.join();
+
+        const auto statistics = queue.getStatistics();
+        CPPUNIT_ASSERT(ordered);
+        CPPUNIT_ASSERT_EQUAL(PACKETS, statistics.m_added);
+        CPPUNIT_ASSERT_EQUAL(PACKETS, taken + statistics.m_dropped);
+        CPPUNIT_ASSERT(statistics.m_maxDepth <= 8);
+    }
+
+private:
+    static DataBufferPtr makePacket(const std::string& text)
+    {
+        return DataBufferPtr(new DataBuffer(text.begin(), text.end()));
+    }
+
+    static std::vector<std::string> toStrings(const DataQueue::Batch& batch)
+    {
+        std::vector<std::string> strings;
+        for (const auto& buffer : batch)
+        {
+            strings.emplace_back(buffer->begin(), buffer->end());
+        }
+        return strings;
+    }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION( DataQueueTest );
@@ -0,0 +1,190 @@
+/*****************************************************************************
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:
+*
+* Copyright 2021 Liberty Global Service B.V.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*****************************************************************************/
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "DataQueue.hpp"
+#include "RenderLoop.hpp"
+
+using namespace subttxrend::app;
+using subttxrend::common::DataBuffer;
+using subttxrend::common::DataBufferPtr;
+
+class RenderLoopTest : public CppUnit::TestFixture
+{
+CPPUNIT_TEST_SUITE( RenderLoopTest );
+    CPPUNIT_TEST(packetsDeliveredWhilePaused);
+    CPPUNIT_TEST(stepsRepeatedAfterWaitTime);
+    CPPUNIT_TEST(queueClearedWhenInactive);
+CPPUNIT_TEST_SUITE_END();
+
+public:
+    void setUp()
+    {
+        m_queue = std::make_unique<DataQueue>(16);
+        m_active = false;
+        m_waitTime = std::chrono::milliseconds::zero();
+        m_steps = 0;
+        m_idleCalls = 0;
+        m_delivered.clear();
+        m_onFirstStep = nullptr;
+
+        m_loop = std::make_unique<RenderLoop>(
+                [this]() {return m_active.load();},
+                [this]() {return step();},
+                [this]() {idle();});
+        m_loop->start();
+    }
+
+    void tearDown()
+    {
+        m_loop.reset();
+        m_queue.reset();
+    }
+
+    /**
+     * Paused engine (zero wait time), packets arriving both during and
+     * after processing of a batch are delivered, not dropped.
+     */
+    void packetsDeliveredWhilePaused()
+    {
+        // arrives after the batch was taken, before the paused step returns
+        m_onFirstStep = [this]() {addPacket("late");};
+
+        m_active = true;
+        addPacket("first");
+        CPPUNIT_ASSERT(waitFor([this]() {return m_delivered.size() == 2;}));
+
+        // arrives while the loop sleeps with nothing scheduled
+        addPacket("later");
+        CPPUNIT_ASSERT(waitFor([this]() {return m_delivered.size() == 3;}));
+
+        std::vector<std::string> expected{"first", "late", "later"};
+        std::lock_guard<std::mutex> lock{m_mutex};
+        CPPUNIT_ASSERT(m_delivered == expected);
+        CPPUNIT_ASSERT_EQUAL(0, m_idleCalls);
+    }
+
+    void stepsRepeatedAfterWaitTime()
+    {
+        m_waitTime = std::chrono::milliseconds(5);
+        m_active = true;
+        m_loop->wakeup();
+
+        // no wakeups needed while steps are scheduled
+        CPPUNIT_ASSERT(waitFor([this]() {return m_steps >= 5;}));
+        CPPUNIT_ASSERT_EQUAL(0, m_idleCalls);
+    }
+
+    void queueClearedWhenInactive()
+    {
+        m_active = true;
+        addPacket("first");
+        CPPUNIT_ASSERT(waitFor([this]() {return m_delivered.size() == 1;}));
+
+        // controller deactivated, the packet left in the queue is dropped
+        m_active = false;
+        m_queue->push(makePacket("stale"));
+        m_loop->wakeup();
+
+        CPPUNIT_ASSERT(waitFor([this]() {return m_idleCalls == 1;}));
+        CPPUNIT_ASSERT(m_queue->isEmpty());
+
+        std::lock_guard<std::mutex> lock{m_mutex};
+        CPPUNIT_ASSERT_EQUAL(std::size_t(1), m_delivered.size());
+    }
+
+private:
+    static DataBufferPtr makePacket(const std::string& text)
+    {
+        return DataBufferPtr(new DataBuffer(text.begin(), text.end()));
+    }
+
+    void addPacket(const std::string& text)
+    {
+        m_queue->push(makePacket(text));
+        m_loop->wakeup();
+    }
+
+    std::chrono::milliseconds step()
+    {
+        DataQueue::Batch batch;
+        m_queue->takeAll(batch);
+
+        if (m_onFirstStep && !batch.empty()) {
+            auto onFirstStep = std::move(m_onFirstStep);
+            m_onFirstStep = nullptr;
+            onFirstStep();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock{m_mutex};
+            for (auto const& buffer : batch) {
+                m_delivered.emplace_back(buffer->begin(), buffer->end());
+            }
+            ++m_steps;
+        }
+        m_cond.notify_all();
+
+        return m_waitTime;
+    }
+
+    void idle()
+    {
+        if (!m_active) {
+            m_queue->clear();
+        }
+        {
+            std::lock_guard<std::mutex> lock{m_mutex};
+            ++m_idleCalls;
+        }
+        m_cond.notify_all();
+    }
+
+    template <class Predicate>
+    bool waitFor(Predicate predicate)
+    {
+        std::unique_lock<std::mutex> lock{m_mutex};
+        return m_cond.wait_for(lock, std::chrono::seconds(5), predicate);
+    }
+
+    std::unique_ptr<DataQueue> m_queue;
+    std::unique_ptr<RenderLoop> m_loop;
+    std::atomic_bool m_active{false};
+    std::chrono::milliseconds m_waitTime{};
+    std::function<void()> m_onFirstStep;
+
+    std::mutex m_mutex;
+    std::condition_variable m_cond;
+    std::vector<std::string> m_delivered;
+    int m_steps{0};
+    int m_idleCalls{0};
+};
+
+// Registers the fixture into the 'registry'
+CPPUNIT_TEST_SUITE_REGISTRATION( RenderLoopTest );
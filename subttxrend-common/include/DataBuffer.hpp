@@ -20,13 +20,114 @@
 #pragma once
 
 #include <memory>
+#include <new>
+#include <utility>
 #include <vector>
 
 namespace subttxrend {
 namespace common {
 
-using DataBuffer = std::vector<char>;
-using DataBufferPtr = std::unique_ptr<DataBuffer>;
+/**
+ * Allocator that leaves new buffer elements uninitialized.
+ *
+ * Buffers are filled with received data right after they are sized so
+ * zero-filling them on resize would be wasted work.
+ */
+template <class T>
+class DataBufferAllocator : public std::allocator<T>
+{
+public:
+    template <class U>
+    struct rebind
+    {
+        using other = DataBufferAllocator<U>;
+    };
+
+    DataBufferAllocator() = default;
+
+    template <class U>
+    DataBufferAllocator(const DataBufferAllocator<U>& other) noexcept
+            : std::allocator<T>(other)
+    {
+        // noop
+    }
+
+    template <class U>
+    void construct(U* ptr)
+    {
+        ::new (static_cast<void*>(ptr)) U;
+    }
+
+    template <class U, class... Args>
+    void construct(U* ptr, Args&&... args)
+    {
+        ::new (static_cast<void*>(ptr)) U(std::forward<Args>(args)...);
+    }
+};
+
+using DataBuffer = std::vector<char, DataBufferAllocator<char>>;
+
+/**
+ * Interface of objects taking back released data buffers.
+ */
+class DataBufferRecycler
+{
+public:
+    virtual ~DataBufferRecycler() = default;
+
+    /**
+     * Takes back buffer that is no longer used.
+     *
+     * @param buffer
+     *      Released buffer. Recycler takes ownership.
+     */
+    virtual void recycle(DataBuffer* buffer) = 0;
+};
+
+/**
+ * Data buffer deleter.
+ *
+ * Buffers taken from a pool are handed back to the pool, other buffers
+ * are deleted. Conversion from std::default_delete allows buffers created
+ * with std::make_unique to be used as DataBufferPtr.
+ */
+class DataBufferDeleter
+{
+public:
+    DataBufferDeleter() = default;
+
+    DataBufferDeleter(std::default_delete<DataBuffer>) noexcept
+    {
+        // noop
+    }
+
+    /**
+     * Constructor.
+     *
+     * @param recycler
+     *      Recycler to return buffers to.
+     */
+    explicit DataBufferDeleter(std::shared_ptr<DataBufferRecycler> recycler) noexcept
+            : m_recycler(std::move(recycler))
+    {
+        // noop
+    }
+
+    void operator()(DataBuffer* buffer) const
+    {
+        if (m_recycler) {
+            m_recycler->recycle(buffer);
+        } else {
+            delete buffer;
+        }
+    }
+
+private:
+    /** Recycler to return buffers to (null if buffer is not pooled). */
+    std::shared_ptr<DataBufferRecycler> m_recycler;
+};
+
+using DataBufferPtr = std::unique_ptr<DataBuffer, DataBufferDeleter>;
 
 } // namespace common
 } // namespace subttxrend
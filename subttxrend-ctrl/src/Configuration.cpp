@@ -25,6 +25,8 @@
 #include <subttxrend/common/Logger.hpp>
 #include <subttxrend/common/StringUtils.hpp>
 
+#include <stdexcept>
+
 namespace subttxrend
 {
 namespace ctrl
@@ -62,6 +64,10 @@ struct ConfigEntry
 };
 
 const std::string MAIN_CONTEXT_SOCKET_PATH_KEY("MAIN_CONTEXT.SOCKET_PATH");
+const std::string MAIN_CONTEXT_DATA_QUEUE_SIZE_KEY("MAIN_CONTEXT.DATA_QUEUE_SIZE");
+const std::string MAIN_CONTEXT_FONT_CACHE_SIZE_KEY("MAIN_CONTEXT.FONT_CACHE_SIZE_KB");
+const std::string MAIN_CONTEXT_GLYPH_PREWARM_FONTS_KEY("MAIN_CONTEXT.GLYPH_PREWARM_FONTS");
+const std::string MAIN_CONTEXT_GLYPH_PREWARM_CODEPOINTS_KEY("MAIN_CONTEXT.GLYPH_PREWARM_CODEPOINTS");
 const std::string TELETEXT_PREFIX("TELETEXT.");
 const std::string LOGGER_PREFIX("LOGGER.");
 const std::string RDKENV_PREFIX("RDKENV.");
@@ -76,6 +82,20 @@ const ConfigEntry MAIN_CONTEXT_SOCKET_PATH_ENTRY(MAIN_CONTEXT_SOCKET_PATH_KEY,
         "/tmp/subttx-socket");
 #endif // PC_BUILD
 
+const ConfigEntry MAIN_CONTEXT_DATA_QUEUE_SIZE_ENTRY(MAIN_CONTEXT_DATA_QUEUE_SIZE_KEY,
+        "1024");
+
+// 8 MB of font atlases
+const ConfigEntry MAIN_CONTEXT_FONT_CACHE_SIZE_ENTRY(MAIN_CONTEXT_FONT_CACHE_SIZE_KEY,
+        "8192");
+
+const ConfigEntry MAIN_CONTEXT_GLYPH_PREWARM_FONTS_ENTRY(MAIN_CONTEXT_GLYPH_PREWARM_FONTS_KEY,
+        "");
+
+// printable ASCII + Latin-1 supplement
+const ConfigEntry MAIN_CONTEXT_GLYPH_PREWARM_CODEPOINTS_ENTRY(MAIN_CONTEXT_GLYPH_PREWARM_CODEPOINTS_KEY,
+        "0x20-0x7E,0xA0-0xFF");
+
 const ConfigEntry DEFAULT_ENTRIES[] =
 {
 // Teletext related settings
@@ -105,6 +125,35 @@ const ConfigEntry DEFAULT_ENTRIES[] =
 
 common::Logger g_logger("App", "Configuration");
 
+/**
+ * Splits string at separator, entries are trimmed and empty ones skipped.
+ */
+std::vector<std::string> splitList(const std::string& value,
+                                   char separator)
+{
+    std::vector<std::string> entries;
+
+    std::string::size_type start = 0;
+    while (start <= value.size())
+    {
+        auto end = value.find(separator, start);
+        if (end == std::string::npos)
+        {
+            end = value.size();
+        }
+
+        auto entry = common::StringUtils::trim(value.substr(start, end - start));
+        if (!entry.empty())
+        {
+            entries.push_back(entry);
+        }
+
+        start = end + 1;
+    }
+
+    return entries;
+}
+
 }
 
 Configuration::Configuration(const Options& options) :
@@ -144,6 +193,103 @@ std::string Configuration::getMainContextSocketPath() const
     return common::StringUtils::trim(value);
 }
 
+std::size_t Configuration::getMainContextDataQueueSize() const
+{
+    auto const defaultValue = std::stoi(MAIN_CONTEXT_DATA_QUEUE_SIZE_ENTRY.m_defaultValue);
+    auto const value = m_configFile.getInt(MAIN_CONTEXT_DATA_QUEUE_SIZE_ENTRY.m_key, defaultValue);
+
+    return static_cast<std::size_t>((value > 0) ? value : defaultValue);
+}
+
+std::size_t Configuration::getFontCacheSize() const
+{
+    auto const defaultValue = std::stoi(MAIN_CONTEXT_FONT_CACHE_SIZE_ENTRY.m_defaultValue);
+    auto const value = m_configFile.getInt(MAIN_CONTEXT_FONT_CACHE_SIZE_ENTRY.m_key, defaultValue);
+
+    return static_cast<std::size_t>((value > 0) ? value : defaultValue) * 1024;
+}
+
+std::vector<gfx::PrerenderedFontCache::PrewarmFont> Configuration::getGlyphPrewarmFonts() const
+{
+    std::vector<gfx::PrerenderedFontCache::PrewarmFont> fonts;
+
+    auto const value = m_configFile.get(MAIN_CONTEXT_GLYPH_PREWARM_FONTS_ENTRY.m_key,
+            MAIN_CONTEXT_GLYPH_PREWARM_FONTS_ENTRY.m_defaultValue);
+
+    for (const auto& entry : splitList(value, ';'))
+    {
+        auto const fields = splitList(entry, ':');
+
+        gfx::PrerenderedFontCache::PrewarmFont font;
+        try
+        {
+            if ((fields.size() < 2) || (fields.size() > 3))
+            {
+                throw std::invalid_argument("invalid number of fields");
+            }
+
+            font.fontName = fields[0];
+            font.faceHeight = std::stoi(fields[1]);
+            if (fields.size() > 2)
+            {
+                font.outlineSize = std::stoi(fields[2]);
+            }
+        }
+        catch (const std::exception&)
+        {
+            g_logger.warning("%s - Invalid prewarm font entry: %s", __func__,
+                    entry.c_str());
+            continue;
+        }
+
+        if (font.faceHeight > 0)
+        {
+            fonts.push_back(font);
+        }
+    }
+
+    return fonts;
+}
+
+std::vector<std::uint32_t> Configuration::getGlyphPrewarmCodepoints() const
+{
+    std::vector<std::uint32_t> codepoints;
+
+    auto const value = m_configFile.get(MAIN_CONTEXT_GLYPH_PREWARM_CODEPOINTS_ENTRY.m_key,
+            MAIN_CONTEXT_GLYPH_PREWARM_CODEPOINTS_ENTRY.m_defaultValue);
+
+    for (const auto& entry : splitList(value, ','))
+    {
+        auto const range = splitList(entry, '-');
+        try
+        {
+            if ((range.size() < 1) || (range.size() > 2))
+            {
+                throw std::invalid_argument("invalid range");
+            }
+
+            auto const first = std::stoul(range.front(), nullptr, 0);
+            auto const last = std::stoul(range.back(), nullptr, 0);
+            if ((first > last) || (last > 0x10FFFF))
+            {
+                throw std::out_of_range("invalid range");
+            }
+
+            for (auto codepoint = first; codepoint <= last; ++codepoint)
+            {
+                codepoints.push_back(static_cast<std::uint32_t>(codepoint));
+            }
+        }
+        catch (const std::exception&)
+        {
+            g_logger.warning("%s - Invalid prewarm codepoints entry: %s", __func__,
+                    entry.c_str());
+        }
+    }
+
+    return codepoints;
+}
+
 const char* Configuration::getValue(const std::string& key) const
 {
     for (const auto& entry : DEFAULT_ENTRIES)
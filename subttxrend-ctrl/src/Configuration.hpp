@@ -21,9 +21,14 @@
 #ifndef SUBTTXREND_APP_CONFIGURATION_HPP_
 #define SUBTTXREND_APP_CONFIGURATION_HPP_
 
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
 #include <subttxrend/common/IniFile.hpp>
 #include <subttxrend/common/ConfigProvider.hpp>
 #include <subttxrend/common/PrefixConfigProvider.hpp>
+#include <subttxrend/gfx/PrerenderedFont.hpp>
 
 namespace subttxrend
 {
@@ -59,6 +64,44 @@ public:
      */
     std::string getMainContextSocketPath() const;
 
+    /**
+     * Returns main context data queue size.
+     *
+     * @return
+     *      Maximum number of data packets waiting for processing.
+     */
+    std::size_t getMainContextDataQueueSize() const;
+
+    /**
+     * Returns font cache size.
+     *
+     * @return
+     *      Maximum number of bytes used by glyph atlases of cached fonts.
+     */
+    std::size_t getFontCacheSize() const;
+
+    /**
+     * Returns fonts to prewarm on subtitles selection.
+     *
+     * Fonts are configured as semicolon separated list of
+     * "family:height[:outline]" entries.
+     *
+     * @return
+     *      Fonts to prewarm, empty if prewarming is disabled.
+     */
+    std::vector<gfx::PrerenderedFontCache::PrewarmFont> getGlyphPrewarmFonts() const;
+
+    /**
+     * Returns characters to prewarm on subtitles selection.
+     *
+     * Characters are configured as comma separated list of codepoints
+     * or codepoint ranges ("0x20-0x7E,0xA0-0xFF").
+     *
+     * @return
+     *      Unicode codepoints.
+     */
+    std::vector<std::uint32_t> getGlyphPrewarmCodepoints() const;
+
     /**
      * Returns teletext configuration.
      *
@@ -33,13 +33,14 @@ namespace ctrl {
 TtmlController::TtmlController(const protocol::PacketChannelSpecific& dataPacket,
                                const common::ConfigProvider& config,
                                gfx::WindowPtr const& gfxWindow,
-                               common::Properties const& properties)
+                               common::Properties const& properties,
+                               std::shared_ptr<gfx::PrerenderedFontCache> fontCache)
     : m_channel()
     , m_logger("App", "TtmlController", this)
     , m_ttmlEngine(ttmlengine::Factory::createTtmlEngine())
 {
     m_logger.oswarning(__LOGGER_FUNC__, " created");
-    m_ttmlEngine->init(&config, gfxWindow.get(), properties);
+    m_ttmlEngine->init(&config, gfxWindow.get(), properties, std::move(fontCache));
     select(dataPacket);
 }
 
@@ -28,6 +28,7 @@
 #include <subttxrend/common/NonCopyable.hpp>
 #include <subttxrend/common/Logger.hpp>
 #include <subttxrend/common/Properties.hpp>
+#include <subttxrend/gfx/PrerenderedFont.hpp>
 #include <subttxrend/gfx/Window.hpp>
 
 #include <subttxrend/ttmlengine/TtmlEngine.hpp>
@@ -51,7 +52,8 @@ class TtmlController final : public ControllerInterface
     TtmlController(const protocol::PacketChannelSpecific& dataPacket,
                    const common::ConfigProvider& config,
                    gfx::WindowPtr const& gfxWindow,
-                   common::Properties const& properties);
+                   common::Properties const& properties,
+                   std::shared_ptr<gfx::PrerenderedFontCache> fontCache);
     ~TtmlController();
 
     void process() override;
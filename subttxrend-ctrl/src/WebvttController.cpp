@@ -34,13 +34,14 @@ namespace ctrl {
 
 WebvttController::WebvttController(const protocol::PacketChannelSpecific& dataPacket,
                                const common::ConfigProvider& config,
-                               gfx::WindowPtr const& gfxWindow)
+                               gfx::WindowPtr const& gfxWindow,
+                               std::shared_ptr<gfx::PrerenderedFontCache> fontCache)
     : m_channel()
     , m_logger("App", "WebvttController", this)
     , m_webvttEngine(webvttengine::Factory::createWebvttEngine())
 {
     m_logger.oswarning(__LOGGER_FUNC__, " created");
-    m_webvttEngine->init(&config, gfxWindow);
+    m_webvttEngine->init(&config, gfxWindow, std::move(fontCache));
     select(dataPacket);
 }
 
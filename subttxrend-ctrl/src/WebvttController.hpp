@@ -25,6 +25,7 @@
 
 #include <subttxrend/common/NonCopyable.hpp>
 #include <subttxrend/common/Logger.hpp>
+#include <subttxrend/gfx/PrerenderedFont.hpp>
 #include <subttxrend/gfx/Window.hpp>
 
 #include <subttxrend/webvttengine/WebvttEngine.hpp>
@@ -47,7 +48,8 @@ class WebvttController final : public ControllerInterface
      */
     WebvttController(const protocol::PacketChannelSpecific& dataPacket, 
                    const common::ConfigProvider& config, 
-                   gfx::WindowPtr const& gfxWindow);
+                   gfx::WindowPtr const& gfxWindow,
+                   std::shared_ptr<gfx::PrerenderedFontCache> fontCache);
     ~WebvttController();
 
     void process() override;
@@ -0,0 +1,75 @@
+/*****************************************************************************
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:
+*
+* Copyright 2021 Liberty Global Service B.V.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*****************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace subttxrend
+{
+namespace gfx
+{
+
+/**
+ * Incremental base64 decoder.
+ *
+ * Decodes text delivered in arbitrary chunks (e.g. SAX character data)
+ * straight into a binary buffer, so the encoded text does not have to be
+ * collected first. Characters outside the base64 alphabet (whitespace,
+ * line breaks) are skipped; a group of four characters split between
+ * chunks is carried over to the next call. Output is the same as of
+ * g_base64_decode() for the whole text.
+ */
+class Base64Decoder
+{
+public:
+    /**
+     * Decodes next part of the text.
+     *
+     * @param text
+     *      Base64 encoded text.
+     * @param length
+     *      Length of the text.
+     * @param output
+     *      Buffer to append decoded bytes to.
+     */
+    void decode(const char* text,
+                std::size_t length,
+                std::vector<std::uint8_t>& output);
+
+    /**
+     * Drops incomplete group of characters, prepares for new text.
+     */
+    void reset();
+
+private:
+    /** Bits of the characters of current group. */
+    std::uint32_t m_value{0};
+
+    /** Number of characters of current group. */
+    std::uint32_t m_count{0};
+
+    /** Last two characters decoded, used to detect padding. */
+    char m_last[2]{0, 0};
+};
+
+} // namespace gfx
+} // namespace subttxrend
@@ -19,6 +19,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <string>
@@ -32,6 +33,26 @@ namespace gfx
 
 using PngCallback = std::function<void(const std::uint8_t* buffer, std::size_t bufferSize)>;
 
+/**
+ * Decodes PNG image.
+ *
+ * @param pngData
+ *      PNG file contents.
+ * @param pngSize
+ *      Size of the PNG data.
+ * @param applyRGBAlphaPremult
+ *      Premultiply colors by alpha.
+ * @param callback
+ *      Called with the PNG data before decoding (debug dumps).
+ *
+ * @return
+ *      Decoded bitmap, null pointer on error.
+ */
+std::unique_ptr<gfx::Bitmap> pngToPixmap(const std::uint8_t* pngData,
+                                         std::size_t pngSize,
+                                         bool applyRGBAlphaPremult,
+                                         PngCallback callback = nullptr);
+
 std::unique_ptr<gfx::Bitmap> base64toPixmap(const std::string& base64txt,
                                             bool applyRGBAlphaPremult,
                                             PngCallback callback = nullptr);
@@ -21,9 +21,16 @@
 #ifndef _SUBTTXREND_GFX_PRERENDEREDFONT_HPP_
 #define _SUBTTXREND_GFX_PRERENDEREDFONT_HPP_
 
+#include <atomic>
+#include <chrono>
 #include <set>
 #include <codecvt>
+#include <list>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <tuple>
 #include <vector>
 #include <map>
 #include <cstdint>
@@ -125,16 +132,94 @@ public:
     virtual std::int32_t getMaxAdvance() const = 0;
 };
 
+class PrerenderedFontImpl;
+
 /**
  * Caches for prerendered fonts.
+ *
+ * The cache is thread safe. Memory used by font atlases is limited by
+ * a byte budget, least recently used fonts are removed from the cache when
+ * it is exceeded (fonts still referenced by users stay alive until
+ * released).
  */
 class PrerenderedFontCache
 {
 
 public:
 
-    /** 
-     * Gets the font corresponding to fontName & face size. Not thread safe!
+    /**
+     * Font to prewarm.
+     */
+    struct PrewarmFont
+    {
+        /** Fontconfig font name. */
+        std::string fontName;
+        /** Font face height. */
+        int faceHeight = 0;
+        /** Enforce strict font height. */
+        bool strictHeight = true;
+        /** Artificial italics. */
+        bool italics = false;
+        /** Outline size in pixels (zero - no outline glyphs). */
+        int outlineSize = 0;
+    };
+
+    /**
+     * Glyph prewarming statistics.
+     */
+    struct PrewarmStatistics
+    {
+        /** Number of prewarm requests. */
+        std::size_t requests = 0;
+        /** Number of requests finished (not cancelled). */
+        std::size_t completed = 0;
+        /** Number of fonts created by the last request. */
+        std::size_t fonts = 0;
+        /** Number of glyphs prerendered by the last request. */
+        std::size_t glyphs = 0;
+        /** Duration of the last request. */
+        std::chrono::milliseconds duration{0};
+    };
+
+    /**
+     * Font statistics.
+     */
+    struct FontStatistics
+    {
+        /** Fontconfig font name. */
+        std::string fontName;
+        /** Font face height. */
+        int faceHeight = 0;
+        /** Enforce strict font height. */
+        bool strictHeight = false;
+        /** Artificial italics. */
+        bool italics = false;
+        /** Number of atlas pages. */
+        std::size_t atlasPages = 0;
+        /** Number of bytes used by atlas pages. */
+        std::size_t memoryUsage = 0;
+    };
+
+    /** Default byte budget. */
+    static const std::size_t DEFAULT_BYTE_BUDGET = 8 * 1024 * 1024;
+
+    /**
+     * Constructor.
+     *
+     * @param byteBudget
+     *      Maximum number of bytes used by atlases of cached fonts.
+     */
+    explicit PrerenderedFontCache(std::size_t byteBudget = DEFAULT_BYTE_BUDGET);
+
+    /**
+     * Destructor.
+     *
+     * Cancels the running prewarm request and waits for the worker.
+     */
+    ~PrerenderedFontCache();
+
+    /**
+     * Gets the font corresponding to fontName & face size.
      *
      * @param fontName
      *         Fontconfig font name, like "Bitstream Vera Sans Mono Bold" or "Liberation Mono Bold".
@@ -148,11 +233,64 @@ public:
      */
     std::shared_ptr<PrerenderedFont> getFont(const std::string& fontName, int faceHeight, bool strictHeight=false, bool italics=false);
 
-    /** 
-     * Clears the cache. Not thread safe!
+    /**
+     * Clears the cache.
      */
     void clear();
 
+    /**
+     * Sets byte budget.
+     *
+     * Fonts are evicted if needed.
+     *
+     * @param byteBudget
+     *      Maximum number of bytes used by atlases of cached fonts.
+     */
+    void setByteBudget(std::size_t byteBudget);
+
+    /**
+     * Returns memory used by cached fonts.
+     *
+     * Fonts grow while used, the growth of a font is accounted when it is
+     * requested again (see getFont()).
+     *
+     * @return
+     *      Number of bytes used by atlases of cached fonts.
+     */
+    std::size_t getMemoryUsage() const;
+
+    /**
+     * Returns statistics of cached fonts.
+     *
+     * @return
+     *      Per font statistics, most recently used first.
+     */
+    std::vector<FontStatistics> getStatistics() const;
+
+    /**
+     * Prerenders glyphs asynchronously.
+     *
+     * Fonts are created and their glyphs rasterized on a background worker,
+     * each font is added to the cache when ready. Fonts already present in
+     * the cache are skipped (they may be in use by the rendering thread).
+     * A new request cancels the one in progress.
+     *
+     * @param fonts
+     *      Fonts to prewarm.
+     * @param codepoints
+     *      Unicode codepoints of characters to prerender.
+     */
+    void prewarm(std::vector<PrewarmFont> fonts,
+                 std::vector<std::uint32_t> codepoints);
+
+    /**
+     * Returns glyph prewarming statistics.
+     *
+     * @return
+     *      Statistics.
+     */
+    PrewarmStatistics getPrewarmStatistics() const;
+
 private:
     struct Height
     {
@@ -160,11 +298,99 @@ private:
         bool strict;
         bool operator<(const Height& rhs) const
         {
-            return height < rhs.height && strict == rhs.strict;
+            return std::tie(height, strict) < std::tie(rhs.height, rhs.strict);
         }
     };
+
+    /** Font cache key. */
+    using FontKey = std::tuple<std::string, Height, bool/*italics*/>;
+
+    /** Cached font. */
+    struct Entry
+    {
+        /** Font key. */
+        FontKey key;
+        /** Font. */
+        std::shared_ptr<PrerenderedFontImpl> font;
+        /** Bytes accounted for the font in the cache memory usage. */
+        std::size_t memoryUsage;
+    };
+
+    /** Entries list type (most recently used first). */
+    using EntryList = std::list<Entry>;
+
+    /**
+     * Adds font to the cache and evicts fonts over the budget.
+     *
+     * Must be called with the mutex locked.
+     *
+     * @param key
+     *      Font key.
+     * @param font
+     *      Font to add.
+     * @param mostRecentlyUsed
+     *      Add as the most recently used font if true, as the least
+     *      recently used one otherwise.
+     *
+     * @return
+     *      True if font was added and kept, false otherwise.
+     */
+    bool insertFont(const FontKey& key,
+                    std::shared_ptr<PrerenderedFontImpl> font,
+                    bool mostRecentlyUsed);
+
+    /**
+     * Updates memory usage accounted for the font.
+     *
+     * Must be called with the mutex locked.
+     *
+     * @param entry
+     *      Cached font.
+     */
+    void updateMemoryUsage(Entry& entry);
+
+    /**
+     * Evicts least recently used fonts (except the most recent one)
+     * until the budget is satisfied.
+     *
+     * Must be called with the mutex locked.
+     */
+    void evict();
+
+    /**
+     * Stops prewarm worker.
+     */
+    void stopPrewarm();
+
+    /**
+     * Prewarm worker body.
+     */
+    void prewarmThread(std::vector<PrewarmFont> fonts,
+                       std::vector<std::uint32_t> codepoints);
+
+    /** Maximum number of bytes used by atlases of cached fonts. */
+    std::size_t m_byteBudget;
+
+    /** Sum of bytes accounted for the cached fonts. */
+    std::size_t m_memoryUsage = 0;
+
+    /** Fonts in LRU order. */
+    EntryList m_entries;
+
     /** Font name <-> class mapping. */
-    std::map<std::tuple<std::string, Height, bool/*italics*/>, std::shared_ptr<PrerenderedFont>> m_fontPathAndSizeToFont;
+    std::map<FontKey, EntryList::iterator> m_fontPathAndSizeToFont;
+
+    /** Mutex guarding fonts mapping and statistics. */
+    mutable std::mutex m_mutex;
+
+    /** Prewarm statistics. */
+    PrewarmStatistics m_prewarmStatistics;
+
+    /** Prewarm worker cancel flag. */
+    std::atomic_bool m_prewarmCancelled{false};
+
+    /** Prewarm worker. */
+    std::thread m_prewarmThread;
 };
 
 }
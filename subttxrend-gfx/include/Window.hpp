@@ -114,6 +114,30 @@ public:
      */
     virtual void clear() = 0;
 
+    /**
+     * Clears window area.
+     *
+     * Used by incremental renderers in retained mode to erase
+     * contents that changed.
+     *
+     * @param rectangle
+     *      Area to clear.
+     */
+    virtual void clearRectangle(const Rectangle& rectangle) = 0;
+
+    /**
+     * Sets retained mode.
+     *
+     * By default the contents drawn after update() are undefined (stale)
+     * so the whole window must be cleared and redrawn. In retained mode
+     * the window contents are kept after update(), so only the areas that
+     * changed need to be cleared and redrawn.
+     *
+     * @param retained
+     *      True to enable retained mode, false to disable it.
+     */
+    virtual void setRetainedMode(bool retained) = 0;
+
     /**
      * Updates window context.
      *
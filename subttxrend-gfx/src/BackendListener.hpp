@@ -31,6 +31,7 @@ namespace subttxrend
 namespace gfx
 {
 
+class DamageRegion;
 class Pixmap;
 /**
  * Window enumeration interface.
@@ -69,9 +70,24 @@ public:
      */
     virtual ~BackendListener() = default;
 
+    /**
+     * Latches windows contents for the frame being rendered.
+     *
+     * Must be called at the beginning of each frame, before windows are
+     * enumerated and damage collected. Windows contents updated after
+     * the call are presented in the next frame.
+     *
+     * @note The latching may be called under synchronization
+     *       so make sure there will be no deadlock when calling this method.
+     */
+    virtual void latchFrames() = 0;
+
     /**
      * Requests enumeration of visible windows.
      *
+     * Enumeration uses the contents latched by latchFrames() and is
+     * done without engine lock held, so windows may be drawn meanwhile.
+     *
      * @note The enumeration may be called under synchronization
      *       so make sure there will be no deadlock when calling this method.
      *
@@ -80,6 +96,24 @@ public:
      */
     virtual void enumerateVisibleWindows(BackendWindowEnumerator& enumerator) = 0;
 
+    /**
+     * Collects areas modified since the previous call.
+     *
+     * Damage of all windows is translated to screen coordinates (windows
+     * are placed in the center of the screen) and clipped to the screen.
+     * The damage collected is reset.
+     *
+     * @note The collection may be called under synchronization
+     *       so make sure there will be no deadlock when calling this method.
+     *
+     * @param screenSize
+     *      Size of the screen the windows are rendered on.
+     * @param damage
+     *      Region to which the damaged areas are added.
+     */
+    virtual void collectDamage(const Size& screenSize,
+                               DamageRegion& damage) = 0;
+
     /**
      * Notifies that focus was gained.
      */
@@ -0,0 +1,106 @@
+/*****************************************************************************
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:
+*
+* Copyright 2021 Liberty Global Service B.V.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*****************************************************************************/
+
+#include "Base64Decoder.hpp"
+
+namespace subttxrend
+{
+namespace gfx
+{
+
+namespace
+{
+
+const std::uint8_t INVALID = 0xFF;
+
+/** Values of base64 alphabet characters, padding decodes as zero bits. */
+struct DecodeTable
+{
+    DecodeTable()
+    {
+        static const char ALPHABET[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+        for (auto& value : m_values)
+        {
+            value = INVALID;
+        }
+        for (std::uint8_t i = 0; i < sizeof(ALPHABET) - 1; ++i)
+        {
+            m_values[static_cast<unsigned char>(ALPHABET[i])] = i;
+        }
+        m_values[static_cast<unsigned char>('=')] = 0;
+    }
+
+    std::uint8_t m_values[256];
+};
+
+} // namespace anonymous
+
+void Base64Decoder::decode(const char* text,
+                           std::size_t length,
+                           std::vector<std::uint8_t>& output)
+{
+    static const DecodeTable TABLE;
+
+    // decode in place past the current end, trimmed when the real size is known
+    const std::size_t start = output.size();
+    output.resize(start + (m_count + length) / 4 * 3);
+
+    std::uint8_t* out = output.data() + start;
+    for (std::size_t i = 0; i < length; ++i)
+    {
+        const char c = text[i];
+        const std::uint8_t value = TABLE.m_values[static_cast<unsigned char>(c)];
+        if (value == INVALID)
+        {
+            continue;
+        }
+
+        m_last[1] = m_last[0];
+        m_last[0] = c;
+        m_value = (m_value << 6) | value;
+
+        if (++m_count == 4)
+        {
+            *out++ = static_cast<std::uint8_t>(m_value >> 16);
+            if (m_last[1] != '=')
+            {
+                *out++ = static_cast<std::uint8_t>(m_value >> 8);
+            }
+            if (m_last[0] != '=')
+            {
+                *out++ = static_cast<std::uint8_t>(m_value);
+            }
+            m_count = 0;
+        }
+    }
+
+    output.resize(out - output.data());
+}
+
+void Base64Decoder::reset()
+{
+    m_value = 0;
+    m_count = 0;
+    m_last[0] = 0;
+    m_last[1] = 0;
+}
+
+} // namespace gfx
+} // namespace subttxrend
@@ -21,15 +21,15 @@
 #include <png.h>
 
 #include "Base64ToPixmap.hpp"
+#include "Base64Decoder.hpp"
 
 #include <cstring>
 #include <csetjmp>
 #include <memory>
+#include <vector>
 #include <cassert>
 
 #include <subttxrend/common/Logger.hpp>
-#include <glib.h>
-#include <glib/gi18n.h>
 
 namespace subttxrend
 {
@@ -43,7 +43,7 @@ common::Logger g_logger("Gfx", "Base64ToPixmap");
 
 struct png_raw_data
 {
-    unsigned char *data;
+    const unsigned char *data;
     size_t ptr;
     size_t datalen;
 };
@@ -79,7 +79,7 @@ void read_function(png_structp png_ptr, png_bytep data, png_size_t length)
     }
 }
 
-std::unique_ptr<gfx::Bitmap> read_png(unsigned char *pngdata, const size_t pngdatalen)
+std::unique_ptr<gfx::Bitmap> read_png(const unsigned char *pngdata, const size_t pngdatalen)
 {
     std::unique_ptr<gfx::Bitmap> ret;
     png_structp png_ptr = 0;
@@ -99,7 +99,7 @@ std::unique_ptr<gfx::Bitmap> read_png(unsigned char *pngdata, const size_t pngda
     png_uint_32 bytesPerRow;
     uint32_t rowIdx;
 
-    if (png_sig_cmp(pngdata, 0, 8) != 0)
+    if ((pngdatalen < 8) || (png_sig_cmp(const_cast<png_bytep>(pngdata), 0, 8) != 0))
     {
         g_logger.warning("not png!");
         return ret;
@@ -288,34 +288,32 @@ void convertToTargetFormat(std::unique_ptr<gfx::Bitmap>& bmp, bool applyAlpha)
 } // namespace anonymous
 
 
-template<typename T, void(*Fn)(T*)> struct Deleter {
-   inline void operator() (void *p) const
-   {
-      if (p)
-         Fn(static_cast<T*>(p));
-   }
-};
+std::unique_ptr<gfx::Bitmap> pngToPixmap(const std::uint8_t* pngData,
+                                         std::size_t pngSize,
+                                         bool applyRGBAlphaPremult,
+                                         PngCallback pngCallback)
+{
+    if (pngCallback)
+    {
+        pngCallback(pngData, pngSize);
+    }
+
+    std::unique_ptr<gfx::Bitmap> ret = read_png(pngData, pngSize);
+    if (ret)
+    {
+        convertToTargetFormat(ret, applyRGBAlphaPremult);
+    }
+    return ret;
+}
 
 std::unique_ptr<gfx::Bitmap> base64toPixmap(const std::string &base64txt,
                                             bool applyRGBAlphaPremult,
                                             PngCallback pngCallback)
 {
-    size_t outLen = 0;
-    std::unique_ptr<uint8_t[], Deleter<void, g_free> > decoded = std::unique_ptr<uint8_t[], Deleter<void, g_free> >(g_base64_decode (base64txt.c_str(), &outLen));
-    std::unique_ptr<gfx::Bitmap> ret;
-    if (decoded.get() != NULL)
-    {
-        if (pngCallback)
-        {
-            pngCallback(decoded.get(), outLen);
-        }
-        ret = read_png(decoded.get(), outLen);
-        if (ret)
-        {
-            convertToTargetFormat(ret, applyRGBAlphaPremult);
-        }
-    }
-    return ret;
+    std::vector<std::uint8_t> decoded;
+    Base64Decoder().decode(base64txt.data(), base64txt.size(), decoded);
+
+    return pngToPixmap(decoded.data(), decoded.size(), applyRGBAlphaPremult, pngCallback);
 }
 
 }   // namespace gfx
@@ -0,0 +1,422 @@
+/*****************************************************************************
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:
+*
+* Copyright 2021 Liberty Global Service B.V.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*****************************************************************************/
+
+
+#include "BlendKernels.hpp"
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define BLEND_KERNELS_X86 1
+#include <immintrin.h>
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define BLEND_KERNELS_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace subttxrend
+{
+namespace gfx
+{
+
+namespace
+{
+
+/** Shift used by the reciprocal table. */
+const int RECIPROCAL_SHIFT = 24;
+
+/**
+ * Reciprocal tables.
+ *
+ * For every output alpha value d the table stores ceil(2^24 / d). For the
+ * numerators produced by the blending (n <= 255 * d) the value
+ * (n * reciprocal[d]) >> 24 is exactly n / d and the product fits in
+ * 32 bits. Index 0 stores 0 so fully transparent output needs no branch.
+ */
+struct ReciprocalTables
+{
+    ReciprocalTables()
+    {
+        reciprocal[0] = 0;
+        reciprocalLow[0] = 0;
+        reciprocalHigh[0] = 0;
+
+        for (std::uint32_t d = 1; d < 256; ++d)
+        {
+            const std::uint32_t value = ((1U << RECIPROCAL_SHIFT) + d - 1) / d;
+
+            reciprocal[d] = value;
+            reciprocalLow[d] = broadcastColor(value & 0xFFFF);
+            reciprocalHigh[d] = broadcastColor(value >> 16);
+        }
+    }
+
+    /**
+     * Builds four 16-bit lanes (B,G,R,A order) with color lanes set.
+     *
+     * @param value
+     *      Lane value.
+     *
+     * @return
+     *      Lanes with value in B, G and R and zero in A.
+     */
+    static std::uint64_t broadcastColor(std::uint64_t value)
+    {
+        return value | (value << 16) | (value << 32);
+    }
+
+    /** Reciprocals (32-bit). */
+    std::uint32_t reciprocal[256];
+
+    /** Low 16 bits of reciprocals broadcasted to color lanes. */
+    std::uint64_t reciprocalLow[256];
+
+    /** High 16 bits of reciprocals broadcasted to color lanes. */
+    std::uint64_t reciprocalHigh[256];
+};
+
+const ReciprocalTables& getTables()
+{
+    static const ReciprocalTables tables;
+    return tables;
+}
+
+/** Kernel function type. */
+typedef void (*KernelFunction)(PixelArgb8888* dst,
+                               const PixelArgb8888* src,
+                               std::size_t count);
+
+void blendLineScalar(PixelArgb8888* dst,
+                     const PixelArgb8888* src,
+                     std::size_t count)
+{
+    const auto& tables = getTables();
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const PixelArgb8888 srcPix = src[i];
+        PixelArgb8888 dstPix = dst[i];
+
+        // dstA * (1 - srcA) - the division by 255 is exact for this range
+        std::uint32_t dstAlpha_1_minus_srcAlpha = dstPix.m_a * (255U - srcPix.m_a);
+        dstAlpha_1_minus_srcAlpha = (dstAlpha_1_minus_srcAlpha + 1
+                + (dstAlpha_1_minus_srcAlpha >> 8)) >> 8;
+
+        const std::uint32_t outAlpha = srcPix.m_a + dstAlpha_1_minus_srcAlpha;
+        const std::uint32_t reciprocal = tables.reciprocal[outAlpha];
+
+        dstPix.m_b = ((srcPix.m_b * srcPix.m_a + dstPix.m_b * dstAlpha_1_minus_srcAlpha)
+                * reciprocal) >> RECIPROCAL_SHIFT;
+        dstPix.m_g = ((srcPix.m_g * srcPix.m_a + dstPix.m_g * dstAlpha_1_minus_srcAlpha)
+                * reciprocal) >> RECIPROCAL_SHIFT;
+        dstPix.m_r = ((srcPix.m_r * srcPix.m_a + dstPix.m_r * dstAlpha_1_minus_srcAlpha)
+                * reciprocal) >> RECIPROCAL_SHIFT;
+        dstPix.m_a = outAlpha;
+
+        dst[i] = dstPix;
+    }
+}
+
+#if defined(BLEND_KERNELS_X86)
+
+/*
+ * The x86 kernels work on pixels unpacked to 16-bit lanes (B,G,R,A per
+ * pixel). All intermediate values fit in 16 bits, the division by the
+ * output alpha is computed as:
+ *
+ *   n / d = (n * recipHigh[d] + mulhi(n, recipLow[d])) >> 8
+ *
+ * which is the 16-bit form of (n * reciprocal[d]) >> 24.
+ */
+
+__attribute__((target("sse2")))
+inline __m128i blendPixelPairSse2(__m128i s,
+                                  __m128i d,
+                                  const ReciprocalTables& tables)
+{
+    const __m128i one = _mm_set1_epi16(1);
+    const __m128i c255 = _mm_set1_epi16(255);
+    const __m128i alphaMask = _mm_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0);
+
+    const __m128i sa = _mm_shufflehi_epi16(_mm_shufflelo_epi16(s, 0xFF), 0xFF);
+    const __m128i da = _mm_shufflehi_epi16(_mm_shufflelo_epi16(d, 0xFF), 0xFF);
+
+    __m128i t = _mm_mullo_epi16(da, _mm_sub_epi16(c255, sa));
+    t = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(t, one), _mm_srli_epi16(t, 8)), 8);
+
+    const __m128i oa = _mm_add_epi16(sa, t);
+    const __m128i n = _mm_add_epi16(_mm_mullo_epi16(s, sa), _mm_mullo_epi16(d, t));
+
+    const int oa0 = _mm_extract_epi16(oa, 3);
+    const int oa1 = _mm_extract_epi16(oa, 7);
+
+    const __m128i rh = _mm_set_epi64x(tables.reciprocalHigh[oa1], tables.reciprocalHigh[oa0]);
+    const __m128i rl = _mm_set_epi64x(tables.reciprocalLow[oa1], tables.reciprocalLow[oa0]);
+
+    const __m128i q = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(n, rh), _mm_mulhi_epu16(n, rl)), 8);
+
+    // reciprocal tables have zeros in alpha lanes
+    return _mm_or_si128(q, _mm_and_si128(oa, alphaMask));
+}
+
+__attribute__((target("sse2")))
+void blendLineSse2(PixelArgb8888* dst,
+                   const PixelArgb8888* src,
+                   std::size_t count)
+{
+    const auto& tables = getTables();
+    const __m128i zero = _mm_setzero_si128();
+
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        const __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+
+        const __m128i lo = blendPixelPairSse2(_mm_unpacklo_epi8(s, zero), _mm_unpacklo_epi8(d, zero), tables);
+        const __m128i hi = blendPixelPairSse2(_mm_unpackhi_epi8(s, zero), _mm_unpackhi_epi8(d, zero), tables);
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packus_epi16(lo, hi));
+    }
+
+    blendLineScalar(dst + i, src + i, count - i);
+}
+
+__attribute__((target("avx2")))
+inline __m256i blendPixelQuadAvx2(__m256i s,
+                                  __m256i d,
+                                  const ReciprocalTables& tables)
+{
+    const __m256i one = _mm256_set1_epi16(1);
+    const __m256i c255 = _mm256_set1_epi16(255);
+    const __m256i alphaMask = _mm256_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0,
+                                               -1, 0, 0, 0, -1, 0, 0, 0);
+
+    const __m256i sa = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(s, 0xFF), 0xFF);
+    const __m256i da = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(d, 0xFF), 0xFF);
+
+    __m256i t = _mm256_mullo_epi16(da, _mm256_sub_epi16(c255, sa));
+    t = _mm256_srli_epi16(_mm256_add_epi16(_mm256_add_epi16(t, one), _mm256_srli_epi16(t, 8)), 8);
+
+    const __m256i oa = _mm256_add_epi16(sa, t);
+    const __m256i n = _mm256_add_epi16(_mm256_mullo_epi16(s, sa), _mm256_mullo_epi16(d, t));
+
+    alignas(32) std::uint16_t oaLanes[16];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(oaLanes), oa);
+
+    const __m256i rh = _mm256_set_epi64x(tables.reciprocalHigh[oaLanes[15]],
+                                         tables.reciprocalHigh[oaLanes[11]],
+                                         tables.reciprocalHigh[oaLanes[7]],
+                                         tables.reciprocalHigh[oaLanes[3]]);
+    const __m256i rl = _mm256_set_epi64x(tables.reciprocalLow[oaLanes[15]],
+                                         tables.reciprocalLow[oaLanes[11]],
+                                         tables.reciprocalLow[oaLanes[7]],
+                                         tables.reciprocalLow[oaLanes[3]]);
+
+    const __m256i q = _mm256_srli_epi16(_mm256_add_epi16(_mm256_mullo_epi16(n, rh), _mm256_mulhi_epu16(n, rl)), 8);
+
+    return _mm256_or_si256(q, _mm256_and_si256(oa, alphaMask));
+}
+
+__attribute__((target("avx2")))
+void blendLineAvx2(PixelArgb8888* dst,
+                   const PixelArgb8888* src,
+                   std::size_t count)
+{
+    const auto& tables = getTables();
+    const __m256i zero = _mm256_setzero_si256();
+
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m256i s = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        const __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+
+        // unpack/pack work within 128-bit lanes so the pixel order is preserved
+        const __m256i lo = blendPixelQuadAvx2(_mm256_unpacklo_epi8(s, zero), _mm256_unpacklo_epi8(d, zero), tables);
+        const __m256i hi = blendPixelQuadAvx2(_mm256_unpackhi_epi8(s, zero), _mm256_unpackhi_epi8(d, zero), tables);
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_packus_epi16(lo, hi));
+    }
+
+    blendLineScalar(dst + i, src + i, count - i);
+}
+
+#endif // BLEND_KERNELS_X86
+
+#if defined(BLEND_KERNELS_NEON)
+
+void blendLineNeon(PixelArgb8888* dst,
+                   const PixelArgb8888* src,
+                   std::size_t count)
+{
+    const auto& tables = getTables();
+    const uint16x8_t one = vdupq_n_u16(1);
+    const uint16x8_t c255 = vdupq_n_u16(255);
+
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        auto srcBytes = reinterpret_cast<const std::uint8_t*>(src + i);
+        auto dstBytes = reinterpret_cast<std::uint8_t*>(dst + i);
+
+        // planes: 0 - blue, 1 - green, 2 - red, 3 - alpha
+        const uint8x8x4_t s = vld4_u8(srcBytes);
+        const uint8x8x4_t d = vld4_u8(dstBytes);
+
+        const uint16x8_t sa = vmovl_u8(s.val[3]);
+        const uint16x8_t da = vmovl_u8(d.val[3]);
+
+        uint16x8_t t = vmulq_u16(da, vsubq_u16(c255, sa));
+        t = vshrq_n_u16(vaddq_u16(vaddq_u16(t, one), vshrq_n_u16(t, 8)), 8);
+
+        const uint16x8_t oa = vaddq_u16(sa, t);
+
+        std::uint16_t oaLanes[8];
+        std::uint32_t reciprocals[8];
+        vst1q_u16(oaLanes, oa);
+        for (int k = 0; k < 8; ++k)
+        {
+            reciprocals[k] = tables.reciprocal[oaLanes[k]];
+        }
+        const uint32x4_t rLow = vld1q_u32(reciprocals);
+        const uint32x4_t rHigh = vld1q_u32(reciprocals + 4);
+
+        uint8x8x4_t out;
+        for (int c = 0; c < 3; ++c)
+        {
+            const uint16x8_t n = vmlaq_u16(vmulq_u16(vmovl_u8(s.val[c]), sa), vmovl_u8(d.val[c]), t);
+
+            const uint32x4_t qLow = vshrq_n_u32(vmulq_u32(vmovl_u16(vget_low_u16(n)), rLow), RECIPROCAL_SHIFT);
+            const uint32x4_t qHigh = vshrq_n_u32(vmulq_u32(vmovl_u16(vget_high_u16(n)), rHigh), RECIPROCAL_SHIFT);
+
+            out.val[c] = vmovn_u16(vcombine_u16(vmovn_u32(qLow), vmovn_u32(qHigh)));
+        }
+        out.val[3] = vmovn_u16(oa);
+
+        vst4_u8(dstBytes, out);
+    }
+
+    blendLineScalar(dst + i, src + i, count - i);
+}
+
+#endif // BLEND_KERNELS_NEON
+
+KernelFunction getKernel(BlendKernels::Type type)
+{
+    switch (type)
+    {
+#if defined(BLEND_KERNELS_X86)
+    case BlendKernels::Type::SSE2:
+        return blendLineSse2;
+    case BlendKernels::Type::AVX2:
+        return blendLineAvx2;
+#endif
+#if defined(BLEND_KERNELS_NEON)
+    case BlendKernels::Type::NEON:
+        return blendLineNeon;
+#endif
+    default:
+        return blendLineScalar;
+    }
+}
+
+BlendKernels::Type selectType()
+{
+    if (BlendKernels::isSupported(BlendKernels::Type::NEON))
+    {
+        return BlendKernels::Type::NEON;
+    }
+    if (BlendKernels::isSupported(BlendKernels::Type::AVX2))
+    {
+        return BlendKernels::Type::AVX2;
+    }
+    if (BlendKernels::isSupported(BlendKernels::Type::SSE2))
+    {
+        return BlendKernels::Type::SSE2;
+    }
+    return BlendKernels::Type::SCALAR;
+}
+
+} // namespace <anonymous>
+
+void BlendKernels::blendLine(PixelArgb8888* dst,
+                             const PixelArgb8888* src,
+                             std::size_t count)
+{
+    static const KernelFunction kernel = getKernel(getActiveType());
+
+    kernel(dst, src, count);
+}
+
+void BlendKernels::blendLine(Type type,
+                             PixelArgb8888* dst,
+                             const PixelArgb8888* src,
+                             std::size_t count)
+{
+    getKernel(type)(dst, src, count);
+}
+
+bool BlendKernels::isSupported(Type type)
+{
+    switch (type)
+    {
+    case Type::SCALAR:
+        return true;
+#if defined(BLEND_KERNELS_X86)
+    case Type::SSE2:
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("sse2");
+    case Type::AVX2:
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2");
+#endif
+#if defined(BLEND_KERNELS_NEON)
+    case Type::NEON:
+        return true;
+#endif
+    default:
+        return false;
+    }
+}
+
+BlendKernels::Type BlendKernels::getActiveType()
+{
+    static const Type type = selectType();
+    return type;
+}
+
+const char* BlendKernels::getName(Type type)
+{
+    switch (type)
+    {
+    case Type::SCALAR:
+        return "scalar";
+    case Type::SSE2:
+        return "sse2";
+    case Type::AVX2:
+        return "avx2";
+    case Type::NEON:
+        return "neon";
+    }
+    return "unknown";
+}
+
+} // namespace gfx
+} // namespace subttxrend
@@ -0,0 +1,135 @@
+/*****************************************************************************
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:
+*
+* Copyright 2021 Liberty Global Service B.V.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*****************************************************************************/
+
+
+#ifndef SUBTTXREND_GFX_BLEND_KERNELS_HPP_
+#define SUBTTXREND_GFX_BLEND_KERNELS_HPP_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "Pixel.hpp"
+
+namespace subttxrend
+{
+namespace gfx
+{
+
+/**
+ * Alpha blending kernels.
+ *
+ * Blends a line of source pixels over a line of destination pixels
+ * (non-premultiplied 'source over' operation). All kernels produce
+ * results that are bit exact with the reference formula:
+ *
+ * @code
+ * t  = dstA * (255 - srcA) / 255
+ * oA = srcA + t
+ * oC = (srcC * srcA + dstC * t) / oA      (0 if oA == 0)
+ * @endcode
+ *
+ * The divisions are replaced by exact reciprocal arithmetic so the
+ * per-pixel work is reduced to multiplications, shifts and one table
+ * lookup. The vectorized kernel is selected once at runtime, the scalar
+ * kernel is used as a fallback and for the line tails.
+ */
+class BlendKernels
+{
+public:
+    /**
+     * Kernel type.
+     */
+    enum class Type
+    {
+        /** Portable scalar implementation. */
+        SCALAR,
+        /** x86 SSE2 implementation (4 pixels per step). */
+        SSE2,
+        /** x86 AVX2 implementation (8 pixels per step). */
+        AVX2,
+        /** ARM NEON implementation (8 pixels per step). */
+        NEON
+    };
+
+    /**
+     * Blends line using the best kernel available.
+     *
+     * @param dst
+     *      Destination pixels (modified in place).
+     * @param src
+     *      Source pixels.
+     * @param count
+     *      Number of pixels.
+     */
+    static void blendLine(PixelArgb8888* dst,
+                          const PixelArgb8888* src,
+                          std::size_t count);
+
+    /**
+     * Blends line using given kernel.
+     *
+     * @param type
+     *      Kernel to use. Must be supported (see isSupported()).
+     * @param dst
+     *      Destination pixels (modified in place).
+     * @param src
+     *      Source pixels.
+     * @param count
+     *      Number of pixels.
+     */
+    static void blendLine(Type type,
+                          PixelArgb8888* dst,
+                          const PixelArgb8888* src,
+                          std::size_t count);
+
+    /**
+     * Checks if kernel could be used on this machine.
+     *
+     * @param type
+     *      Kernel type.
+     *
+     * @return
+     *      True if kernel is compiled in and supported by the CPU.
+     */
+    static bool isSupported(Type type);
+
+    /**
+     * Returns kernel selected for blendLine().
+     *
+     * @return
+     *      Kernel type.
+     */
+    static Type getActiveType();
+
+    /**
+     * Returns kernel name.
+     *
+     * @param type
+     *      Kernel type.
+     *
+     * @return
+     *      Kernel name.
+     */
+    static const char* getName(Type type);
+};
+
+} // namespace gfx
+} // namespace subttxrend
+
+#endif                          // SUBTTXREND_GFX_BLEND_KERNELS_HPP_
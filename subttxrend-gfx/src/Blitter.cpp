@@ -31,6 +31,8 @@ namespace gfx
 
 subttxrend::common::Logger Blitter::m_logger("Gfx", "Blitter");
 
+const std::size_t Blitter::BLEND_CHUNK_SIZE;
+
 const Blitter::DrawPosition Blitter::DrawPosition::CENTER(
         Blitter::DrawPosition::Mode::CENTER, 0, 0);
 
@@ -24,10 +24,15 @@
 #include <cstdint>
 #include <cstring>
 #include <algorithm>
+#include <vector>
 
 #include <subttxrend/common/Logger.hpp>
 
+#include "BlendKernels.hpp"
+#include "ClutPixmap.hpp"
+#include "FillKernels.hpp"
 #include "Pixmap.hpp"
+#include "Scaler.hpp"
 #include "Types.hpp"
 
 namespace subttxrend
@@ -113,8 +118,12 @@ public:
     {
         /** Simple (single pixel copy from source to target). */
         SIMPLE,
-        /** Smooth (up to 4 pixels mixed to get smoother look). */
-        SMOOTH
+        /** Smooth (bilinear for upscaling, area for downscaling). */
+        SMOOTH,
+        /** Bilinear interpolation in both directions. */
+        BILINEAR,
+        /** Area (box) averaging in both directions. */
+        AREA
     };
 
     /**
@@ -252,6 +261,21 @@ private:
     static bool checkRectangle(const PixmapType& pixmap,
                                const Rectangle& rect);
 
+    /**
+     * Fills lines.
+     *
+     * @param dstPixmap
+     *      Destination pixmap.
+     * @param dstRect
+     *      Rectangle to fill (already clipped to pixmap).
+     * @param value
+     *      Fill color.
+     */
+    template<class DstPixmapType, class DstPixelType>
+    static void fillLines(DstPixmapType& dstPixmap,
+                          const Rectangle& dstRect,
+                          DstPixelType value);
+
     /**
      * Copies line.
      *
@@ -358,7 +382,7 @@ private:
                                         const Rectangle& dstRect);
 
     /**
-     * Performs stretch blit operation (smooth - pixel mixing).
+     * Performs stretch blit operation (separable filtering).
      *
      * @param srcPixmap
      *      Source pixmap.
@@ -368,12 +392,18 @@ private:
      *      Destination pixmap.
      * @param dstRect
      *      Destination rectangle.
+     * @param horizontalFilter
+     *      Filter used for columns.
+     * @param verticalFilter
+     *      Filter used for lines.
      */
     template<class SrcPixmapType, class DstPixmapType>
-    static void pixmapStretchBlitSmooth(const SrcPixmapType& srcPixmap,
+    static void pixmapStretchBlitScaled(const SrcPixmapType& srcPixmap,
                                         const Rectangle& srcRect,
                                         DstPixmapType& dstPixmap,
-                                        const Rectangle& dstRect);
+                                        const Rectangle& dstRect,
+                                        Scaler::Filter horizontalFilter,
+                                        Scaler::Filter verticalFilter);
 
     /**
      * Performs blit operation.
@@ -396,6 +426,67 @@ private:
                            const Rectangle& dstRect,
                            Blitter::RenderMode renderMode);
 
+    /**
+     * Provides source lines as ARGB pixels for the scaler.
+     *
+     * Generic version converts the pixels using line iterator.
+     */
+    template<class SrcPixmapType>
+    class LineFetcher
+    {
+    public:
+        /**
+         * Constructor.
+         *
+         * @param pixmap
+         *      Source pixmap.
+         * @param rect
+         *      Source rectangle.
+         */
+        LineFetcher(const SrcPixmapType& pixmap,
+                    const Rectangle& rect) :
+                m_pixmap(pixmap),
+                m_rect(rect)
+        {
+            // noop
+        }
+
+        /**
+         * Fetches line.
+         *
+         * @param line
+         *      Line number (relative to rectangle).
+         * @param buffer
+         *      Buffer for converted pixels (rectangle width entries).
+         *
+         * @return
+         *      Pointer to line pixels.
+         */
+        const PixelArgb8888* fetch(int line,
+                                   PixelArgb8888* buffer)
+        {
+            auto srcLine = m_pixmap.getLine(line + m_rect.m_y) + m_rect.m_x;
+
+            for (int i = 0; i < m_rect.m_w; ++i)
+            {
+                buffer[i] = *srcLine;
+                ++srcLine;
+            }
+
+            return buffer;
+        }
+
+    private:
+        /** Source pixmap. */
+        const SrcPixmapType& m_pixmap;
+
+        /** Source rectangle. */
+        const Rectangle m_rect;
+    };
+
+    /** Number of pixels blended at once by generic alphaBlendLine(). */
+    static const std::size_t BLEND_CHUNK_SIZE = 64;
+
     /** Logger. */
     static subttxrend::common::Logger m_logger;
 };
@@ -417,6 +508,27 @@ inline void Blitter::clear(DstPixmapType& dstPixmap)
     }
 }
 
+/**
+ * Clears the pixmap with transparent (0) color.
+ *
+ * Pixmap without line padding is cleared at once.
+ *
+ * @param dstPixmap
+ *      Destination pixmap.
+ */
+template<>
+inline void Blitter::clear<Pixmap>(Pixmap& dstPixmap)
+{
+    auto line = dstPixmap.getLine(0);
+    if (!line || (dstPixmap.getWidth() <= 0) || (dstPixmap.getHeight() <= 0))
+    {
+        return;
+    }
+
+    FillKernels::fillRectangle(line.ptr(), dstPixmap.getStride(),
+            dstPixmap.getWidth(), dstPixmap.getHeight(), PixelArgb8888(0));
+}
+
 template<class DstPixmapType, class DstPixelType>
 inline void Blitter::fillRectangle(DstPixmapType& dstPixmap,
                                    const Rectangle& dstRect,
@@ -433,19 +545,8 @@ inline void Blitter::fillRectangle(DstPixmapType& dstPixmap,
             return;
     }
 
-    const int lx = dstRect.m_x + width;
-    const int ly = dstRect.m_y + dstRect.m_h;
-
-    for (int cy = dstRect.m_y; cy < ly; ++cy)
-    {
-        auto line = dstPixmap.getLine(cy) + dstRect.m_x;
-
-        for (int cx = dstRect.m_x; cx < lx; ++cx)
-        {
-            *line = value;
-            ++line;
-        }
-    }
+    fillLines(dstPixmap, Rectangle{dstRect.m_x, dstRect.m_y, width, dstRect.m_h},
+            value);
 }
 
 template<class SrcPixmapType, class DstPixmapType>
@@ -573,6 +674,52 @@ inline bool Blitter::checkRectangle(const PixmapType& pixmap,
     return true;
 }
 
+template<class DstPixmapType, class DstPixelType>
+inline void Blitter::fillLines(DstPixmapType& dstPixmap,
+                               const Rectangle& dstRect,
+                               DstPixelType value)
+{
+    const int lx = dstRect.m_x + dstRect.m_w;
+    const int ly = dstRect.m_y + dstRect.m_h;
+
+    for (int cy = dstRect.m_y; cy < ly; ++cy)
+    {
+        auto line = dstPixmap.getLine(cy) + dstRect.m_x;
+
+        for (int cx = dstRect.m_x; cx < lx; ++cx)
+        {
+            *line = value;
+            ++line;
+        }
+    }
+}
+
+/**
+ * Fills lines.
+ *
+ * @param dstPixmap
+ *      Destination pixmap.
+ * @param dstRect
+ *      Rectangle to fill (already clipped to pixmap).
+ * @param value
+ *      Fill color.
+ */
+template<>
+inline void Blitter::fillLines<Pixmap, PixelArgb8888>(Pixmap& dstPixmap,
+                                                      const Rectangle& dstRect,
+                                                      PixelArgb8888 value)
+{
+    if ((dstRect.m_w <= 0) || (dstRect.m_h <= 0))
+    {
+        return;
+    }
+
+    auto line = dstPixmap.getLine(dstRect.m_y) + dstRect.m_x;
+
+    FillKernels::fillRectangle(line.ptr(), dstPixmap.getStride(), dstRect.m_w,
+            dstRect.m_h, value);
+}
+
 template<class SrcPixmapType, class DstPixmapType>
 inline void Blitter::copyLine(const SrcPixmapType& srcPixmap,
                               const Rectangle& srcRect,
@@ -633,40 +780,58 @@ inline void Blitter::alphaBlendLine(const SrcPixmapType& srcPixmap,
 {
     auto srcLine = srcPixmap.getLine(line + srcRect.m_y) + srcRect.m_x;
     auto dstLine = dstPixmap.getLine(line + dstRect.m_y) + dstRect.m_x;
-    PixelArgb8888 srcPix;
-    PixelArgb8888 dstPix;
-    uint8_t outAlpha;
 
-    for (std::size_t i = 0; i < count; ++i)
-    {
-        srcPix = *srcLine;
-        dstPix = *dstLine;
+    // source pixels may be generated (e.g. colorized) so they are expanded
+    // in chunks to allow the blending kernel to process them in bulk
+    PixelArgb8888 srcChunk[BLEND_CHUNK_SIZE];
 
-        // Blend Alpha component
-        const uint8_t dstAlpha_1_minus_srcAlpha = dstPix.m_a * (255 - srcPix.m_a) / 255;
-        outAlpha = srcPix.m_a + dstAlpha_1_minus_srcAlpha;
+    while (count > 0)
+    {
+        const std::size_t chunkSize = std::min(count, BLEND_CHUNK_SIZE);
 
-        if(outAlpha > 0)
-        {
-            dstPix.m_b = (srcPix.m_b * srcPix.m_a + dstPix.m_b * dstAlpha_1_minus_srcAlpha) / outAlpha;
-            dstPix.m_g = (srcPix.m_g * srcPix.m_a + dstPix.m_g * dstAlpha_1_minus_srcAlpha) / outAlpha;
-            dstPix.m_r = (srcPix.m_r * srcPix.m_a + dstPix.m_r * dstAlpha_1_minus_srcAlpha) / outAlpha;
-        }
-        else
+        for (std::size_t i = 0; i < chunkSize; ++i)
         {
-            dstPix.m_b = 0;
-            dstPix.m_g = 0;
-            dstPix.m_r = 0;
+            srcChunk[i] = *srcLine;
+            ++srcLine;
         }
 
-        dstPix.m_a = outAlpha;
-        *dstLine = dstPix;
+        BlendKernels::blendLine(dstLine.ptr(), srcChunk, chunkSize);
 
-        ++dstLine;
-        ++srcLine;
+        dstLine += chunkSize;
+        count -= chunkSize;
     }
 }
 
+/**
+ * Copies line with mixing.
+ *
+ * @param srcPixmap
+ *      Source pixmap.
+ * @param srcRect
+ *      Source rectangle.
+ * @param dstPixmap
+ *      Destination pixmap.
+ * @param dstRect
+ *      Destination rectangle.
+ * @param line
+ *      Line number (relative to rectangles!).
+ * @param count
+ *      Number of items (pixels) to copy.
+ */
+template<>
+inline void Blitter::alphaBlendLine<Pixmap, Pixmap>(const Pixmap& srcPixmap,
+                                                    const Rectangle& srcRect,
+                                                    Pixmap& dstPixmap,
+                                                    const Rectangle& dstRect,
+                                                    int line,
+                                                    std::size_t count)
+{
+    auto srcLine = srcPixmap.getLine(line + srcRect.m_y) + srcRect.m_x;
+    auto dstLine = dstPixmap.getLine(line + dstRect.m_y) + dstRect.m_x;
+
+    BlendKernels::blendLine(dstLine.ptr(), srcLine.ptr(), count);
+}
+
 template<class SrcPixmapType, class DstPixmapType>
 inline void Blitter::alphaBlendPixmaps(const SrcPixmapType& srcPixmap,
                                        const Rectangle& srcRect,
@@ -697,6 +862,40 @@ inline void Blitter::pixmapBitBlit(const SrcPixmapType& srcPixmap,
     }
 }
 
+/**
+ * Copies CLUT pixmap.
+ *
+ * The lookup table is expanded once for the whole blit, so each pixel
+ * is converted with a single lookup instead of the iterator range check
+ * and premultiplication.
+ *
+ * @param srcPixmap
+ *      Source pixmap.
+ * @param srcRect
+ *      Source rectangle.
+ * @param dstPixmap
+ *      Destination pixmap.
+ * @param dstRect
+ *      Destination rectangle.
+ */
+template<>
+inline void Blitter::pixmapBitBlit<ClutPixmap, Pixmap>(const ClutPixmap& srcPixmap,
+                                                       const Rectangle& srcRect,
+                                                       Pixmap& dstPixmap,
+                                                       const Rectangle& dstRect)
+{
+    ClutPixmap::ExpandedClut clut;
+    srcPixmap.expandClut(clut);
+
+    for (int y = 0; y < srcRect.m_h; ++y)
+    {
+        auto srcLine = srcPixmap.getLine(y + srcRect.m_y) + srcRect.m_x;
+        auto dstLine = dstPixmap.getLine(y + dstRect.m_y) + dstRect.m_x;
+
+        ClutPixmap::convertLine(clut, srcLine.ptr(), dstLine.ptr(), srcRect.m_w);
+    }
+}
+
 template<class SrcPixmapType, class DstPixmapType>
 inline void Blitter::pixmapStretchBlitSimple(const SrcPixmapType& srcPixmap,
                                              const Rectangle& srcRect,
@@ -732,88 +931,107 @@ inline void Blitter::pixmapStretchBlitSimple(const SrcPixmapType& srcPixmap,
     }
 }
 
-template<class SrcPixmapType, class DstPixmapType>
-inline void Blitter::pixmapStretchBlitSmooth(const SrcPixmapType& srcPixmap,
-                                             const Rectangle& srcRect,
-                                             DstPixmapType& dstPixmap,
-                                             const Rectangle& dstRect)
+/**
+ * Provides source lines for the scaler (no conversion needed).
+ */
+template<>
+class Blitter::LineFetcher<Pixmap>
 {
-    const int RATIO_SHIFT = 16;
+public:
+    LineFetcher(const Pixmap& pixmap,
+                const Rectangle& rect) :
+            m_pixmap(pixmap),
+            m_rect(rect)
+    {
+        // noop
+    }
 
-    int wRatio = (srcRect.m_w << RATIO_SHIFT) / dstRect.m_w;
-    int hRatio = (srcRect.m_h << RATIO_SHIFT) / dstRect.m_h;
+    const PixelArgb8888* fetch(int line,
+                               PixelArgb8888* /*buffer*/)
+    {
+        return (m_pixmap.getLine(line + m_rect.m_y) + m_rect.m_x).ptr();
+    }
 
-    typename SrcPixmapType::ConstLineIterator srcLineStartPrev;
+private:
+    const Pixmap& m_pixmap;
+    const Rectangle m_rect;
+};
 
-    for (int dstY = 0; dstY < dstRect.m_h; ++dstY)
+/**
+ * Provides source lines for the scaler (CLUT expanded once).
+ */
+template<>
+class Blitter::LineFetcher<ClutPixmap>
+{
+public:
+    LineFetcher(const ClutPixmap& pixmap,
+                const Rectangle& rect) :
+            m_pixmap(pixmap),
+            m_rect(rect)
     {
-        int32_t srcY = dstY;
-        srcY *= hRatio;
-        srcY >>= RATIO_SHIFT;
+        m_pixmap.expandClut(m_clut);
+    }
 
-        auto dstLineStart = dstPixmap.getLine(dstY + dstRect.m_y) + dstRect.m_x;
-        auto srcLineStart = srcPixmap.getLine(srcY + srcRect.m_y) + srcRect.m_x;
+    const PixelArgb8888* fetch(int line,
+                               PixelArgb8888* buffer)
+    {
+        auto srcLine = m_pixmap.getLine(line + m_rect.m_y) + m_rect.m_x;
 
-        int srcXprev = -1;
+        ClutPixmap::convertLine(m_clut, srcLine.ptr(), buffer, m_rect.m_w);
 
-        auto dstPixel = dstLineStart;
-        for (int dstX = 0; dstX < dstRect.m_w; ++dstX)
-        {
-            int32_t srcX = dstX;
-            srcX *= wRatio;
-            srcX >>= RATIO_SHIFT;
+        return buffer;
+    }
 
-            auto srcPixel = *(srcLineStart + srcX);
+private:
+    const ClutPixmap& m_pixmap;
+    const Rectangle m_rect;
+    ClutPixmap::ExpandedClut m_clut;
+};
 
-            int ta = srcPixel.m_a;
-            int tr = srcPixel.m_r;
-            int tg = srcPixel.m_g;
-            int tb = srcPixel.m_b;
-            int count = 1;
+template<class SrcPixmapType, class DstPixmapType>
+inline void Blitter::pixmapStretchBlitScaled(const SrcPixmapType& srcPixmap,
+                                             const Rectangle& srcRect,
+                                             DstPixmapType& dstPixmap,
+                                             const Rectangle& dstRect,
+                                             Scaler::Filter horizontalFilter,
+                                             Scaler::Filter verticalFilter)
+{
+    // coefficient tables are cached by the scaler, blits of the same
+    // sizes do not calculate them again
+    Scaler scaler(horizontalFilter, verticalFilter, srcRect.m_w, srcRect.m_h,
+            dstRect.m_w, dstRect.m_h);
+    LineFetcher<SrcPixmapType> fetcher(srcPixmap, srcRect);
 
-            if (srcXprev >= 0)
-            {
-                srcPixel = *(srcLineStart + srcXprev);
+    // consecutive destination lines share source lines, fetched lines
+    // are kept in slots selected by line number modulo line count
+    const int lineCount = scaler.getSourceLineCount();
 
-                ta += srcPixel.m_a;
-                tr += srcPixel.m_r;
-                tg += srcPixel.m_g;
-                tb += srcPixel.m_b;
-                ++count;
-            }
+    std::vector<PixelArgb8888> slotBuffers(lineCount * srcRect.m_w);
+    std::vector<const PixelArgb8888*> slotPointers(lineCount);
+    std::vector<int> slotLines(lineCount, -1);
+    std::vector<const PixelArgb8888*> srcLines(lineCount);
 
-            if (srcLineStartPrev)
-            {
-                srcPixel = *(srcLineStartPrev + srcX);
-
-                ta += srcPixel.m_a;
-                tr += srcPixel.m_r;
-                tg += srcPixel.m_g;
-                tb += srcPixel.m_b;
-                ++count;
-
-                if (srcXprev >= 0)
-                {
-                    srcPixel = *(srcLineStartPrev + srcXprev);
-
-                    ta += srcPixel.m_a;
-                    tr += srcPixel.m_r;
-                    tg += srcPixel.m_g;
-                    tb += srcPixel.m_b;
-                    ++count;
-                }
-            }
-
-            PixelArgb8888 srcPixelValue(ta / count, tr / count, tg / count,
-                    tb / count);
+    for (int dstY = 0; dstY < dstRect.m_h; ++dstY)
+    {
+        const int firstLine = scaler.getFirstSourceLine(dstY);
 
-            *dstPixel = srcPixelValue;
-            ++dstPixel;
+        for (int i = 0; i < lineCount; ++i)
+        {
+            const int srcY = firstLine + i;
+            const int slot = srcY % lineCount;
 
-            srcXprev = srcX;
+            if (slotLines[slot] != srcY)
+            {
+                slotPointers[slot] = fetcher.fetch(srcY,
+                        slotBuffers.data() + slot * srcRect.m_w);
+                slotLines[slot] = srcY;
+            }
+            srcLines[i] = slotPointers[slot];
         }
 
-        srcLineStartPrev = srcLineStart;
+        auto dstLine = dstPixmap.getLine(dstY + dstRect.m_y) + dstRect.m_x;
+
+        scaler.scaleLine(dstY, srcLines.data(), dstLine.ptr());
     }
 }
 
@@ -849,8 +1067,22 @@ inline void Blitter::pixmapBlit(const SrcPixmapType& srcPixmap,
         }
         else if (renderMode == Blitter::RenderMode::SMOOTH)
         {
-            auto t = m_logger.timing("pixmapStretchBlitSmooth");
-            pixmapStretchBlitSmooth(srcPixmap, srcRect, dstPixmap, dstRect);
+            auto t = m_logger.timing("pixmapStretchBlitScaled");
+            pixmapStretchBlitScaled(srcPixmap, srcRect, dstPixmap, dstRect,
+                    Scaler::selectFilter(srcRect.m_w, dstRect.m_w),
+                    Scaler::selectFilter(srcRect.m_h, dstRect.m_h));
+        }
+        else if (renderMode == Blitter::RenderMode::BILINEAR)
+        {
+            auto t = m_logger.timing("pixmapStretchBlitScaled");
+            pixmapStretchBlitScaled(srcPixmap, srcRect, dstPixmap, dstRect,
+                    Scaler::Filter::BILINEAR, Scaler::Filter::BILINEAR);
+        }
+        else if (renderMode == Blitter::RenderMode::AREA)
+        {
+            auto t = m_logger.timing("pixmapStretchBlitScaled");
+            pixmapStretchBlitScaled(srcPixmap, srcRect, dstPixmap, dstRect,
+                    Scaler::Filter::AREA, Scaler::Filter::AREA);
         }
         else
         {
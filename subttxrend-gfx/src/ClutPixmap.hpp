@@ -23,6 +23,7 @@
 
 #include <cassert>
 #include <cstdint>
+#include <cstring>
 
 #include "Pixel.hpp"
 #include "Types.hpp"
@@ -89,6 +90,17 @@ public:
             return m_pointer;
         }
 
+        /**
+         * Returns pointer to item.
+         *
+         * @return
+         *      Pointer to item (pixel value).
+         */
+        const std::uint8_t* ptr() const
+        {
+            return m_pointer;
+        }
+
         /**
          * Moves iterator to next position.
          *
@@ -141,19 +153,11 @@ public:
          */
         PixelArgb8888 operator*() const
         {
-            static const uint32_t TRANSPARENT_BLACK = 0;
-
             assert(m_pointer);
             auto value = *m_pointer;
             if (value < m_clutSize)
             {
-                PixelArgb8888 ret = PixelArgb8888(m_clut[value]);
-                // apply per-pixel alpha-premultiplication
-                ret.m_r = uint8_t(uint32_t(ret.m_r * ret.m_a) / 255);
-                ret.m_g = uint8_t(uint32_t(ret.m_g * ret.m_a) / 255);
-                ret.m_b = uint8_t(uint32_t(ret.m_b * ret.m_a) / 255);
-
-                return ret;
+                return premultiply(m_clut[value]);
             }
 
             return PixelArgb8888(TRANSPARENT_BLACK);
@@ -170,6 +174,21 @@ public:
         std::size_t m_clutSize;
     };
 
+    /**
+     * Colour lookup table expanded to all possible pixel values.
+     *
+     * Built once per blit so the pixels could be converted with a single
+     * table lookup, without the range check and premultiplication.
+     */
+    struct ExpandedClut
+    {
+        /** Colours (alpha premultiplied) indexed by pixel value. */
+        PixelArgb8888 m_colors[256];
+
+        /** Pixel value mapped to transparent black, -1 if none. */
+        int m_transparentValue;
+    };
+
     /**
      * Constructor.
      *
@@ -229,6 +248,94 @@ public:
         return m_height;
     }
 
+    /**
+     * Expands colour lookup table.
+     *
+     * @param table
+     *      Table to fill, produces same colours as line iterator.
+     */
+    void expandClut(ExpandedClut& table) const
+    {
+        table.m_transparentValue = -1;
+
+        for (std::size_t i = 0; i < 256; ++i)
+        {
+            table.m_colors[i] = (i < m_clutSize) ? premultiply(m_clut[i])
+                                                 : PixelArgb8888(TRANSPARENT_BLACK);
+
+            const auto& color = table.m_colors[i];
+            if ((table.m_transparentValue < 0) && (color.m_a == 0)
+                    && (color.m_r == 0) && (color.m_g == 0) && (color.m_b == 0))
+            {
+                table.m_transparentValue = static_cast<int>(i);
+            }
+        }
+    }
+
+    /**
+     * Converts line of pixel values to colours.
+     *
+     * Runs of the transparent pixel value are detected eight pixels at
+     * a time and cleared without the table lookups.
+     *
+     * @param table
+     *      Expanded colour lookup table.
+     * @param src
+     *      Pixel values.
+     * @param dst
+     *      Destination pixels.
+     * @param count
+     *      Number of pixels.
+     */
+    static void convertLine(const ExpandedClut& table,
+                            const std::uint8_t* src,
+                            PixelArgb8888* dst,
+                            std::size_t count)
+    {
+        if (table.m_transparentValue >= 0)
+        {
+            const std::uint64_t transparentWord = 0x0101010101010101ULL
+                    * static_cast<std::uint8_t>(table.m_transparentValue);
+
+            while (count >= 8)
+            {
+                std::size_t run = 0;
+                while (run + 8 <= count)
+                {
+                    std::uint64_t word;
+                    std::memcpy(&word, src + run, sizeof(word));
+                    if (word != transparentWord)
+                    {
+                        break;
+                    }
+                    run += 8;
+                }
+
+                if (run > 0)
+                {
+                    std::memset(static_cast<void*>(dst), 0, run * sizeof(PixelArgb8888));
+                }
+                else
+                {
+                    run = 8;
+                    for (std::size_t i = 0; i < run; ++i)
+                    {
+                        dst[i] = table.m_colors[src[i]];
+                    }
+                }
+
+                src += run;
+                dst += run;
+                count -= run;
+            }
+        }
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            dst[i] = table.m_colors[src[i]];
+        }
+    }
+
     /**
      * Returns pointer to line data.
      *
@@ -250,6 +357,28 @@ public:
         return ConstLineIterator(ptr, m_clut, m_clutSize);
     }
 
+private:
+    /** Colour used for pixel values outside of the lookup table. */
+    static const std::uint32_t TRANSPARENT_BLACK = 0;
+
+    /**
+     * Applies alpha premultiplication.
+     *
+     * @param color
+     *      Colour from lookup table.
+     *
+     * @return
+     *      Premultiplied pixel.
+     */
+    static PixelArgb8888 premultiply(std::uint32_t color)
+    {
+        PixelArgb8888 ret = PixelArgb8888(color);
+        ret.m_r = uint8_t(uint32_t(ret.m_r * ret.m_a) / 255);
+        ret.m_g = uint8_t(uint32_t(ret.m_g * ret.m_a) / 255);
+        ret.m_b = uint8_t(uint32_t(ret.m_b * ret.m_a) / 255);
+        return ret;
+    }
+
 private:
     /** Pixmap buffer. */
     const std::uint8_t* m_buffer;
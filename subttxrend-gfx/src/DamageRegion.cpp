@@ -0,0 +1,222 @@
+/*****************************************************************************
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:
+*
+* Copyright 2021 Liberty Global Service B.V.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*****************************************************************************/
+
+
+#include "DamageRegion.hpp"
+
+#include <algorithm>
+#include <limits>
+
+namespace subttxrend
+{
+namespace gfx
+{
+
+namespace
+{
+
+std::int64_t getArea(const Rectangle& rect)
+{
+    return static_cast<std::int64_t>(rect.m_w) * rect.m_h;
+}
+
+bool contains(const Rectangle& outer,
+              const Rectangle& inner)
+{
+    return (inner.m_x >= outer.m_x) && (inner.m_y >= outer.m_y)
+            && (inner.m_x + inner.m_w <= outer.m_x + outer.m_w)
+            && (inner.m_y + inner.m_h <= outer.m_y + outer.m_h);
+}
+
+} // namespace <anonymous>
+
+const std::size_t DamageRegion::MAX_RECTANGLES;
+
+void DamageRegion::add(const Rectangle& rect)
+{
+    if (isEmpty(rect))
+    {
+        return;
+    }
+
+    for (const auto& current : m_rectangles)
+    {
+        if (contains(current, rect))
+        {
+            return;
+        }
+    }
+
+    m_rectangles.erase(
+            std::remove_if(m_rectangles.begin(), m_rectangles.end(),
+                    [&rect](const Rectangle& current)
+                    {
+                        return contains(rect, current);
+                    }), m_rectangles.end());
+
+    m_rectangles.push_back(rect);
+
+    reduce();
+}
+
+void DamageRegion::add(const DamageRegion& region)
+{
+    for (const auto& rect : region.m_rectangles)
+    {
+        add(rect);
+    }
+}
+
+void DamageRegion::clear()
+{
+    m_rectangles.clear();
+}
+
+bool DamageRegion::isEmpty() const
+{
+    return m_rectangles.empty();
+}
+
+const std::vector<Rectangle>& DamageRegion::getRectangles() const
+{
+    return m_rectangles;
+}
+
+Rectangle DamageRegion::getBounds() const
+{
+    Rectangle bounds;
+
+    for (const auto& rect : m_rectangles)
+    {
+        bounds = unite(bounds, rect);
+    }
+
+    return bounds;
+}
+
+void DamageRegion::clip(const Rectangle& bounds)
+{
+    for (auto& rect : m_rectangles)
+    {
+        rect = intersect(rect, bounds);
+    }
+
+    m_rectangles.erase(
+            std::remove_if(m_rectangles.begin(), m_rectangles.end(),
+                    [](const Rectangle& rect)
+                    {
+                        return isEmpty(rect);
+                    }), m_rectangles.end());
+}
+
+void DamageRegion::translate(std::int32_t dx,
+                             std::int32_t dy)
+{
+    for (auto& rect : m_rectangles)
+    {
+        rect.m_x += dx;
+        rect.m_y += dy;
+    }
+}
+
+bool DamageRegion::isEmpty(const Rectangle& rect)
+{
+    return (rect.m_w <= 0) || (rect.m_h <= 0);
+}
+
+Rectangle DamageRegion::unite(const Rectangle& rect1,
+                              const Rectangle& rect2)
+{
+    if (isEmpty(rect1))
+    {
+        return isEmpty(rect2) ? Rectangle() : rect2;
+    }
+    if (isEmpty(rect2))
+    {
+        return rect1;
+    }
+
+    const auto x1 = std::min(rect1.m_x, rect2.m_x);
+    const auto y1 = std::min(rect1.m_y, rect2.m_y);
+    const auto x2 = std::max(rect1.m_x + rect1.m_w, rect2.m_x + rect2.m_w);
+    const auto y2 = std::max(rect1.m_y + rect1.m_h, rect2.m_y + rect2.m_h);
+
+    return Rectangle(x1, y1, x2 - x1, y2 - y1);
+}
+
+Rectangle DamageRegion::intersect(const Rectangle& rect1,
+                                  const Rectangle& rect2)
+{
+    const auto x1 = std::max(rect1.m_x, rect2.m_x);
+    const auto y1 = std::max(rect1.m_y, rect2.m_y);
+    const auto x2 = std::min(rect1.m_x + rect1.m_w, rect2.m_x + rect2.m_w);
+    const auto y2 = std::min(rect1.m_y + rect1.m_h, rect2.m_y + rect2.m_h);
+
+    if ((x2 <= x1) || (y2 <= y1))
+    {
+        return Rectangle();
+    }
+
+    return Rectangle(x1, y1, x2 - x1, y2 - y1);
+}
+
+void DamageRegion::reduce()
+{
+    while (m_rectangles.size() > MAX_RECTANGLES)
+    {
+        // find pair which wastes the smallest area when merged
+        std::size_t bestFirst = 0;
+        std::size_t bestSecond = 1;
+        auto bestWaste = std::numeric_limits<std::int64_t>::max();
+
+        for (std::size_t i = 0; i < m_rectangles.size(); ++i)
+        {
+            for (std::size_t j = i + 1; j < m_rectangles.size(); ++j)
+            {
+                const auto waste = getArea(unite(m_rectangles[i], m_rectangles[j]))
+                        - getArea(m_rectangles[i]) - getArea(m_rectangles[j]);
+                if (waste < bestWaste)
+                {
+                    bestWaste = waste;
+                    bestFirst = i;
+                    bestSecond = j;
+                }
+            }
+        }
+
+        const auto merged = unite(m_rectangles[bestFirst],
+                m_rectangles[bestSecond]);
+
+        m_rectangles.erase(m_rectangles.begin() + bestSecond);
+        m_rectangles.erase(m_rectangles.begin() + bestFirst);
+
+        // merged rectangle may now cover some of the remaining ones
+        m_rectangles.erase(
+                std::remove_if(m_rectangles.begin(), m_rectangles.end(),
+                        [&merged](const Rectangle& current)
+                        {
+                            return contains(merged, current);
+                        }), m_rectangles.end());
+
+        m_rectangles.push_back(merged);
+    }
+}
+
+} // namespace gfx
+} // namespace subttxrend
@@ -0,0 +1,173 @@
+/*****************************************************************************
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:
+*
+* Copyright 2021 Liberty Global Service B.V.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*****************************************************************************/
+
+
+#ifndef SUBTTXREND_GFX_DAMAGE_REGION_HPP_
+#define SUBTTXREND_GFX_DAMAGE_REGION_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Types.hpp"
+
+namespace subttxrend
+{
+namespace gfx
+{
+
+/**
+ * Damaged (modified) area.
+ *
+ * The region is stored as a short list of rectangles. The rectangles may
+ * overlap, the region only guarantees that every added area is covered.
+ * When the number of rectangles would exceed MAX_RECTANGLES the pair
+ * giving the smallest bounding box is merged, so the cost of processing
+ * the region stays constant regardless of the number of drawing operations.
+ */
+class DamageRegion
+{
+public:
+    /** Maximum number of rectangles kept. */
+    static const std::size_t MAX_RECTANGLES = 8;
+
+    /**
+     * Constructor.
+     *
+     * Creates empty region.
+     */
+    DamageRegion() = default;
+
+    /**
+     * Adds rectangle to the region.
+     *
+     * @param rect
+     *      Rectangle to add. Empty rectangles are ignored.
+     */
+    void add(const Rectangle& rect);
+
+    /**
+     * Adds other region to the region.
+     *
+     * @param region
+     *      Region to add.
+     */
+    void add(const DamageRegion& region);
+
+    /**
+     * Removes all rectangles.
+     */
+    void clear();
+
+    /**
+     * Checks if region is empty.
+     *
+     * @return
+     *      True if there are no damaged areas, false otherwise.
+     */
+    bool isEmpty() const;
+
+    /**
+     * Returns rectangles forming the region.
+     *
+     * @return
+     *      Collection of non-empty rectangles.
+     */
+    const std::vector<Rectangle>& getRectangles() const;
+
+    /**
+     * Returns bounding box of the region.
+     *
+     * @return
+     *      Bounding box (empty rectangle if region is empty).
+     */
+    Rectangle getBounds() const;
+
+    /**
+     * Limits the region to given bounds.
+     *
+     * @param bounds
+     *      Bounding rectangle.
+     */
+    void clip(const Rectangle& bounds);
+
+    /**
+     * Moves the region.
+     *
+     * @param dx
+     *      Horizontal offset.
+     * @param dy
+     *      Vertical offset.
+     */
+    void translate(std::int32_t dx,
+                   std::int32_t dy);
+
+    /**
+     * Checks if rectangle is empty.
+     *
+     * @param rect
+     *      Rectangle to check.
+     *
+     * @return
+     *      True if rectangle has no area.
+     */
+    static bool isEmpty(const Rectangle& rect);
+
+    /**
+     * Calculates bounding box of two rectangles.
+     *
+     * @param rect1
+     *      First rectangle.
+     * @param rect2
+     *      Second rectangle.
+     *
+     * @return
+     *      Smallest rectangle containing both (empty rectangles are ignored).
+     */
+    static Rectangle unite(const Rectangle& rect1,
+                           const Rectangle& rect2);
+
+    /**
+     * Calculates intersection of two rectangles.
+     *
+     * @param rect1
+     *      First rectangle.
+     * @param rect2
+     *      Second rectangle.
+     *
+     * @return
+     *      Common part (empty rectangle if rectangles do not overlap).
+     */
+    static Rectangle intersect(const Rectangle& rect1,
+                               const Rectangle& rect2);
+
+private:
+    /**
+     * Merges rectangles until limit is satisfied.
+     */
+    void reduce();
+
+    /** Rectangles forming the region. */
+    std::vector<Rectangle> m_rectangles;
+};
+
+} // namespace gfx
+} // namespace subttxrend
+
+#endif                          // SUBTTXREND_GFX_DAMAGE_REGION_HPP_
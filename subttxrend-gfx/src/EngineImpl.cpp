@@ -25,6 +25,8 @@
 #include <subttxrend/common/Logger.hpp>
 
 #include "BackendFactory.hpp"
+#include "BlendKernels.hpp"
+#include "DamageRegion.hpp"
 #include "FontStripImpl.hpp"
 
 namespace subttxrend
@@ -39,7 +41,8 @@ common::Logger g_logger("Gfx", "EngineImpl");
 
 }
 
-EngineImpl::EngineImpl()
+EngineImpl::EngineImpl() :
+        m_windowsChanged(false)
 {
     g_logger.trace("%s", __func__);
 }
@@ -58,6 +61,9 @@ void EngineImpl::init(const std::string &displayName)
 {
     g_logger.trace("%s", __func__);
 
+    g_logger.info("%s - Alpha blending kernel: %s", __func__,
+            BlendKernels::getName(BlendKernels::getActiveType()));
+
     auto backend = BackendFactory::createBackend(this);
     if (backend->init(displayName))
     {
@@ -151,6 +157,7 @@ void EngineImpl::attach(WindowPtr window)
     }
 
     m_attachedWindows.push_back(windowImpl);
+    m_windowsChanged = true;
 
     windowImpl->setEngineHooks(this);
 
@@ -176,6 +183,7 @@ void EngineImpl::detach(WindowPtr window)
     {
         windowImpl->setEngineHooks(nullptr);
         m_attachedWindows.erase(iter);
+        m_windowsChanged = true;
     }
     else
     {
@@ -221,31 +229,93 @@ void EngineImpl::unlock()
     m_mutex.unlock();
 }
 
+void EngineImpl::latchFrames()
+{
+    g_logger.trace("%s", __func__);
+
+    lock();
+
+    for (auto& window : m_attachedWindows)
+    {
+        window->latchFrame();
+    }
+
+    unlock();
+}
+
 void EngineImpl::enumerateVisibleWindows(BackendWindowEnumerator& enumerator)
 {
     g_logger.trace("%s", __func__);
 
+    // presented surfaces are modified by latchFrames() only (called by
+    // the backend thread), so composition does not block window drawing
+    std::vector<WindowImplPtr> visibleWindows;
+
     lock();
 
     for (auto& window : m_attachedWindows)
     {
         if (window->isVisible())
         {
-            const auto& pixmap = window->getPixmap();
+            visibleWindows.push_back(window);
+        }
+    }
+
+    unlock();
+
+    for (auto& window : visibleWindows)
+    {
+        const auto& pixmap = window->getPixmap();
+
+        g_logger.trace("%s -> wnd=%p pix=%dx%d", __func__, window.get(),
+            pixmap.getWidth(), pixmap.getHeight());
 
-            g_logger.trace("%s -> wnd=%p pix=%dx%d", __func__, window.get(),
-                pixmap.getWidth(), pixmap.getHeight());
-                
 #if BACKEND_TYPE == BACKEND_TYPE_EGL
-            auto& bgpixmap = window->getBgPixmap();
-            enumerator.processWindow(pixmap, bgpixmap);
+        auto& bgpixmap = window->getBgPixmap();
+        enumerator.processWindow(pixmap, bgpixmap);
 #else
-            enumerator.processWindow(pixmap);
+        enumerator.processWindow(pixmap);
 #endif
+    }
+}
+
+void EngineImpl::collectDamage(const Size& screenSize,
+                               DamageRegion& damage)
+{
+    g_logger.trace("%s", __func__);
+
+    const Rectangle screenRect{0, 0, screenSize.m_w, screenSize.m_h};
+
+    lock();
+
+    bool fullDamage = m_windowsChanged;
+    m_windowsChanged = false;
+
+    for (auto& window : m_attachedWindows)
+    {
+        DamageRegion windowDamage;
+
+        if (window->takeDamage(windowDamage))
+        {
+            fullDamage = true;
         }
+
+        const auto& pixmap = window->getPixmap();
+
+        windowDamage.translate((screenSize.m_w - pixmap.getWidth()) / 2,
+                (screenSize.m_h - pixmap.getHeight()) / 2);
+
+        damage.add(windowDamage);
     }
 
     unlock();
+
+    if (fullDamage)
+    {
+        damage.add(screenRect);
+    }
+
+    damage.clip(screenRect);
 }
 
 void EngineImpl::focusGained()
@@ -86,9 +86,14 @@ private:
 
     virtual void unlock() override;
 
+    virtual void latchFrames() override;
+
     virtual void enumerateVisibleWindows(BackendWindowEnumerator& enumerator)
             override;
 
+    virtual void collectDamage(const Size& screenSize,
+                               DamageRegion& damage) override;
+
     virtual void focusGained() override;
 
     virtual void focusLost() override;
@@ -108,6 +113,9 @@ private:
 
     /** Queue with events. */
     std::queue<KeyEvent> m_keyEventsQueue;
+
+    /** Flag indicating that set of windows changed since damage was collected. */
+    bool m_windowsChanged;
 };
 
 } // namespace gfx
@@ -0,0 +1,250 @@
+/*****************************************************************************
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:
+*
+* Copyright 2021 Liberty Global Service B.V.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*****************************************************************************/
+
+#include "FillKernels.hpp"
+
+#include <cstring>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define FILL_KERNELS_X86 1
+#include <immintrin.h>
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define FILL_KERNELS_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace subttxrend
+{
+namespace gfx
+{
+
+namespace
+{
+
+/** Kernel function type. */
+typedef void (*KernelFunction)(std::uint8_t* dst,
+                               std::uint32_t pattern,
+                               std::size_t count);
+
+void fillLineScalar(std::uint8_t* dst,
+                    std::uint32_t pattern,
+                    std::size_t count)
+{
+    const std::uint64_t wide = (static_cast<std::uint64_t>(pattern) << 32) | pattern;
+
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        std::uint8_t* wideDst = dst + i * sizeof(pattern);
+        (void) std::memcpy(wideDst + 0, &wide, sizeof(wide));
+        (void) std::memcpy(wideDst + 8, &wide, sizeof(wide));
+        (void) std::memcpy(wideDst + 16, &wide, sizeof(wide));
+        (void) std::memcpy(wideDst + 24, &wide, sizeof(wide));
+    }
+
+    for (; i < count; ++i)
+    {
+        (void) std::memcpy(dst + i * sizeof(pattern), &pattern, sizeof(pattern));
+    }
+}
+
+#if defined(FILL_KERNELS_X86)
+
+__attribute__((target("sse2")))
+void fillLineSse2(std::uint8_t* dst,
+                  std::uint32_t pattern,
+                  std::size_t count)
+{
+    const __m128i wide = _mm_set1_epi32(pattern);
+
+    std::size_t i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        __m128i* wideDst = reinterpret_cast<__m128i*>(dst + i * sizeof(pattern));
+        _mm_storeu_si128(wideDst + 0, wide);
+        _mm_storeu_si128(wideDst + 1, wide);
+        _mm_storeu_si128(wideDst + 2, wide);
+        _mm_storeu_si128(wideDst + 3, wide);
+    }
+
+    fillLineScalar(dst + i * sizeof(pattern), pattern, count - i);
+}
+
+#endif // FILL_KERNELS_X86
+
+#if defined(FILL_KERNELS_NEON)
+
+void fillLineNeon(std::uint8_t* dst,
+                  std::uint32_t pattern,
+                  std::size_t count)
+{
+    const uint32x4_t wide = vdupq_n_u32(pattern);
+
+    std::size_t i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        std::uint32_t* wideDst = reinterpret_cast<std::uint32_t*>(dst + i * sizeof(pattern));
+        vst1q_u32(wideDst + 0, wide);
+        vst1q_u32(wideDst + 4, wide);
+        vst1q_u32(wideDst + 8, wide);
+        vst1q_u32(wideDst + 12, wide);
+    }
+
+    fillLineScalar(dst + i * sizeof(pattern), pattern, count - i);
+}
+
+#endif // FILL_KERNELS_NEON
+
+KernelFunction getKernel(FillKernels::Type type)
+{
+    switch (type)
+    {
+#if defined(FILL_KERNELS_X86)
+    case FillKernels::Type::SSE2:
+        return fillLineSse2;
+#endif
+#if defined(FILL_KERNELS_NEON)
+    case FillKernels::Type::NEON:
+        return fillLineNeon;
+#endif
+    default:
+        return fillLineScalar;
+    }
+}
+
+FillKernels::Type selectType()
+{
+    if (FillKernels::isSupported(FillKernels::Type::NEON))
+    {
+        return FillKernels::Type::NEON;
+    }
+    if (FillKernels::isSupported(FillKernels::Type::SSE2))
+    {
+        return FillKernels::Type::SSE2;
+    }
+    return FillKernels::Type::SCALAR;
+}
+
+/**
+ * Fills line with given kernel.
+ *
+ * Colors with all bytes equal are filled with memset, it is faster than
+ * any of the kernels.
+ */
+void fillLineWith(KernelFunction kernel,
+                  PixelArgb8888* dst,
+                  PixelArgb8888 value,
+                  std::size_t count)
+{
+    if ((value.m_a == value.m_r) && (value.m_a == value.m_g)
+            && (value.m_a == value.m_b))
+    {
+        (void) std::memset(static_cast<void*>(dst), value.m_a, count * sizeof(PixelArgb8888));
+        return;
+    }
+
+    std::uint32_t pattern;
+    (void) std::memcpy(&pattern, &value, sizeof(pattern));
+
+    kernel(reinterpret_cast<std::uint8_t*>(dst), pattern, count);
+}
+
+} // namespace <anonymous>
+
+void FillKernels::fillLine(PixelArgb8888* dst,
+                           PixelArgb8888 value,
+                           std::size_t count)
+{
+    static const KernelFunction kernel = getKernel(getActiveType());
+
+    fillLineWith(kernel, dst, value, count);
+}
+
+void FillKernels::fillLine(Type type,
+                           PixelArgb8888* dst,
+                           PixelArgb8888 value,
+                           std::size_t count)
+{
+    fillLineWith(getKernel(type), dst, value, count);
+}
+
+void FillKernels::fillRectangle(PixelArgb8888* dst,
+                                std::size_t stride,
+                                std::size_t width,
+                                std::size_t height,
+                                PixelArgb8888 value)
+{
+    if (stride == width * sizeof(PixelArgb8888))
+    {
+        fillLine(dst, value, width * height);
+        return;
+    }
+
+    std::uint8_t* line = reinterpret_cast<std::uint8_t*>(dst);
+    for (std::size_t y = 0; y < height; ++y)
+    {
+        fillLine(reinterpret_cast<PixelArgb8888*>(line), value, width);
+        line += stride;
+    }
+}
+
+bool FillKernels::isSupported(Type type)
+{
+    switch (type)
+    {
+    case Type::SCALAR:
+        return true;
+#if defined(FILL_KERNELS_X86)
+    case Type::SSE2:
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("sse2");
+#endif
+#if defined(FILL_KERNELS_NEON)
+    case Type::NEON:
+        return true;
+#endif
+    default:
+        return false;
+    }
+}
+
+FillKernels::Type FillKernels::getActiveType()
+{
+    static const Type type = selectType();
+    return type;
+}
+
+const char* FillKernels::getName(Type type)
+{
+    switch (type)
+    {
+    case Type::SCALAR:
+        return "scalar";
+    case Type::SSE2:
+        return "sse2";
+    case Type::NEON:
+        return "neon";
+    }
+    return "unknown";
+}
+
+} // namespace gfx
+} // namespace subttxrend
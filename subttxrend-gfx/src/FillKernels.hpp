@@ -0,0 +1,143 @@
+/*****************************************************************************
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:
+*
+* Copyright 2021 Liberty Global Service B.V.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*****************************************************************************/
+
+#ifndef SUBTTXREND_GFX_FILL_KERNELS_HPP_
+#define SUBTTXREND_GFX_FILL_KERNELS_HPP_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "Pixel.hpp"
+
+namespace subttxrend
+{
+namespace gfx
+{
+
+/**
+ * Pixel fill kernels.
+ *
+ * Colors with all bytes equal (e.g. transparent) are filled with memset,
+ * other colors with wide stores of a repeated pixel pattern. The wide
+ * store kernel is selected once at runtime, the scalar kernel is used as
+ * a fallback and for the line tails. Rectangles covering whole lines of
+ * a buffer without padding are filled at once.
+ */
+class FillKernels
+{
+public:
+    /**
+     * Kernel type.
+     */
+    enum class Type
+    {
+        /** Portable scalar implementation (64-bit stores). */
+        SCALAR,
+        /** x86 SSE2 implementation (128-bit stores). */
+        SSE2,
+        /** ARM NEON implementation (128-bit stores). */
+        NEON
+    };
+
+    /**
+     * Fills line of pixels using the best kernel available.
+     *
+     * @param dst
+     *      Destination pixels.
+     * @param value
+     *      Fill color.
+     * @param count
+     *      Number of pixels.
+     */
+    static void fillLine(PixelArgb8888* dst,
+                         PixelArgb8888 value,
+                         std::size_t count);
+
+    /**
+     * Fills line of pixels using given kernel.
+     *
+     * @param type
+     *      Kernel to use. Must be supported (see isSupported()).
+     * @param dst
+     *      Destination pixels.
+     * @param value
+     *      Fill color.
+     * @param count
+     *      Number of pixels.
+     */
+    static void fillLine(Type type,
+                         PixelArgb8888* dst,
+                         PixelArgb8888 value,
+                         std::size_t count);
+
+    /**
+     * Fills rectangle of pixels using the best kernel available.
+     *
+     * @param dst
+     *      Pointer to first pixel of the rectangle.
+     * @param stride
+     *      Line stride in bytes.
+     * @param width
+     *      Rectangle width in pixels.
+     * @param height
+     *      Rectangle height in lines.
+     * @param value
+     *      Fill color.
+     */
+    static void fillRectangle(PixelArgb8888* dst,
+                              std::size_t stride,
+                              std::size_t width,
+                              std::size_t height,
+                              PixelArgb8888 value);
+
+    /**
+     * Checks if kernel could be used on this machine.
+     *
+     * @param type
+     *      Kernel type.
+     *
+     * @return
+     *      True if kernel is compiled in and supported by the CPU.
+     */
+    static bool isSupported(Type type);
+
+    /**
+     * Returns kernel selected for fillLine() and fillRectangle().
+     *
+     * @return
+     *      Kernel type.
+     */
+    static Type getActiveType();
+
+    /**
+     * Returns kernel name.
+     *
+     * @param type
+     *      Kernel type.
+     *
+     * @return
+     *      Kernel name.
+     */
+    static const char* getName(Type type);
+};
+
+} // namespace gfx
+} // namespace subttxrend
+
+#endif                          // SUBTTXREND_GFX_FILL_KERNELS_HPP_
@@ -0,0 +1,249 @@
+/*****************************************************************************
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:
+*
+* Copyright 2021 Liberty Global Service B.V.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*****************************************************************************/
+
+#ifndef SUBTTXREND_GFX_GLYPH_INFO_MAP_HPP_
+#define SUBTTXREND_GFX_GLYPH_INFO_MAP_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace subttxrend
+{
+namespace gfx
+{
+
+/**
+ * Map from glyph index to glyph information.
+ *
+ * Glyph lookup is done for every drawn glyph on every redraw, so the map
+ * avoids node based containers. Low glyph indices (where fonts usually
+ * keep ASCII and Latin-1 characters) are stored in a directly indexed
+ * array, all other indices go to an open addressing (linear probing)
+ * hash table.
+ *
+ * Entries are never removed one by one, only whole map could be cleared.
+ *
+ * @note Pointers returned by find() and insert() are valid only until
+ *       the next insert() or clear() call.
+ */
+template<typename Value>
+class GlyphInfoMap
+{
+public:
+    /** Number of directly indexed keys. */
+    static const std::uint32_t DIRECT_SIZE = 256;
+
+    /**
+     * Constructor.
+     *
+     * Creates empty map.
+     */
+    GlyphInfoMap() :
+            m_direct(DIRECT_SIZE),
+            m_slots(INITIAL_CAPACITY),
+            m_hashedCount(0),
+            m_size(0)
+    {
+        // noop
+    }
+
+    /**
+     * Looks up value.
+     *
+     * @param key
+     *      Glyph index.
+     *
+     * @return
+     *      Pointer to value if found, null pointer otherwise.
+     */
+    Value* find(std::uint32_t key)
+    {
+        if (key < DIRECT_SIZE)
+        {
+            auto& slot = m_direct[key];
+            return slot.m_used ? &slot.m_value : nullptr;
+        }
+
+        const std::size_t mask = m_slots.size() - 1;
+        for (std::size_t i = hash(key) & mask;; i = (i + 1) & mask)
+        {
+            auto& slot = m_slots[i];
+            if (!slot.m_used)
+            {
+                return nullptr;
+            }
+            if (slot.m_key == key)
+            {
+                return &slot.m_value;
+            }
+        }
+    }
+
+    /**
+     * Inserts value.
+     *
+     * If the key is already present the stored value is replaced.
+     *
+     * @param key
+     *      Glyph index.
+     * @param value
+     *      Value to store.
+     *
+     * @return
+     *      Pointer to stored value.
+     */
+    Value* insert(std::uint32_t key,
+                  const Value& value)
+    {
+        if (key < DIRECT_SIZE)
+        {
+            auto& slot = m_direct[key];
+            if (!slot.m_used)
+            {
+                slot.m_used = true;
+                ++m_size;
+            }
+            slot.m_value = value;
+            return &slot.m_value;
+        }
+
+        // keep load factor below 1/2, probe sequences stay short
+        if ((m_hashedCount + 1) * 2 > m_slots.size())
+        {
+            rehash(m_slots.size() * 2);
+        }
+
+        auto& slot = findSlot(m_slots, key);
+        if (!slot.m_used)
+        {
+            slot.m_used = true;
+            slot.m_key = key;
+            ++m_hashedCount;
+            ++m_size;
+        }
+        slot.m_value = value;
+        return &slot.m_value;
+    }
+
+    /**
+     * Removes all entries.
+     */
+    void clear()
+    {
+        m_direct.assign(DIRECT_SIZE, Slot());
+        m_slots.assign(INITIAL_CAPACITY, Slot());
+        m_hashedCount = 0;
+        m_size = 0;
+    }
+
+    /**
+     * Returns number of entries.
+     *
+     * @return
+     *      Number of entries.
+     */
+    std::size_t size() const
+    {
+        return m_size;
+    }
+
+private:
+    /** Initial hash table capacity (power of two). */
+    static const std::size_t INITIAL_CAPACITY = 64;
+
+    /** Table slot. */
+    struct Slot
+    {
+        /** Value. */
+        Value m_value{};
+
+        /** Key (used by hash table slots only). */
+        std::uint32_t m_key{};
+
+        /** Slot used flag. */
+        bool m_used{false};
+    };
+
+    /**
+     * Hashes the key.
+     *
+     * Glyph indices are dense, multiplicative hashing spreads them well.
+     */
+    static std::size_t hash(std::uint32_t key)
+    {
+        return static_cast<std::size_t>((key * 0x9E3779B1u) >> 7);
+    }
+
+    /**
+     * Finds slot for given key (either matching or first free one).
+     */
+    static Slot& findSlot(std::vector<Slot>& slots,
+                          std::uint32_t key)
+    {
+        const std::size_t mask = slots.size() - 1;
+        for (std::size_t i = hash(key) & mask;; i = (i + 1) & mask)
+        {
+            auto& slot = slots[i];
+            if (!slot.m_used || (slot.m_key == key))
+            {
+                return slot;
+            }
+        }
+    }
+
+    /**
+     * Rebuilds hash table with new capacity.
+     */
+    void rehash(std::size_t capacity)
+    {
+        std::vector<Slot> slots(capacity);
+        for (auto& slot : m_slots)
+        {
+            if (slot.m_used)
+            {
+                findSlot(slots, slot.m_key) = std::move(slot);
+            }
+        }
+        m_slots.swap(slots);
+    }
+
+    /** Directly indexed slots. */
+    std::vector<Slot> m_direct;
+
+    /** Hash table slots. */
+    std::vector<Slot> m_slots;
+
+    /** Number of entries in hash table. */
+    std::size_t m_hashedCount;
+
+    /** Total number of entries. */
+    std::size_t m_size;
+};
+
+template<typename Value>
+const std::uint32_t GlyphInfoMap<Value>::DIRECT_SIZE;
+
+template<typename Value>
+const std::size_t GlyphInfoMap<Value>::INITIAL_CAPACITY;
+
+} // namespace gfx
+} // namespace subttxrend
+
+#endif                          // SUBTTXREND_GFX_GLYPH_INFO_MAP_HPP_
@@ -242,6 +242,17 @@ public:
         return m_height;
     }
 
+    /**
+     * Returns stride.
+     *
+     * @return
+     *      Line stride in bytes.
+     */
+    std::uint32_t getStride() const
+    {
+        return m_stride;
+    }
+
     /**
      * Returns pointer to line data.
      *
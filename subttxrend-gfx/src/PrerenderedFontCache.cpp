@@ -20,38 +20,251 @@
 
 #include "PrerenderedFontImpl.hpp"
 
+#include <algorithm>
 #include <map>
 #include <string>
 #include <utility>
 
+#include <subttxrend/common/Logger.hpp>
+
 #include "FontStripImpl.hpp"
 
+namespace
+{
+subttxrend::common::Logger g_logger("Gfx", "PrerenderedFontCache");
+}
+
 namespace subttxrend
 {
 namespace gfx
 {
 
+const std::size_t PrerenderedFontCache::DEFAULT_BYTE_BUDGET;
+
+PrerenderedFontCache::PrerenderedFontCache(std::size_t byteBudget)
+        : m_byteBudget(byteBudget)
+{
+    // noop
+}
+
+PrerenderedFontCache::~PrerenderedFontCache()
+{
+    stopPrewarm();
+}
+
 std::shared_ptr<PrerenderedFont> PrerenderedFontCache::getFont(const std::string& fontName, int faceHeight, bool strictHeight, bool italics)
 {
     auto fontKey = std::make_tuple(fontName, Height{faceHeight, strictHeight}, italics);
+
+    std::lock_guard<std::mutex> lock{m_mutex};
+
     auto iter = m_fontPathAndSizeToFont.find(fontKey);
     
     if (iter == m_fontPathAndSizeToFont.end())
     {
         std::string fontPath = FontStripImpl::findFontFile(fontName.c_str());
         auto newFont = std::make_shared<PrerenderedFontImpl>(fontPath.c_str(), faceHeight, strictHeight, italics);
-        m_fontPathAndSizeToFont[fontKey] = newFont;
+        insertFont(fontKey, newFont, true);
         return newFont;
     }
     else
     {
-        return iter->second;
+        // move to front (most recently used), fonts grow while used so
+        // the usage is updated and the budget checked on every access
+        m_entries.splice(m_entries.begin(), m_entries, iter->second);
+        updateMemoryUsage(m_entries.front());
+        evict();
+        return m_entries.front().font;
     }
 }
 
 void PrerenderedFontCache::clear()
 {
+    std::lock_guard<std::mutex> lock{m_mutex};
     m_fontPathAndSizeToFont.clear();
+    m_entries.clear();
+    m_memoryUsage = 0;
+}
+
+void PrerenderedFontCache::setByteBudget(std::size_t byteBudget)
+{
+    std::lock_guard<std::mutex> lock{m_mutex};
+    m_byteBudget = byteBudget;
+    evict();
+}
+
+std::size_t PrerenderedFontCache::getMemoryUsage() const
+{
+    std::lock_guard<std::mutex> lock{m_mutex};
+    return m_memoryUsage;
+}
+
+std::vector<PrerenderedFontCache::FontStatistics> PrerenderedFontCache::getStatistics() const
+{
+    std::lock_guard<std::mutex> lock{m_mutex};
+
+    std::vector<FontStatistics> statistics;
+    statistics.reserve(m_entries.size());
+
+    for (const auto& entry : m_entries)
+    {
+        FontStatistics fontStatistics;
+        fontStatistics.fontName = std::get<0>(entry.key);
+        fontStatistics.faceHeight = std::get<1>(entry.key).height;
+        fontStatistics.strictHeight = std::get<1>(entry.key).strict;
+        fontStatistics.italics = std::get<2>(entry.key);
+        fontStatistics.atlasPages = entry.font->getAtlasPageCount();
+        fontStatistics.memoryUsage = entry.font->getMemoryUsage();
+        statistics.push_back(fontStatistics);
+    }
+    return statistics;
+}
+
+void PrerenderedFontCache::prewarm(std::vector<PrewarmFont> fonts,
+                                   std::vector<std::uint32_t> codepoints)
+{
+    stopPrewarm();
+
+    if (fonts.empty() || codepoints.empty())
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        ++m_prewarmStatistics.requests;
+    }
+
+    m_prewarmCancelled = false;
+    m_prewarmThread = std::thread(&PrerenderedFontCache::prewarmThread, this,
+            std::move(fonts), std::move(codepoints));
+}
+
+PrerenderedFontCache::PrewarmStatistics PrerenderedFontCache::getPrewarmStatistics() const
+{
+    std::lock_guard<std::mutex> lock{m_mutex};
+    return m_prewarmStatistics;
+}
+
+bool PrerenderedFontCache::insertFont(const FontKey& key,
+                                      std::shared_ptr<PrerenderedFontImpl> font,
+                                      bool mostRecentlyUsed)
+{
+    if (m_fontPathAndSizeToFont.count(key) != 0)
+    {
+        return false;
+    }
+
+    auto position = mostRecentlyUsed ? m_entries.begin() : m_entries.end();
+    const auto memoryUsage = font->getMemoryUsage();
+    auto entry = m_entries.insert(position, Entry{key, std::move(font), memoryUsage});
+    m_fontPathAndSizeToFont.emplace(key, entry);
+    m_memoryUsage += memoryUsage;
+
+    evict();
+
+    return m_fontPathAndSizeToFont.count(key) != 0;
+}
+
+void PrerenderedFontCache::updateMemoryUsage(Entry& entry)
+{
+    const auto memoryUsage = entry.font->getMemoryUsage();
+
+    m_memoryUsage = m_memoryUsage - entry.memoryUsage + memoryUsage;
+    entry.memoryUsage = memoryUsage;
+}
+
+void PrerenderedFontCache::evict()
+{
+    // the most recently used font is kept even if it alone exceeds the budget
+    while ((m_entries.size() > 1) && (m_memoryUsage > m_byteBudget))
+    {
+        auto& last = m_entries.back();
+
+        g_logger.info("%s evicting font '%s' (%d) pages: %zu bytes: %zu, cache bytes: %zu budget: %zu",
+                __LOGGER_FUNC__, std::get<0>(last.key).c_str(), std::get<1>(last.key).height,
+                last.font->getAtlasPageCount(), last.memoryUsage, m_memoryUsage, m_byteBudget);
+
+        m_memoryUsage -= last.memoryUsage;
+
+        m_fontPathAndSizeToFont.erase(last.key);
+        m_entries.pop_back();
+    }
+}
+
+void PrerenderedFontCache::stopPrewarm()
+{
+    if (m_prewarmThread.joinable())
+    {
+        m_prewarmCancelled = true;
+        m_prewarmThread.join();
+    }
+}
+
+void PrerenderedFontCache::prewarmThread(std::vector<PrewarmFont> fonts,
+                                         std::vector<std::uint32_t> codepoints)
+{
+    const auto startTime = std::chrono::steady_clock::now();
+    std::size_t fontCount = 0;
+    std::size_t glyphCount = 0;
+
+    for (const auto& font : fonts)
+    {
+        if (m_prewarmCancelled)
+        {
+            break;
+        }
+
+        auto fontKey = std::make_tuple(font.fontName, Height{font.faceHeight, font.strictHeight}, font.italics);
+        {
+            std::lock_guard<std::mutex> lock{m_mutex};
+            if (m_fontPathAndSizeToFont.count(fontKey) != 0)
+            {
+                continue;
+            }
+        }
+
+        try
+        {
+            std::string fontPath = FontStripImpl::findFontFile(font.fontName.c_str());
+            auto newFont = std::make_shared<PrerenderedFontImpl>(fontPath.c_str(),
+                    font.faceHeight, font.strictHeight, font.italics);
+
+            glyphCount += newFont->prerenderGlyphs(codepoints, font.outlineSize, m_prewarmCancelled);
+
+            // font requested by the rendering thread meanwhile wins,
+            // prewarmed fonts only use spare budget (inserted as least
+            // recently used, so they are evicted before the fonts in use)
+            std::lock_guard<std::mutex> lock{m_mutex};
+            if (insertFont(fontKey, std::move(newFont), false))
+            {
+                ++fontCount;
+            }
+        }
+        catch (const std::exception& e)
+        {
+            g_logger.warning("%s font '%s' (%d) failed: %s", __LOGGER_FUNC__,
+                    font.fontName.c_str(), font.faceHeight, e.what());
+        }
+    }
+
+    const auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - startTime);
+
+    {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        if (!m_prewarmCancelled)
+        {
+            ++m_prewarmStatistics.completed;
+        }
+        m_prewarmStatistics.fonts = fontCount;
+        m_prewarmStatistics.glyphs = glyphCount;
+        m_prewarmStatistics.duration = duration;
+    }
+
+    g_logger.info("%s %s: fonts: %zu glyphs: %zu time: %lld ms", __LOGGER_FUNC__,
+            m_prewarmCancelled ? "cancelled" : "done",
+            fontCount, glyphCount, static_cast<long long>(duration.count()));
 }
 
 
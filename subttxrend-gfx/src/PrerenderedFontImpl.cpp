@@ -25,7 +25,6 @@
 
 #include <cmath>
 #include <cwctype>
-#include <functional>
 #include <map>
 #include <memory>
 
@@ -44,6 +43,8 @@ namespace gfx
 
 PrerenderedFontImpl::~PrerenderedFontImpl()
 {
+    hb_buffer_destroy(m_hbBuffer);
+    hb_font_destroy(m_hbFont);
     FT_Done_Face(face);
     FT_Stroker_Done(stroker);
 }
@@ -92,23 +93,40 @@ void PrerenderedFontImpl::render(ftcpp::Library &ftcpplib,
 
 void PrerenderedFontImpl::addAtlasPage()
 {
-    atlasPages.emplace_back();
-    atlasPages.back().surface->resize(ATLAS_PAGE_WIDTH, ATLAS_PAGE_HEIGHT, 0);
+    atlasPages.emplace_back(m_atlasPageSize);
+    atlasPages.back().surface->resize(m_atlasPageSize, m_atlasPageSize, 0);
+    m_atlasPageCount = atlasPages.size();
 }
 
-void PrerenderedFontImpl::renderToAtlasPage(CharacterInformation &charInfo, AtlasPage &page,
-                                            const FT_Bitmap &glyphBitmap, int bitmapLeft, int bitmapTop)
+std::size_t PrerenderedFontImpl::getAtlasPageCount() const
+{
+    return m_atlasPageCount;
+}
+
+std::size_t PrerenderedFontImpl::getMemoryUsage() const
+{
+    // alpha surface, one byte per pixel
+    const auto pageSize = static_cast<std::size_t>(m_atlasPageSize);
+    return m_atlasPageCount * pageSize * pageSize;
+}
+
+std::int32_t PrerenderedFontImpl::calculateAtlasPageSize(std::int32_t fontHeight)
 {
-    if (page.currentRowWidth + glyphBitmap.width + 1 >= ATLAS_PAGE_WIDTH)
+    std::int32_t size = ATLAS_PAGE_MIN_SIZE;
+    while ((size < ATLAS_PAGE_MAX_SIZE) && (size < fontHeight * ATLAS_PAGE_GLYPHS_PER_SIDE))
     {
-        page.currentRowY += page.currentRowHeight;
-        page.currentRowWidth = 0;
-        page.currentRowHeight = 0;
+        size *= 2;
     }
+    return size;
+}
 
+void PrerenderedFontImpl::renderToAtlasPage(CharacterInformation &charInfo, AtlasPage &page,
+                                            std::int32_t atlasX, std::int32_t atlasY,
+                                            const FT_Bitmap &glyphBitmap, int bitmapLeft, int bitmapTop)
+{
     Rectangle renderRect = {
-            page.currentRowWidth,
-            page.currentRowY,
+            atlasX,
+            atlasY,
             static_cast<std::int32_t>(glyphBitmap.width),
             static_cast<std::int32_t>(glyphBitmap.rows) };
 
@@ -125,22 +143,15 @@ void PrerenderedFontImpl::renderToAtlasPage(CharacterInformation &charInfo, Atla
     charInfo.atlasXOffset = renderRect.m_x;
     charInfo.atlasYOffset = renderRect.m_y;
 
-    page.currentRowHeight = std::max(page.currentRowHeight, static_cast<int>(glyphBitmap.rows));
-    page.currentRowWidth += glyphBitmap.width + 1;
+    charInfo.surface = page.surface.get();
 }
 
 const CharacterInformation *PrerenderedFontImpl::getCharInfo(std::uint32_t glyphIndex, int outlineSize)
 {
-    if (outlineSize <= 0) {
-        auto ci = characterInfosCache.find(glyphIndex);
-        if (ci != characterInfosCache.end()) {
-            return &ci->second;
-        }
-    } else {
-        auto ci = outlineInfosCache.find(glyphIndex);
-        if (ci != outlineInfosCache.end()) {
-            return &ci->second;
-        }
+    auto& infosCache = (outlineSize <= 0) ? characterInfosCache : outlineInfosCache;
+
+    if (auto ci = infosCache.find(glyphIndex)) {
+        return ci;
     }
 
     std::unique_ptr<ftcpp::Bitmap> bitmapPtr = freetypeLib->newBitmap();
@@ -191,50 +202,70 @@ const CharacterInformation *PrerenderedFontImpl::getCharInfo(std::uint32_t glyph
         bitmapTop = face->glyph->bitmap_top;
     }
 
-    if (bitmap->width > ATLAS_PAGE_WIDTH) {
+    if (bitmap->width >= static_cast<unsigned>(m_atlasPageSize)) {
         g_logger.warning("Loading character at idx %d : too wide for atlas page!", glyphIndex);
         return nullptr;
     }
 
-    if (std::size_t(bitmap->rows) > ATLAS_PAGE_HEIGHT) {
+    if (bitmap->rows >= static_cast<unsigned>(m_atlasPageSize)) {
         g_logger.warning("Loading character at idx %d : too high for atlas page!", glyphIndex);
         return nullptr;
     }
 
-    const AtlasPage &page = atlasPages.back();
+    // one pixel gap between glyphs
+    const std::int32_t packWidth = bitmap->width + 1;
+    const std::int32_t packHeight = bitmap->rows + 1;
+    std::int32_t atlasX = 0;
+    std::int32_t atlasY = 0;
 
-    int rowHeight = page.currentRowHeight;
-    int rowY = page.currentRowY;
-    int rowWidth = page.currentRowWidth;
-
-    if (rowWidth + bitmap->width + 1 >= ATLAS_PAGE_WIDTH) {
-        rowY += rowHeight;
-    }
-
-    if (rowY + bitmap->rows + 1 >= ATLAS_PAGE_HEIGHT) {
-        // need new atlas page, this one will not fit
+    if (!atlasPages.back().packer.pack(packWidth, packHeight, atlasX, atlasY)) {
+        // need new atlas page, this one is full
         addAtlasPage();
+        atlasPages.back().packer.pack(packWidth, packHeight, atlasX, atlasY);
     }
 
-    CharacterInformation* charInfo {nullptr};
-    if (outlineSize > 0) {
-        auto outlineInfoIt = outlineInfosCache.emplace(glyphIndex, CharacterInformation()).first;
-        charInfo = &(outlineInfoIt->second);
-    } else {
-        auto charInfoIt = characterInfosCache.emplace(glyphIndex, CharacterInformation()).first;
-        charInfo = &(charInfoIt->second);
-    }
+    CharacterInformation charInfo;
 
     try {
-        renderToAtlasPage(*charInfo, atlasPages.back(), *bitmap, bitmapLeft, bitmapTop);
+        renderToAtlasPage(charInfo, atlasPages.back(), atlasX, atlasY, *bitmap, bitmapLeft, bitmapTop);
     }  catch (ftcpp::Exception& ex) {
         g_logger.warning("rendering glyph at idx %d: failed. Exception: %s", glyphIndex, ex.what());
         return nullptr;
     }
 
-    charInfo->surface = atlasPages.back().surface.get();
+    return infosCache.insert(glyphIndex, charInfo);
+}
+
+std::size_t PrerenderedFontImpl::prerenderGlyphs(const std::vector<std::uint32_t>& codepoints,
+                                                 int outlineSize,
+                                                 const std::atomic_bool& cancelled)
+{
+    std::size_t count = 0;
+
+    for (auto codepoint : codepoints)
+    {
+        if (cancelled)
+        {
+            break;
+        }
+
+        const std::uint32_t glyphIndex = FT_Get_Char_Index(face, codepoint);
+        if (glyphIndex == 0)
+        {
+            continue;
+        }
+
+        if (getCharInfo(glyphIndex, 0))
+        {
+            ++count;
+        }
+        if ((outlineSize > 0) && getCharInfo(glyphIndex, outlineSize))
+        {
+            ++count;
+        }
+    }
 
-    return charInfo;
+    return count;
 }
 
 PrerenderedFontImpl::PrerenderedFontImpl(const char *fontFilePath, int height, bool strict, bool italics)
@@ -301,8 +332,6 @@ PrerenderedFontImpl::PrerenderedFontImpl(const char *fontFilePath, int height, b
        FT_Set_Pixel_Sizes(face, 0, height);
     }
 
-    addAtlasPage();
-
     m_fontHeight = static_cast<std::int32_t>(std::ceil(face->size->metrics.height  / 64.f));
     m_maxAdvance = static_cast<std::int32_t>(std::ceil(face->size->metrics.max_advance / 64.f));
 
@@ -319,14 +348,22 @@ PrerenderedFontImpl::PrerenderedFontImpl(const char *fontFilePath, int height, b
         m_descender = 0;
     }
 
-    g_logger.info("%s path: %s requestHeight: %d(strict=%d) fontHeight: %d ascender: %d descender: %d italics: %s",
+    m_atlasPageSize = calculateAtlasPageSize(m_fontHeight);
+    addAtlasPage();
+
+    // created after the size is selected, harfbuzz takes the scale from the face
+    m_hbFont = hb_ft_font_create(face, nullptr);
+    m_hbBuffer = hb_buffer_create();
+
+    g_logger.info("%s path: %s requestHeight: %d(strict=%d) fontHeight: %d ascender: %d descender: %d italics: %s atlasPageSize: %d",
         __LOGGER_FUNC__,
         fontFilePath,
         height,
         strict,
         getFontHeight(),
         getFontAscender(), getFontDescender(),
-        italics ? "true" : "false");
+        italics ? "true" : "false",
+        m_atlasPageSize);
 }
 
 bool PrerenderedFontImpl::isWhite(uint32_t codepoint)
@@ -346,23 +383,26 @@ bool PrerenderedFontImpl::isBreakline(uint32_t codepoint)
         codepoint == 0x2029;
 }
 
-// TODO: not really well tested
 std::vector<TextTokenData> PrerenderedFontImpl::textToTokens(const std::string &str)
 {
-    std::unique_ptr<hb_buffer_t, std::function<void(hb_buffer_t *)>> buf_guard = {
-        hb_buffer_create(),
-        [](hb_buffer_t *buf) {
-            hb_buffer_destroy(buf);
-        }};
-    hb_buffer_t *buf = buf_guard.get();
-
-    // TODO: keep the font, do not recreate at each call (?)
-    std::unique_ptr<hb_font_t, std::function<void(hb_font_t *)>> hb_ft_font_guard = {
-        hb_ft_font_create(face, nullptr),
-        [](hb_font_t *font) {
-            hb_font_destroy(font);
-        }};
-    hb_font_t *hb_ft_font = hb_ft_font_guard.get();
+    if (auto cachedTokens = m_shapingCache.find(str))
+    {
+        return *cachedTokens;
+    }
+
+    auto tokens = shapeText(str);
+    m_shapingCache.insert(str, tokens);
+
+    return tokens;
+}
+
+// TODO: not really well tested
+std::vector<TextTokenData> PrerenderedFontImpl::shapeText(const std::string &str)
+{
+    hb_buffer_t *buf = m_hbBuffer;
+
+    // keeps the allocated memory for the next call
+    hb_buffer_clear_contents(buf);
 
     auto len = strlen(str.c_str());
 
@@ -388,7 +428,7 @@ std::vector<TextTokenData> PrerenderedFontImpl::textToTokens(const std::string &
         clusterToCodepoint[glyphInfo[i].cluster] = glyphInfo[i].codepoint;
     }
 
-    hb_shape(hb_ft_font, buf, NULL, 0);
+    hb_shape(m_hbFont, buf, NULL, 0);
 
     // fetch the buffer again; 'codepoint' should now be 'glyph index' (after shaping)
     glyphInfo = hb_buffer_get_glyph_infos(buf, &glyphCount);
@@ -21,7 +21,7 @@
 #ifndef ATLAS_FONT_IMPL_H__
 #define ATLAS_FONT_IMPL_H__
 
-#include <map>
+#include <atomic>
 #include <memory>
 #include <vector>
 
@@ -29,8 +29,13 @@
 #include FT_FREETYPE_H
 #include FT_STROKER_H
 
+#include <hb.h>
+
 #include "PrerenderedFont.hpp"
 
+#include "GlyphInfoMap.hpp"
+#include "ShapingCache.hpp"
+#include "SkylinePacker.hpp"
 #include "Surface.hpp"
 #include <Types.hpp>
 
@@ -117,10 +122,52 @@ public:
      *      Outline size in pixels.
      *
      * @return
-     *      Character info for given char.
+     *      Character info for given char. The pointer is valid until
+     *      the next call.
      */
     const CharacterInformation* getCharInfo(std::uint32_t codepoint, int outlineSize);
 
+    /**
+     * Prerenders glyphs for given characters.
+     *
+     * Used to move rasterization cost out of the first draw. Characters
+     * not available in the font are skipped.
+     *
+     * @param codepoints
+     *      Unicode codepoints of characters to prerender.
+     * @param outlineSize
+     *      Outline size in pixels, outline glyphs are prerendered too
+     *      if greater than zero.
+     * @param cancelled
+     *      Flag checked between glyphs, prerendering stops when set.
+     *
+     * @return
+     *      Number of glyphs prerendered.
+     */
+    std::size_t prerenderGlyphs(const std::vector<std::uint32_t>& codepoints,
+                                int outlineSize,
+                                const std::atomic_bool& cancelled);
+
+    /**
+     * Returns number of atlas pages.
+     *
+     * May be called from any thread.
+     *
+     * @return
+     *      Number of atlas pages allocated.
+     */
+    std::size_t getAtlasPageCount() const;
+
+    /**
+     * Returns memory used by atlas pages.
+     *
+     * May be called from any thread.
+     *
+     * @return
+     *      Number of bytes used by atlas surfaces.
+     */
+    std::size_t getMemoryUsage() const;
+
 private:
 
     /**
@@ -128,8 +175,9 @@ private:
      */
     struct AtlasPage
     {
-        AtlasPage() :
-                surface(new AlphaSurface())
+        AtlasPage(std::int32_t size) :
+                surface(new AlphaSurface()),
+                packer(size, size)
         {
             // noop
         }
@@ -137,14 +185,8 @@ private:
         /** Surface where font is rendered. */
         std::unique_ptr<AlphaSurface> surface;
 
-        /** Current row height. */
-        int currentRowHeight = 0;
-
-        /** Current row. */
-        int currentRowY = 0;
-
-        /** Current row width. */
-        int currentRowWidth = 0;
+        /** Allocator of the page area. */
+        SkylinePacker packer;
     };
 
     /**
@@ -171,19 +213,47 @@ private:
     void addAtlasPage();
 
     /**
-     * Renders the bitmap currently loaded via FT_Load_Char.
+     * Renders the glyph bitmap to the atlas page.
      *
      * @param charInfo
      *      Character information.
      * @param page
      *      Atlas page to add to.
+     * @param atlasX
+     *      Position in atlas page.
+     * @param atlasY
+     *      Position in atlas page.
      */
     void renderToAtlasPage(CharacterInformation &charInfo,
                            AtlasPage &page,
+                           std::int32_t atlasX,
+                           std::int32_t atlasY,
                            const FT_Bitmap &glyphBitmap,
                            int bitmapLeft,
                            int bitmapTop);
 
+    /**
+     * Calculates atlas page size for given font height.
+     *
+     * @param fontHeight
+     *      Font height in pixels.
+     *
+     * @return
+     *      Page width and height in pixels.
+     */
+    static std::int32_t calculateAtlasPageSize(std::int32_t fontHeight);
+
+    /**
+     * Shapes text and splits it into tokens.
+     *
+     * @param str
+     *      Text to shape (UTF-8).
+     *
+     * @return
+     *      Text tokens.
+     */
+    std::vector<TextTokenData> shapeText(const std::string &str);
+
     /**
      * Is given codepoint whitespace.
      *
@@ -202,16 +272,21 @@ private:
      */
     bool isBreakline(uint32_t codepoint);
 
-    // TODO: make that dependant of font size
     enum
     {
-        ATLAS_PAGE_WIDTH = 128,
-        ATLAS_PAGE_HEIGHT = 128
+        /** Number of glyphs (font height squares) along atlas page side. */
+        ATLAS_PAGE_GLYPHS_PER_SIDE = 10,
+        /** Minimum atlas page size. */
+        ATLAS_PAGE_MIN_SIZE = 128,
+        /** Maximum atlas page size. */
+        ATLAS_PAGE_MAX_SIZE = 1024
     };
 
-    // TODO: maybe unordered/hashset?
-    std::map<uint32_t, CharacterInformation> characterInfosCache;
-    std::map<uint32_t, CharacterInformation> outlineInfosCache;
+    /** Prerendered glyphs. */
+    GlyphInfoMap<CharacterInformation> characterInfosCache;
+
+    /** Prerendered outline glyphs. */
+    GlyphInfoMap<CharacterInformation> outlineInfosCache;
 
 
     /** Font face. */
@@ -220,6 +295,15 @@ private:
     /** Font stroker. */
     FT_Stroker stroker;
 
+    /** HarfBuzz font created for the face. */
+    hb_font_t *m_hbFont = nullptr;
+
+    /** HarfBuzz buffer reused between shaping calls. */
+    hb_buffer_t *m_hbBuffer = nullptr;
+
+    /** Shaping results of recently used texts. */
+    ShapingCache m_shapingCache;
+
     /** Font height. */
     std::int32_t m_fontHeight;
 
@@ -232,9 +316,15 @@ private:
     /** Font ascender. */
     std::int32_t m_ascender;
 
+    /** Atlas page width and height. */
+    std::int32_t m_atlasPageSize = ATLAS_PAGE_MIN_SIZE;
+
     /** Collection of atlas pages. */
     std::vector<AtlasPage> atlasPages;
 
+    /** Number of atlas pages (readable without synchronization). */
+    std::atomic<std::size_t> m_atlasPageCount{0};
+
     /** Freetype library. */
     std::unique_ptr<ftcpp::Library> freetypeLib;
 
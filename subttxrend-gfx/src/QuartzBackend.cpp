@@ -98,6 +98,8 @@ void QuartzBackend::redraw()
 {
     g_logger.trace("%s", __func__);
 
+    getListener()->latchFrames();
+
     auto contentSize = calculateContentSize();
 
     const bool anythingToDraw = (contentSize.m_w > 0) || (contentSize.m_h > 0);
@@ -0,0 +1,700 @@
+/*****************************************************************************
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:
+*
+* Copyright 2021 Liberty Global Service B.V.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*****************************************************************************/
+
+#include "Scaler.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <list>
+#include <mutex>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define SCALER_X86 1
+#include <immintrin.h>
+#endif
+
+namespace subttxrend
+{
+namespace gfx
+{
+
+namespace
+{
+
+/** Number of channels per pixel. */
+const std::size_t CHANNELS = 4;
+
+/** Sum of coefficients of single destination position. */
+const double COEFFICIENTS_SUM = 65536.0;
+
+/** Maximum coefficient value. */
+const std::uint32_t COEFFICIENT_MAX = 0xFFFF;
+
+/** Number of coefficient tables kept by the cache. */
+const std::size_t TABLES_CACHE_CAPACITY = 4;
+
+/*
+ * Both passes multiply 16-bit values by 16-bit coefficients and keep the
+ * high half of the product ((value * coefficient) >> 16). Source bytes are
+ * extended to 8.8 fixed point by the vertical pass. As the coefficients
+ * sum up to at most 65536 the accumulated values never exceed 0xFF00 and
+ * there is no overflow in 16-bit lanes. The horizontal pass rounds the
+ * result back to 8 bits.
+ */
+
+/** Vertical pass parameters. */
+struct VerticalPass
+{
+    /** Line coefficients (one per tap). */
+    const std::uint16_t* m_coefficients;
+
+    /** Source lines (one per tap). */
+    const PixelArgb8888* const * m_lines;
+
+    /** Number of taps. */
+    std::int32_t m_taps;
+
+    /** Output (one value per source byte). */
+    std::uint16_t* m_output;
+};
+
+/** Horizontal pass parameters. */
+struct HorizontalPass
+{
+    /** First intermediate pixel per destination pixel. */
+    const std::int32_t* m_first;
+
+    /** Column coefficients (taps per destination pixel). */
+    const std::uint16_t* m_values;
+
+    /** Column coefficients (see Scaler::m_columnValues). */
+    const std::uint16_t* m_coefficients;
+
+    /** Number of taps. */
+    std::int32_t m_taps;
+
+    /** Destination width. */
+    std::int32_t m_width;
+
+    /** Intermediate pixels (vertical pass output). */
+    const std::uint16_t* m_input;
+
+    /** Destination pixels. */
+    std::uint8_t* m_output;
+};
+
+/** Vertical kernel function type (range of bytes). */
+typedef void (*VerticalFunction)(const VerticalPass& pass,
+                                 std::size_t begin,
+                                 std::size_t end);
+
+/** Horizontal kernel function type (range of pixels). */
+typedef void (*HorizontalFunction)(const HorizontalPass& pass,
+                                   std::size_t begin,
+                                   std::size_t end);
+
+const std::uint8_t* getBytes(const PixelArgb8888* pixels)
+{
+    return reinterpret_cast<const std::uint8_t*>(pixels);
+}
+
+/*
+ * The scalar kernels keep two channels in 32-bit lanes of a 64-bit value,
+ * the product of a 16-bit value and a coefficient fits in a lane, so
+ * a single multiplication serves two channels. Pixels are loaded and
+ * stored as whole words, channel N of a pixel is kept at bit 8 * N
+ * (bit 16 * N in the intermediate line), which is the byte order of
+ * the vectorized kernels on little endian machines.
+ *
+ * Subtitle planes are mostly transparent and premultiplied zero pixels
+ * contribute nothing, so they are skipped.
+ */
+
+/** Mask of the low 16 bits of both lanes. */
+const std::uint64_t LANES_MASK = 0x0000FFFF0000FFFFULL;
+
+/*
+ * Scalar passes are instantiated for the common tap counts (bilinear
+ * filter and area filter with scale below 2 use 2 taps), so the tap loop
+ * could be unrolled. Zero means any number of taps.
+ */
+template<std::int32_t TAPS>
+void verticalScalarTaps(const VerticalPass& pass,
+                        std::size_t begin,
+                        std::size_t end)
+{
+    const std::int32_t taps = (TAPS > 0) ? TAPS : pass.m_taps;
+
+    // stores could alias the pass, keep what the loop needs local
+    const PixelArgb8888* const * const lines = pass.m_lines;
+    const std::uint16_t* const coefficients = pass.m_coefficients;
+    std::uint16_t* const output = pass.m_output;
+
+    for (std::size_t i = begin; i < end; i += CHANNELS)
+    {
+        std::uint64_t acc02 = 0;
+        std::uint64_t acc13 = 0;
+
+        for (std::int32_t k = 0; k < taps; ++k)
+        {
+            std::uint32_t pixel;
+            std::memcpy(&pixel, getBytes(lines[k]) + i, sizeof(pixel));
+            if (pixel == 0)
+            {
+                continue;
+            }
+
+            const std::uint64_t coefficient = coefficients[k];
+            const std::uint64_t value = pixel;
+
+            // source bytes extended to 8.8 fixed point
+            const std::uint64_t s02 = ((value & 0x000000FF) << 8) | ((value & 0x00FF0000) << 24);
+            const std::uint64_t s13 = (value & 0x0000FF00) | ((value & 0xFF000000) << 16);
+
+            acc02 += ((s02 * coefficient) >> 16) & LANES_MASK;
+            acc13 += ((s13 * coefficient) >> 16) & LANES_MASK;
+        }
+
+        const std::uint64_t result = acc02 | (acc13 << 16);
+        std::memcpy(output + i, &result, sizeof(result));
+    }
+}
+
+template<std::int32_t TAPS>
+void horizontalScalarTaps(const HorizontalPass& pass,
+                          std::size_t begin,
+                          std::size_t end)
+{
+    // rounding added to both lanes before dropping the fraction
+    const std::uint64_t ROUNDING = 0x0000008000000080ULL;
+
+    const std::int32_t taps = (TAPS > 0) ? TAPS : pass.m_taps;
+
+    // stores could alias the pass, keep what the loop needs local
+    const std::int32_t* const first = pass.m_first;
+    const std::uint16_t* const values = pass.m_values;
+    const std::uint16_t* const intermediate = pass.m_input;
+    std::uint8_t* const output = pass.m_output;
+
+    for (std::size_t x = begin; x < end; ++x)
+    {
+        const std::uint16_t* coefficients = values + x * taps;
+        const std::uint16_t* input = intermediate + first[x] * CHANNELS;
+
+        std::uint64_t acc02 = 0;
+        std::uint64_t acc13 = 0;
+
+        for (std::int32_t k = 0; k < taps; ++k, input += CHANNELS)
+        {
+            std::uint64_t value;
+            std::memcpy(&value, input, sizeof(value));
+            if (value == 0)
+            {
+                continue;
+            }
+
+            const std::uint64_t coefficient = coefficients[k];
+
+            acc02 += (((value & LANES_MASK) * coefficient) >> 16) & LANES_MASK;
+            acc13 += ((((value >> 16) & LANES_MASK) * coefficient) >> 16) & LANES_MASK;
+        }
+
+        acc02 = ((acc02 + ROUNDING) >> 8) & 0x000000FF000000FFULL;
+        acc13 = ((acc13 + ROUNDING) >> 8) & 0x000000FF000000FFULL;
+
+        const std::uint64_t packed = acc02 | (acc13 << 8);
+        const std::uint32_t result = static_cast<std::uint32_t>(packed | (packed >> 16));
+        std::memcpy(output + x * CHANNELS, &result, sizeof(result));
+    }
+}
+
+void verticalScalar(const VerticalPass& pass,
+                    std::size_t begin,
+                    std::size_t end)
+{
+    assert((begin % CHANNELS == 0) && (end % CHANNELS == 0));
+
+    if (pass.m_taps == 2)
+    {
+        verticalScalarTaps<2>(pass, begin, end);
+    }
+    else
+    {
+        verticalScalarTaps<0>(pass, begin, end);
+    }
+}
+
+void horizontalScalar(const HorizontalPass& pass,
+                      std::size_t begin,
+                      std::size_t end)
+{
+    if (pass.m_taps == 2)
+    {
+        horizontalScalarTaps<2>(pass, begin, end);
+    }
+    else
+    {
+        horizontalScalarTaps<0>(pass, begin, end);
+    }
+}
+
+#if defined(SCALER_X86)
+
+__attribute__((target("sse2")))
+void verticalSse2(const VerticalPass& pass,
+                  std::size_t begin,
+                  std::size_t end)
+{
+    const __m128i zero = _mm_setzero_si128();
+
+    std::size_t i = begin;
+    for (; i + 16 <= end; i += 16)
+    {
+        __m128i accLow = zero;
+        __m128i accHigh = zero;
+
+        for (std::int32_t k = 0; k < pass.m_taps; ++k)
+        {
+            const __m128i coefficient = _mm_set1_epi16(pass.m_coefficients[k]);
+            const __m128i s = _mm_loadu_si128(
+                    reinterpret_cast<const __m128i*>(getBytes(pass.m_lines[k]) + i));
+
+            // interleaving with zero as low byte gives value << 8
+            accLow = _mm_add_epi16(accLow,
+                    _mm_mulhi_epu16(_mm_unpacklo_epi8(zero, s), coefficient));
+            accHigh = _mm_add_epi16(accHigh,
+                    _mm_mulhi_epu16(_mm_unpackhi_epi8(zero, s), coefficient));
+        }
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pass.m_output + i), accLow);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pass.m_output + i + 8), accHigh);
+    }
+
+    verticalScalar(pass, i, end);
+}
+
+__attribute__((target("sse2")))
+inline __m128i loadPixelPairSse2(const std::uint16_t* first,
+                                 const std::uint16_t* second)
+{
+    return _mm_unpacklo_epi64(
+            _mm_loadl_epi64(reinterpret_cast<const __m128i*>(first)),
+            _mm_loadl_epi64(reinterpret_cast<const __m128i*>(second)));
+}
+
+__attribute__((target("sse2")))
+void horizontalSse2(const HorizontalPass& pass,
+                    std::size_t begin,
+                    std::size_t end)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i rounding = _mm_set1_epi16(128);
+
+    std::size_t x = begin;
+    for (; x + 4 <= end; x += 4)
+    {
+        __m128i acc01 = zero;
+        __m128i acc23 = zero;
+
+        for (std::int32_t k = 0; k < pass.m_taps; ++k)
+        {
+            const std::uint16_t* coefficients = pass.m_coefficients
+                    + (k * pass.m_width + x) * CHANNELS;
+            const __m128i c01 = _mm_loadu_si128(
+                    reinterpret_cast<const __m128i*>(coefficients));
+            const __m128i c23 = _mm_loadu_si128(
+                    reinterpret_cast<const __m128i*>(coefficients + 2 * CHANNELS));
+
+            const __m128i p01 = loadPixelPairSse2(
+                    pass.m_input + (pass.m_first[x] + k) * CHANNELS,
+                    pass.m_input + (pass.m_first[x + 1] + k) * CHANNELS);
+            const __m128i p23 = loadPixelPairSse2(
+                    pass.m_input + (pass.m_first[x + 2] + k) * CHANNELS,
+                    pass.m_input + (pass.m_first[x + 3] + k) * CHANNELS);
+
+            acc01 = _mm_add_epi16(acc01, _mm_mulhi_epu16(p01, c01));
+            acc23 = _mm_add_epi16(acc23, _mm_mulhi_epu16(p23, c23));
+        }
+
+        acc01 = _mm_srli_epi16(_mm_add_epi16(acc01, rounding), 8);
+        acc23 = _mm_srli_epi16(_mm_add_epi16(acc23, rounding), 8);
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pass.m_output + x * CHANNELS),
+                _mm_packus_epi16(acc01, acc23));
+    }
+
+    horizontalScalar(pass, x, end);
+}
+
+#endif // SCALER_X86
+
+/** Kernel functions. */
+struct Kernel
+{
+    /** Vertical pass. */
+    VerticalFunction m_vertical;
+
+    /** Horizontal pass. */
+    HorizontalFunction m_horizontal;
+};
+
+Kernel getKernel(Scaler::Type type)
+{
+    switch (type)
+    {
+#if defined(SCALER_X86)
+    case Scaler::Type::SSE2:
+        return Kernel{verticalSse2, horizontalSse2};
+#endif
+    default:
+        return Kernel{verticalScalar, horizontalScalar};
+    }
+}
+
+Scaler::Type selectType()
+{
+    if (Scaler::isSupported(Scaler::Type::SSE2))
+    {
+        return Scaler::Type::SSE2;
+    }
+    return Scaler::Type::SCALAR;
+}
+
+} // namespace <anonymous>
+
+class Scaler::TablesCache
+{
+public:
+    static TablesCache& getInstance()
+    {
+        static TablesCache cache;
+        return cache;
+    }
+
+    std::shared_ptr<const Tables> get(Filter horizontalFilter,
+                                      Filter verticalFilter,
+                                      std::int32_t srcWidth,
+                                      std::int32_t srcHeight,
+                                      std::int32_t dstWidth,
+                                      std::int32_t dstHeight)
+    {
+        const Key key{horizontalFilter, verticalFilter, srcWidth, srcHeight,
+                dstWidth, dstHeight};
+
+        std::lock_guard<std::mutex> lock{m_mutex};
+
+        for (auto iter = m_entries.begin(); iter != m_entries.end(); ++iter)
+        {
+            if (iter->m_key == key)
+            {
+                m_entries.splice(m_entries.begin(), m_entries, iter);
+                ++m_statistics.m_hits;
+                return iter->m_tables;
+            }
+        }
+
+        ++m_statistics.m_misses;
+
+        m_entries.push_front(Entry{key, calculate(key)});
+        if (m_entries.size() > TABLES_CACHE_CAPACITY)
+        {
+            m_entries.pop_back();
+        }
+        m_statistics.m_entries = m_entries.size();
+
+        return m_entries.front().m_tables;
+    }
+
+    CacheStatistics getStatistics() const
+    {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        return m_statistics;
+    }
+
+private:
+    /** Filters and sizes the tables are calculated for. */
+    struct Key
+    {
+        Filter m_horizontalFilter;
+        Filter m_verticalFilter;
+        std::int32_t m_srcWidth;
+        std::int32_t m_srcHeight;
+        std::int32_t m_dstWidth;
+        std::int32_t m_dstHeight;
+
+        bool operator==(const Key& other) const
+        {
+            return (m_horizontalFilter == other.m_horizontalFilter)
+                    && (m_verticalFilter == other.m_verticalFilter)
+                    && (m_srcWidth == other.m_srcWidth)
+                    && (m_srcHeight == other.m_srcHeight)
+                    && (m_dstWidth == other.m_dstWidth)
+                    && (m_dstHeight == other.m_dstHeight);
+        }
+    };
+
+    struct Entry
+    {
+        Key m_key;
+        std::shared_ptr<const Tables> m_tables;
+    };
+
+    static std::shared_ptr<const Tables> calculate(const Key& key)
+    {
+        auto tables = std::make_shared<Tables>();
+
+        tables->m_columns = calculateCoefficients(key.m_horizontalFilter,
+                key.m_srcWidth, key.m_dstWidth);
+        tables->m_lines = calculateCoefficients(key.m_verticalFilter,
+                key.m_srcHeight, key.m_dstHeight);
+
+        const auto& columns = tables->m_columns;
+        const std::int32_t taps = columns.m_taps;
+
+        auto& columnValues = tables->m_columnValues;
+        columnValues.resize(taps * key.m_dstWidth * CHANNELS);
+        for (std::int32_t x = 0; x < key.m_dstWidth; ++x)
+        {
+            for (std::int32_t k = 0; k < taps; ++k)
+            {
+                auto value = columns.m_values[x * taps + k];
+                std::fill_n(columnValues.begin() + (k * key.m_dstWidth + x) * CHANNELS,
+                        CHANNELS, value);
+            }
+        }
+
+        return tables;
+    }
+
+    /** Entries (most recently used first). */
+    std::list<Entry> m_entries;
+
+    /** Statistics. */
+    CacheStatistics m_statistics;
+
+    /** Mutex protecting the entries, blits could run on many threads. */
+    mutable std::mutex m_mutex;
+};
+
+Scaler::Scaler(Filter horizontalFilter,
+               Filter verticalFilter,
+               std::int32_t srcWidth,
+               std::int32_t srcHeight,
+               std::int32_t dstWidth,
+               std::int32_t dstHeight) :
+        m_tables(TablesCache::getInstance().get(horizontalFilter,
+                verticalFilter, srcWidth, srcHeight, dstWidth, dstHeight)),
+        m_srcWidth(srcWidth),
+        m_dstWidth(dstWidth),
+        m_intermediate(srcWidth * CHANNELS)
+{
+    // noop
+}
+
+Scaler::Filter Scaler::selectFilter(std::int32_t srcSize,
+                                    std::int32_t dstSize)
+{
+    return (dstSize >= srcSize) ? Filter::BILINEAR : Filter::AREA;
+}
+
+std::int32_t Scaler::getSourceLineCount() const
+{
+    return m_tables->m_lines.m_taps;
+}
+
+std::int32_t Scaler::getFirstSourceLine(std::int32_t dstLine) const
+{
+    return m_tables->m_lines.m_first[dstLine];
+}
+
+void Scaler::scaleLine(std::int32_t dstLine,
+                       const PixelArgb8888* const * srcLines,
+                       PixelArgb8888* dst)
+{
+    static const Type type = getActiveType();
+
+    scaleLine(type, dstLine, srcLines, dst);
+}
+
+void Scaler::scaleLine(Type type,
+                       std::int32_t dstLine,
+                       const PixelArgb8888* const * srcLines,
+                       PixelArgb8888* dst)
+{
+    const Kernel kernel = getKernel(type);
+    const Coefficients& lines = m_tables->m_lines;
+    const Coefficients& columns = m_tables->m_columns;
+
+    const VerticalPass vertical{
+            lines.m_values.data() + dstLine * lines.m_taps,
+            srcLines,
+            lines.m_taps,
+            m_intermediate.data() };
+
+    kernel.m_vertical(vertical, 0, m_srcWidth * CHANNELS);
+
+    const HorizontalPass horizontal{
+            columns.m_first.data(),
+            columns.m_values.data(),
+            m_tables->m_columnValues.data(),
+            columns.m_taps,
+            m_dstWidth,
+            m_intermediate.data(),
+            reinterpret_cast<std::uint8_t*>(dst) };
+
+    kernel.m_horizontal(horizontal, 0, m_dstWidth);
+}
+
+bool Scaler::isSupported(Type type)
+{
+    switch (type)
+    {
+    case Type::SCALAR:
+        return true;
+#if defined(SCALER_X86)
+    case Type::SSE2:
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("sse2");
+#endif
+    default:
+        return false;
+    }
+}
+
+Scaler::Type Scaler::getActiveType()
+{
+    static const Type type = selectType();
+    return type;
+}
+
+Scaler::CacheStatistics Scaler::getCacheStatistics()
+{
+    return TablesCache::getInstance().getStatistics();
+}
+
+const char* Scaler::getName(Type type)
+{
+    switch (type)
+    {
+    case Type::SCALAR:
+        return "scalar";
+    case Type::SSE2:
+        return "sse2";
+    }
+    return "unknown";
+}
+
+Scaler::Coefficients Scaler::calculateCoefficients(Filter filter,
+                                                   std::int32_t srcSize,
+                                                   std::int32_t dstSize)
+{
+    assert((srcSize > 0) && (dstSize > 0));
+
+    /** Contribution of single source position. */
+    struct Contribution
+    {
+        std::int32_t m_position;
+        double m_weight;
+    };
+
+    const double scale = static_cast<double>(srcSize) / dstSize;
+
+    std::vector<std::vector<Contribution>> contributions(dstSize);
+    std::int32_t taps = 1;
+
+    for (std::int32_t i = 0; i < dstSize; ++i)
+    {
+        auto& current = contributions[i];
+
+        if (filter == Filter::BILINEAR)
+        {
+            // pixel centers are at half-integer positions
+            const double center = (i + 0.5) * scale - 0.5;
+            const double position = std::floor(center);
+            const double fraction = center - position;
+
+            current.push_back(Contribution{static_cast<std::int32_t>(position), 1.0 - fraction});
+            current.push_back(Contribution{static_cast<std::int32_t>(position) + 1, fraction});
+        }
+        else
+        {
+            // source pixels covered by the destination pixel, weighted by overlap
+            const double begin = i * scale;
+            const double end = (i + 1) * scale;
+
+            for (double position = std::floor(begin); position < end; position += 1.0)
+            {
+                const double overlap = std::min(end, position + 1.0)
+                        - std::max(begin, position);
+                if (overlap > 1e-9)
+                {
+                    current.push_back(Contribution{static_cast<std::int32_t>(position), overlap});
+                }
+            }
+        }
+
+        for (auto& contribution : current)
+        {
+            contribution.m_position = std::min(std::max(contribution.m_position, 0), srcSize - 1);
+        }
+
+        taps = std::max(taps, current.back().m_position - current.front().m_position + 1);
+    }
+
+    Coefficients coefficients;
+    coefficients.m_taps = taps;
+    coefficients.m_first.resize(dstSize);
+    coefficients.m_values.resize(dstSize * taps);
+
+    for (std::int32_t i = 0; i < dstSize; ++i)
+    {
+        const auto& current = contributions[i];
+
+        const std::int32_t first = std::min(current.front().m_position, srcSize - taps);
+        coefficients.m_first[i] = first;
+
+        double total = 0;
+        for (const auto& contribution : current)
+        {
+            total += contribution.m_weight;
+        }
+
+        // rounding the running sum keeps the sum of coefficients exact
+        double sum = 0;
+        std::int32_t previous = 0;
+        for (const auto& contribution : current)
+        {
+            sum += contribution.m_weight;
+            const std::int32_t next = static_cast<std::int32_t>(
+                    std::lround(sum / total * COEFFICIENTS_SUM));
+
+            auto& value = coefficients.m_values[i * taps + contribution.m_position - first];
+            value = std::min<std::uint32_t>(value + next - previous, COEFFICIENT_MAX);
+
+            previous = next;
+        }
+    }
+
+    return coefficients;
+}
+
+} // namespace gfx
+} // namespace subttxrend
@@ -0,0 +1,300 @@
+/*****************************************************************************
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:
+*
+* Copyright 2021 Liberty Global Service B.V.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*****************************************************************************/
+
+#ifndef SUBTTXREND_GFX_SCALER_HPP_
+#define SUBTTXREND_GFX_SCALER_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "Pixel.hpp"
+
+namespace subttxrend
+{
+namespace gfx
+{
+
+/**
+ * Separable fixed-point image scaler.
+ *
+ * The image is scaled in two passes per destination line. The vertical
+ * pass mixes the contributing source lines into a line of 16-bit
+ * intermediate values (source width), the horizontal pass mixes the
+ * contributing intermediate pixels into the destination line. The
+ * contributions of each source line / column are calculated once per
+ * filters and sizes and shared by scalers through a small cache (the same
+ * sizes are used by every blit of a subtitle plane), the per-pixel work
+ * is reduced to multiplications by 16-bit coefficients, so the passes
+ * could be vectorized.
+ *
+ * Channels are filtered independently, which is correct for premultiplied
+ * pixels. All kernels produce bit exact results. The vectorized kernel is
+ * selected once at runtime, the scalar kernel is used as a fallback and
+ * for the line tails.
+ */
+class Scaler
+{
+public:
+    /**
+     * Filter type.
+     */
+    enum class Filter
+    {
+        /** Bilinear interpolation (2 taps, intended for upscaling). */
+        BILINEAR,
+        /** Box / area averaging (intended for downscaling). */
+        AREA
+    };
+
+    /**
+     * Kernel type.
+     */
+    enum class Type
+    {
+        /** Portable scalar implementation. */
+        SCALAR,
+        /** x86 SSE2 implementation. */
+        SSE2
+    };
+
+    /**
+     * Coefficient tables cache statistics.
+     */
+    struct CacheStatistics
+    {
+        /** Number of scalers that reused cached tables. */
+        std::size_t m_hits{};
+
+        /** Number of scalers that calculated the tables. */
+        std::size_t m_misses{};
+
+        /** Number of tables in the cache. */
+        std::size_t m_entries{};
+    };
+
+    /**
+     * Constructor.
+     *
+     * @param horizontalFilter
+     *      Filter used for columns.
+     * @param verticalFilter
+     *      Filter used for lines.
+     * @param srcWidth
+     *      Source width in pixels (must be positive).
+     * @param srcHeight
+     *      Source height in pixels (must be positive).
+     * @param dstWidth
+     *      Destination width in pixels (must be positive).
+     * @param dstHeight
+     *      Destination height in pixels (must be positive).
+     */
+    Scaler(Filter horizontalFilter,
+           Filter verticalFilter,
+           std::int32_t srcWidth,
+           std::int32_t srcHeight,
+           std::int32_t dstWidth,
+           std::int32_t dstHeight);
+
+    /**
+     * Returns filter best suited for given scaling.
+     *
+     * @param srcSize
+     *      Source size (width or height).
+     * @param dstSize
+     *      Destination size (width or height).
+     *
+     * @return
+     *      Bilinear filter for upscaling, area filter for downscaling.
+     */
+    static Filter selectFilter(std::int32_t srcSize,
+                               std::int32_t dstSize);
+
+    /**
+     * Returns number of source lines needed for one destination line.
+     *
+     * @return
+     *      Number of source lines.
+     */
+    std::int32_t getSourceLineCount() const;
+
+    /**
+     * Returns first source line needed for given destination line.
+     *
+     * The lines needed are always in range
+     * [first, first + getSourceLineCount()) and within the source image.
+     * The value is not decreasing with destination line.
+     *
+     * @param dstLine
+     *      Destination line.
+     *
+     * @return
+     *      Source line index.
+     */
+    std::int32_t getFirstSourceLine(std::int32_t dstLine) const;
+
+    /**
+     * Scales single line using the best kernel available.
+     *
+     * @param dstLine
+     *      Destination line index.
+     * @param srcLines
+     *      Pointers to source lines (getSourceLineCount() entries starting
+     *      from getFirstSourceLine(dstLine)).
+     * @param dst
+     *      Destination pixels (destination width entries).
+     */
+    void scaleLine(std::int32_t dstLine,
+                   const PixelArgb8888* const * srcLines,
+                   PixelArgb8888* dst);
+
+    /**
+     * Scales single line using given kernel.
+     *
+     * @param type
+     *      Kernel to use. Must be supported (see isSupported()).
+     * @param dstLine
+     *      Destination line index.
+     * @param srcLines
+     *      Pointers to source lines (getSourceLineCount() entries starting
+     *      from getFirstSourceLine(dstLine)).
+     * @param dst
+     *      Destination pixels (destination width entries).
+     */
+    void scaleLine(Type type,
+                   std::int32_t dstLine,
+                   const PixelArgb8888* const * srcLines,
+                   PixelArgb8888* dst);
+
+    /**
+     * Checks if kernel could be used on this machine.
+     *
+     * @param type
+     *      Kernel type.
+     *
+     * @return
+     *      True if kernel is compiled in and supported by the CPU.
+     */
+    static bool isSupported(Type type);
+
+    /**
+     * Returns kernel selected for scaleLine().
+     *
+     * @return
+     *      Kernel type.
+     */
+    static Type getActiveType();
+
+    /**
+     * Returns kernel name.
+     *
+     * @param type
+     *      Kernel type.
+     *
+     * @return
+     *      Kernel name.
+     */
+    static const char* getName(Type type);
+
+    /**
+     * Returns coefficient tables cache statistics.
+     *
+     * @return
+     *      Current statistics.
+     */
+    static CacheStatistics getCacheStatistics();
+
+private:
+    /**
+     * Coefficients of single axis.
+     *
+     * Every destination position uses m_taps consecutive source positions
+     * starting at m_first. Coefficients are 16-bit fractions of 65536
+     * (a single full contribution is stored as 65535).
+     */
+    struct Coefficients
+    {
+        /** Number of source positions per destination position. */
+        std::int32_t m_taps;
+
+        /** First source position per destination position. */
+        std::vector<std::int32_t> m_first;
+
+        /** Coefficients (m_taps per destination position). */
+        std::vector<std::uint16_t> m_values;
+    };
+
+    /**
+     * Coefficient tables of both axes.
+     */
+    struct Tables
+    {
+        /** Column coefficients. */
+        Coefficients m_columns;
+
+        /**
+         * Column coefficients used by the vectorized horizontal pass.
+         * Stored per tap (all destination columns of tap 0, then tap 1...)
+         * and repeated for every channel, so neighbouring columns could be
+         * loaded at once.
+         */
+        std::vector<std::uint16_t> m_columnValues;
+
+        /** Line coefficients. */
+        Coefficients m_lines;
+    };
+
+    /**
+     * Calculates coefficients of single axis.
+     *
+     * @param filter
+     *      Filter to use.
+     * @param srcSize
+     *      Source size.
+     * @param dstSize
+     *      Destination size.
+     *
+     * @return
+     *      Calculated coefficients.
+     */
+    static Coefficients calculateCoefficients(Filter filter,
+                                              std::int32_t srcSize,
+                                              std::int32_t dstSize);
+
+    /** Cache of coefficient tables (most recently used kept). */
+    class TablesCache;
+
+    /** Coefficient tables (shared with other scalers). */
+    std::shared_ptr<const Tables> m_tables;
+
+    /** Source width in pixels. */
+    std::int32_t m_srcWidth;
+
+    /** Destination width in pixels. */
+    std::int32_t m_dstWidth;
+
+    /** Vertical pass result (4 channels per source pixel). */
+    std::vector<std::uint16_t> m_intermediate;
+};
+
+} // namespace gfx
+} // namespace subttxrend
+
+#endif                          // SUBTTXREND_GFX_SCALER_HPP_
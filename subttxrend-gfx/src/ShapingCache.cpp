@@ -0,0 +1,100 @@
+/*****************************************************************************
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:
+*
+* Copyright 2021 Liberty Global Service B.V.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*****************************************************************************/
+
+#include "ShapingCache.hpp"
+
+namespace subttxrend
+{
+namespace gfx
+{
+
+const std::size_t ShapingCache::DEFAULT_MAX_STRINGS;
+
+ShapingCache::ShapingCache(std::size_t maxStrings) :
+        m_maxStrings(maxStrings)
+{
+    // noop
+}
+
+const std::vector<TextTokenData>* ShapingCache::find(const std::string &str)
+{
+    auto iter = m_texts.find(str);
+    if (iter == m_texts.end())
+    {
+        ++m_missCount;
+        return nullptr;
+    }
+
+    ++m_hitCount;
+    m_usage.splice(m_usage.begin(), m_usage, iter->second.usage);
+
+    return &iter->second.tokens;
+}
+
+void ShapingCache::insert(const std::string &str,
+                          const std::vector<TextTokenData> &tokens)
+{
+    if (m_maxStrings == 0)
+    {
+        return;
+    }
+
+    auto iter = m_texts.find(str);
+    if (iter != m_texts.end())
+    {
+        iter->second.tokens = tokens;
+        m_usage.splice(m_usage.begin(), m_usage, iter->second.usage);
+        return;
+    }
+
+    if (m_texts.size() >= m_maxStrings)
+    {
+        // keys of unordered_map are stable, the pointer is still valid
+        m_texts.erase(*m_usage.back());
+        m_usage.pop_back();
+    }
+
+    iter = m_texts.emplace(str, ShapedText{tokens, UsageList::iterator()}).first;
+    m_usage.push_front(&iter->first);
+    iter->second.usage = m_usage.begin();
+}
+
+void ShapingCache::clear()
+{
+    m_usage.clear();
+    m_texts.clear();
+}
+
+std::size_t ShapingCache::getSize() const
+{
+    return m_texts.size();
+}
+
+std::size_t ShapingCache::getHitCount() const
+{
+    return m_hitCount;
+}
+
+std::size_t ShapingCache::getMissCount() const
+{
+    return m_missCount;
+}
+
+} // namespace gfx
+} // namespace subttxrend
@@ -0,0 +1,151 @@
+/*****************************************************************************
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:
+*
+* Copyright 2021 Liberty Global Service B.V.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*****************************************************************************/
+
+#ifndef SUBTTXREND_GFX_SHAPING_CACHE_HPP_
+#define SUBTTXREND_GFX_SHAPING_CACHE_HPP_
+
+#include <cstddef>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "PrerenderedFont.hpp"
+
+namespace subttxrend
+{
+namespace gfx
+{
+
+/**
+ * Text tokens of recently shaped strings.
+ *
+ * Used by PrerenderedFontImpl::textToTokens() - the renderers ask for the
+ * tokens of the same strings on every redraw of an unchanged cue, while
+ * HarfBuzz shaping is the most expensive part of it. Tokens depend only
+ * on the font and the string, so the string is the complete key.
+ *
+ * Number of strings kept is limited, the least recently used string is
+ * dropped when the limit is reached.
+ *
+ * Not synchronized, like the rest of the font it is used from the rendering
+ * thread only (background prewarming does not shape text).
+ */
+class ShapingCache
+{
+public:
+    /** Default maximum number of strings. */
+    static const std::size_t DEFAULT_MAX_STRINGS = 256;
+
+    /**
+     * Constructor.
+     *
+     * @param maxStrings
+     *      Maximum number of strings kept. Zero disables the cache.
+     */
+    explicit ShapingCache(std::size_t maxStrings = DEFAULT_MAX_STRINGS);
+
+    /**
+     * Text tokens getter.
+     *
+     * @param str
+     *      Text (UTF-8).
+     *
+     * @return
+     *      Tokens of given text or null pointer if the text was not
+     *      shaped recently. The pointer is valid until the next call.
+     */
+    const std::vector<TextTokenData>* find(const std::string &str);
+
+    /**
+     * Stores text tokens.
+     *
+     * @param str
+     *      Text (UTF-8).
+     * @param tokens
+     *      Tokens returned by shaping of the text.
+     */
+    void insert(const std::string &str,
+                const std::vector<TextTokenData> &tokens);
+
+    /**
+     * Drops all strings.
+     */
+    void clear();
+
+    /**
+     * Returns number of strings kept.
+     *
+     * @return
+     *      Number of strings.
+     */
+    std::size_t getSize() const;
+
+    /**
+     * Returns number of find() calls that returned tokens.
+     *
+     * @return
+     *      Number of hits since construction.
+     */
+    std::size_t getHitCount() const;
+
+    /**
+     * Returns number of find() calls that returned null pointer.
+     *
+     * @return
+     *      Number of misses since construction.
+     */
+    std::size_t getMissCount() const;
+
+private:
+    /** Strings in usage order, most recent first. */
+    using UsageList = std::list<const std::string*>;
+
+    /**
+     * Shaped string.
+     */
+    struct ShapedText
+    {
+        /** Text tokens. */
+        std::vector<TextTokenData> tokens;
+
+        /** Position in usage list. */
+        UsageList::iterator usage;
+    };
+
+    /** Maximum number of strings. */
+    const std::size_t m_maxStrings;
+
+    /** Shaped strings. Keys are the only copy of the strings. */
+    std::unordered_map<std::string, ShapedText> m_texts;
+
+    /** Usage order, points to keys of m_texts. */
+    UsageList m_usage;
+
+    /** Number of hits. */
+    std::size_t m_hitCount = 0;
+
+    /** Number of misses. */
+    std::size_t m_missCount = 0;
+};
+
+} // namespace gfx
+} // namespace subttxrend
+
+#endif                          // SUBTTXREND_GFX_SHAPING_CACHE_HPP_
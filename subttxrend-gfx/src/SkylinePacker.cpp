@@ -0,0 +1,167 @@
+/*****************************************************************************
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:
+*
+* Copyright 2021 Liberty Global Service B.V.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*****************************************************************************/
+
+#include "SkylinePacker.hpp"
+
+#include <algorithm>
+#include <limits>
+
+namespace subttxrend
+{
+namespace gfx
+{
+
+SkylinePacker::SkylinePacker(std::int32_t width,
+                             std::int32_t height) :
+        m_width(width),
+        m_height(height),
+        m_skyline{Segment{0, 0, width}},
+        m_usedArea(0)
+{
+    // noop
+}
+
+bool SkylinePacker::pack(std::int32_t width,
+                         std::int32_t height,
+                         std::int32_t& x,
+                         std::int32_t& y)
+{
+    if ((width <= 0) || (height <= 0))
+    {
+        return false;
+    }
+
+    std::int32_t bestTop = std::numeric_limits<std::int32_t>::max();
+    std::int32_t bestWidth = std::numeric_limits<std::int32_t>::max();
+    std::size_t bestIndex = m_skyline.size();
+    std::int32_t bestY = 0;
+
+    for (std::size_t i = 0; i < m_skyline.size(); ++i)
+    {
+        std::int32_t fitY = 0;
+        if (!fits(i, width, height, fitY))
+        {
+            continue;
+        }
+
+        const std::int32_t top = fitY + height;
+        if ((top < bestTop) || ((top == bestTop) && (m_skyline[i].m_width < bestWidth)))
+        {
+            bestTop = top;
+            bestWidth = m_skyline[i].m_width;
+            bestIndex = i;
+            bestY = fitY;
+        }
+    }
+
+    if (bestIndex == m_skyline.size())
+    {
+        return false;
+    }
+
+    x = m_skyline[bestIndex].m_x;
+    y = bestY;
+
+    addSegment(bestIndex, x, y + height, width);
+    m_usedArea += static_cast<std::int64_t>(width) * height;
+
+    return true;
+}
+
+double SkylinePacker::getFillRate() const
+{
+    const double totalArea = static_cast<double>(m_width) * m_height;
+    return (totalArea > 0) ? (m_usedArea / totalArea) : 0.0;
+}
+
+bool SkylinePacker::fits(std::size_t index,
+                         std::int32_t width,
+                         std::int32_t height,
+                         std::int32_t& y) const
+{
+    const std::int32_t x = m_skyline[index].m_x;
+    if (x + width > m_width)
+    {
+        return false;
+    }
+
+    y = 0;
+    std::int32_t remaining = width;
+    for (std::size_t i = index; remaining > 0; ++i)
+    {
+        // segments always cover the whole width
+        y = std::max(y, m_skyline[i].m_y);
+        if (y + height > m_height)
+        {
+            return false;
+        }
+        remaining -= m_skyline[i].m_width;
+    }
+
+    return true;
+}
+
+void SkylinePacker::addSegment(std::size_t index,
+                               std::int32_t x,
+                               std::int32_t y,
+                               std::int32_t width)
+{
+    m_skyline.insert(m_skyline.begin() + index, Segment{x, y, width});
+
+    // shrink or remove segments now covered by the new one
+    const std::int32_t end = x + width;
+    std::size_t i = index + 1;
+    while (i < m_skyline.size())
+    {
+        auto& segment = m_skyline[i];
+        if (segment.m_x >= end)
+        {
+            break;
+        }
+
+        const std::int32_t segmentEnd = segment.m_x + segment.m_width;
+        if (segmentEnd <= end)
+        {
+            m_skyline.erase(m_skyline.begin() + i);
+        }
+        else
+        {
+            segment.m_width = segmentEnd - end;
+            segment.m_x = end;
+            break;
+        }
+    }
+
+    // merge neighbours of equal height
+    for (i = 0; i + 1 < m_skyline.size();)
+    {
+        if (m_skyline[i].m_y == m_skyline[i + 1].m_y)
+        {
+            m_skyline[i].m_width += m_skyline[i + 1].m_width;
+            m_skyline.erase(m_skyline.begin() + i + 1);
+        }
+        else
+        {
+            ++i;
+        }
+    }
+}
+
+} // namespace gfx
+} // namespace subttxrend
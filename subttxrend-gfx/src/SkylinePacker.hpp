@@ -0,0 +1,161 @@
+/*****************************************************************************
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:
+*
+* Copyright 2021 Liberty Global Service B.V.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*****************************************************************************/
+
+#ifndef SUBTTXREND_GFX_SKYLINE_PACKER_HPP_
+#define SUBTTXREND_GFX_SKYLINE_PACKER_HPP_
+
+#include <cstdint>
+#include <vector>
+
+namespace subttxrend
+{
+namespace gfx
+{
+
+/**
+ * Rectangle packer using the skyline bottom-left heuristic.
+ *
+ * The packer keeps the upper contour (skyline) of already placed
+ * rectangles and puts each new rectangle at the position where its top
+ * edge is lowest. Compared to simple row (shelf) packing this does not
+ * waste the space above short glyphs placed in a row of tall ones.
+ */
+class SkylinePacker
+{
+public:
+    /**
+     * Constructor.
+     *
+     * @param width
+     *      Area width.
+     * @param height
+     *      Area height.
+     */
+    SkylinePacker(std::int32_t width,
+                  std::int32_t height);
+
+    /**
+     * Finds place for a rectangle and marks it as used.
+     *
+     * @param width
+     *      Rectangle width.
+     * @param height
+     *      Rectangle height.
+     * @param x
+     *      Output: rectangle position.
+     * @param y
+     *      Output: rectangle position.
+     *
+     * @return
+     *      True on success, false if there is no room left.
+     */
+    bool pack(std::int32_t width,
+              std::int32_t height,
+              std::int32_t& x,
+              std::int32_t& y);
+
+    /**
+     * Returns area width.
+     *
+     * @return
+     *      Width in pixels.
+     */
+    std::int32_t getWidth() const
+    {
+        return m_width;
+    }
+
+    /**
+     * Returns area height.
+     *
+     * @return
+     *      Height in pixels.
+     */
+    std::int32_t getHeight() const
+    {
+        return m_height;
+    }
+
+    /**
+     * Returns fill rate.
+     *
+     * @return
+     *      Ratio of the area covered by packed rectangles (0..1).
+     */
+    double getFillRate() const;
+
+private:
+    /** Skyline segment. */
+    struct Segment
+    {
+        /** Start position. */
+        std::int32_t m_x;
+
+        /** Height of the skyline. */
+        std::int32_t m_y;
+
+        /** Segment width. */
+        std::int32_t m_width;
+    };
+
+    /**
+     * Checks if rectangle fits starting at given segment.
+     *
+     * @param index
+     *      Index of the first segment.
+     * @param width
+     *      Rectangle width.
+     * @param height
+     *      Rectangle height.
+     * @param y
+     *      Output: lowest position at which the rectangle fits.
+     *
+     * @return
+     *      True if rectangle fits, false otherwise.
+     */
+    bool fits(std::size_t index,
+              std::int32_t width,
+              std::int32_t height,
+              std::int32_t& y) const;
+
+    /**
+     * Updates skyline after placing a rectangle.
+     */
+    void addSegment(std::size_t index,
+                    std::int32_t x,
+                    std::int32_t y,
+                    std::int32_t width);
+
+    /** Area width. */
+    const std::int32_t m_width;
+
+    /** Area height. */
+    const std::int32_t m_height;
+
+    /** Skyline segments (sorted by position). */
+    std::vector<Segment> m_skyline;
+
+    /** Area covered by packed rectangles. */
+    std::int64_t m_usedArea;
+};
+
+} // namespace gfx
+} // namespace subttxrend
+
+#endif                          // SUBTTXREND_GFX_SKYLINE_PACKER_HPP_
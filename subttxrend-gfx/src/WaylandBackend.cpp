@@ -778,6 +778,7 @@ void WaylandBackend::redraw(uint32_t /*time*/)
     g_logger.debug("%s - Redrawing", __func__);
 
     m_forceRender.store(false, std::memory_order_relaxed);
+    getListener()->latchFrames();
     redraw(m_surface);
 }
 
@@ -22,6 +22,14 @@
 
 #include <subttxrend/common/Logger.hpp>
 
+#include <algorithm>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#include <GLES2/gl2ext.h>
+
+#include "DamageRegion.hpp"
 #include "Pixel.hpp"
 #include "Pixmap.hpp"
 #ifdef USE_UPSTREAM_WAYLAND
@@ -63,6 +71,82 @@ GLchar FRAGMENT_SHADER_SOURCE[] = ""
 
 const int TEXT_TEXTURE = 0;
 const int BACKGROUND_TEXTURE = 1;
+
+/** Number of rows cleared with a single upload. */
+const std::int32_t CLEAR_CHUNK_ROWS = 64;
+
+/**
+ * Checks if GL extension is supported.
+ *
+ * Requires current GL context.
+ *
+ * @param name
+ *      Extension name.
+ *
+ * @return
+ *      True if extension is listed by the context, false otherwise.
+ */
+bool hasGlExtension(const char* name)
+{
+    auto extensions = reinterpret_cast<const char*>(glGetString(GL_EXTENSIONS));
+    if (!extensions)
+    {
+        return false;
+    }
+
+    const auto nameLength = std::strlen(name);
+
+    for (auto pos = std::strstr(extensions, name); pos;
+            pos = std::strstr(pos + nameLength, name))
+    {
+        // whole names only (list is space separated)
+        const bool startOk = (pos == extensions) || (pos[-1] == ' ');
+        const bool endOk = (pos[nameLength] == ' ') || (pos[nameLength] == '\0');
+        if (startOk && endOk)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/** Range of texture rows (first, last + 1). */
+using RowBand = std::pair<std::int32_t, std::int32_t>;
+
+/**
+ * Converts damage to sorted, non-overlapping row bands.
+ *
+ * GLES2 has no GL_UNPACK_ROW_LENGTH so sub-image uploads from a pixmap
+ * must span full rows.
+ */
+std::vector<RowBand> getDamagedBands(const DamageRegion& damage)
+{
+    std::vector<RowBand> bands;
+
+    for (const auto& rect : damage.getRectangles())
+    {
+        bands.emplace_back(rect.m_y, rect.m_y + rect.m_h);
+    }
+
+    std::sort(bands.begin(), bands.end());
+
+    std::vector<RowBand> merged;
+    for (const auto& band : bands)
+    {
+        if (!merged.empty() && (band.first <= merged.back().second))
+        {
+            merged.back().second = std::max(merged.back().second, band.second);
+        }
+        else
+        {
+            merged.push_back(band);
+        }
+    }
+
+    return merged;
+}
+
 } // namespace <anonymous>
 
 //------------------------------------------
@@ -75,6 +159,11 @@ WaylandBackendEgl::WaylandBackendEgl(BackendListener* listener) :
         m_eglDisplay(nullptr),
         m_eglWindow(nullptr),
         m_eglSurface(nullptr),
+        m_texturesReallocated(false),
+        m_uploadedAreas(),
+        m_unpackSubimageSupported(false),
+        m_frameUploadBytes(0),
+        m_uploadStatistics(),
         m_textureUniformHandle(-1),
         m_positionAttribHandle(-1),
         m_textureCoordinateHandle(-1),
@@ -86,6 +175,11 @@ WaylandBackendEgl::WaylandBackendEgl(BackendListener* listener) :
 
 WaylandBackendEgl::~WaylandBackendEgl()
 {
+    g_logger.info("%s - texture uploads: frames: %llu bytes: %llu max frame bytes: %zu",
+            __func__, static_cast<unsigned long long>(m_uploadStatistics.m_frames),
+            static_cast<unsigned long long>(m_uploadStatistics.m_bytes),
+            m_uploadStatistics.m_maxFrameBytes);
+
     if (!eglMakeCurrent(m_eglDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT))
     {
         g_logger.error("%s - cannot set current EGL context (%d)", __func__,
@@ -258,6 +352,13 @@ bool WaylandBackendEgl::initRendering()
 
     glDisable(GL_DEPTH_TEST);
 
+#ifdef GL_UNPACK_ROW_LENGTH_EXT
+    m_unpackSubimageSupported = hasGlExtension("GL_EXT_unpack_subimage");
+#endif
+
+    g_logger.info("%s - GL_EXT_unpack_subimage: %s", __func__,
+            m_unpackSubimageSupported ? "yes" : "no");
+
     g_logger.trace("%s - finished with success", __func__);
 
     return true;
@@ -328,6 +429,10 @@ bool WaylandBackendEgl::prepareTexture(const Size& contentSize, int textureId)
         if (glGetError() == GL_NO_ERROR)
         {
             textureSize = contentSize;
+            m_texturesReallocated = true;
+
+            // storage contents are undefined until uploaded
+            clearTextureArea(Rectangle(0, 0, contentSize.m_w, contentSize.m_h));
 
             g_logger.trace("%s - texture of size %dx%d created", __func__,
                     contentSize.m_w, contentSize.m_h);
@@ -349,57 +454,210 @@ bool WaylandBackendEgl::drawOnTexture(const Size& contentSize)
 {
     g_logger.trace("%s", __func__);
 
+    DamageRegion damage;
+    getListener()->collectDamage(contentSize, damage);
+
+    const bool fullUpload = m_texturesReallocated;
+    m_texturesReallocated = false;
+
     class TextureRenderer : public BackendWindowEnumerator
     {
     public:
-        TextureRenderer(const std::array<Size, 2>& textureSizes) :
-                m_textureSizes(textureSizes)
+        TextureRenderer(WaylandBackendEgl& backend,
+                        const Size& contentSize,
+                        const DamageRegion& damage,
+                        bool fullUpload) :
+                m_backend(backend),
+                m_contentSize(contentSize),
+                m_damage(damage),
+                m_fullUpload(fullUpload)
         {
             // noop
         }
 
         virtual void processWindow(const Pixmap& pixmap) override
         {
-            drawPixmapOnTexture(pixmap, TEXT_TEXTURE);
+            m_backend.uploadPixmap(pixmap, TEXT_TEXTURE, m_contentSize,
+                    m_damage, m_fullUpload);
         }
 #if BACKEND_TYPE == 2
         virtual void processWindow(const Pixmap& pixmap, const Pixmap& bgPixmap) override
         {
-            drawPixmapOnTexture(pixmap, TEXT_TEXTURE);
-            drawPixmapOnTexture(bgPixmap, BACKGROUND_TEXTURE);
+            m_backend.uploadPixmap(pixmap, TEXT_TEXTURE, m_contentSize,
+                    m_damage, m_fullUpload);
+            m_backend.uploadPixmap(bgPixmap, BACKGROUND_TEXTURE, m_contentSize,
+                    m_damage, m_fullUpload);
         }
 #endif
 
     private:
-        void drawPixmapOnTexture(const Pixmap& pixmap, int textureId)
+        WaylandBackendEgl& m_backend;
+        const Size m_contentSize;
+        const DamageRegion& m_damage;
+        const bool m_fullUpload;
+    };
+
+    TextureRenderer renderer(*this, contentSize, damage, fullUpload);
+
+    getListener()->enumerateVisibleWindows(renderer);
+
+    ++m_uploadStatistics.m_frames;
+    m_uploadStatistics.m_bytes += m_frameUploadBytes;
+    m_uploadStatistics.m_lastFrameBytes = m_frameUploadBytes;
+    m_uploadStatistics.m_maxFrameBytes = std::max(
+            m_uploadStatistics.m_maxFrameBytes, m_frameUploadBytes);
+
+    g_logger.trace("%s - uploaded bytes: %zu", __func__, m_frameUploadBytes);
+
+    m_frameUploadBytes = 0;
+
+    return true;
+}
+
+void WaylandBackendEgl::uploadPixmap(const Pixmap& pixmap,
+                                     int textureId,
+                                     const Size& contentSize,
+                                     const DamageRegion& damage,
+                                     bool fullUpload)
+{
+    const auto pw = pixmap.getWidth();
+    const auto ph = pixmap.getHeight();
+    const auto& textureSize = m_textureSizes[textureId];
+
+    if ((pw > textureSize.m_w) || (ph > textureSize.m_h))
+    {
+        g_logger.info("%s - pixmap larger than texture, skipping",
+                __func__);
+        return;
+    }
+
+    const Rectangle pixmapArea((textureSize.m_w - pw) / 2,
+            (textureSize.m_h - ph) / 2, pw, ph);
+    auto& uploadedArea = m_uploadedAreas[textureId];
+
+    glActiveTexture(GL_TEXTURE0 + textureId);
+    glBindTexture(GL_TEXTURE_2D, m_textures[textureId].get());
+
+    const bool areaChanged = (uploadedArea.m_x != pixmapArea.m_x)
+            || (uploadedArea.m_y != pixmapArea.m_y)
+            || (uploadedArea.m_w != pixmapArea.m_w)
+            || (uploadedArea.m_h != pixmapArea.m_h);
+
+    if (fullUpload || areaChanged)
+    {
+        // reallocated texture is already cleared
+        if (!fullUpload)
         {
-            const auto pw = pixmap.getWidth();
-            const auto ph = pixmap.getHeight();
-            const auto& textureSize = m_textureSizes[textureId];
+            clearTextureArea(uploadedArea);
+        }
 
-            if ((pw > textureSize.m_w) || (ph > textureSize.m_h))
-            {
-                g_logger.info("%s - pixmap larger than texture, skipping",
-                        __func__);
-                return;
-            }
+        uploadPixmapArea(pixmap, Rectangle(0, 0, pw, ph), pixmapArea.m_x,
+                pixmapArea.m_y);
+        uploadedArea = pixmapArea;
+        return;
+    }
+
+    // damage is collected with the pixmap centered on the content
+    DamageRegion pixmapDamage;
+    pixmapDamage.add(damage);
+    pixmapDamage.translate(-(contentSize.m_w - pw) / 2,
+            -(contentSize.m_h - ph) / 2);
+    pixmapDamage.clip(Rectangle(0, 0, pw, ph));
+
+    if (m_unpackSubimageSupported)
+    {
+        for (const auto& rect : pixmapDamage.getRectangles())
+        {
+            uploadPixmapArea(pixmap, rect, pixmapArea.m_x, pixmapArea.m_y);
+        }
+    }
+    else
+    {
+        for (const auto& band : getDamagedBands(pixmapDamage))
+        {
+            uploadPixmapArea(pixmap,
+                    Rectangle(0, band.first, pw, band.second - band.first),
+                    pixmapArea.m_x, pixmapArea.m_y);
+        }
+    }
+}
 
-            const auto tx = (textureSize.m_w - pw) / 2;
-            const auto ty = (textureSize.m_h - ph) / 2;
+void WaylandBackendEgl::uploadPixmapArea(const Pixmap& pixmap,
+                                         const Rectangle& area,
+                                         std::int32_t textureX,
+                                         std::int32_t textureY)
+{
+    if (DamageRegion::isEmpty(area))
+    {
+        return;
+    }
 
-            glActiveTexture(GL_TEXTURE0 + textureId);
-            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, textureSize.m_w, textureSize.m_h, 0,
-                GL_RGBA, GL_UNSIGNED_BYTE, pixmap.getLine(0).ptr());
+    const auto pixelSize = static_cast<std::uint32_t>(sizeof(PixelArgb8888));
+    const auto stride = pixmap.getStride();
+    const auto data = pixmap.getLine(area.m_y) + area.m_x;
 
+    if ((area.m_x == 0) && (stride == area.m_w * pixelSize))
+    {
+        // rows are contiguous
+        glTexSubImage2D(GL_TEXTURE_2D, 0, textureX, textureY + area.m_y,
+                area.m_w, area.m_h, GL_RGBA, GL_UNSIGNED_BYTE, data.ptr());
+    }
+#ifdef GL_UNPACK_ROW_LENGTH_EXT
+    else if (m_unpackSubimageSupported && (stride % pixelSize == 0))
+    {
+        glPixelStorei(GL_UNPACK_ROW_LENGTH_EXT, stride / pixelSize);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, textureX + area.m_x,
+                textureY + area.m_y, area.m_w, area.m_h, GL_RGBA,
+                GL_UNSIGNED_BYTE, data.ptr());
+        glPixelStorei(GL_UNPACK_ROW_LENGTH_EXT, 0);
+    }
+#endif
+    else
+    {
+        for (std::int32_t y = 0; y < area.m_h; ++y)
+        {
+            glTexSubImage2D(GL_TEXTURE_2D, 0, textureX + area.m_x,
+                    textureY + area.m_y + y, area.m_w, 1, GL_RGBA,
+                    GL_UNSIGNED_BYTE, (pixmap.getLine(area.m_y + y) + area.m_x).ptr());
         }
-        const std::array<Size, 2> m_textureSizes;
-    };
+    }
 
-    TextureRenderer renderer(m_textureSizes);
+    m_frameUploadBytes += static_cast<std::size_t>(area.m_w) * area.m_h * pixelSize;
+}
 
-    getListener()->enumerateVisibleWindows(renderer);
+void WaylandBackendEgl::clearTextureArea(const Rectangle& area)
+{
+    if (DamageRegion::isEmpty(area))
+    {
+        return;
+    }
 
-    return true;
+    // cleared in chunks of rows to keep the buffer small
+    const std::int32_t chunkRows = std::min(area.m_h, CLEAR_CHUNK_ROWS);
+    const std::int32_t requiredSize = area.m_w * chunkRows;
+
+    if (m_clearBufferSize < requiredSize)
+    {
+        m_clearBuffer.reset(new PixelArgb8888[requiredSize]);
+        std::fill_n(m_clearBuffer.get(), requiredSize, PixelArgb8888(0u));
+        m_clearBufferSize = requiredSize;
+    }
+
+    for (std::int32_t y = 0; y < area.m_h; y += chunkRows)
+    {
+        const auto rows = std::min(chunkRows, area.m_h - y);
+
+        glTexSubImage2D(GL_TEXTURE_2D, 0, area.m_x, area.m_y + y, area.m_w,
+                rows, GL_RGBA, GL_UNSIGNED_BYTE, m_clearBuffer.get());
+    }
+
+    m_frameUploadBytes += static_cast<std::size_t>(area.m_w) * area.m_h
+            * sizeof(PixelArgb8888);
+}
+
+WaylandBackendEgl::UploadStatistics WaylandBackendEgl::getUploadStatistics() const
+{
+    return m_uploadStatistics;
 }
 
 void WaylandBackendEgl::drawTexturedObject(const Size& contentSize)
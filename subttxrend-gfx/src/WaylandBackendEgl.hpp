@@ -21,6 +21,9 @@
 #ifndef SUBTTXREND_GFX_WAYLAND_BACKEND_EGL_HPP_
 #define SUBTTXREND_GFX_WAYLAND_BACKEND_EGL_HPP_
 
+#include <array>
+#include <cstddef>
+
 #include "WaylandBackend.hpp"
 #include "GLcpp.hpp"
 #include "Types.hpp"
@@ -34,6 +37,8 @@ namespace gfx
 {
 
 
+class DamageRegion;
+class Pixmap;
 class PixelArgb8888;
 
 /**
@@ -42,6 +47,24 @@ class PixelArgb8888;
 class WaylandBackendEgl : public WaylandBackend
 {
 public:
+    /**
+     * Texture upload statistics.
+     */
+    struct UploadStatistics
+    {
+        /** Number of frames with texture uploads. */
+        std::uint64_t m_frames{};
+
+        /** Total number of bytes uploaded. */
+        std::uint64_t m_bytes{};
+
+        /** Number of bytes uploaded in the last frame. */
+        std::size_t m_lastFrameBytes{};
+
+        /** Maximum number of bytes uploaded in a single frame. */
+        std::size_t m_maxFrameBytes{};
+    };
+
     /**
      * Constructor.
      *
@@ -55,6 +78,14 @@ public:
      */
     virtual ~WaylandBackendEgl();
 
+    /**
+     * Returns texture upload statistics.
+     *
+     * @return
+     *      Current statistics.
+     */
+    UploadStatistics getUploadStatistics() const;
+
 protected:
     /** @copydoc WaylandBackend::initRendering */
     virtual bool initRendering() override;
@@ -104,6 +135,54 @@ private:
      */
     bool drawOnTexture(const Size& contentSize);
 
+    /**
+     * Uploads changed parts of the pixmap to texture.
+     *
+     * Texture storage is not reallocated, only sub-images are uploaded.
+     * The pixmap is centered on the texture.
+     *
+     * @param pixmap
+     *      Pixmap to upload.
+     * @param textureId
+     *      Texture to upload to.
+     * @param contentSize
+     *      Content size (damage coordinates space).
+     * @param damage
+     *      Damaged area in content coordinates.
+     * @param fullUpload
+     *      Upload whole pixmap regardless of damage.
+     */
+    void uploadPixmap(const Pixmap& pixmap,
+                      int textureId,
+                      const Size& contentSize,
+                      const DamageRegion& damage,
+                      bool fullUpload);
+
+    /**
+     * Uploads pixmap area to currently bound texture.
+     *
+     * @param pixmap
+     *      Source pixmap.
+     * @param area
+     *      Pixmap area to upload.
+     * @param textureX
+     *      Texture position of the pixmap left edge.
+     * @param textureY
+     *      Texture position of the pixmap top edge.
+     */
+    void uploadPixmapArea(const Pixmap& pixmap,
+                          const Rectangle& area,
+                          std::int32_t textureX,
+                          std::int32_t textureY);
+
+    /**
+     * Fills area of currently bound texture with transparent pixels.
+     *
+     * @param area
+     *      Texture area to clear.
+     */
+    void clearTextureArea(const Rectangle& area);
+
     /**
      * Draws textured object on GL context.
      *
@@ -166,6 +245,21 @@ private:
     /** Current textures sizes. */
     std::array<Size, 2> m_textureSizes;
 
+    /** Flag indicating that textures were reallocated and need full upload. */
+    bool m_texturesReallocated;
+
+    /** Texture areas updated by the last upload (per texture). */
+    std::array<Rectangle, 2> m_uploadedAreas;
+
+    /** GL_EXT_unpack_subimage support (upload with custom row length). */
+    bool m_unpackSubimageSupported;
+
+    /** Number of bytes uploaded in the current frame. */
+    std::size_t m_frameUploadBytes;
+
+    /** Texture upload statistics. */
+    UploadStatistics m_uploadStatistics;
+
     /** GL shader program. */
     glcpp::ProgramPtr m_program;
 
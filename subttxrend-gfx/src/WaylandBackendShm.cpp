@@ -70,7 +70,8 @@ const Size WaylandBackendShm::DEFAULT_SIZE =
 
 WaylandBackendShm::WaylandBackendShm(BackendListener* listener) :
         WaylandBackend(listener),
-        m_currentSize({0, 0})
+        m_currentSize({0, 0}),
+        m_renderedSize({0, 0})
 {
     // noop
 }
@@ -155,6 +156,22 @@ void WaylandBackendShm::redraw(const waylandcpp::Surface1::Ptr& m_surface)
 
     const auto& size = getCurrentSize();
 
+    DamageRegion frameDamage;
+    getListener()->collectDamage(size, frameDamage);
+
+    if (size != m_renderedSize)
+    {
+        // windows are centered so all the contents moved
+        m_bufferManager->invalidateBuffers();
+        frameDamage.add(Rectangle(0, 0, size.m_w, size.m_h));
+
+        m_renderedSize = size;
+    }
+
+    // buffers are used in rotation, each one needs to catch up
+    m_bufferManager->addDamage(frameDamage);
+    m_surfaceDamage.add(frameDamage);
+
     WaylandBuffer::Ptr buffer = m_bufferManager->getBuffer(size);
 
     if (!buffer)
@@ -174,10 +191,20 @@ void WaylandBackendShm::redraw(const waylandcpp::Surface1::Ptr& m_surface)
     if (!buffer->isEmpty())
     {
         paintPixels(buffer);
+
+        for (const auto& rect : m_surfaceDamage.getRectangles())
+        {
+            m_surface->damage(rect.m_x, rect.m_y, rect.m_w, rect.m_h);
+        }
     }
+    else
+    {
+        m_surface->damage(0, 0, buffer->getParams().m_width,
+                buffer->getParams().m_height);
+    }
+
+    m_surfaceDamage.clear();
 
-    m_surface->damage(0, 0, buffer->getParams().m_width,
-            buffer->getParams().m_height);
     m_surface->attach(buffer->markAttached());
 
     m_surface->commit();
@@ -216,15 +243,40 @@ void WaylandBackendShm::paintPixels(const WaylandBuffer::Ptr& buffer)
     Pixmap screenPixmap(reinterpret_cast<uint8_t*>(buffer->getDataPtr()),
             params.m_width, params.m_height, params.m_stride);
 
-    Blitter::clear(screenPixmap);
+    const Rectangle screenRect{0, 0, params.m_width, params.m_height};
+
+    auto& damage = buffer->getDamage();
+    damage.clip(screenRect);
+
+    if (damage.isEmpty())
+    {
+        g_logger.trace("%s - nothing changed", __func__);
+        return;
+    }
+
+    const auto bounds = damage.getBounds();
+    if ((bounds.m_w == screenRect.m_w) && (bounds.m_h == screenRect.m_h))
+    {
+        Blitter::clear(screenPixmap);
+    }
+    else
+    {
+        for (const auto& rect : damage.getRectangles())
+        {
+            Blitter::fillRectangle(screenPixmap, rect,
+                    PixelArgb8888(0x00, 0x00, 0x00, 0x00));
+        }
+    }
 
     g_logger.trace("%s - rendering windows", __func__);
 
     class RenderEnumerator : public BackendWindowEnumerator
     {
     public:
-        RenderEnumerator(Pixmap& screenPixmap) :
-                m_screenPixmap(screenPixmap)
+        RenderEnumerator(Pixmap& screenPixmap,
+                         const DamageRegion& damage) :
+                m_screenPixmap(screenPixmap),
+                m_damage(damage)
         {
             // noop
         }
@@ -234,24 +286,52 @@ void WaylandBackendShm::paintPixels(const WaylandBuffer::Ptr& buffer)
             g_logger.trace("%s - pixmap=%p size=%dx%d", __func__, &pixmap,
                     pixmap.getWidth(), pixmap.getHeight());
 
-            // TODO: configurable mode
-            auto mode = Blitter::DrawPosition::CENTER;
-            // auto mode = Blitter::ResizeMode::UPDOWN;
-            // auto mode = Blitter::ResizeMode::UPDOWN_PRESERVE_ASPECT;
-
-            Blitter::write(m_screenPixmap, pixmap, mode,
-                    Blitter::ResizeMode::NO_RESIZE,
-                    Blitter::RenderMode::SMOOTH);
+            const auto screenWidth = m_screenPixmap.getWidth();
+            const auto screenHeight = m_screenPixmap.getHeight();
+
+            // windows larger than the screen are not rendered
+            if ((pixmap.getWidth() > screenWidth)
+                    || (pixmap.getHeight() > screenHeight))
+            {
+                return;
+            }
+
+            // window is placed in the center of the screen
+            const Rectangle windowRect{
+                    (screenWidth - pixmap.getWidth()) / 2,
+                    (screenHeight - pixmap.getHeight()) / 2,
+                    pixmap.getWidth(),
+                    pixmap.getHeight() };
+
+            for (const auto& rect : m_damage.getRectangles())
+            {
+                const auto dstRect = DamageRegion::intersect(rect, windowRect);
+                if (DamageRegion::isEmpty(dstRect))
+                {
+                    continue;
+                }
+
+                const Rectangle srcRect{
+                        dstRect.m_x - windowRect.m_x,
+                        dstRect.m_y - windowRect.m_y,
+                        dstRect.m_w,
+                        dstRect.m_h };
+
+                Blitter::write(m_screenPixmap, pixmap, srcRect, dstRect);
+            }
         }
 
     private:
         Pixmap& m_screenPixmap;
+        const DamageRegion& m_damage;
     };
 
-    RenderEnumerator enumerator(screenPixmap);
+    RenderEnumerator enumerator(screenPixmap, damage);
 
     getListener()->enumerateVisibleWindows(enumerator);
 
+    damage.clear();
+
     g_logger.trace("%s - complete", __func__);
 }
 
@@ -21,6 +21,7 @@
 #ifndef SUBTTXREND_GFX_WAYLAND_BACKEND_SHM_HPP_
 #define SUBTTXREND_GFX_WAYLAND_BACKEND_SHM_HPP_
 
+#include "DamageRegion.hpp"
 #include "WaylandBackend.hpp"
 #include "WaylandBuffer.hpp"
 #include "waylandcpp-client/Shm.hpp"
@@ -78,6 +79,8 @@ private:
     /**
      * Paints the frame pixels.
      *
+     * Only the damaged area of the buffer is repainted.
+     *
      * @param buffer
      *      Buffer to draw on.
      */
@@ -111,6 +114,12 @@ private:
     /** Current size. */
     Size m_currentSize;
 
+    /** Size of the last rendered frame. */
+    Size m_renderedSize;
+
+    /** Damage not yet reported to the compositor. */
+    DamageRegion m_surfaceDamage;
+
     /** Default size. */
     static const Size DEFAULT_SIZE;
 };
@@ -44,6 +44,9 @@ WaylandBuffer::WaylandBuffer(waylandcpp::Buffer1::Ptr buffer,
     g_logger.trace("%s - Created (%p)", __func__, this);
 
     m_buffer->setListener(this);
+
+    const auto& params = m_buffer->getParams();
+    m_damage.add(Rectangle(0, 0, params.m_width, params.m_height));
 }
 
 WaylandBuffer::~WaylandBuffer()
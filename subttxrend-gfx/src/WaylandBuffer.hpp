@@ -27,6 +27,8 @@
 #include "waylandcpp-client/Buffer.hpp"
 #include "waylandcpp-client/Shm.hpp"
 
+#include "DamageRegion.hpp"
+
 namespace subttxrend
 {
 namespace gfx
@@ -114,6 +116,21 @@ public:
         return static_cast<bool>(m_selfPtr);
     }
 
+    /**
+     * Returns area of the buffer that needs to be repainted.
+     *
+     * Buffers are used in rotation so the contents of a buffer lag behind
+     * the screen by all the changes done since the buffer was last painted.
+     * Newly created buffer is damaged completely.
+     *
+     * @return
+     *      Damaged region.
+     */
+    DamageRegion& getDamage()
+    {
+        return m_damage;
+    }
+
 private:
     /** @copydoc waylandcpp::BufferListener::release */
     virtual void release(waylandcpp::BufferPtr object) override;
@@ -128,6 +145,11 @@ private:
      */
     const bool m_empty;
 
+    /**
+     * Area that needs to be repainted.
+     */
+    DamageRegion m_damage;
+
     /**
      * Pointer to self.
      *
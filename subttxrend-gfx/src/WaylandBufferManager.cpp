@@ -63,6 +63,25 @@ WaylandBuffer::Ptr WaylandBufferManager::getBuffer(const Size& size)
     }
 }
 
+void WaylandBufferManager::addDamage(const DamageRegion& damage)
+{
+    for (auto& entry : m_regularBuffers)
+    {
+        entry.m_buffer->getDamage().add(damage);
+    }
+}
+
+void WaylandBufferManager::invalidateBuffers()
+{
+    for (auto& entry : m_regularBuffers)
+    {
+        const auto& params = entry.m_buffer->getParams();
+
+        entry.m_buffer->getDamage().add(
+                Rectangle(0, 0, params.m_width, params.m_height));
+    }
+}
+
 WaylandBuffer::Ptr WaylandBufferManager::getRegularBuffer(const Size& size)
 {
     g_logger.trace("%s - %d x %d", __func__, size.m_w, size.m_h);
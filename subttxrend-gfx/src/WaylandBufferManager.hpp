@@ -63,6 +63,19 @@ public:
      */
     WaylandBuffer::Ptr getBuffer(const Size& size);
 
+    /**
+     * Adds damage to all regular buffers.
+     *
+     * @param damage
+     *      Damaged region.
+     */
+    void addDamage(const DamageRegion& damage);
+
+    /**
+     * Marks all regular buffers as damaged completely.
+     */
+    void invalidateBuffers();
+
 private:
     /** Buffer entry. */
     struct BufferEntry
@@ -28,6 +28,7 @@
 
 #include <codecvt> // newer compilers would have <cuchar>
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 #include <iostream>
@@ -54,6 +55,8 @@ class NullEngineHooks : public EngineHooks
 
 static NullEngineHooks nullEngineHooks;
 
+const PixelArgb8888 TRANSPARENT_COLOR(0x00, 0x00, 0x00, 0x00);
+
 class HooksScopedLock
 {
 public:
@@ -72,11 +75,55 @@ private:
     EngineHooks* m_hooks;
 };
 
+void clearRegion(Pixmap& pixmap,
+                 const DamageRegion& region)
+{
+    const Rectangle pixmapRect{0, 0, pixmap.getWidth(), pixmap.getHeight()};
+
+    const auto bounds = DamageRegion::intersect(region.getBounds(), pixmapRect);
+    if ((bounds.m_w == pixmapRect.m_w) && (bounds.m_h == pixmapRect.m_h))
+    {
+        Blitter::clear(pixmap);
+        return;
+    }
+
+    for (const auto& rect : region.getRectangles())
+    {
+        const auto clipped = DamageRegion::intersect(rect, pixmapRect);
+        if (!DamageRegion::isEmpty(clipped))
+        {
+            Blitter::fillRectangle(pixmap, clipped, TRANSPARENT_COLOR);
+        }
+    }
+}
+
+void copyRegion(Pixmap& dstPixmap,
+                const Pixmap& srcPixmap,
+                const DamageRegion& region)
+{
+    const Rectangle pixmapRect{0, 0,
+            std::min(dstPixmap.getWidth(), srcPixmap.getWidth()),
+            std::min(dstPixmap.getHeight(), srcPixmap.getHeight())};
+
+    for (const auto& rect : region.getRectangles())
+    {
+        const auto clipped = DamageRegion::intersect(rect, pixmapRect);
+        if (!DamageRegion::isEmpty(clipped))
+        {
+            Blitter::write(dstPixmap, srcPixmap, clipped, clipped);
+        }
+    }
+}
+
 }
 
 WindowImpl::WindowImpl() :
         m_visible(false),
         m_hooks(&nullEngineHooks),
+        m_readyFrameNew(false),
+        m_resizePending(false),
+        m_geometryChanged(false),
+        m_retainedMode(false),
         drawDir(DrawDirection::LEFT_TO_RIGHT),
         m_preferredSize{0, 0}
 {
@@ -87,6 +134,9 @@ WindowImpl::WindowImpl() :
 
     m_bgDrawingSurface.reset(new Surface());
     m_bgReadySurface.reset(new Surface());
+
+    m_presentedSurface.reset(new Surface());
+    m_bgPresentedSurface.reset(new Surface());
 }
 
 WindowImpl::~WindowImpl()
@@ -152,8 +202,6 @@ void WindowImpl::setSize(const Size& newSize)
 {
     g_logger.trace("%s w=%d h=%d", __func__, newSize.m_w, newSize.m_h);
 
-    const PixelArgb8888 TRANSPARENT_COLOR(0x00, 0x00, 0x00, 0x00);
-
     HooksScopedLock lock{m_hooks};
 
     m_size = newSize;
@@ -163,6 +211,11 @@ void WindowImpl::setSize(const Size& newSize)
     m_bgReadySurface->resize(newSize.m_w, newSize.m_h, TRANSPARENT_COLOR);
     m_bgDrawingSurface->resize(newSize.m_w, newSize.m_h, TRANSPARENT_COLOR);
 #endif
+
+    // presented surface may be in use by the backend, resized when latched
+    m_readyFrameNew = true;
+    m_resizePending = true;
+
     if (m_visible)
     {
         m_hooks->requestRedraw();
@@ -176,6 +229,9 @@ void WindowImpl::setVisible(bool visible)
     m_visible = visible;
 
     HooksScopedLock lock{m_hooks};
+
+    m_pendingDamage.add(getBounds());
+
     if (m_visible)
     {
         m_hooks->requestRedraw();
@@ -198,6 +254,14 @@ void WindowImpl::update()
 #if BACKEND_TYPE == BACKEND_TYPE_EGL
     std::swap(m_bgDrawingSurface, m_bgReadySurface);
 #endif
+    std::swap(m_drawingContent, m_readyContent);
+
+    m_readyFrameNew = true;
+
+    if (m_retainedMode)
+    {
+        retainContents();
+    }
 
     if (m_visible)
     {
@@ -211,11 +275,47 @@ void WindowImpl::clear()
 
     HooksScopedLock lock{m_hooks};
 
-    Blitter::clear(m_drawingSurface->getPixmap());
-    Blitter::clear(m_bgDrawingSurface->getPixmap());
+    clearRegion(m_drawingSurface->getPixmap(), m_drawingContent);
+#if BACKEND_TYPE == BACKEND_TYPE_EGL
+    clearRegion(m_bgDrawingSurface->getPixmap(), m_drawingContent);
+#endif
+    m_drawingContent.clear();
+
+    m_hooks->requestRedraw();
+}
+
+void WindowImpl::clearRectangle(const Rectangle& rectangle)
+{
+    g_logger.trace("%s - rect=%d,%d,%d,%d", __func__, rectangle.m_x,
+            rectangle.m_y, rectangle.m_w, rectangle.m_h);
+
+    HooksScopedLock lock{m_hooks};
+
+    DamageRegion region;
+    region.add(rectangle);
+
+    clearRegion(m_drawingSurface->getPixmap(), region);
+#if BACKEND_TYPE == BACKEND_TYPE_EGL
+    clearRegion(m_bgDrawingSurface->getPixmap(), region);
+#endif
+
     m_hooks->requestRedraw();
 }
 
+void WindowImpl::setRetainedMode(bool retained)
+{
+    g_logger.trace("%s retained=%d", __func__, retained ? 1 : 0);
+
+    HooksScopedLock lock{m_hooks};
+
+    if (retained && !m_retainedMode)
+    {
+        retainContents();
+    }
+
+    m_retainedMode = retained;
+}
+
 void WindowImpl::setEngineHooks(EngineHooks* hooks)
 {
     if (hooks)
@@ -233,18 +333,62 @@ bool WindowImpl::isVisible() const
     return m_visible;
 }
 
+void WindowImpl::latchFrame()
+{
+    if (!m_readyFrameNew)
+    {
+        return;
+    }
+
+    std::swap(m_readySurface, m_presentedSurface);
+#if BACKEND_TYPE == BACKEND_TYPE_EGL
+    std::swap(m_bgReadySurface, m_bgPresentedSurface);
+#endif
+    std::swap(m_readyContent, m_presentedContent);
+
+    // pixels could change only where either old or new contents are
+    m_pendingDamage.add(m_readyContent);
+    m_pendingDamage.add(m_presentedContent);
+
+    if (m_resizePending)
+    {
+        // previously presented surface is reused for drawing, keep the size
+        m_readySurface->resize(m_size.m_w, m_size.m_h, TRANSPARENT_COLOR);
+#if BACKEND_TYPE == BACKEND_TYPE_EGL
+        m_bgReadySurface->resize(m_size.m_w, m_size.m_h, TRANSPARENT_COLOR);
+#endif
+
+        m_geometryChanged = true;
+        m_resizePending = false;
+    }
+
+    m_readyFrameNew = false;
+}
+
 Pixmap& WindowImpl::getPixmap()
 {
     g_logger.trace("%s", __func__);
 
-    return m_readySurface->getPixmap();
+    return m_presentedSurface->getPixmap();
 }
 
 Pixmap& WindowImpl::getBgPixmap()
 {
     g_logger.trace("%s", __func__);
 
-    return m_bgReadySurface->getPixmap();
+    return m_bgPresentedSurface->getPixmap();
+}
+
+bool WindowImpl::takeDamage(DamageRegion& damage)
+{
+    const bool geometryChanged = m_geometryChanged;
+
+    damage.add(m_pendingDamage);
+
+    m_pendingDamage.clear();
+    m_geometryChanged = false;
+
+    return geometryChanged;
 }
 
 void WindowImpl::processKeyEvent(const KeyEvent& event)
@@ -271,6 +415,35 @@ void WindowImpl::setDrawDirection(DrawDirection dir)
     drawDir = dir;
 }
 
+void WindowImpl::addDrawingContent(const Rectangle& rect)
+{
+    const auto& pixmap = m_drawingSurface->getPixmap();
+
+    m_drawingContent.add(DamageRegion::intersect(rect,
+            Rectangle{0, 0, pixmap.getWidth(), pixmap.getHeight()}));
+}
+
+void WindowImpl::retainContents()
+{
+    // once latched, the last updated contents are in the presented surface
+    const auto& surface = m_readyFrameNew ? m_readySurface : m_presentedSurface;
+    const auto& content = m_readyFrameNew ? m_readyContent : m_presentedContent;
+
+    // stale drawing surface differs from the updated one only where
+    // either of them has contents
+    DamageRegion region;
+    region.add(m_drawingContent);
+    region.add(content);
+
+    copyRegion(m_drawingSurface->getPixmap(), surface->getPixmap(), region);
+#if BACKEND_TYPE == BACKEND_TYPE_EGL
+    const auto& bgSurface = m_readyFrameNew ? m_bgReadySurface : m_bgPresentedSurface;
+    copyRegion(m_bgDrawingSurface->getPixmap(), bgSurface->getPixmap(), region);
+#endif
+
+    m_drawingContent = content;
+}
+
 #define VERBOSE_LOGGING 0
 
 void WindowImpl::fillRectangle(ColorArgb color,
@@ -294,6 +467,7 @@ void WindowImpl::fillRectangle(ColorArgb color,
     Blitter::fillRectangle(m_drawingSurface->getPixmap(), rectangle,
             PixelArgb8888(color.m_a, color.m_r, color.m_g, color.m_b));
 #endif
+    addDrawingContent(rectangle);
 }
 
 void WindowImpl::drawUnderline(ColorArgb color,
@@ -307,6 +481,7 @@ void WindowImpl::drawUnderline(ColorArgb color,
 #endif
     Blitter::fillRectangle(m_drawingSurface->getPixmap(), rectangle,
             PixelArgb8888(color.m_a, color.m_r, color.m_g, color.m_b));
+    addDrawingContent(rectangle);
 }
 
 void WindowImpl::drawPixmap(const ClutBitmap& bitmap,
@@ -324,6 +499,7 @@ void WindowImpl::drawPixmap(const ClutBitmap& bitmap,
     ClutPixmap srcPixmap(bitmap.m_pixels, bitmap.m_width, bitmap.m_height,
             bitmap.m_stride, bitmap.m_clut, bitmap.m_clutSize);
     Blitter::write(m_drawingSurface->getPixmap(), srcPixmap, srcRect, dstRect);
+    addDrawingContent(dstRect);
 }
 
 void WindowImpl::drawBitmap(const Bitmap& bitmap, const Rectangle& dstRect)
@@ -345,6 +521,7 @@ void WindowImpl::drawBitmap(const Bitmap& bitmap, const Rectangle& dstRect)
             Blitter::write(m_drawingSurface->getPixmap(), srcPixmap, srcRect, dstRect);
         }
     }
+    addDrawingContent(dstRect);
 }
 
 void WindowImpl::drawGlyph(const FontStripPtr& fontStrip,
@@ -375,6 +552,7 @@ void WindowImpl::drawGlyph(const FontStripPtr& fontStrip,
 
         Blitter::write(m_drawingSurface->getPixmap(), colorizedPixmap,
                 glyphRect, rect);
+        addDrawingContent(rect);
     }
 }
 
@@ -391,6 +569,7 @@ void WindowImpl::drawString(PrerenderedFont &font_,
     float penY = 0;
     float xStart = 0;
     float yStart = 0;
+    Rectangle stringBounds;
 
 #if VERBOSE_LOGGING
     auto t = g_logger.timing(__func__);
@@ -479,6 +658,7 @@ void WindowImpl::drawString(PrerenderedFont &font_,
 #else
                 Blitter::writeWithBlend(m_drawingSurface->getPixmap(), colorizedPixmap, sourceRect, destinationRect);
 #endif
+                stringBounds = DamageRegion::unite(stringBounds, destinationRect);
             }
 
             switch(drawDir)
@@ -503,6 +683,8 @@ void WindowImpl::drawString(PrerenderedFont &font_,
             g_logger.warning("didn't find glyph for index %d", glyphIndex);
         }
     }
+
+    addDrawingContent(stringBounds);
 }
 
 } // namespace gfx
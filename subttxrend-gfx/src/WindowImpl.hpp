@@ -25,6 +25,7 @@
 
 #include "Window.hpp"
 #include "Surface.hpp"
+#include "DamageRegion.hpp"
 #include "DrawContext.hpp"
 #include "EngineHooks.hpp"
 #include "PrerenderedFontImpl.hpp"
@@ -78,6 +79,12 @@ public:
     /** @copydoc Window::clear */
     virtual void clear() override;
 
+    /** @copydoc Window::clearRectangle */
+    virtual void clearRectangle(const Rectangle& rectangle) override;
+
+    /** @copydoc Window::setRetainedMode */
+    virtual void setRetainedMode(bool retained) override;
+
     /** @copydoc Window::update */
     virtual void update() override;
 
@@ -97,11 +104,20 @@ public:
      */
     bool isVisible() const;
 
+    /**
+     * Makes the most recently updated contents current for presentation.
+     *
+     * Must be called with engine hooks locked, from the backend thread
+     * only. The presented surfaces are not touched by other calls so the
+     * backend may read them without holding the lock.
+     */
+    void latchFrame();
+
     /**
      * Returns window pixmap.
      *
      * @return
-     *      Pixmap.
+     *      Pixmap (presented contents, see latchFrame()).
      */
     Pixmap& getPixmap();
     
@@ -109,10 +125,25 @@ public:
      * Returns window background pixmap.
      *
      * @return
-     *      Pixmap.
+     *      Pixmap (presented contents, see latchFrame()).
      */
     Pixmap& getBgPixmap();
 
+    /**
+     * Takes damage accumulated since the previous call.
+     *
+     * Must be called with engine hooks locked.
+     *
+     * @param damage
+     *      Region to which the damaged areas (in window coordinates)
+     *      are added.
+     *
+     * @return
+     *      True if window geometry changed so the whole screen needs
+     *      to be repainted, false otherwise.
+     */
+    bool takeDamage(DamageRegion& damage);
+
     /**
      * Processes key event.
      *
@@ -166,6 +197,23 @@ private:
 
     virtual void drawBitmap(const Bitmap& bitmap,const Rectangle& dstRect) override;
 
+    /**
+     * Marks area of the drawing surface as modified.
+     *
+     * @param rect
+     *      Modified area (clipped to surface size).
+     */
+    void addDrawingContent(const Rectangle& rect);
+
+    /**
+     * Makes the drawing surface contents equal to the last updated ones.
+     *
+     * These are in the ready surface or, if already latched, in the
+     * presented one. Only the areas where either surface may hold contents
+     * are copied. Must be called with engine hooks locked.
+     */
+    void retainContents();
+
     /** Window visiblity flag. */
     bool m_visible;
 
@@ -187,6 +235,36 @@ private:
     /** Surface for rendering background */
     std::unique_ptr<Surface> m_bgReadySurface;
 
+    /** Surface used by the backend (latched ready surface). */
+    std::unique_ptr<Surface> m_presentedSurface;
+
+    /** Background surface used by the backend. */
+    std::unique_ptr<Surface> m_bgPresentedSurface;
+
+    /** Area of the drawing surface that may hold non-transparent pixels. */
+    DamageRegion m_drawingContent;
+
+    /** Area of the ready surface that may hold non-transparent pixels. */
+    DamageRegion m_readyContent;
+
+    /** Area of the presented surface that may hold non-transparent pixels. */
+    DamageRegion m_presentedContent;
+
+    /** Damage of the presented surface not yet collected by the backend. */
+    DamageRegion m_pendingDamage;
+
+    /** Flag indicating that ready surface holds contents not latched yet. */
+    bool m_readyFrameNew;
+
+    /** Flag indicating that window was resized and the size is not latched yet. */
+    bool m_resizePending;
+
+    /** Flag indicating that window size changed since damage was collected. */
+    bool m_geometryChanged;
+
+    /** Retained mode flag (drawing surface kept in sync with the last updated one). */
+    bool m_retainedMode;
+
     /** Store drawing direction for non-trivial scenarios */
     DrawDirection drawDir;
 
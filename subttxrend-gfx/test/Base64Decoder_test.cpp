@@ -0,0 +1,115 @@
+/*****************************************************************************
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:
+*
+* Copyright 2021 Liberty Global Service B.V.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*****************************************************************************/
+
+#include <cppunit/extensions/HelperMacros.h>
+#include "Base64Decoder.hpp"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+using namespace subttxrend::gfx;
+
+class Base64DecoderTest : public CppUnit::TestFixture
+{
+CPPUNIT_TEST_SUITE( Base64DecoderTest );
+    CPPUNIT_TEST(wholeText);
+    CPPUNIT_TEST(padding);
+    CPPUNIT_TEST(chunks);
+    CPPUNIT_TEST(skippedCharacters);
+    CPPUNIT_TEST(reset);
+CPPUNIT_TEST_SUITE_END();
+
+public:
+    void setUp()
+    {
+        // noop
+    }
+
+    void tearDown()
+    {
+        // noop
+    }
+
+    void wholeText()
+    {
+        CPPUNIT_ASSERT_EQUAL(std::string("Hello, world"), decode("SGVsbG8sIHdvcmxk"));
+        CPPUNIT_ASSERT_EQUAL(std::string(), decode(""));
+
+        std::vector<std::uint8_t> output;
+        Base64Decoder().decode("AP8AgA==", 8, output);
+        CPPUNIT_ASSERT(output == std::vector<std::uint8_t>({0x00, 0xFF, 0x00, 0x80}));
+    }
+
+    void padding()
+    {
+        CPPUNIT_ASSERT_EQUAL(std::string("a"), decode("YQ=="));
+        CPPUNIT_ASSERT_EQUAL(std::string("ab"), decode("YWI="));
+        CPPUNIT_ASSERT_EQUAL(std::string("abc"), decode("YWJj"));
+
+        // incomplete group is dropped
+        CPPUNIT_ASSERT_EQUAL(std::string("abc"), decode("YWJjZA"));
+    }
+
+    void chunks()
+    {
+        const std::string text = "VGhlIHF1aWNrIGJyb3duIGZveCBqdW1wcyBvdmVyIHRoZSBsYXp5IGRvZw==";
+        const std::string expected = "The quick brown fox jumps over the lazy dog";
+
+        for (std::size_t chunkSize = 1; chunkSize <= text.size(); ++chunkSize)
+        {
+            Base64Decoder decoder;
+            std::vector<std::uint8_t> output;
+            for (std::size_t pos = 0; pos < text.size(); pos += chunkSize)
+            {
+                const auto length = std::min(chunkSize, text.size() - pos);
+                decoder.decode(text.data() + pos, length, output);
+            }
+            CPPUNIT_ASSERT_EQUAL(expected, std::string(output.begin(), output.end()));
+        }
+    }
+
+    void skippedCharacters()
+    {
+        CPPUNIT_ASSERT_EQUAL(std::string("Hello, world"), decode("  SGVs\nbG8s\r\n\tIHdv*cmxk \n"));
+    }
+
+    void reset()
+    {
+        Base64Decoder decoder;
+        std::vector<std::uint8_t> output;
+
+        decoder.decode("YWJjZA", 6, output);
+        decoder.reset();
+        output.clear();
+        decoder.decode("YWJj", 4, output);
+
+        CPPUNIT_ASSERT_EQUAL(std::string("abc"), std::string(output.begin(), output.end()));
+    }
+
+private:
+    static std::string decode(const std::string& text)
+    {
+        std::vector<std::uint8_t> output;
+        Base64Decoder().decode(text.data(), text.size(), output);
+        return std::string(output.begin(), output.end());
+    }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION( Base64DecoderTest );
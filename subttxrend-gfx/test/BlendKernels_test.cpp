@@ -0,0 +1,219 @@
+/*****************************************************************************
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:
+*
+* Copyright 2021 Liberty Global Service B.V.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*****************************************************************************/
+
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <vector>
+
+#include "BlendKernels.hpp"
+
+using subttxrend::gfx::BlendKernels;
+using subttxrend::gfx::PixelArgb8888;
+
+class BlendKernelsTest : public CppUnit::TestFixture
+{
+CPPUNIT_TEST_SUITE( BlendKernelsTest );
+    CPPUNIT_TEST(testActiveType);
+    CPPUNIT_TEST(testAllAlphaCombinations);
+    CPPUNIT_TEST(testExtremeColors);
+    CPPUNIT_TEST(testLineLengths);
+CPPUNIT_TEST_SUITE_END();
+
+public:
+    void setUp()
+    {
+        m_random = 0x12345678;
+
+        m_types.clear();
+        for (auto type : { BlendKernels::Type::SCALAR, BlendKernels::Type::SSE2,
+                BlendKernels::Type::AVX2, BlendKernels::Type::NEON })
+        {
+            if (BlendKernels::isSupported(type))
+            {
+                m_types.push_back(type);
+            }
+        }
+    }
+
+    void tearDown()
+    {
+        // noop
+    }
+
+    void testActiveType()
+    {
+        CPPUNIT_ASSERT(BlendKernels::isSupported(BlendKernels::Type::SCALAR));
+        CPPUNIT_ASSERT(BlendKernels::isSupported(BlendKernels::getActiveType()));
+        CPPUNIT_ASSERT(BlendKernels::getName(BlendKernels::getActiveType()) != nullptr);
+    }
+
+    void testAllAlphaCombinations()
+    {
+        std::vector<PixelArgb8888> src(256);
+        std::vector<PixelArgb8888> dst(256);
+
+        for (int round = 0; round < 4; ++round)
+        {
+            for (int srcAlpha = 0; srcAlpha < 256; ++srcAlpha)
+            {
+                for (int dstAlpha = 0; dstAlpha < 256; ++dstAlpha)
+                {
+                    src[dstAlpha] = randomPixel(srcAlpha);
+                    dst[dstAlpha] = randomPixel(dstAlpha);
+                }
+
+                checkAllKernels(src, dst);
+            }
+        }
+    }
+
+    void testExtremeColors()
+    {
+        const std::uint8_t values[] = { 0x00, 0x01, 0x7F, 0x80, 0xFE, 0xFF };
+
+        std::vector<PixelArgb8888> src;
+        std::vector<PixelArgb8888> dst;
+
+        for (auto sa : values)
+        {
+            for (auto sc : values)
+            {
+                for (auto da : values)
+                {
+                    for (auto dc : values)
+                    {
+                        src.push_back(PixelArgb8888(sa, sc, 255 - sc, sc));
+                        dst.push_back(PixelArgb8888(da, dc, dc, 255 - dc));
+                    }
+                }
+            }
+        }
+
+        checkAllKernels(src, dst);
+    }
+
+    void testLineLengths()
+    {
+        for (std::size_t offset = 0; offset < 4; ++offset)
+        {
+            for (std::size_t count = 0; count < 40; ++count)
+            {
+                std::vector<PixelArgb8888> src(offset + count + 1);
+                std::vector<PixelArgb8888> dst(offset + count + 1);
+
+                for (std::size_t i = 0; i < src.size(); ++i)
+                {
+                    src[i] = randomPixel(nextRandom() & 0xFF);
+                    dst[i] = randomPixel(nextRandom() & 0xFF);
+                }
+
+                for (auto type : m_types)
+                {
+                    auto expected = dst;
+                    auto actual = dst;
+
+                    blendReference(expected.data() + offset, src.data() + offset, count);
+                    BlendKernels::blendLine(type, actual.data() + offset, src.data() + offset, count);
+
+                    // pixels outside of the line must stay untouched
+                    for (std::size_t i = 0; i < actual.size(); ++i)
+                    {
+                        CPPUNIT_ASSERT(toColor(actual[i]) == toColor(expected[i]));
+                    }
+                }
+            }
+        }
+    }
+
+private:
+    void checkAllKernels(const std::vector<PixelArgb8888>& src,
+                         const std::vector<PixelArgb8888>& dst)
+    {
+        auto expected = dst;
+        blendReference(expected.data(), src.data(), src.size());
+
+        for (auto type : m_types)
+        {
+            auto actual = dst;
+            BlendKernels::blendLine(type, actual.data(), src.data(), src.size());
+
+            for (std::size_t i = 0; i < actual.size(); ++i)
+            {
+                CPPUNIT_ASSERT_EQUAL(toColor(expected[i]), toColor(actual[i]));
+            }
+        }
+    }
+
+    /**
+     * Reference implementation (original Blitter::alphaBlendLine).
+     */
+    static void blendReference(PixelArgb8888* dst,
+                               const PixelArgb8888* src,
+                               std::size_t count)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            PixelArgb8888 srcPix = src[i];
+            PixelArgb8888 dstPix = dst[i];
+
+            const std::uint8_t dstAlpha_1_minus_srcAlpha = dstPix.m_a * (255 - srcPix.m_a) / 255;
+            const std::uint8_t outAlpha = srcPix.m_a + dstAlpha_1_minus_srcAlpha;
+
+            if (outAlpha > 0)
+            {
+                dstPix.m_b = (srcPix.m_b * srcPix.m_a + dstPix.m_b * dstAlpha_1_minus_srcAlpha) / outAlpha;
+                dstPix.m_g = (srcPix.m_g * srcPix.m_a + dstPix.m_g * dstAlpha_1_minus_srcAlpha) / outAlpha;
+                dstPix.m_r = (srcPix.m_r * srcPix.m_a + dstPix.m_r * dstAlpha_1_minus_srcAlpha) / outAlpha;
+            }
+            else
+            {
+                dstPix.m_b = 0;
+                dstPix.m_g = 0;
+                dstPix.m_r = 0;
+            }
+
+            dstPix.m_a = outAlpha;
+            dst[i] = dstPix;
+        }
+    }
+
+    static std::uint32_t toColor(const PixelArgb8888& pixel)
+    {
+        return (static_cast<std::uint32_t>(pixel.m_a) << 24) | (pixel.m_r << 16) | (pixel.m_g << 8) | pixel.m_b;
+    }
+
+    std::uint32_t nextRandom()
+    {
+        m_random = m_random * 1103515245 + 12345;
+        return m_random >> 8;
+    }
+
+    PixelArgb8888 randomPixel(int alpha)
+    {
+        const auto value = nextRandom();
+        return PixelArgb8888(alpha, value & 0xFF, (value >> 8) & 0xFF, (value >> 16) & 0xFF);
+    }
+
+    std::uint32_t m_random;
+
+    std::vector<BlendKernels::Type> m_types;
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION( BlendKernelsTest );
@@ -0,0 +1,157 @@
+/*****************************************************************************
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:
+*
+* Copyright 2021 Liberty Global Service B.V.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*****************************************************************************/
+/*
+ * Micro-benchmark of ClutPixmap to Pixmap conversion.
+ *
+ * Compares the generic per-pixel iterator copy previously used by
+ * Blitter::pixmapBitBlit with the pre-expanded CLUT line conversion, on a
+ * full HD subtitle-like bitmap (mostly transparent with text runs). Not a
+ * unit test, run manually: ClutBlit_Benchmark [iterations]
+ */
+
+#include "ClutPixmap.hpp"
+#include "Pixmap.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+using namespace subttxrend::gfx;
+
+namespace
+{
+
+const std::int32_t WIDTH = 1920;
+const std::int32_t HEIGHT = 1080;
+
+/**
+ * Builds 8bpp bitmap resembling DVB subtitles: transparent background with
+ * two text rows of short opaque and antialiased runs.
+ */
+std::vector<std::uint8_t> makeBitmap()
+{
+    std::vector<std::uint8_t> bitmap(WIDTH * HEIGHT, 0);
+
+    std::uint32_t seed = 12345;
+    for (std::int32_t y = 0; y < HEIGHT; ++y)
+    {
+        const bool textRow = ((y >= 840) && (y < 900)) || ((y >= 920) && (y < 980));
+        if (!textRow)
+        {
+            continue;
+        }
+
+        std::int32_t x = 300;
+        while (x < WIDTH - 300)
+        {
+            seed = seed * 1103515245 + 12345;
+            const std::int32_t r = (seed >> 16) & 0x7FFF;
+
+            const std::int32_t gap = r % 12;
+            const std::int32_t run = 1 + (r >> 4) % 6;
+            x += gap;
+            for (std::int32_t i = 0; (i < run) && (x < WIDTH - 300); ++i, ++x)
+            {
+                bitmap[y * WIDTH + x] = static_cast<std::uint8_t>(1 + (r >> 8) % 15);
+            }
+        }
+    }
+
+    return bitmap;
+}
+
+template<typename Function>
+double measureNs(std::size_t operations,
+                 Function function)
+{
+    const auto start = std::chrono::steady_clock::now();
+    function();
+    const auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / operations;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    std::size_t iterations = 50;
+    if (argc > 1)
+    {
+        iterations = std::strtoul(argv[1], nullptr, 10);
+    }
+
+    auto values = makeBitmap();
+
+    std::vector<std::uint32_t> clut(16);
+    clut[0] = 0x00000000;
+    for (std::size_t i = 1; i < clut.size(); ++i)
+    {
+        const std::uint32_t alpha = 0x40 + i * 0x0C;
+        clut[i] = (alpha << 24) | 0xFFFFFF;
+    }
+
+    ClutPixmap source(values.data(), WIDTH, HEIGHT, WIDTH, clut.data(), clut.size());
+
+    std::vector<std::uint8_t> buffer(WIDTH * HEIGHT * 4);
+    Pixmap target(buffer.data(), WIDTH, HEIGHT, WIDTH * 4);
+
+    const std::size_t operations = iterations * WIDTH * HEIGHT;
+    std::uint32_t checksum = 0;
+
+    const double genericNs = measureNs(operations, [&]()
+    {
+        for (std::size_t i = 0; i < iterations; ++i)
+        {
+            for (std::int32_t y = 0; y < HEIGHT; ++y)
+            {
+                auto srcIterator = source.getLine(y);
+                auto dstIterator = target.getLine(y);
+                for (std::int32_t x = 0; x < WIDTH; ++x, ++srcIterator, ++dstIterator)
+                {
+                    *dstIterator = *srcIterator;
+                }
+            }
+            checksum += target.getLine(900)->m_a;
+        }
+    });
+
+    const double expandedNs = measureNs(operations, [&]()
+    {
+        for (std::size_t i = 0; i < iterations; ++i)
+        {
+            ClutPixmap::ExpandedClut table;
+            source.expandClut(table);
+
+            for (std::int32_t y = 0; y < HEIGHT; ++y)
+            {
+                ClutPixmap::convertLine(table, source.getLine(y).ptr(),
+                        target.getLine(y).ptr(), WIDTH);
+            }
+            checksum += target.getLine(900)->m_a;
+        }
+    });
+
+    std::printf("ClutPixmap -> Pixmap blit (%dx%d):\n", WIDTH, HEIGHT);
+    std::printf("  generic iterator  %6.3f ns/pixel\n", genericNs);
+    std::printf("  expanded CLUT     %6.3f ns/pixel\n", expandedNs);
+    std::printf("  (checksum %x)\n", checksum & 0xF);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,162 @@
+/*****************************************************************************
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:
+*
+* Copyright 2021 Liberty Global Service B.V.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*****************************************************************************/
+
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <vector>
+
+#include "ClutPixmap.hpp"
+
+using subttxrend::gfx::ClutPixmap;
+using subttxrend::gfx::PixelArgb8888;
+
+class ClutPixmapTest : public CppUnit::TestFixture
+{
+CPPUNIT_TEST_SUITE( ClutPixmapTest );
+    CPPUNIT_TEST(testExpandedClut);
+    CPPUNIT_TEST(testConvertLine);
+    CPPUNIT_TEST(testNoTransparentValue);
+CPPUNIT_TEST_SUITE_END();
+
+public:
+    void setUp()
+    {
+        m_random = 0x12345678;
+    }
+
+    void tearDown()
+    {
+        // noop
+    }
+
+    void testExpandedClut()
+    {
+        std::vector<std::uint32_t> clut;
+        for (int i = 0; i < 16; ++i)
+        {
+            clut.push_back(nextRandom());
+        }
+        clut[0] = 0x80FF4020;
+        clut[5] = 0x00000000;
+
+        std::vector<std::uint8_t> values;
+        for (int i = 0; i < 256; ++i)
+        {
+            values.push_back(static_cast<std::uint8_t>(i));
+        }
+
+        ClutPixmap pixmap(values.data(), 256, 1, 256, clut.data(), clut.size());
+
+        ClutPixmap::ExpandedClut table;
+        pixmap.expandClut(table);
+
+        CPPUNIT_ASSERT_EQUAL(5, table.m_transparentValue);
+
+        auto iter = pixmap.getLine(0);
+        for (int i = 0; i < 256; ++i, ++iter)
+        {
+            assertEqual(*iter, table.m_colors[i]);
+        }
+    }
+
+    void testConvertLine()
+    {
+        std::vector<std::uint32_t> clut =
+        { 0x00000000, 0xFFFFFFFF, 0x80102030, 0xFF000000 };
+
+        // transparent runs of various lengths and alignments
+        std::vector<std::uint8_t> values;
+        for (int run = 0; run < 40; ++run)
+        {
+            values.insert(values.end(), run, 0);
+            values.insert(values.end(), run % 5 + 1, 1 + run % 3);
+            values.push_back(7);
+        }
+
+        ClutPixmap pixmap(values.data(), values.size(), 1, values.size(),
+                clut.data(), clut.size());
+
+        ClutPixmap::ExpandedClut table;
+        pixmap.expandClut(table);
+        CPPUNIT_ASSERT_EQUAL(0, table.m_transparentValue);
+
+        for (std::size_t offset = 0; offset < 8; ++offset)
+        {
+            const std::size_t count = values.size() - offset;
+            std::vector<PixelArgb8888> result(count + 1,
+                    PixelArgb8888(0x12345678));
+
+            ClutPixmap::convertLine(table, values.data() + offset,
+                    result.data(), count);
+
+            auto iter = pixmap.getLine(0) + static_cast<int>(offset);
+            for (std::size_t i = 0; i < count; ++i, ++iter)
+            {
+                assertEqual(*iter, result[i]);
+            }
+
+            // nothing written beyond the line
+            assertEqual(PixelArgb8888(0x12345678), result[count]);
+        }
+    }
+
+    void testNoTransparentValue()
+    {
+        std::vector<std::uint32_t> clut(256, 0xFF102030);
+
+        std::vector<std::uint8_t> values(100, 0);
+
+        ClutPixmap pixmap(values.data(), values.size(), 1, values.size(),
+                clut.data(), clut.size());
+
+        ClutPixmap::ExpandedClut table;
+        pixmap.expandClut(table);
+        CPPUNIT_ASSERT_EQUAL(-1, table.m_transparentValue);
+
+        std::vector<PixelArgb8888> result(values.size());
+        ClutPixmap::convertLine(table, values.data(), result.data(),
+                result.size());
+
+        for (const auto& pixel : result)
+        {
+            assertEqual(PixelArgb8888(0xFF102030), pixel);
+        }
+    }
+
+private:
+    void assertEqual(const PixelArgb8888& expected,
+                     const PixelArgb8888& actual)
+    {
+        CPPUNIT_ASSERT_EQUAL(static_cast<int>(expected.m_a), static_cast<int>(actual.m_a));
+        CPPUNIT_ASSERT_EQUAL(static_cast<int>(expected.m_r), static_cast<int>(actual.m_r));
+        CPPUNIT_ASSERT_EQUAL(static_cast<int>(expected.m_g), static_cast<int>(actual.m_g));
+        CPPUNIT_ASSERT_EQUAL(static_cast<int>(expected.m_b), static_cast<int>(actual.m_b));
+    }
+
+    std::uint32_t nextRandom()
+    {
+        m_random = m_random * 1103515245 + 12345;
+        return (m_random >> 16) | (m_random << 16);
+    }
+
+    std::uint32_t m_random;
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION( ClutPixmapTest );
@@ -0,0 +1,205 @@
+/*****************************************************************************
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:
+*
+* Copyright 2021 Liberty Global Service B.V.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*****************************************************************************/
+
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <vector>
+
+#include "DamageRegion.hpp"
+
+using subttxrend::gfx::DamageRegion;
+using subttxrend::gfx::Rectangle;
+
+class DamageRegionTest : public CppUnit::TestFixture
+{
+CPPUNIT_TEST_SUITE( DamageRegionTest );
+    CPPUNIT_TEST(testEmpty);
+    CPPUNIT_TEST(testAddContained);
+    CPPUNIT_TEST(testBounds);
+    CPPUNIT_TEST(testClip);
+    CPPUNIT_TEST(testTranslate);
+    CPPUNIT_TEST(testIntersectUnite);
+    CPPUNIT_TEST(testLimitCoversAllAreas);
+CPPUNIT_TEST_SUITE_END();
+
+public:
+    void setUp()
+    {
+        // noop
+    }
+
+    void tearDown()
+    {
+        // noop
+    }
+
+    void testEmpty()
+    {
+        DamageRegion region;
+
+        CPPUNIT_ASSERT(region.isEmpty());
+
+        region.add(Rectangle(10, 10, 0, 5));
+        region.add(Rectangle(10, 10, 5, 0));
+        region.add(Rectangle(10, 10, -1, 5));
+        CPPUNIT_ASSERT(region.isEmpty());
+
+        region.add(Rectangle(10, 10, 5, 5));
+        CPPUNIT_ASSERT(!region.isEmpty());
+
+        region.clear();
+        CPPUNIT_ASSERT(region.isEmpty());
+        CPPUNIT_ASSERT(DamageRegion::isEmpty(region.getBounds()));
+    }
+
+    void testAddContained()
+    {
+        DamageRegion region;
+
+        region.add(Rectangle(10, 10, 20, 20));
+        region.add(Rectangle(15, 15, 5, 5));
+        CPPUNIT_ASSERT_EQUAL(std::size_t(1), region.getRectangles().size());
+
+        region.add(Rectangle(100, 100, 5, 5));
+        region.add(Rectangle(0, 0, 50, 50));
+        CPPUNIT_ASSERT_EQUAL(std::size_t(2), region.getRectangles().size());
+        CPPUNIT_ASSERT(covers(region, Rectangle(0, 0, 50, 50)));
+        CPPUNIT_ASSERT(covers(region, Rectangle(100, 100, 5, 5)));
+    }
+
+    void testBounds()
+    {
+        DamageRegion region;
+
+        region.add(Rectangle(10, 20, 5, 5));
+        region.add(Rectangle(100, 5, 10, 10));
+
+        checkRect(Rectangle(10, 5, 100, 20), region.getBounds());
+    }
+
+    void testClip()
+    {
+        DamageRegion region;
+
+        region.add(Rectangle(-10, -10, 20, 20));
+        region.add(Rectangle(90, 40, 20, 20));
+        region.add(Rectangle(200, 200, 20, 20));
+
+        region.clip(Rectangle(0, 0, 100, 50));
+
+        CPPUNIT_ASSERT_EQUAL(std::size_t(2), region.getRectangles().size());
+        checkRect(Rectangle(0, 0, 10, 10), region.getRectangles()[0]);
+        checkRect(Rectangle(90, 40, 10, 10), region.getRectangles()[1]);
+    }
+
+    void testTranslate()
+    {
+        DamageRegion region;
+
+        region.add(Rectangle(10, 20, 5, 5));
+        region.translate(-5, 100);
+
+        checkRect(Rectangle(5, 120, 5, 5), region.getBounds());
+    }
+
+    void testIntersectUnite()
+    {
+        checkRect(Rectangle(5, 5, 5, 5),
+                DamageRegion::intersect(Rectangle(0, 0, 10, 10),
+                        Rectangle(5, 5, 10, 10)));
+        CPPUNIT_ASSERT(DamageRegion::isEmpty(
+                DamageRegion::intersect(Rectangle(0, 0, 10, 10),
+                        Rectangle(10, 0, 10, 10))));
+
+        checkRect(Rectangle(0, 0, 15, 15),
+                DamageRegion::unite(Rectangle(0, 0, 10, 10),
+                        Rectangle(5, 5, 10, 10)));
+        checkRect(Rectangle(5, 5, 10, 10),
+                DamageRegion::unite(Rectangle(),
+                        Rectangle(5, 5, 10, 10)));
+    }
+
+    void testLimitCoversAllAreas()
+    {
+        DamageRegion region;
+        std::vector<Rectangle> added;
+
+        std::uint32_t random = 0x12345678;
+        for (int i = 0; i < 200; ++i)
+        {
+            random = random * 1103515245 + 12345;
+            Rectangle rect((random >> 8) % 1800, (random >> 16) % 1000,
+                    1 + (random >> 4) % 100, 1 + (random >> 12) % 60);
+
+            region.add(rect);
+            added.push_back(rect);
+
+            CPPUNIT_ASSERT(region.getRectangles().size()
+                    <= DamageRegion::MAX_RECTANGLES);
+        }
+
+        for (const auto& rect : added)
+        {
+            CPPUNIT_ASSERT(covers(region, rect));
+        }
+    }
+
+private:
+    static void checkRect(const Rectangle& expected,
+                          const Rectangle& actual)
+    {
+        CPPUNIT_ASSERT_EQUAL(expected.m_x, actual.m_x);
+        CPPUNIT_ASSERT_EQUAL(expected.m_y, actual.m_y);
+        CPPUNIT_ASSERT_EQUAL(expected.m_w, actual.m_w);
+        CPPUNIT_ASSERT_EQUAL(expected.m_h, actual.m_h);
+    }
+
+    /**
+     * Checks that every pixel of the rectangle is covered by the region.
+     */
+    static bool covers(const DamageRegion& region,
+                       const Rectangle& rect)
+    {
+        for (int y = rect.m_y; y < rect.m_y + rect.m_h; ++y)
+        {
+            for (int x = rect.m_x; x < rect.m_x + rect.m_w; ++x)
+            {
+                bool found = false;
+                for (const auto& current : region.getRectangles())
+                {
+                    if ((x >= current.m_x) && (x < current.m_x + current.m_w)
+                            && (y >= current.m_y)
+                            && (y < current.m_y + current.m_h))
+                    {
+                        found = true;
+                        break;
+                    }
+                }
+                if (!found)
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION( DamageRegionTest );
@@ -0,0 +1,140 @@
+/*****************************************************************************
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:
+*
+* Copyright 2021 Liberty Global Service B.V.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*****************************************************************************/
+
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <vector>
+
+#include "FillKernels.hpp"
+
+using subttxrend::gfx::FillKernels;
+using subttxrend::gfx::PixelArgb8888;
+
+class FillKernelsTest : public CppUnit::TestFixture
+{
+CPPUNIT_TEST_SUITE( FillKernelsTest );
+    CPPUNIT_TEST(testActiveType);
+    CPPUNIT_TEST(testLineLengths);
+    CPPUNIT_TEST(testRectangleWithPadding);
+    CPPUNIT_TEST(testRectangleContiguous);
+CPPUNIT_TEST_SUITE_END();
+
+public:
+    void setUp()
+    {
+        m_types.clear();
+        for (auto type : { FillKernels::Type::SCALAR, FillKernels::Type::SSE2,
+                FillKernels::Type::NEON })
+        {
+            if (FillKernels::isSupported(type))
+            {
+                m_types.push_back(type);
+            }
+        }
+    }
+
+    void tearDown()
+    {
+        // noop
+    }
+
+    void testActiveType()
+    {
+        CPPUNIT_ASSERT(FillKernels::isSupported(FillKernels::Type::SCALAR));
+        CPPUNIT_ASSERT(FillKernels::isSupported(FillKernels::getActiveType()));
+        CPPUNIT_ASSERT(FillKernels::getName(FillKernels::getActiveType()) != nullptr);
+    }
+
+    void testLineLengths()
+    {
+        const std::uint32_t colors[] = { 0x00000000, 0xFFFFFFFF, 0x80402010, 0xFF0000FF };
+
+        for (auto type : m_types)
+        {
+            for (auto color : colors)
+            {
+                for (std::size_t offset = 0; offset < 4; ++offset)
+                {
+                    for (std::size_t count = 0; count < 70; ++count)
+                    {
+                        std::vector<std::uint32_t> pixels(offset + count + 1, BACKGROUND);
+
+                        FillKernels::fillLine(type, asPixels(pixels.data() + offset),
+                                PixelArgb8888(color), count);
+
+                        for (std::size_t i = 0; i < pixels.size(); ++i)
+                        {
+                            const bool inside = (i >= offset) && (i < offset + count);
+                            CPPUNIT_ASSERT_EQUAL_MESSAGE(FillKernels::getName(type),
+                                    inside ? color : BACKGROUND, pixels[i]);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    void testRectangleWithPadding()
+    {
+        const std::size_t stridePixels = 40;
+        std::vector<std::uint32_t> pixels(stridePixels * 10, BACKGROUND);
+
+        // rectangle 3,2 - 33x5
+        FillKernels::fillRectangle(asPixels(pixels.data() + 2 * stridePixels + 3),
+                stridePixels * 4, 33, 5, PixelArgb8888(0x12345678));
+
+        for (std::size_t y = 0; y < 10; ++y)
+        {
+            for (std::size_t x = 0; x < stridePixels; ++x)
+            {
+                const bool inside = (x >= 3) && (x < 36) && (y >= 2) && (y < 7);
+                CPPUNIT_ASSERT_EQUAL(inside ? 0x12345678U : BACKGROUND,
+                        pixels[y * stridePixels + x]);
+            }
+        }
+    }
+
+    void testRectangleContiguous()
+    {
+        std::vector<std::uint32_t> pixels(17 * 9 + 1, BACKGROUND);
+
+        FillKernels::fillRectangle(asPixels(pixels.data()), 17 * 4, 17, 9,
+                PixelArgb8888(0));
+
+        for (std::size_t i = 0; i < pixels.size(); ++i)
+        {
+            CPPUNIT_ASSERT_EQUAL((i < 17 * 9) ? 0U : BACKGROUND, pixels[i]);
+        }
+    }
+
+private:
+    static PixelArgb8888* asPixels(std::uint32_t* data)
+    {
+        return reinterpret_cast<PixelArgb8888*>(data);
+    }
+
+    static const std::uint32_t BACKGROUND = 0xDEADBEEF;
+
+    std::vector<FillKernels::Type> m_types;
+};
+
+const std::uint32_t FillKernelsTest::BACKGROUND;
+
+CPPUNIT_TEST_SUITE_REGISTRATION( FillKernelsTest );
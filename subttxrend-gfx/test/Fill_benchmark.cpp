@@ -0,0 +1,145 @@
+/*****************************************************************************
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:
+*
+* Copyright 2021 Liberty Global Service B.V.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*****************************************************************************/
+/*
+ * Micro-benchmark of surface clear and rectangle fill.
+ *
+ * Compares the per-line / per-pixel iterator loops previously used by
+ * Blitter::clear and Blitter::fillRectangle with FillKernels on 1080p and
+ * 4K surfaces. Not a unit test, run manually: Fill_Benchmark [iterations]
+ */
+
+#include "FillKernels.hpp"
+#include "Pixmap.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+using namespace subttxrend::gfx;
+
+namespace
+{
+
+template<typename Function>
+double measureUs(std::size_t iterations,
+                 Function function)
+{
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < iterations; ++i)
+    {
+        function();
+    }
+    const auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(end - start).count() / iterations;
+}
+
+void benchmark(const char* name,
+               std::int32_t width,
+               std::int32_t height,
+               std::size_t iterations)
+{
+    std::vector<std::uint8_t> buffer(width * height * 4);
+    Pixmap pixmap(buffer.data(), width, height, width * 4);
+
+    // caption background box (lower third)
+    const std::int32_t boxX = width / 8;
+    const std::int32_t boxY = height * 3 / 4;
+    const std::int32_t boxW = width * 3 / 4;
+    const std::int32_t boxH = height / 6;
+    const PixelArgb8888 boxColor(0xC0, 0x10, 0x10, 0x10);
+
+    const double clearLines = measureUs(iterations, [&]()
+    {
+        for (std::int32_t y = 0; y < height; ++y)
+        {
+            auto line = pixmap.getLine(y);
+            (void) std::memset(line.ptr(), 0, width * 4);
+        }
+    });
+
+    const double clearKernel = measureUs(iterations, [&]()
+    {
+        FillKernels::fillRectangle(pixmap.getLine(0).ptr(), pixmap.getStride(),
+                width, height, PixelArgb8888(0));
+    });
+
+    const double fillPixels = measureUs(iterations, [&]()
+    {
+        for (std::int32_t y = boxY; y < boxY + boxH; ++y)
+        {
+            auto line = pixmap.getLine(y) + boxX;
+            for (std::int32_t x = 0; x < boxW; ++x)
+            {
+                *line = boxColor;
+                ++line;
+            }
+        }
+    });
+
+    const double fillKernel = measureUs(iterations, [&]()
+    {
+        FillKernels::fillRectangle((pixmap.getLine(boxY) + boxX).ptr(),
+                pixmap.getStride(), boxW, boxH, boxColor);
+    });
+
+    const double fillFullPixels = measureUs(iterations, [&]()
+    {
+        for (std::int32_t y = 0; y < height; ++y)
+        {
+            auto line = pixmap.getLine(y);
+            for (std::int32_t x = 0; x < width; ++x)
+            {
+                *line = boxColor;
+                ++line;
+            }
+        }
+    });
+
+    const double fillFullKernel = measureUs(iterations, [&]()
+    {
+        FillKernels::fillRectangle(pixmap.getLine(0).ptr(), pixmap.getStride(),
+                width, height, boxColor);
+    });
+
+    std::printf("%s (%dx%d):\n", name, width, height);
+    std::printf("  clear             per-line %8.1f us  kernel %8.1f us\n", clearLines, clearKernel);
+    std::printf("  fill caption box  per-pixel %7.1f us  kernel %8.1f us\n", fillPixels, fillKernel);
+    std::printf("  fill whole        per-pixel %7.1f us  kernel %8.1f us\n", fillFullPixels, fillFullKernel);
+    std::printf("  (checksum %x)\n", buffer[(boxY * width + boxX) * 4] & 0xF);
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    std::size_t iterations = 50;
+    if (argc > 1)
+    {
+        iterations = std::strtoul(argv[1], nullptr, 10);
+    }
+
+    std::printf("fill kernel: %s\n", FillKernels::getName(FillKernels::getActiveType()));
+
+    benchmark("1080p", 1920, 1080, iterations);
+    benchmark("4K", 3840, 2160, iterations);
+
+    return EXIT_SUCCESS;
+}
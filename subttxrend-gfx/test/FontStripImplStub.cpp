@@ -0,0 +1,84 @@
+/*****************************************************************************
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:
+*
+* Copyright 2021 Liberty Global Service B.V.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*****************************************************************************/
+
+/*
+ * Test implementation of FontStripImpl, without fontconfig and FreeType.
+ *
+ * Font file lookup returns the given name unchanged, fonts cannot be
+ * loaded and the strip pixmap is empty.
+ */
+
+#include "FontStripImpl.hpp"
+
+namespace subttxrend
+{
+namespace gfx
+{
+
+FontStripImpl::FontStripImpl(const Size& glyphSize,
+                             const std::size_t glyphCount) :
+        m_glyphSize(glyphSize),
+        m_glyphCount(glyphCount)
+{
+    // noop
+}
+
+FontStripImpl::~FontStripImpl()
+{
+    // noop
+}
+
+bool FontStripImpl::loadFont(const std::string& fontName,
+                             const Size& charSize,
+                             const FontStripMap& charMap)
+{
+    (void) fontName;
+    (void) charSize;
+    (void) charMap;
+    return false;
+}
+
+bool FontStripImpl::loadGlyph(std::int32_t glyphIndex,
+                              const std::uint8_t* data,
+                              const std::size_t size)
+{
+    (void) glyphIndex;
+    (void) data;
+    (void) size;
+    return false;
+}
+
+const AlphaPixmap& FontStripImpl::getPixmap() const
+{
+    return m_surface.getPixmap();
+}
+
+Rectangle FontStripImpl::getGlyphRect(std::int32_t glyphIndex) const
+{
+    (void) glyphIndex;
+    return Rectangle(0, 0, 0, 0);
+}
+
+std::string FontStripImpl::findFontFile(const std::string& fontName)
+{
+    return fontName;
+}
+
+} // namespace gfx
+} // namespace subttxrend
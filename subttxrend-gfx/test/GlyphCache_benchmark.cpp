@@ -0,0 +1,258 @@
+/*****************************************************************************
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:
+*
+* Copyright 2021 Liberty Global Service B.V.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*****************************************************************************/
+
+/*
+ * Micro-benchmark of the glyph cache structures used by PrerenderedFontImpl.
+ *
+ * Measures glyph information lookup time (std::map vs GlyphInfoMap) and
+ * the atlas fill rate (row packing vs skyline packing). Not a unit test,
+ * run manually: GlyphCache_Benchmark [iterations]
+ */
+
+#include "GlyphInfoMap.hpp"
+#include "SkylinePacker.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <vector>
+
+using namespace subttxrend::gfx;
+
+namespace
+{
+
+/** Benchmark value, same size as CharacterInformation. */
+struct Info
+{
+    std::int32_t data[8];
+    const void* surface;
+};
+
+/** Glyph size. */
+struct GlyphSize
+{
+    std::int32_t w;
+    std::int32_t h;
+};
+
+/**
+ * Builds glyph index sequence resembling subtitle text: mostly Latin
+ * letters with some glyphs at high indices (accents, other scripts).
+ */
+std::vector<std::uint32_t> makeText(std::size_t length)
+{
+    std::vector<std::uint32_t> text;
+    text.reserve(length);
+
+    std::uint32_t seed = 12345;
+    for (std::size_t i = 0; i < length; ++i)
+    {
+        seed = seed * 1103515245 + 12345;
+        const std::uint32_t r = (seed >> 16) & 0x7FFF;
+        text.push_back(((r % 10) == 0) ? (300 + r % 700) : (32 + r % 95));
+    }
+    return text;
+}
+
+/**
+ * Builds glyph sizes for given font height.
+ */
+std::vector<GlyphSize> makeGlyphs(std::int32_t fontHeight,
+                                  std::size_t count)
+{
+    std::vector<GlyphSize> glyphs;
+    glyphs.reserve(count);
+
+    std::uint32_t seed = 54321;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        seed = seed * 1103515245 + 12345;
+        const std::int32_t r = (seed >> 16) & 0x7FFF;
+
+        // lower case letters, capitals with ascenders and punctuation
+        const std::int32_t h = (r % 3 == 0) ? fontHeight * 3 / 4
+                             : (r % 3 == 1) ? fontHeight / 2
+                             : fontHeight / 5 + 1;
+        const std::int32_t w = fontHeight / 4 + (r % (fontHeight / 2 + 1));
+        glyphs.push_back(GlyphSize{w + 1, h + 1});
+    }
+    return glyphs;
+}
+
+/**
+ * Row packing as previously used by the font atlas.
+ */
+std::size_t packRows(std::int32_t size,
+                     const std::vector<GlyphSize>& glyphs,
+                     double& fillRate)
+{
+    std::int32_t rowX = 0;
+    std::int32_t rowY = 0;
+    std::int32_t rowHeight = 0;
+    std::int64_t used = 0;
+    std::size_t packed = 0;
+
+    for (const auto& glyph : glyphs)
+    {
+        if (rowX + glyph.w >= size)
+        {
+            rowY += rowHeight;
+            rowX = 0;
+            rowHeight = 0;
+        }
+        if (rowY + glyph.h >= size)
+        {
+            break;
+        }
+        rowX += glyph.w;
+        rowHeight = std::max(rowHeight, glyph.h);
+        used += glyph.w * glyph.h;
+        ++packed;
+    }
+
+    fillRate = static_cast<double>(used) / (static_cast<double>(size) * size);
+    return packed;
+}
+
+/**
+ * Skyline packing as used by the font atlas.
+ */
+std::size_t packSkyline(std::int32_t size,
+                        const std::vector<GlyphSize>& glyphs,
+                        double& fillRate)
+{
+    SkylinePacker packer(size, size);
+    std::size_t packed = 0;
+
+    for (const auto& glyph : glyphs)
+    {
+        std::int32_t x = 0;
+        std::int32_t y = 0;
+        if (!packer.pack(glyph.w, glyph.h, x, y))
+        {
+            break;
+        }
+        ++packed;
+    }
+
+    fillRate = packer.getFillRate();
+    return packed;
+}
+
+template<typename Function>
+double measureNs(std::size_t operations,
+                 Function function)
+{
+    const auto start = std::chrono::steady_clock::now();
+    function();
+    const auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / operations;
+}
+
+void benchmarkLookup(std::size_t iterations)
+{
+    const auto text = makeText(4096);
+
+    std::map<std::uint32_t, Info> map;
+    GlyphInfoMap<Info> flatMap;
+    for (auto glyphIndex : text)
+    {
+        map.emplace(glyphIndex, Info());
+        flatMap.insert(glyphIndex, Info());
+    }
+
+    const std::size_t operations = iterations * text.size();
+    std::uintptr_t checksum = 0;
+
+    const double mapNs = measureNs(operations, [&]()
+    {
+        for (std::size_t i = 0; i < iterations; ++i)
+        {
+            for (auto glyphIndex : text)
+            {
+                checksum += reinterpret_cast<std::uintptr_t>(&map.find(glyphIndex)->second);
+            }
+        }
+    });
+
+    const double flatNs = measureNs(operations, [&]()
+    {
+        for (std::size_t i = 0; i < iterations; ++i)
+        {
+            for (auto glyphIndex : text)
+            {
+                checksum += reinterpret_cast<std::uintptr_t>(flatMap.find(glyphIndex));
+            }
+        }
+    });
+
+    std::printf("getCharInfo lookup (%zu distinct glyphs):\n", flatMap.size());
+    std::printf("  std::map      %6.2f ns/lookup\n", mapNs);
+    std::printf("  GlyphInfoMap  %6.2f ns/lookup\n", flatNs);
+    std::printf("  (checksum %zx)\n", static_cast<std::size_t>(checksum & 0xF));
+}
+
+void benchmarkAtlas()
+{
+    std::printf("atlas fill rate (page packed until first failure):\n");
+
+    for (std::int32_t fontHeight : {16, 24, 36, 54, 80})
+    {
+        const auto glyphs = makeGlyphs(fontHeight, 10000);
+
+        // previous fixed page size vs page size derived from font height
+        std::int32_t pageSize = 128;
+        while ((pageSize < 1024) && (pageSize < fontHeight * 10))
+        {
+            pageSize *= 2;
+        }
+
+        double rowsFill128 = 0;
+        double rowsFill = 0;
+        double skylineFill = 0;
+        const auto rows128 = packRows(128, glyphs, rowsFill128);
+        const auto rows = packRows(pageSize, glyphs, rowsFill);
+        const auto skyline = packSkyline(pageSize, glyphs, skylineFill);
+
+        std::printf("  font %2d px: rows@128 %4zu glyphs %5.1f%% | rows@%d %4zu glyphs %5.1f%% | skyline@%d %4zu glyphs %5.1f%%\n",
+                fontHeight,
+                rows128, rowsFill128 * 100,
+                pageSize, rows, rowsFill * 100,
+                pageSize, skyline, skylineFill * 100);
+    }
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    std::size_t iterations = 2000;
+    if (argc > 1)
+    {
+        iterations = std::strtoul(argv[1], nullptr, 10);
+    }
+
+    benchmarkLookup(iterations);
+    benchmarkAtlas();
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,127 @@
+/*****************************************************************************
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:
+*
+* Copyright 2021 Liberty Global Service B.V.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*****************************************************************************/
+
+#include <cppunit/extensions/HelperMacros.h>
+#include "GlyphInfoMap.hpp"
+
+using namespace subttxrend::gfx;
+
+class GlyphInfoMapTest : public CppUnit::TestFixture
+{
+CPPUNIT_TEST_SUITE( GlyphInfoMapTest );
+    CPPUNIT_TEST(directKeys);
+    CPPUNIT_TEST(hashedKeys);
+    CPPUNIT_TEST(replaceValue);
+    CPPUNIT_TEST(growth);
+    CPPUNIT_TEST(clear);
+CPPUNIT_TEST_SUITE_END();
+
+public:
+    void setUp()
+    {
+        // noop
+    }
+
+    void tearDown()
+    {
+        // noop
+    }
+
+    void directKeys()
+    {
+        GlyphInfoMap<int> map;
+
+        CPPUNIT_ASSERT(!map.find(0));
+        CPPUNIT_ASSERT(!map.find(65));
+
+        map.insert(0, 10);
+        map.insert(65, 20);
+
+        CPPUNIT_ASSERT(map.find(0));
+        CPPUNIT_ASSERT_EQUAL(10, *map.find(0));
+        CPPUNIT_ASSERT_EQUAL(20, *map.find(65));
+        CPPUNIT_ASSERT(!map.find(66));
+        CPPUNIT_ASSERT_EQUAL(std::size_t(2), map.size());
+    }
+
+    void hashedKeys()
+    {
+        GlyphInfoMap<int> map;
+
+        map.insert(1000, 1);
+        map.insert(0x10000, 2);
+        map.insert(0xFFFFFFFF, 3);
+
+        CPPUNIT_ASSERT_EQUAL(1, *map.find(1000));
+        CPPUNIT_ASSERT_EQUAL(2, *map.find(0x10000));
+        CPPUNIT_ASSERT_EQUAL(3, *map.find(0xFFFFFFFF));
+        CPPUNIT_ASSERT(!map.find(1001));
+        CPPUNIT_ASSERT_EQUAL(std::size_t(3), map.size());
+    }
+
+    void replaceValue()
+    {
+        GlyphInfoMap<int> map;
+
+        map.insert(5, 1);
+        map.insert(5, 2);
+        map.insert(500, 1);
+        auto value = map.insert(500, 2);
+
+        CPPUNIT_ASSERT_EQUAL(2, *value);
+        CPPUNIT_ASSERT_EQUAL(2, *map.find(5));
+        CPPUNIT_ASSERT_EQUAL(2, *map.find(500));
+        CPPUNIT_ASSERT_EQUAL(std::size_t(2), map.size());
+    }
+
+    void growth()
+    {
+        GlyphInfoMap<std::uint32_t> map;
+
+        const std::uint32_t count = 10000;
+        for (std::uint32_t i = 0; i < count; ++i)
+        {
+            map.insert(i * 7, i);
+        }
+
+        CPPUNIT_ASSERT_EQUAL(std::size_t(count), map.size());
+        for (std::uint32_t i = 0; i < count; ++i)
+        {
+            auto value = map.find(i * 7);
+            CPPUNIT_ASSERT(value);
+            CPPUNIT_ASSERT_EQUAL(i, *value);
+            CPPUNIT_ASSERT(!map.find(i * 7 + 1));
+        }
+    }
+
+    void clear()
+    {
+        GlyphInfoMap<int> map;
+
+        map.insert(1, 1);
+        map.insert(1000, 2);
+        map.clear();
+
+        CPPUNIT_ASSERT(!map.find(1));
+        CPPUNIT_ASSERT(!map.find(1000));
+        CPPUNIT_ASSERT_EQUAL(std::size_t(0), map.size());
+    }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION( GlyphInfoMapTest );
@@ -0,0 +1,290 @@
+/*****************************************************************************
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:
+*
+* Copyright 2021 Liberty Global Service B.V.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*****************************************************************************/
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <chrono>
+#include <memory>
+#include <thread>
+
+#include "PrerenderedFont.hpp"
+#include "PrerenderedFontImpl.hpp"
+
+using namespace subttxrend::gfx;
+
+/** Number of glyphs prerendered by all fonts (PrerenderedFontImplStub). */
+extern std::atomic<std::size_t> g_stubPrerenderedGlyphs;
+
+class PrerenderedFontCacheTest : public CppUnit::TestFixture
+{
+CPPUNIT_TEST_SUITE( PrerenderedFontCacheTest );
+    CPPUNIT_TEST(testSameFont);
+    CPPUNIT_TEST(testLruOrder);
+    CPPUNIT_TEST(testByteBudget);
+    CPPUNIT_TEST(testGrowthAccountedOnAccess);
+    CPPUNIT_TEST(testSetByteBudgetAndClear);
+    CPPUNIT_TEST(testPrewarm);
+    CPPUNIT_TEST(testPrewarmCancelledByNewRequest);
+    CPPUNIT_TEST(testPrewarmStoppedByDestructor);
+CPPUNIT_TEST_SUITE_END();
+
+public:
+    void setUp()
+    {
+        // noop
+    }
+
+    void tearDown()
+    {
+        // noop
+    }
+
+    void testSameFont()
+    {
+        PrerenderedFontCache cache(pages(4));
+
+        auto font1 = cache.getFont("/a", 20);
+        auto font2 = cache.getFont("/a", 20);
+        auto font3 = cache.getFont("/a", 20, true);
+
+        CPPUNIT_ASSERT(font1 == font2);
+        CPPUNIT_ASSERT(font1 != font3);
+        CPPUNIT_ASSERT_EQUAL(std::size_t(2), cache.getStatistics().size());
+        CPPUNIT_ASSERT_EQUAL(pages(2), cache.getMemoryUsage());
+    }
+
+    void testLruOrder()
+    {
+        PrerenderedFontCache cache(pages(3));
+
+        cache.getFont("/a", 20);
+        cache.getFont("/b", 20);
+        cache.getFont("/c", 20);
+
+        // "/a" most recently used, "/b" least recently used
+        cache.getFont("/a", 20);
+        cache.getFont("/d", 20);
+
+        CPPUNIT_ASSERT(getNames(cache) == std::vector<std::string>({"/d", "/a", "/c"}));
+        CPPUNIT_ASSERT_EQUAL(pages(3), cache.getMemoryUsage());
+    }
+
+    void testByteBudget()
+    {
+        PrerenderedFontCache cache(pages(3));
+
+        auto fontA = cache.getFont("/a", 20);
+        growFont(fontA, 1);
+        cache.getFont("/a", 20);
+        cache.getFont("/b", 20);
+
+        CPPUNIT_ASSERT_EQUAL(pages(3), cache.getMemoryUsage());
+
+        // over budget, the least recently used font goes
+        cache.getFont("/c", 20);
+
+        CPPUNIT_ASSERT(getNames(cache) == std::vector<std::string>({"/c", "/b"}));
+        CPPUNIT_ASSERT_EQUAL(pages(2), cache.getMemoryUsage());
+
+        // font evicted from the cache stays alive while referenced
+        CPPUNIT_ASSERT_EQUAL(20, fontA->getFontHeight());
+
+        growFont(cache.getFont("/d", 20), 4);
+
+        // the most recently used font is kept even if it alone exceeds the budget
+        cache.getFont("/d", 20);
+
+        CPPUNIT_ASSERT(getNames(cache) == std::vector<std::string>({"/d"}));
+        CPPUNIT_ASSERT_EQUAL(pages(5), cache.getMemoryUsage());
+    }
+
+    void testGrowthAccountedOnAccess()
+    {
+        PrerenderedFontCache cache(pages(4));
+
+        auto font = cache.getFont("/a", 20);
+        cache.getFont("/b", 20);
+
+        growFont(font, 2);
+
+        // not accessed since it grew
+        CPPUNIT_ASSERT_EQUAL(pages(2), cache.getMemoryUsage());
+
+        cache.getFont("/a", 20);
+
+        CPPUNIT_ASSERT_EQUAL(pages(4), cache.getMemoryUsage());
+        CPPUNIT_ASSERT_EQUAL(std::size_t(2), cache.getStatistics().size());
+
+        growFont(font, 1);
+        cache.getFont("/a", 20);
+
+        CPPUNIT_ASSERT(getNames(cache) == std::vector<std::string>({"/a"}));
+        CPPUNIT_ASSERT_EQUAL(pages(4), cache.getMemoryUsage());
+    }
+
+    void testSetByteBudgetAndClear()
+    {
+        PrerenderedFontCache cache(pages(4));
+
+        cache.getFont("/a", 20);
+        cache.getFont("/b", 20);
+        cache.getFont("/c", 20);
+
+        cache.setByteBudget(pages(1));
+
+        CPPUNIT_ASSERT(getNames(cache) == std::vector<std::string>({"/c"}));
+        CPPUNIT_ASSERT_EQUAL(pages(1), cache.getMemoryUsage());
+
+        cache.clear();
+
+        CPPUNIT_ASSERT(cache.getStatistics().empty());
+        CPPUNIT_ASSERT_EQUAL(std::size_t(0), cache.getMemoryUsage());
+    }
+
+    void testPrewarm()
+    {
+        PrerenderedFontCache cache(pages(20));
+
+        auto font = cache.getFont("/a", 20, true);
+
+        cache.prewarm({ prewarmFont("/a"), prewarmFont("/broken"), prewarmFont("/b") },
+                { 'a', 'b', 'c' });
+
+        CPPUNIT_ASSERT(waitForCompleted(cache, 1));
+
+        const auto statistics = cache.getPrewarmStatistics();
+        CPPUNIT_ASSERT_EQUAL(std::size_t(1), statistics.requests);
+        CPPUNIT_ASSERT_EQUAL(std::size_t(1), statistics.fonts);
+        CPPUNIT_ASSERT_EQUAL(std::size_t(3), statistics.glyphs);
+
+        // font in use is not replaced, prewarmed font is least recently used
+        CPPUNIT_ASSERT(getNames(cache) == std::vector<std::string>({"/a", "/b"}));
+        CPPUNIT_ASSERT(cache.getFont("/a", 20, true) == font);
+        CPPUNIT_ASSERT_EQUAL(pages(5), cache.getMemoryUsage());
+    }
+
+    void testPrewarmCancelledByNewRequest()
+    {
+        PrerenderedFontCache cache(pages(100000));
+
+        const std::vector<std::uint32_t> manyCodepoints(10000, 'a');
+
+        const auto glyphsBefore = g_stubPrerenderedGlyphs.load();
+        cache.prewarm({ prewarmFont("/a"), prewarmFont("/b") }, manyCodepoints);
+        CPPUNIT_ASSERT(waitForGlyphs(glyphsBefore + 1));
+
+        const auto start = std::chrono::steady_clock::now();
+        cache.prewarm({}, {});
+        const auto stopTime = std::chrono::steady_clock::now() - start;
+
+        CPPUNIT_ASSERT(stopTime < std::chrono::seconds(1));
+
+        auto statistics = cache.getPrewarmStatistics();
+        CPPUNIT_ASSERT_EQUAL(std::size_t(1), statistics.requests);
+        CPPUNIT_ASSERT_EQUAL(std::size_t(0), statistics.completed);
+        CPPUNIT_ASSERT(statistics.glyphs < manyCodepoints.size());
+
+        // "/b" was not started
+        CPPUNIT_ASSERT(getNames(cache) == std::vector<std::string>({"/a"}));
+
+        cache.prewarm({ prewarmFont("/c") }, { 'a' });
+
+        CPPUNIT_ASSERT(waitForCompleted(cache, 1));
+        statistics = cache.getPrewarmStatistics();
+        CPPUNIT_ASSERT_EQUAL(std::size_t(2), statistics.requests);
+        CPPUNIT_ASSERT_EQUAL(std::size_t(1), statistics.glyphs);
+    }
+
+    void testPrewarmStoppedByDestructor()
+    {
+        std::unique_ptr<PrerenderedFontCache> cache(new PrerenderedFontCache());
+
+        const auto glyphsBefore = g_stubPrerenderedGlyphs.load();
+        cache->prewarm({ prewarmFont("/a") }, std::vector<std::uint32_t>(10000, 'a'));
+        CPPUNIT_ASSERT(waitForGlyphs(glyphsBefore + 1));
+
+        const auto start = std::chrono::steady_clock::now();
+        cache.reset();
+        const auto stopTime = std::chrono::steady_clock::now() - start;
+
+        CPPUNIT_ASSERT(stopTime < std::chrono::seconds(1));
+    }
+
+private:
+    /** Bytes used by given number of stub atlas pages. */
+    static std::size_t pages(std::size_t count)
+    {
+        return count * 128 * 128;
+    }
+
+    /** Adds atlas pages to the stub font. */
+    static void growFont(std::shared_ptr<PrerenderedFont> font,
+                         std::size_t pageCount)
+    {
+        const std::atomic_bool cancelled{false};
+        std::static_pointer_cast<PrerenderedFontImpl>(font)->prerenderGlyphs(
+                std::vector<std::uint32_t>(pageCount, 'a'), 0, cancelled);
+    }
+
+    static PrerenderedFontCache::PrewarmFont prewarmFont(const std::string& fontName)
+    {
+        PrerenderedFontCache::PrewarmFont font;
+        font.fontName = fontName;
+        font.faceHeight = 20;
+        return font;
+    }
+
+    static std::vector<std::string> getNames(const PrerenderedFontCache& cache)
+    {
+        std::vector<std::string> names;
+        for (const auto& statistics : cache.getStatistics())
+        {
+            names.push_back(statistics.fontName);
+        }
+        return names;
+    }
+
+    static bool waitForCompleted(const PrerenderedFontCache& cache,
+                                 std::size_t completed)
+    {
+        return waitFor([&]() { return cache.getPrewarmStatistics().completed >= completed; });
+    }
+
+    static bool waitForGlyphs(std::size_t glyphs)
+    {
+        return waitFor([&]() { return g_stubPrerenderedGlyphs >= glyphs; });
+    }
+
+    template<typename Condition>
+    static bool waitFor(Condition condition)
+    {
+        const auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (!condition())
+        {
+            if (std::chrono::steady_clock::now() > timeout)
+            {
+                return false;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return true;
+    }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION( PrerenderedFontCacheTest );
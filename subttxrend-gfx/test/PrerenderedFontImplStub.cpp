@@ -0,0 +1,131 @@
+/*****************************************************************************
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:
+*
+* Copyright 2021 Liberty Global Service B.V.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*****************************************************************************/
+
+/*
+ * Test implementation of PrerenderedFontImpl used to test code using
+ * fonts without font files.
+ *
+ * Every font starts with one atlas page (ATLAS_PAGE_MIN_SIZE square, one
+ * byte per pixel). prerenderGlyphs() adds one page per codepoint and takes
+ * about a millisecond per codepoint, so a running prewarm request could be
+ * observed and cancelled. Font files which path contains "broken" fail to
+ * open.
+ */
+
+#include "PrerenderedFontImpl.hpp"
+
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+/** Number of glyphs prerendered by all fonts. */
+std::atomic<std::size_t> g_stubPrerenderedGlyphs{0};
+
+namespace subttxrend
+{
+namespace gfx
+{
+
+PrerenderedFontImpl::PrerenderedFontImpl(const char *fontFilePath, int height, bool strict, bool italics)
+{
+    (void) strict;
+    (void) italics;
+
+    if (std::string(fontFilePath).find("broken") != std::string::npos)
+    {
+        throw std::runtime_error("font could not be opened");
+    }
+
+    m_fontHeight = height;
+    m_maxAdvance = height;
+    m_ascender = height;
+    m_descender = 0;
+    m_atlasPageSize = ATLAS_PAGE_MIN_SIZE;
+    m_atlasPageCount = 1;
+}
+
+PrerenderedFontImpl::~PrerenderedFontImpl()
+{
+    // noop
+}
+
+std::vector<TextTokenData> PrerenderedFontImpl::textToTokens(const std::string &str)
+{
+    (void) str;
+    return {};
+}
+
+std::int32_t PrerenderedFontImpl::getFontHeight() const
+{
+    return m_fontHeight;
+}
+
+std::int32_t PrerenderedFontImpl::getMaxAdvance() const
+{
+    return m_maxAdvance;
+}
+
+std::int32_t PrerenderedFontImpl::getFontDescender() const
+{
+    return m_descender;
+}
+
+std::int32_t PrerenderedFontImpl::getFontAscender() const
+{
+    return m_ascender;
+}
+
+std::size_t PrerenderedFontImpl::prerenderGlyphs(const std::vector<std::uint32_t>& codepoints,
+                                                 int outlineSize,
+                                                 const std::atomic_bool& cancelled)
+{
+    (void) outlineSize;
+
+    std::size_t count = 0;
+    for (std::size_t i = 0; (i < codepoints.size()) && !cancelled; ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+        ++m_atlasPageCount;
+        ++g_stubPrerenderedGlyphs;
+        ++count;
+    }
+    return count;
+}
+
+std::size_t PrerenderedFontImpl::getAtlasPageCount() const
+{
+    return m_atlasPageCount;
+}
+
+std::size_t PrerenderedFontImpl::getMemoryUsage() const
+{
+    const auto pageSize = static_cast<std::size_t>(m_atlasPageSize);
+    return m_atlasPageCount * pageSize * pageSize;
+}
+
+const CharacterInformation* PrerenderedFontImpl::getCharInfo(std::uint32_t codepoint, int outlineSize)
+{
+    (void) codepoint;
+    (void) outlineSize;
+    return nullptr;
+}
+
+} // namespace gfx
+} // namespace subttxrend
@@ -0,0 +1,247 @@
+/*****************************************************************************
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:
+*
+* Copyright 2021 Liberty Global Service B.V.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*****************************************************************************/
+/*
+ * Micro-benchmark of stretch blit scaling.
+ *
+ * Compares the 4-neighbour averaging previously used by
+ * Blitter::pixmapStretchBlitSmooth with the separable Scaler (scalar and
+ * vectorized kernels) for typical subtitle cases: a mostly transparent
+ * subtitle plane and a worst case picture with no transparent pixels.
+ * Not a unit test, run manually: Scaler_Benchmark [iterations]
+ */
+
+#include "Scaler.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+using namespace subttxrend::gfx;
+
+namespace
+{
+
+/**
+ * Previous smooth stretch blit (destination pixel averaged with the
+ * previous column and line samples).
+ */
+void stretchSmooth(const std::vector<PixelArgb8888>& src,
+                   int srcW,
+                   int srcH,
+                   std::vector<PixelArgb8888>& dst,
+                   int dstW,
+                   int dstH)
+{
+    const int RATIO_SHIFT = 16;
+
+    int wRatio = (srcW << RATIO_SHIFT) / dstW;
+    int hRatio = (srcH << RATIO_SHIFT) / dstH;
+
+    const PixelArgb8888* srcLineStartPrev = nullptr;
+
+    for (int dstY = 0; dstY < dstH; ++dstY)
+    {
+        const int srcY = (dstY * hRatio) >> RATIO_SHIFT;
+
+        const PixelArgb8888* srcLineStart = src.data() + srcY * srcW;
+        PixelArgb8888* dstPixel = dst.data() + dstY * dstW;
+
+        int srcXprev = -1;
+
+        for (int dstX = 0; dstX < dstW; ++dstX)
+        {
+            const int srcX = (dstX * wRatio) >> RATIO_SHIFT;
+
+            auto srcPixel = srcLineStart[srcX];
+
+            int ta = srcPixel.m_a;
+            int tr = srcPixel.m_r;
+            int tg = srcPixel.m_g;
+            int tb = srcPixel.m_b;
+            int count = 1;
+
+            if (srcXprev >= 0)
+            {
+                srcPixel = srcLineStart[srcXprev];
+                ta += srcPixel.m_a;
+                tr += srcPixel.m_r;
+                tg += srcPixel.m_g;
+                tb += srcPixel.m_b;
+                ++count;
+            }
+
+            if (srcLineStartPrev)
+            {
+                srcPixel = srcLineStartPrev[srcX];
+                ta += srcPixel.m_a;
+                tr += srcPixel.m_r;
+                tg += srcPixel.m_g;
+                tb += srcPixel.m_b;
+                ++count;
+
+                if (srcXprev >= 0)
+                {
+                    srcPixel = srcLineStartPrev[srcXprev];
+                    ta += srcPixel.m_a;
+                    tr += srcPixel.m_r;
+                    tg += srcPixel.m_g;
+                    tb += srcPixel.m_b;
+                    ++count;
+                }
+            }
+
+            *dstPixel++ = PixelArgb8888(ta / count, tr / count, tg / count, tb / count);
+
+            srcXprev = srcX;
+        }
+
+        srcLineStartPrev = srcLineStart;
+    }
+}
+
+void stretchScaler(Scaler::Type type,
+                   const std::vector<PixelArgb8888>& src,
+                   int srcW,
+                   int srcH,
+                   std::vector<PixelArgb8888>& dst,
+                   int dstW,
+                   int dstH)
+{
+    Scaler scaler(Scaler::selectFilter(srcW, dstW), Scaler::selectFilter(srcH, dstH),
+            srcW, srcH, dstW, dstH);
+
+    std::vector<const PixelArgb8888*> lines(scaler.getSourceLineCount());
+
+    for (int y = 0; y < dstH; ++y)
+    {
+        for (std::size_t i = 0; i < lines.size(); ++i)
+        {
+            lines[i] = src.data() + (scaler.getFirstSourceLine(y) + i) * srcW;
+        }
+        scaler.scaleLine(type, y, lines.data(), dst.data() + y * dstW);
+    }
+}
+
+std::vector<PixelArgb8888> makeSubtitleImage(int width,
+                                             int height)
+{
+    std::vector<PixelArgb8888> image(width * height, PixelArgb8888(0));
+
+    std::uint32_t seed = 12345;
+    for (int y = height * 3 / 4; y < height * 9 / 10; ++y)
+    {
+        for (int x = width / 8; x < width * 7 / 8; ++x)
+        {
+            seed = seed * 1103515245 + 12345;
+            image[y * width + x] = ((seed >> 16) & 1) ? PixelArgb8888(0xFFFFFFFF) : PixelArgb8888(0xFF000000);
+        }
+    }
+    return image;
+}
+
+std::vector<PixelArgb8888> makePictureImage(int width,
+                                            int height)
+{
+    std::vector<PixelArgb8888> image(width * height);
+
+    std::uint32_t seed = 12345;
+    for (auto& pixel : image)
+    {
+        seed = seed * 1103515245 + 12345;
+        pixel = PixelArgb8888((seed >> 8) | 0xFF000000);
+    }
+    return image;
+}
+
+template<typename Function>
+double measureNs(std::size_t operations,
+                 Function function)
+{
+    const auto start = std::chrono::steady_clock::now();
+    function();
+    const auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / operations;
+}
+
+void benchmark(const char* name,
+               const std::vector<PixelArgb8888>& src,
+               int srcW,
+               int srcH,
+               int dstW,
+               int dstH,
+               std::size_t iterations)
+{
+    std::vector<PixelArgb8888> dst(dstW * dstH);
+
+    const std::size_t operations = iterations * dstW * dstH;
+
+    std::printf("%s (%dx%d -> %dx%d):\n", name, srcW, srcH, dstW, dstH);
+
+    const double smoothNs = measureNs(operations, [&]()
+    {
+        for (std::size_t i = 0; i < iterations; ++i)
+        {
+            stretchSmooth(src, srcW, srcH, dst, dstW, dstH);
+        }
+    });
+    std::printf("  previous smooth  %6.3f ns/pixel\n", smoothNs);
+
+    for (auto type : { Scaler::Type::SCALAR, Scaler::Type::SSE2 })
+    {
+        if (!Scaler::isSupported(type))
+        {
+            continue;
+        }
+
+        const double scalerNs = measureNs(operations, [&]()
+        {
+            for (std::size_t i = 0; i < iterations; ++i)
+            {
+                stretchScaler(type, src, srcW, srcH, dst, dstW, dstH);
+            }
+        });
+        std::printf("  scaler %-8s  %6.3f ns/pixel\n", Scaler::getName(type), scalerNs);
+    }
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    std::size_t iterations = 20;
+    if (argc > 1)
+    {
+        iterations = std::strtoul(argv[1], nullptr, 10);
+    }
+
+    benchmark("DVB SD to HD", makeSubtitleImage(720, 576),
+            720, 576, 1920, 1080, iterations);
+    benchmark("TTML image SD to HD", makeSubtitleImage(720, 480),
+            720, 480, 1920, 1080, iterations);
+    benchmark("HD to 720p", makeSubtitleImage(1920, 1080),
+            1920, 1080, 1280, 720, iterations);
+
+    benchmark("Picture SD to HD", makePictureImage(720, 576),
+            720, 576, 1920, 1080, iterations);
+    benchmark("Picture HD to 720p", makePictureImage(1920, 1080),
+            1920, 1080, 1280, 720, iterations);
+
+    return EXIT_SUCCESS;
+}
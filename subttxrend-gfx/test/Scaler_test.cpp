@@ -0,0 +1,545 @@
+/*****************************************************************************
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:
+*
+* Copyright 2021 Liberty Global Service B.V.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*****************************************************************************/
+
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <cstdlib>
+#include <vector>
+
+#include "Scaler.hpp"
+
+using subttxrend::gfx::Scaler;
+using subttxrend::gfx::PixelArgb8888;
+
+class ScalerTest : public CppUnit::TestFixture
+{
+CPPUNIT_TEST_SUITE( ScalerTest );
+    CPPUNIT_TEST(testActiveType);
+    CPPUNIT_TEST(testSelectFilter);
+    CPPUNIT_TEST(testSameSize);
+    CPPUNIT_TEST(testConstantColor);
+    CPPUNIT_TEST(testSourceLines);
+    CPPUNIT_TEST(testAreaHalfSize);
+    CPPUNIT_TEST(testBilinearRamp);
+    CPPUNIT_TEST(testKernelsExact);
+    CPPUNIT_TEST(testGoldenDvbSdToHd);
+    CPPUNIT_TEST(testGoldenTtmlSdToHd);
+    CPPUNIT_TEST(testGoldenHdTo720p);
+    CPPUNIT_TEST(testTablesCache);
+CPPUNIT_TEST_SUITE_END();
+
+public:
+    void setUp()
+    {
+        m_random = 0x12345678;
+
+        m_types.clear();
+        for (auto type : { Scaler::Type::SCALAR, Scaler::Type::SSE2 })
+        {
+            if (Scaler::isSupported(type))
+            {
+                m_types.push_back(type);
+            }
+        }
+    }
+
+    void tearDown()
+    {
+        // noop
+    }
+
+    void testActiveType()
+    {
+        CPPUNIT_ASSERT(Scaler::isSupported(Scaler::Type::SCALAR));
+        CPPUNIT_ASSERT(Scaler::isSupported(Scaler::getActiveType()));
+        CPPUNIT_ASSERT(Scaler::getName(Scaler::getActiveType()) != nullptr);
+    }
+
+    void testSelectFilter()
+    {
+        CPPUNIT_ASSERT(Scaler::selectFilter(720, 1920) == Scaler::Filter::BILINEAR);
+        CPPUNIT_ASSERT(Scaler::selectFilter(720, 720) == Scaler::Filter::BILINEAR);
+        CPPUNIT_ASSERT(Scaler::selectFilter(1920, 1280) == Scaler::Filter::AREA);
+    }
+
+    void testSameSize()
+    {
+        const Image src = randomImage(37, 11);
+
+        for (auto filter : { Scaler::Filter::BILINEAR, Scaler::Filter::AREA })
+        {
+            for (auto type : m_types)
+            {
+                const Image dst = scale(src, 37, 11, filter, filter, type);
+
+                CPPUNIT_ASSERT(dst.m_pixels == src.m_pixels);
+            }
+        }
+    }
+
+    void testConstantColor()
+    {
+        const std::int32_t sizes[][2] = { { 1, 5 }, { 5, 1 }, { 7, 19 }, { 19, 7 }, { 30, 11 }, { 3, 3 } };
+
+        for (auto color : { 0x00000000U, 0xFFFFFFFFU, 0x80402010U, 0x01FE7F80U })
+        {
+            for (const auto& width : sizes)
+            {
+                for (const auto& height : sizes)
+                {
+                    Image src(width[0], height[0]);
+                    src.m_pixels.assign(src.m_pixels.size(), color);
+
+                    for (auto filter : { Scaler::Filter::BILINEAR, Scaler::Filter::AREA })
+                    {
+                        const Image dst = scale(src, width[1], height[1],
+                                filter, filter, Scaler::getActiveType());
+
+                        for (auto pixel : dst.m_pixels)
+                        {
+                            CPPUNIT_ASSERT_EQUAL(color, pixel);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    void testSourceLines()
+    {
+        const std::int32_t sizes[] = { 1, 2, 3, 7, 64, 576, 1080 };
+
+        for (auto srcHeight : sizes)
+        {
+            for (auto dstHeight : sizes)
+            {
+                for (auto filter : { Scaler::Filter::BILINEAR, Scaler::Filter::AREA })
+                {
+                    Scaler scaler(filter, filter, 4, srcHeight, 4, dstHeight);
+
+                    const std::int32_t count = scaler.getSourceLineCount();
+                    CPPUNIT_ASSERT(count >= 1);
+                    CPPUNIT_ASSERT(count <= srcHeight);
+
+                    std::int32_t previous = 0;
+                    for (std::int32_t line = 0; line < dstHeight; ++line)
+                    {
+                        const std::int32_t first = scaler.getFirstSourceLine(line);
+                        CPPUNIT_ASSERT(first >= previous);
+                        CPPUNIT_ASSERT(first + count <= srcHeight);
+                        previous = first;
+                    }
+                }
+            }
+        }
+    }
+
+    void testAreaHalfSize()
+    {
+        const Image src = randomImage(64, 32);
+
+        for (auto type : m_types)
+        {
+            const Image dst = scale(src, 32, 16, Scaler::Filter::AREA,
+                    Scaler::Filter::AREA, type);
+
+            for (std::int32_t y = 0; y < dst.m_height; ++y)
+            {
+                for (std::int32_t x = 0; x < dst.m_width; ++x)
+                {
+                    for (int shift = 0; shift < 32; shift += 8)
+                    {
+                        const int sum = channel(src.at(2 * x, 2 * y), shift)
+                                + channel(src.at(2 * x + 1, 2 * y), shift)
+                                + channel(src.at(2 * x, 2 * y + 1), shift)
+                                + channel(src.at(2 * x + 1, 2 * y + 1), shift);
+
+                        const int actual = channel(dst.at(x, y), shift);
+                        CPPUNIT_ASSERT(std::abs(actual * 4 - sum) <= 4);
+                    }
+                }
+            }
+        }
+    }
+
+    void testBilinearRamp()
+    {
+        Image src(8, 1);
+        for (std::int32_t x = 0; x < src.m_width; ++x)
+        {
+            const std::uint32_t value = x * 32;
+            src.m_pixels[x] = 0xFF000000 | (value << 16) | (value << 8) | value;
+        }
+
+        const Image dst = scale(src, 64, 1, Scaler::Filter::BILINEAR,
+                Scaler::Filter::BILINEAR, Scaler::getActiveType());
+
+        // edges are clamped, inside values are interpolated linearly
+        CPPUNIT_ASSERT_EQUAL(0, channel(dst.at(0, 0), 0));
+        CPPUNIT_ASSERT_EQUAL(224, channel(dst.at(63, 0), 0));
+
+        for (std::int32_t x = 4; x < 60; ++x)
+        {
+            const double expected = ((x + 0.5) / 8 - 0.5) * 32;
+            const int actual = channel(dst.at(x, 0), 0);
+
+            CPPUNIT_ASSERT(std::abs(actual - expected) <= 1.0);
+            CPPUNIT_ASSERT_EQUAL(255, channel(dst.at(x, 0), 24));
+        }
+    }
+
+    void testKernelsExact()
+    {
+        const std::int32_t sizes[][2] = { { 1, 1 }, { 13, 5 }, { 17, 33 }, { 33, 17 }, { 100, 23 }, { 23, 100 } };
+
+        for (const auto& size : sizes)
+        {
+            const Image src = randomImage(size[0], size[1]);
+
+            for (auto horizontalFilter : { Scaler::Filter::BILINEAR, Scaler::Filter::AREA })
+            {
+                for (auto verticalFilter : { Scaler::Filter::BILINEAR, Scaler::Filter::AREA })
+                {
+                    const Image expected = scale(src, size[1], size[0],
+                            horizontalFilter, verticalFilter, Scaler::Type::SCALAR);
+
+                    for (auto type : m_types)
+                    {
+                        const Image actual = scale(src, size[1], size[0],
+                                horizontalFilter, verticalFilter, type);
+
+                        CPPUNIT_ASSERT(actual.m_pixels == expected.m_pixels);
+                    }
+                }
+            }
+        }
+    }
+
+    void testGoldenDvbSdToHd()
+    {
+        const Image src = subtitleImage(720, 576);
+
+        checkGolden(src, 1920, 1080);
+    }
+
+    void testGoldenTtmlSdToHd()
+    {
+        const Image src = pictureImage(720, 480);
+
+        checkGolden(src, 1920, 1080);
+    }
+
+    void testGoldenHdTo720p()
+    {
+        const Image src = pictureImage(1920, 1080);
+
+        checkGolden(src, 1280, 720);
+    }
+
+    void testTablesCache()
+    {
+        const auto before = Scaler::getCacheStatistics();
+
+        Scaler first(Scaler::Filter::BILINEAR, Scaler::Filter::AREA, 123, 45, 67, 89);
+        Scaler second(Scaler::Filter::BILINEAR, Scaler::Filter::AREA, 123, 45, 67, 89);
+        Scaler other(Scaler::Filter::AREA, Scaler::Filter::AREA, 123, 45, 67, 89);
+
+        const auto after = Scaler::getCacheStatistics();
+
+        CPPUNIT_ASSERT_EQUAL(before.m_misses + 2, after.m_misses);
+        CPPUNIT_ASSERT_EQUAL(before.m_hits + 1, after.m_hits);
+        CPPUNIT_ASSERT(after.m_entries >= 2);
+
+        // cached tables give the same result
+        const Image src = randomImage(123, 45);
+        const Image expected = scale(src, 67, 89, Scaler::Filter::BILINEAR,
+                Scaler::Filter::AREA, Scaler::Type::SCALAR);
+        const Image actual = scale(src, 67, 89, Scaler::Filter::BILINEAR,
+                Scaler::Filter::AREA, Scaler::Type::SCALAR);
+
+        CPPUNIT_ASSERT(actual.m_pixels == expected.m_pixels);
+    }
+
+private:
+    /** Test image (premultiplied ARGB values). */
+    struct Image
+    {
+        Image(std::int32_t width,
+              std::int32_t height) :
+                m_width(width),
+                m_height(height),
+                m_pixels(width * height)
+        {
+            // noop
+        }
+
+        std::uint32_t at(std::int32_t x,
+                         std::int32_t y) const
+        {
+            return m_pixels[y * m_width + x];
+        }
+
+        std::int32_t m_width;
+        std::int32_t m_height;
+        std::vector<std::uint32_t> m_pixels;
+    };
+
+    /**
+     * Scales whole image (same way as Blitter does).
+     */
+    static Image scale(const Image& src,
+                       std::int32_t width,
+                       std::int32_t height,
+                       Scaler::Filter horizontalFilter,
+                       Scaler::Filter verticalFilter,
+                       Scaler::Type type)
+    {
+        Scaler scaler(horizontalFilter, verticalFilter, src.m_width,
+                src.m_height, width, height);
+
+        Image dst(width, height);
+        std::vector<const PixelArgb8888*> lines(scaler.getSourceLineCount());
+
+        for (std::int32_t y = 0; y < height; ++y)
+        {
+            for (std::size_t i = 0; i < lines.size(); ++i)
+            {
+                const std::int32_t srcY = scaler.getFirstSourceLine(y) + i;
+                lines[i] = reinterpret_cast<const PixelArgb8888*>(
+                        src.m_pixels.data() + srcY * src.m_width);
+            }
+
+            scaler.scaleLine(type, y, lines.data(),
+                    reinterpret_cast<PixelArgb8888*>(dst.m_pixels.data() + y * width));
+        }
+
+        return dst;
+    }
+
+    /**
+     * Scales whole image the way the previous Blitter smooth stretch blit
+     * did (point sample averaged with the previous column and line
+     * samples).
+     */
+    static Image scaleSmooth(const Image& src,
+                             std::int32_t width,
+                             std::int32_t height)
+    {
+        const int RATIO_SHIFT = 16;
+
+        const int wRatio = (src.m_width << RATIO_SHIFT) / width;
+        const int hRatio = (src.m_height << RATIO_SHIFT) / height;
+
+        Image dst(width, height);
+        int srcYprev = -1;
+
+        for (std::int32_t y = 0; y < height; ++y)
+        {
+            const int srcY = (y * hRatio) >> RATIO_SHIFT;
+            int srcXprev = -1;
+
+            for (std::int32_t x = 0; x < width; ++x)
+            {
+                const int srcX = (x * wRatio) >> RATIO_SHIFT;
+
+                std::uint32_t value = 0;
+                for (int shift = 0; shift < 32; shift += 8)
+                {
+                    int sum = channel(src.at(srcX, srcY), shift);
+                    int count = 1;
+
+                    if (srcXprev >= 0)
+                    {
+                        sum += channel(src.at(srcXprev, srcY), shift);
+                        ++count;
+                    }
+                    if (srcYprev >= 0)
+                    {
+                        sum += channel(src.at(srcX, srcYprev), shift);
+                        ++count;
+
+                        if (srcXprev >= 0)
+                        {
+                            sum += channel(src.at(srcXprev, srcYprev), shift);
+                            ++count;
+                        }
+                    }
+
+                    value |= std::uint32_t(sum / count) << shift;
+                }
+                dst.m_pixels[y * width + x] = value;
+
+                srcXprev = srcX;
+            }
+
+            srcYprev = srcY;
+        }
+
+        return dst;
+    }
+
+    /**
+     * Compares scaler output with the previous smooth stretch blit.
+     *
+     * The filters differ in phase and weights, so edges are not exactly
+     * the same, but the overall picture must be: the channel totals
+     * (coverage and colour) are preserved and the average difference is
+     * small. All kernels must give the same result.
+     */
+    void checkGolden(const Image& src,
+                     std::int32_t width,
+                     std::int32_t height)
+    {
+        const double TOTAL_DIFFERENCE_MAX = 0.01;
+        const double MEAN_DIFFERENCE_MAX = 4.0;
+
+        const Image reference = scaleSmooth(src, width, height);
+
+        const Image expected = scale(src, width, height,
+                Scaler::selectFilter(src.m_width, width),
+                Scaler::selectFilter(src.m_height, height),
+                Scaler::Type::SCALAR);
+
+        double difference = 0;
+        for (int shift = 0; shift < 32; shift += 8)
+        {
+            double referenceTotal = 0;
+            double expectedTotal = 0;
+
+            for (std::size_t i = 0; i < expected.m_pixels.size(); ++i)
+            {
+                const int referenceValue = channel(reference.m_pixels[i], shift);
+                const int expectedValue = channel(expected.m_pixels[i], shift);
+
+                referenceTotal += referenceValue;
+                expectedTotal += expectedValue;
+                difference += std::abs(referenceValue - expectedValue);
+            }
+
+            CPPUNIT_ASSERT(referenceTotal > 0);
+            CPPUNIT_ASSERT(std::abs(expectedTotal / referenceTotal - 1.0) <= TOTAL_DIFFERENCE_MAX);
+        }
+
+        const double meanDifference = difference / (expected.m_pixels.size() * 4);
+        CPPUNIT_ASSERT(meanDifference <= MEAN_DIFFERENCE_MAX);
+
+        for (auto type : m_types)
+        {
+            const Image actual = scale(src, width, height,
+                    Scaler::selectFilter(src.m_width, width),
+                    Scaler::selectFilter(src.m_height, height),
+                    type);
+
+            CPPUNIT_ASSERT(actual.m_pixels == expected.m_pixels);
+        }
+    }
+
+    /**
+     * Builds image resembling DVB subtitles: transparent background and
+     * two lines of opaque white "text" with black outline.
+     */
+    static Image subtitleImage(std::int32_t width,
+                               std::int32_t height)
+    {
+        Image image(width, height);
+
+        for (std::int32_t y = 0; y < height; ++y)
+        {
+            for (std::int32_t x = 0; x < width; ++x)
+            {
+                const bool row = ((y >= 440) && (y < 476)) || ((y >= 490) && (y < 526));
+                const bool inside = (x >= 100) && (x < width - 100);
+                if (!row || !inside)
+                {
+                    continue;
+                }
+
+                // vertical strokes with outline
+                const std::int32_t phase = (x + y / 12) % 9;
+                if (phase < 3)
+                {
+                    image.m_pixels[y * width + x] = 0xFFFFFFFF;
+                }
+                else if (phase < 5)
+                {
+                    image.m_pixels[y * width + x] = 0xFF000000;
+                }
+            }
+        }
+
+        return image;
+    }
+
+    /**
+     * Builds image resembling TTML picture subtitles: semi-transparent
+     * box with gradient and sharp edges.
+     */
+    static Image pictureImage(std::int32_t width,
+                              std::int32_t height)
+    {
+        Image image(width, height);
+
+        for (std::int32_t y = height / 2; y < height - 40; ++y)
+        {
+            for (std::int32_t x = 60; x < width - 60; ++x)
+            {
+                const std::uint32_t alpha = ((x / 16 + y / 16) % 2) ? 0xFF : 0xC0;
+                const std::uint32_t red = (x * 255 / width) * alpha / 255;
+                const std::uint32_t green = (y * 255 / height) * alpha / 255;
+                const std::uint32_t blue = 0x80 * alpha / 255;
+
+                image.m_pixels[y * width + x] = (alpha << 24) | (red << 16) | (green << 8) | blue;
+            }
+        }
+
+        return image;
+    }
+
+    Image randomImage(std::int32_t width,
+                      std::int32_t height)
+    {
+        Image image(width, height);
+
+        for (auto& pixel : image.m_pixels)
+        {
+            pixel = nextRandom();
+        }
+
+        return image;
+    }
+
+    static int channel(std::uint32_t pixel,
+                       int shift)
+    {
+        return (pixel >> shift) & 0xFF;
+    }
+
+    std::uint32_t nextRandom()
+    {
+        m_random = m_random * 1103515245 + 12345;
+        return (m_random >> 16) | (m_random << 16);
+    }
+
+    std::uint32_t m_random;
+
+    std::vector<Scaler::Type> m_types;
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION( ScalerTest );
@@ -0,0 +1,122 @@
+/*****************************************************************************
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:
+*
+* Copyright 2021 Liberty Global Service B.V.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*****************************************************************************/
+
+#include <cppunit/extensions/HelperMacros.h>
+#include "ShapingCache.hpp"
+
+using namespace subttxrend::gfx;
+
+class ShapingCacheTest : public CppUnit::TestFixture
+{
+CPPUNIT_TEST_SUITE( ShapingCacheTest );
+    CPPUNIT_TEST(hitAndMiss);
+    CPPUNIT_TEST(lruEviction);
+    CPPUNIT_TEST(replaceExisting);
+    CPPUNIT_TEST(disabled);
+CPPUNIT_TEST_SUITE_END();
+
+public:
+    void setUp()
+    {
+        // noop
+    }
+
+    void tearDown()
+    {
+        // noop
+    }
+
+    void hitAndMiss()
+    {
+        ShapingCache cache;
+
+        CPPUNIT_ASSERT(!cache.find("text"));
+
+        cache.insert("text", makeTokens(3));
+
+        auto tokens = cache.find("text");
+        CPPUNIT_ASSERT(tokens);
+        CPPUNIT_ASSERT_EQUAL(std::size_t(3), tokens->size());
+        CPPUNIT_ASSERT(!cache.find("other"));
+
+        CPPUNIT_ASSERT_EQUAL(std::size_t(1), cache.getHitCount());
+        CPPUNIT_ASSERT_EQUAL(std::size_t(2), cache.getMissCount());
+        CPPUNIT_ASSERT_EQUAL(std::size_t(1), cache.getSize());
+
+        cache.clear();
+        CPPUNIT_ASSERT(!cache.find("text"));
+        CPPUNIT_ASSERT_EQUAL(std::size_t(0), cache.getSize());
+    }
+
+    void lruEviction()
+    {
+        ShapingCache cache(2);
+
+        cache.insert("a", makeTokens(1));
+        cache.insert("b", makeTokens(2));
+
+        // make "a" most recently used
+        CPPUNIT_ASSERT(cache.find("a"));
+
+        cache.insert("c", makeTokens(3));
+
+        CPPUNIT_ASSERT_EQUAL(std::size_t(2), cache.getSize());
+        CPPUNIT_ASSERT(cache.find("a"));
+        CPPUNIT_ASSERT(!cache.find("b"));
+        CPPUNIT_ASSERT(cache.find("c"));
+
+        // "a" is least recently used now
+        cache.insert("d", makeTokens(4));
+
+        CPPUNIT_ASSERT(!cache.find("a"));
+        CPPUNIT_ASSERT(cache.find("c"));
+        CPPUNIT_ASSERT(cache.find("d"));
+    }
+
+    void replaceExisting()
+    {
+        ShapingCache cache(2);
+
+        cache.insert("a", makeTokens(1));
+        cache.insert("a", makeTokens(4));
+
+        auto tokens = cache.find("a");
+        CPPUNIT_ASSERT(tokens);
+        CPPUNIT_ASSERT_EQUAL(std::size_t(4), tokens->size());
+        CPPUNIT_ASSERT_EQUAL(std::size_t(1), cache.getSize());
+    }
+
+    void disabled()
+    {
+        ShapingCache cache(0);
+
+        cache.insert("a", makeTokens(1));
+
+        CPPUNIT_ASSERT(!cache.find("a"));
+        CPPUNIT_ASSERT_EQUAL(std::size_t(0), cache.getSize());
+    }
+
+private:
+    static std::vector<TextTokenData> makeTokens(std::size_t count)
+    {
+        return std::vector<TextTokenData>(count);
+    }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION( ShapingCacheTest );
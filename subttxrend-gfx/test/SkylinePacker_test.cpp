@@ -0,0 +1,125 @@
+/*****************************************************************************
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:
+*
+* Copyright 2021 Liberty Global Service B.V.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*****************************************************************************/
+
+#include <cppunit/extensions/HelperMacros.h>
+#include "SkylinePacker.hpp"
+
+#include <vector>
+
+using namespace subttxrend::gfx;
+
+class SkylinePackerTest : public CppUnit::TestFixture
+{
+CPPUNIT_TEST_SUITE( SkylinePackerTest );
+    CPPUNIT_TEST(singleRectangle);
+    CPPUNIT_TEST(fillCompletely);
+    CPPUNIT_TEST(noOverlap);
+    CPPUNIT_TEST(tooLarge);
+CPPUNIT_TEST_SUITE_END();
+
+public:
+    void setUp()
+    {
+        // noop
+    }
+
+    void tearDown()
+    {
+        // noop
+    }
+
+    void singleRectangle()
+    {
+        SkylinePacker packer(64, 32);
+
+        std::int32_t x = -1;
+        std::int32_t y = -1;
+        CPPUNIT_ASSERT(packer.pack(10, 20, x, y));
+        CPPUNIT_ASSERT_EQUAL(0, x);
+        CPPUNIT_ASSERT_EQUAL(0, y);
+
+        CPPUNIT_ASSERT(packer.pack(10, 5, x, y));
+        CPPUNIT_ASSERT_EQUAL(10, x);
+        CPPUNIT_ASSERT_EQUAL(0, y);
+    }
+
+    void fillCompletely()
+    {
+        SkylinePacker packer(64, 64);
+
+        std::int32_t x = 0;
+        std::int32_t y = 0;
+        for (int i = 0; i < 64; ++i)
+        {
+            CPPUNIT_ASSERT(packer.pack(8, 8, x, y));
+        }
+        CPPUNIT_ASSERT(!packer.pack(8, 8, x, y));
+        CPPUNIT_ASSERT(!packer.pack(1, 1, x, y));
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0, packer.getFillRate(), 0.0001);
+    }
+
+    void noOverlap()
+    {
+        const std::int32_t size = 128;
+        SkylinePacker packer(size, size);
+        std::vector<int> used(size * size, 0);
+
+        // mixed glyph sizes, like in a real font
+        for (int i = 0; i < 1000; ++i)
+        {
+            const std::int32_t w = 3 + (i * 7) % 13;
+            const std::int32_t h = 5 + (i * 11) % 17;
+
+            std::int32_t x = 0;
+            std::int32_t y = 0;
+            if (!packer.pack(w, h, x, y))
+            {
+                continue;
+            }
+
+            CPPUNIT_ASSERT(x >= 0 && x + w <= size);
+            CPPUNIT_ASSERT(y >= 0 && y + h <= size);
+
+            for (std::int32_t py = y; py < y + h; ++py)
+            {
+                for (std::int32_t px = x; px < x + w; ++px)
+                {
+                    CPPUNIT_ASSERT_EQUAL(0, used[py * size + px]);
+                    used[py * size + px] = 1;
+                }
+            }
+        }
+
+        CPPUNIT_ASSERT(packer.getFillRate() > 0.7);
+    }
+
+    void tooLarge()
+    {
+        SkylinePacker packer(32, 32);
+
+        std::int32_t x = 0;
+        std::int32_t y = 0;
+        CPPUNIT_ASSERT(!packer.pack(33, 1, x, y));
+        CPPUNIT_ASSERT(!packer.pack(1, 33, x, y));
+        CPPUNIT_ASSERT(!packer.pack(0, 1, x, y));
+        CPPUNIT_ASSERT(packer.pack(32, 32, x, y));
+    }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION( SkylinePackerTest );
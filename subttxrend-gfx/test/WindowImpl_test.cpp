@@ -0,0 +1,194 @@
+/*****************************************************************************
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:
+*
+* Copyright 2021 Liberty Global Service B.V.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*****************************************************************************/
+
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "WindowImpl.hpp"
+#include "EngineHooks.hpp"
+#include "Pixmap.hpp"
+
+using subttxrend::gfx::ColorArgb;
+using subttxrend::gfx::EngineHooks;
+using subttxrend::gfx::Pixmap;
+using subttxrend::gfx::Rectangle;
+using subttxrend::gfx::Size;
+using subttxrend::gfx::WindowImpl;
+
+class WindowImplTest : public CppUnit::TestFixture
+{
+CPPUNIT_TEST_SUITE( WindowImplTest );
+    CPPUNIT_TEST(testRetainedKeepsContents);
+    CPPUNIT_TEST(testRetainedEnabledAfterUpdate);
+    CPPUNIT_TEST(testClearRectangle);
+    CPPUNIT_TEST(testClearRectangleLocksHooks);
+CPPUNIT_TEST_SUITE_END();
+
+public:
+    void setUp()
+    {
+        m_window.reset(new WindowImpl());
+        m_window->setEngineHooks(&m_hooks);
+        m_window->setSize(Size{WIDTH, HEIGHT});
+        m_window->setVisible(true);
+        m_hooks.m_redrawRequests = 0;
+        m_hooks.m_locks = 0;
+    }
+
+    void tearDown()
+    {
+        m_window.reset();
+    }
+
+    void testRetainedKeepsContents()
+    {
+        m_window->setRetainedMode(true);
+
+        m_window->getDrawContext().fillRectangle(RED, FIRST);
+        present();
+        assertColor(RED, FIRST);
+
+        // drawing surface must hold the first frame after the swap
+        m_window->getDrawContext().fillRectangle(BLUE, SECOND);
+        present();
+        assertColor(RED, FIRST);
+        assertColor(BLUE, SECOND);
+
+        // and all the frames after it
+        present();
+        present();
+        assertColor(RED, FIRST);
+        assertColor(BLUE, SECOND);
+    }
+
+    void testRetainedEnabledAfterUpdate()
+    {
+        m_window->getDrawContext().fillRectangle(RED, FIRST);
+        present();
+
+        m_window->setRetainedMode(true);
+
+        m_window->getDrawContext().fillRectangle(BLUE, SECOND);
+        present();
+        assertColor(RED, FIRST);
+        assertColor(BLUE, SECOND);
+    }
+
+    void testClearRectangle()
+    {
+        m_window->setRetainedMode(true);
+
+        m_window->getDrawContext().fillRectangle(RED, FIRST);
+        m_window->getDrawContext().fillRectangle(BLUE, SECOND);
+        present();
+
+        m_window->clearRectangle(FIRST);
+        present();
+        assertColor(TRANSPARENT, FIRST);
+        assertColor(BLUE, SECOND);
+
+        present();
+        assertColor(TRANSPARENT, FIRST);
+        assertColor(BLUE, SECOND);
+    }
+
+    void testClearRectangleLocksHooks()
+    {
+        m_window->clearRectangle(FIRST);
+
+        CPPUNIT_ASSERT_EQUAL(1, m_hooks.m_locks);
+        CPPUNIT_ASSERT_EQUAL(0, m_hooks.m_depth);
+        CPPUNIT_ASSERT_EQUAL(1, m_hooks.m_redrawRequests);
+    }
+
+private:
+    class TestEngineHooks : public EngineHooks
+    {
+    public:
+        virtual void requestRedraw() override
+        {
+            CPPUNIT_ASSERT(m_depth > 0);
+            ++m_redrawRequests;
+        }
+
+        virtual void forceRedraw() override
+        {
+            // noop
+        }
+
+        virtual void lock() override
+        {
+            ++m_locks;
+            ++m_depth;
+        }
+
+        virtual void unlock() override
+        {
+            --m_depth;
+        }
+
+        int m_redrawRequests = 0;
+        int m_locks = 0;
+        int m_depth = 0;
+    };
+
+    static constexpr std::int32_t WIDTH = 64;
+    static constexpr std::int32_t HEIGHT = 32;
+
+    const ColorArgb RED{0xFF, 0xFF, 0x00, 0x00};
+    const ColorArgb BLUE{0xFF, 0x00, 0x00, 0xFF};
+    const ColorArgb TRANSPARENT{0x00, 0x00, 0x00, 0x00};
+
+    const Rectangle FIRST{4, 4, 16, 8};
+    const Rectangle SECOND{32, 16, 16, 8};
+
+    /**
+     * Updates the window and latches the frame the way the backend does.
+     */
+    void present()
+    {
+        m_window->update();
+        m_hooks.lock();
+        m_window->latchFrame();
+        m_hooks.unlock();
+    }
+
+    void assertColor(const ColorArgb& expected,
+                     const Rectangle& rect)
+    {
+        Pixmap& pixmap = m_window->getPixmap();
+
+        for (auto y = rect.m_y; y < rect.m_y + rect.m_h; ++y)
+        {
+            auto pixel = pixmap.getLine(y) + rect.m_x;
+            for (auto x = 0; x < rect.m_w; ++x, ++pixel)
+            {
+                CPPUNIT_ASSERT_EQUAL(static_cast<int>(expected.m_a), static_cast<int>(pixel->m_a));
+                CPPUNIT_ASSERT_EQUAL(static_cast<int>(expected.m_r), static_cast<int>(pixel->m_r));
+                CPPUNIT_ASSERT_EQUAL(static_cast<int>(expected.m_g), static_cast<int>(pixel->m_g));
+                CPPUNIT_ASSERT_EQUAL(static_cast<int>(expected.m_b), static_cast<int>(pixel->m_b));
+            }
+        }
+    }
+
+    TestEngineHooks m_hooks;
+    std::unique_ptr<WindowImpl> m_window;
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION( WindowImplTest );
@@ -0,0 +1,72 @@
+/*****************************************************************************
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:
+*
+* Copyright 2021 Liberty Global Service B.V.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*****************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "ScteRawBitmapDecoder.hpp"
+#include "ScteSimpleBitmap.hpp"
+
+namespace subttxrend
+{
+namespace scte
+{
+
+/**
+ * Writes decoded character pixels into the bytemap.
+ *
+ * Pixels are placed in lines from the character top left corner, a line
+ * ends at the bottom right x coordinate. If it is not right of the top
+ * left one, every pixel starts a new line (one pixel wide column), the
+ * same as the previous writer did. The bottom y coordinate is not used,
+ * pixels are written until the bitmap ends or the bytemap is full.
+ *
+ * The drop shadow (if any) is written from the same runs, shifted by the
+ * shadow offset. As long as a line is not longer than the bytemap width,
+ * shadow pixels always land at or after the character pixel decoded from
+ * the same run, so the result is the same as drawing the whole shadow first
+ * and the characters on top of it.
+ */
+class BytemapWriter : public RawBitmapDecoder::RunHandler
+{
+public:
+    BytemapWriter(uint8_t* bytemap, size_t size, size_t width, Coords topLeft, Coords bottomRight, uint8_t offColor);
+
+    void setShadow(uint8_t shadowRight, uint8_t shadowBottom);
+
+    void onRun(unsigned length, bool on) override;
+
+private:
+    void write(size_t start, size_t count, bool on, uint8_t onColor);
+
+    uint8_t* const bytemap;
+    const size_t size;
+    const size_t width;
+    const size_t lineLength;
+    size_t lineStart;
+    size_t column;
+    const uint8_t offColor;
+    bool shadowEnabled;
+    size_t shadowOffset;
+};
+
+} // namespace scte
+} // namespace subttxrend
@@ -21,6 +21,7 @@
 
 #include <cstdint>
 #include <utility>
+#include <vector>
 
 #include "ScteSimpleBitmap.hpp"
 
@@ -37,17 +38,29 @@ public:
     void setRange(const Coords &tl, const Coords &br);
 
 private:
-    void setPixel(unsigned x, unsigned y, uint32_t color);
-    void initCircle(unsigned outline_thickness);
-    void drawOutline(unsigned bx, unsigned by, unsigned outline_thickness, uint32_t value);
+    struct Box
+    {
+        uint32_t x0;
+        uint32_t y0;
+        uint32_t x1;
+        uint32_t y1;
+    };
+
+    bool findCharacterBox(Box &box) const;
+    void calculateColumnDistances(const Box &box, unsigned outline_thickness);
+    void outlineRow(const Box &box, uint32_t y, uint32_t value);
 
 private:
     std::uint8_t *m_bytemap;
     const uint32_t m_width;
     const uint32_t m_height;
     std::pair<uint32_t, uint32_t> m_range;
-    static constexpr int C_SIZE = 16;
-    static bool m_circle[C_SIZE][C_SIZE];
+
+    // distance to the nearest character pixel in the same column
+    // (outlined box area, row major)
+    std::vector<uint8_t> m_columnDistances;
+    // half width of the circle for given vertical distance
+    std::vector<uint8_t> m_halfWidths;
 };
 
 } // namespace scte
@@ -32,30 +32,55 @@ namespace scte
 class RawBitmapDecoder
 {
 public:
+    /**
+     * Receiver of decoded pixel runs.
+     *
+     * Runs are reported in bitmap order, line by line. A run may span
+     * several lines.
+     */
+    class RunHandler
+    {
+    public:
+        virtual ~RunHandler() = default;
+
+        /**
+         * Called for every decoded run.
+         *
+         * @param length
+         *      Number of pixels.
+         * @param on
+         *      True for character (on) pixels, false for background.
+         */
+        virtual void onRun(unsigned length, bool on) = 0;
+    };
+
     RawBitmapDecoder(RawBitmap &source, uint16_t width, uint16_t height);
     void decompress();
 
-private:
-    struct OutputData
-    {
-        RawBitmap::Data data;
-        const uint16_t width;
-        const uint16_t height;
-
-        OutputData(uint16_t width, uint16_t height)
-            : width(width), height(height)
-        {
-            data.reserve(static_cast<uint32_t>(width) * static_cast<uint32_t>(height));
-        }
-    };
+    /**
+     * Decodes bitmap without storing the pixels.
+     *
+     * Compressed bitmaps are decoded run by run, uncompressed ones are
+     * reported one byte (pixel) at a time.
+     *
+     * @param source
+     *      Bitmap to decode.
+     * @param width
+     *      Bitmap width.
+     * @param height
+     *      Bitmap height.
+     * @param handler
+     *      Receiver of decoded runs.
+     */
+    static void decode(const RawBitmap &source, uint16_t width, uint16_t height, RunHandler &handler);
 
-    void decompressInternal();
-    unsigned fillTillEol();
-    unsigned fill(uint16_t size, bool value);
+private:
+    static void decodeInternal(const RawBitmap &source, uint16_t width, uint16_t height, RunHandler &handler);
 
 private:
     RawBitmap &in;
-    OutputData out;
+    const uint16_t width;
+    const uint16_t height;
 
 };
 
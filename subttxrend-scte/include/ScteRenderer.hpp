@@ -23,6 +23,8 @@
 #include <subttxrend/gfx/Window.hpp>
 #include <subttxrend/gfx/Types.hpp>
 
+#include <vector>
+
 #include "ScteSimpleBitmap.hpp"
 #include "ScteRawBitmap.hpp"
 
@@ -51,9 +53,11 @@ public:
 private:
 
     static unsigned yuv2rgb(Color color);
-    void render(const RawBitmap::Data& bitmap, uint8_t* bytemap, Coords topLeft, Coords bottomRight, uint8_t onColor, uint8_t offColor, size_t width, size_t size);
     gfx::Window* const m_gfxWindow;
 
+    // CLUT indices of the rendered subtitle, reused between subtitles
+    std::vector<uint8_t> m_bytemap;
+
 };
 
 }   // namespace scte
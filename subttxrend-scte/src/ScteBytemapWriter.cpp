@@ -0,0 +1,90 @@
+/*****************************************************************************
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:
+*
+* Copyright 2021 Liberty Global Service B.V.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*****************************************************************************/
+
+#include "ScteBytemapWriter.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace subttxrend
+{
+namespace scte
+{
+
+BytemapWriter::BytemapWriter(uint8_t* bytemap, size_t size, size_t width, Coords topLeft, Coords bottomRight, uint8_t offColor) :
+    bytemap(bytemap), size(size), width(width),
+    lineLength((bottomRight.x > topLeft.x) ? bottomRight.x - topLeft.x : 1),
+    lineStart(topLeft.y * width + topLeft.x), column(0), offColor(offColor),
+    shadowEnabled(false), shadowOffset(0)
+{
+}
+
+void BytemapWriter::setShadow(uint8_t shadowRight, uint8_t shadowBottom)
+{
+    shadowEnabled = true;
+    shadowOffset = shadowBottom * width + shadowRight;
+}
+
+void BytemapWriter::onRun(unsigned length, bool on)
+{
+    while (length > 0)
+    {
+        size_t count = std::min<size_t>(length, lineLength - column);
+        size_t start = lineStart + column;
+
+        if (shadowEnabled)
+        {
+            write(start + shadowOffset, count, on, COLOR_SHADOW);
+        }
+        write(start, count, on, COLOR_CHARACTER);
+
+        length -= count;
+        column += count;
+        if (column >= lineLength)
+        {
+            lineStart += width;
+            column = 0;
+        }
+    }
+}
+
+void BytemapWriter::write(size_t start, size_t count, bool on, uint8_t onColor)
+{
+    if (start >= size)
+    {
+        return;
+    }
+    count = std::min(count, size - start);
+
+    if (on)
+    {
+        std::memset(bytemap + start, onColor, count);
+    }
+    else if (offColor != COLOR_TRANSPARENT)
+    {
+        for (auto pixel = bytemap + start; pixel != bytemap + start + count; ++pixel)
+        {
+            if (*pixel == COLOR_TRANSPARENT)
+                *pixel = offColor;
+        }
+    }
+}
+
+} // namespace scte
+} // namespace subttxrend
@@ -19,82 +19,199 @@
 
 #include "ScteOutliner.hpp"
 
+#include <algorithm>
+#include <cstring>
+
 #include "ScteSimpleBitmap.hpp"
 
 namespace subttxrend
 {
 namespace scte
 {
-bool Outliner::m_circle[C_SIZE][C_SIZE];
+
+namespace
+{
+
+const uint8_t NO_DISTANCE = 0xFF;
+
+// outline thickness is a 4-bit field, larger values are clamped so the
+// distances fit in bytes
+const unsigned MAX_THICKNESS = NO_DISTANCE - 1;
+
+} // namespace <anonymous>
 
 Outliner::Outliner(std::uint8_t *bytemap, uint32_t width, uint32_t height)
     : m_bytemap(bytemap), m_width(width), m_height(height), m_range{0, height - 1}
 {
 }
 
-void Outliner::setPixel(unsigned x, unsigned y, uint32_t color)
-{
-    auto pos = y * m_width + x;
-    if (pos < m_width * m_height && (m_bytemap[pos] == COLOR_TRANSPARENT || m_bytemap[pos] == COLOR_FRAME))
-    {
-        m_bytemap[pos] = static_cast<uint8_t>(color);
-    }
-}
-
-void Outliner::initCircle(unsigned outline_thickness)
+/*
+ * Every transparent or frame pixel within euclidean distance of
+ * outline_thickness from a character pixel (dx * dx + dy * dy <= t * t)
+ * gets the outline color. This is a dilation with a circular structuring
+ * element done in two linear passes over the character bounding box grown
+ * by the thickness: the vertical distance to the nearest character pixel
+ * in each column first, then along each row every such pixel covers
+ * the circle chord at its vertical distance.
+ */
+void Outliner::outline(unsigned outline_thickness, uint32_t value)
 {
-    static bool initialized = false;
+    outline_thickness = std::min(outline_thickness, MAX_THICKNESS);
 
-    if (initialized)
+    Box box;
+    if ((outline_thickness == 0) || !findCharacterBox(box))
     {
         return;
     }
-    for (unsigned dy = 0; dy <= C_SIZE - 1; dy++)
+
+    box.x0 = (box.x0 > outline_thickness) ? box.x0 - outline_thickness : 0;
+    box.y0 = (box.y0 > outline_thickness) ? box.y0 - outline_thickness : 0;
+    box.x1 = std::min<uint32_t>(box.x1 + outline_thickness, m_width - 1);
+    box.y1 = std::min<uint32_t>(box.y1 + outline_thickness, m_height - 1);
+
+    m_halfWidths.resize(outline_thickness + 1);
+    for (unsigned dy = 0; dy <= outline_thickness; dy++)
     {
-        for (unsigned dx = 0; dx <= C_SIZE -1; dx++)
+        unsigned dx = 0;
+        while ((dx + 1) * (dx + 1) + dy * dy <= outline_thickness * outline_thickness)
         {
-            m_circle[dy][dx] = (dx * dx + dy * dy <= outline_thickness * outline_thickness);
+            dx++;
         }
+        m_halfWidths[dy] = static_cast<uint8_t>(dx);
+    }
+
+    calculateColumnDistances(box, outline_thickness);
+
+    for (uint32_t y = box.y0; y <= box.y1; y++)
+    {
+        outlineRow(box, y, value);
     }
-    initialized = true;
 }
 
-void Outliner::drawOutline(unsigned bx, unsigned by, unsigned outline_thickness, uint32_t value)
+void Outliner::setRange(const Coords &tl, const Coords &br)
 {
-    for (unsigned dy = 0; dy <= outline_thickness; dy++)
+    m_range = {tl.y, br.y};
+}
+
+bool Outliner::findCharacterBox(Box &box) const
+{
+    bool found = false;
+    const uint32_t lastRow = std::min<uint32_t>(m_range.second, m_height - 1);
+
+    for (uint32_t y = m_range.first; y <= lastRow; y++)
     {
-        for (unsigned dx = 0; dx <= outline_thickness; dx++)
+        const std::uint8_t *row = m_bytemap + y * m_width;
+        auto first = static_cast<const std::uint8_t *>(std::memchr(row, COLOR_CHARACTER, m_width));
+        if (!first)
         {
-            if (m_circle[dy][dx])
-            {
-                setPixel(bx + dx, by + dy, value);
-                setPixel(bx - dx, by + dy, value);
-                setPixel(bx + dx, by - dy, value);
-                setPixel(bx - dx, by - dy, value);
-            }
+            continue;
+        }
+        uint32_t last = m_width - 1;
+        while (row[last] != COLOR_CHARACTER)
+        {
+            --last;
         }
+
+        const uint32_t x = first - row;
+        if (!found)
+        {
+            box = {x, y, last, y};
+            found = true;
+        }
+        box.x0 = std::min(box.x0, x);
+        box.x1 = std::max(box.x1, last);
+        box.y1 = y;
     }
+    return found;
 }
 
-void Outliner::outline(unsigned outline_thickness, uint32_t value)
+void Outliner::calculateColumnDistances(const Box &box, unsigned outline_thickness)
 {
-    initCircle(outline_thickness);
-    for (unsigned by = m_range.first; by < m_range.second + 1; by++)
+    const uint32_t boxWidth = box.x1 - box.x0 + 1;
+    const uint32_t boxHeight = box.y1 - box.y0 + 1;
+
+    m_columnDistances.resize(boxWidth * boxHeight);
+
+    // distances further than the thickness are never needed
+    auto next = [outline_thickness](uint8_t distance) -> uint8_t
     {
-        for (unsigned bx = 0; bx < m_width; bx++)
+        return (distance < outline_thickness) ? distance + 1 : NO_DISTANCE;
+    };
+
+    for (uint32_t y = 0; y < boxHeight; y++)
+    {
+        const uint32_t bitmapY = box.y0 + y;
+        const bool inRange = (bitmapY >= m_range.first) && (bitmapY <= m_range.second);
+        const std::uint8_t *row = m_bytemap + bitmapY * m_width + box.x0;
+        uint8_t *distances = m_columnDistances.data() + y * boxWidth;
+        const uint8_t *above = distances - boxWidth;
+
+        for (uint32_t x = 0; x < boxWidth; x++)
         {
-            if (m_bytemap[by * m_width + bx] != 1)
+            if (inRange && row[x] == COLOR_CHARACTER)
             {
-                continue;
+                distances[x] = 0;
+            }
+            else
+            {
+                distances[x] = (y > 0) ? next(above[x]) : NO_DISTANCE;
             }
-            drawOutline(bx, by, outline_thickness, value);
+        }
+    }
+
+    for (uint32_t y = boxHeight - 1; y-- > 0;)
+    {
+        uint8_t *distances = m_columnDistances.data() + y * boxWidth;
+        const uint8_t *below = distances + boxWidth;
+
+        for (uint32_t x = 0; x < boxWidth; x++)
+        {
+            distances[x] = std::min(distances[x], next(below[x]));
         }
     }
 }
 
-void Outliner::setRange(const Coords &tl, const Coords &br)
+void Outliner::outlineRow(const Box &box, uint32_t y, uint32_t value)
 {
-    m_range = {tl.y, br.y};
+    const int32_t boxWidth = box.x1 - box.x0 + 1;
+    const uint8_t *distances = m_columnDistances.data() + (y - box.y0) * boxWidth;
+    std::uint8_t *row = m_bytemap + y * m_width + box.x0;
+
+    auto paint = [row, value](int32_t x)
+    {
+        if (row[x] == COLOR_TRANSPARENT || row[x] == COLOR_FRAME)
+        {
+            row[x] = static_cast<uint8_t>(value);
+        }
+    };
+
+    // pixels covered by chords of columns on the left
+    int32_t reach = -1;
+    for (int32_t x = 0; x < boxWidth; x++)
+    {
+        if (distances[x] != NO_DISTANCE)
+        {
+            reach = std::max(reach, x + m_halfWidths[distances[x]]);
+        }
+        if (reach >= x)
+        {
+            paint(x);
+        }
+    }
+
+    // pixels covered by chords of columns on the right
+    reach = boxWidth;
+    for (int32_t x = boxWidth - 1; x >= 0; x--)
+    {
+        if (distances[x] != NO_DISTANCE)
+        {
+            reach = std::min(reach, x - m_halfWidths[distances[x]]);
+        }
+        if (reach <= x)
+        {
+            paint(x);
+        }
+    }
 }
 
 } // namespace scte
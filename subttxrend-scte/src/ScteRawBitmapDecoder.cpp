@@ -32,10 +32,28 @@ namespace scte
 namespace
 {
 common::Logger g_logger("Scte", "ScteRawBitmapDecoder");
+
+class DataWriter : public RawBitmapDecoder::RunHandler
+{
+public:
+    DataWriter(RawBitmap::Data &data) :
+            data(data)
+    {
+    }
+
+    void onRun(unsigned length, bool on) override
+    {
+        data.insert(data.end(), length, on);
+    }
+
+private:
+    RawBitmap::Data &data;
+};
+
 } // namespace
 
 RawBitmapDecoder::RawBitmapDecoder(RawBitmap &source, uint16_t width, uint16_t height)
-    : in(source), out(width, height)
+    : in(source), width(width), height(height)
 {
     if (!width || !height)
     {
@@ -47,36 +65,53 @@ void RawBitmapDecoder::decompress()
 {
     if (!in.isCompressed()) return;
 
+    RawBitmap::Data data;
+    data.reserve(static_cast<uint32_t>(width) * static_cast<uint32_t>(height));
+
+    DataWriter writer{data};
+    decode(in, width, height, writer);
+
+    in.setRawData(std::move(data));
+    in.setCompression(false);
+}
+
+void RawBitmapDecoder::decode(const RawBitmap &source, uint16_t width, uint16_t height, RunHandler &handler)
+{
+    if (!source.isCompressed())
+    {
+        for (auto byte : source.getRawData())
+        {
+            handler.onRun(1, byte != 0);
+        }
+        return;
+    }
+
+    if (!width || !height)
+    {
+        return;
+    }
+
     try
     {
-        decompressInternal();
+        decodeInternal(source, width, height, handler);
     }
     catch (InvalidArgument &ex)
     {
         g_logger.error("bitmap finished prematurely during decompression");
     }
-
-    in.setRawData(std::move(out.data));
-    in.setCompression(false);
-}
-
-unsigned RawBitmapDecoder::fillTillEol()
-{
-    uint16_t to_fill = out.width - (out.data.size() % out.width);
-    return fill(to_fill, false);
 }
 
-unsigned RawBitmapDecoder::fill(uint16_t size, bool value)
+void RawBitmapDecoder::decodeInternal(const RawBitmap &source, uint16_t width, uint16_t height, RunHandler &handler)
 {
-    out.data.insert(out.data.end(), size, value);
-    return size;
-}
+    BitStream bs{source.getRawData()};
 
-void RawBitmapDecoder::decompressInternal()
-{
-    BitStream bs{in.getRawData()};
+    auto fill = [&handler](unsigned size, bool value)
+    {
+        handler.onRun(size, value);
+        return size;
+    };
 
-    unsigned bitmap_size = out.width * out.height;
+    unsigned bitmap_size = width * height;
     for (unsigned i = 0; i < bitmap_size;)
     {
         if (bs.data(1))
@@ -109,7 +144,7 @@ void RawBitmapDecoder::decompressInternal()
             if (op == 0x1)
             {
                 // newline, fill remaining bits with zeroes
-                i += fillTillEol();
+                i += fill(width - (i % width), false);
             }
             else if (op != 0x0)
             {
@@ -18,13 +18,18 @@
 *****************************************************************************/
 
 #include "ScteRenderer.hpp"
+#include "ScteBytemapWriter.hpp"
 #include "ScteOutliner.hpp"
+#include "ScteRawBitmapDecoder.hpp"
 
 #include <subttxrend/gfx/ColorArgb.hpp>
 #include <subttxrend/gfx/Types.hpp>
 #include <subttxrend/common/Logger.hpp>
 
+#include <algorithm>
 #include <cassert>
+#include <cstring>
+
 namespace subttxrend
 {
 namespace scte
@@ -40,36 +45,6 @@ const int DEFAULT_WINDOW_H = 1080;
 
 gfx::Rectangle dstRect{0, 0, DEFAULT_WINDOW_W, DEFAULT_WINDOW_H};
 
-class Indexer
-{
-public:
-    Indexer(Coords ft, Coords fb, size_t width):
-        idx(ft.y * width + ft.x), line_begin(ft.y * width + ft.x), line_end(ft.y * width + fb.x), width(width)
-    {
-    }
-
-    operator size_t () const
-    {
-        return idx;
-    }
-
-    void operator++()
-    {
-        idx++;
-        if (idx >= line_end)
-        {
-            line_begin += width;
-            line_end += width;
-            idx = line_begin;
-        }
-    }
-private:
-    size_t idx;
-    size_t width;
-    size_t line_begin;
-    size_t line_end;
-};
-
 }
 
 Renderer::Renderer(gfx::Window* gfxWindow) :
@@ -118,7 +93,6 @@ unsigned Renderer::yuv2rgb(Color color)
 void Renderer::render(const SimpleBitmap& bm, size_t width, size_t height)
 {
     auto size = width * height;
-    auto& bitmap = bm.getBitmap().getRawData();
 
     std::uint32_t clut[COLOR_LAST];
     clut[COLOR_TRANSPARENT] = 0;
@@ -127,8 +101,10 @@ void Renderer::render(const SimpleBitmap& bm, size_t width, size_t height)
     clut[COLOR_OUTLINE] =  yuv2rgb(bm.getOutlineColor());
     clut[COLOR_SHADOW] = yuv2rgb(bm.getShadowColor());
 
-    auto bytemap = std::make_unique<std::uint8_t[]>(std::max(size, static_cast<size_t>(1)));
-    std::fill_n(bytemap.get(), size, 0);
+    // buffer is kept between subtitles, only cleared
+    m_bytemap.resize(std::max(size, static_cast<size_t>(1)));
+    std::fill_n(m_bytemap.data(), size, 0);
+    auto bytemap = m_bytemap.data();
 
     auto framed = bm.getBackgroundStyle() == BackgroundStyle::FRAMED;
 
@@ -148,51 +124,26 @@ void Renderer::render(const SimpleBitmap& bm, size_t width, size_t height)
     auto bottom = bm.getCharacterBottom();
     auto bgcolor = framed ? COLOR_FRAME: COLOR_TRANSPARENT;
 
+    BytemapWriter writer(bytemap, size, width, top, bottom, bgcolor);
     if (bm.getOutlineStyle() == OutlineStyle::DROP_SHADOW)
     {
-        auto shR = bm.getShadowRight();
-        auto shB = bm.getShadowBottom();
-        Coords topLeft {static_cast<uint16_t>(top.x + shR), static_cast<uint16_t>(top.y + shB)};
-        Coords bottomRight {static_cast<uint16_t>(bottom.x + shR), static_cast<uint16_t>(bottom.y + shB)};
-        render(bitmap, bytemap.get(), topLeft, bottomRight, COLOR_SHADOW, bgcolor, width, size);
+        writer.setShadow(bm.getShadowRight(), bm.getShadowBottom());
     }
-    render(bitmap, bytemap.get(), top, bottom, COLOR_CHARACTER, bgcolor, width, size);
+    RawBitmapDecoder::decode(bm.getBitmap(), bm.width(), bm.height(), writer);
 
     if (bm.getOutlineStyle() == OutlineStyle::OUTLINE)
     {
-        Outliner outliner(bytemap.get(), width, height);
+        Outliner outliner(bytemap, width, height);
         outliner.setRange(bm.getCharacterTop(), bm.getCharacterBottom());
         outliner.outline(bm.getOutlineThickness(), COLOR_OUTLINE);
     }
 
-    gfx::ClutBitmap pixmap(width, height, width, bytemap.get(), clut, sizeof(clut)/sizeof(*clut));
+    gfx::ClutBitmap pixmap(width, height, width, bytemap, clut, sizeof(clut)/sizeof(*clut));
 
     m_gfxWindow->getDrawContext().drawPixmap(pixmap, gfx::Rectangle(0, 0, width, height), dstRect);
     update();
 }
 
-
-void Renderer::render(const RawBitmap::Data& bitmap, uint8_t* bytemap, Coords topLeft, Coords bottomRight, uint8_t onColor, uint8_t offColor, size_t width, size_t size)
-{
-    Indexer idx(topLeft, bottomRight, width);
-    if (idx >= size)
-    {
-        return;
-    }
-    for (auto& byte: bitmap)
-    {
-        if (byte)
-            bytemap[idx] = onColor;
-        else if (bytemap[idx] == COLOR_TRANSPARENT)
-            bytemap[idx] = offColor;
-        ++idx;
-        if (idx >= size)
-        {
-            break;
-        }
-    }
-}
-
 void Renderer::show()
 {
     g_logger.debug("%s - showing window: w:%d, h:%d" , __func__, DEFAULT_WINDOW_W, DEFAULT_WINDOW_H);
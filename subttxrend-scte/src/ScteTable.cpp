@@ -162,7 +162,12 @@ void ScteTable::fillFields(const uint8_t* data, std::size_t size)
             throw ParseError("ScteTable: extracted bitmap length is zero");
         }
         bitmap.setBitmap(data+12, bitmapLen);
-        bitmap.decompress();
+        // bitmap stays compressed, renderer decodes it straight into the bytemap;
+        // only compressed bitmaps need non-empty size to be decoded
+        if (bitmap.getBitmap().isCompressed() && (!bitmap.width() || !bitmap.height()))
+        {
+            throw InvalidArgument("ScteTable: compressed bitmap width and height cannot be zero");
+        }
     }
 }
 
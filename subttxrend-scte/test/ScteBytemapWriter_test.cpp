@@ -0,0 +1,339 @@
+/*****************************************************************************
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:
+*
+* Copyright 2021 Liberty Global Service B.V.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*****************************************************************************/
+
+#include <cppunit/extensions/HelperMacros.h>
+#include "ScteBytemapWriter.hpp"
+#include "ScteRawBitmapDecoder.hpp"
+#include "TwoPassBytemapWriter.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using namespace subttxrend::scte;
+
+class ScteBytemapWriterTest : public CppUnit::TestFixture
+{
+CPPUNIT_TEST_SUITE( ScteBytemapWriterTest );
+    CPPUNIT_TEST(sameAsTwoPassCompressed);
+    CPPUNIT_TEST(sameAsTwoPassUncompressed);
+    CPPUNIT_TEST(sameAsTwoPassTruncated);
+    CPPUNIT_TEST(clippedAtBytemapEnd);
+    CPPUNIT_TEST(invertedCoordinates);
+    CPPUNIT_TEST(zeroLineLength);
+    CPPUNIT_TEST(shadowUnderCharacters);
+CPPUNIT_TEST_SUITE_END();
+
+public:
+    void setUp()
+    {
+        // noop
+    }
+
+    void tearDown()
+    {
+        // noop
+    }
+
+    void sameAsTwoPassCompressed()
+    {
+        std::mt19937 random(1234);
+
+        for (int i = 0; i < 200; i++)
+        {
+            uint16_t bmWidth = 1 + random() % 40;
+            uint16_t bmHeight = 1 + random() % 20;
+            auto bitmap = makeCompressed(random, bmWidth, bmHeight, false);
+
+            Coords top{uint16_t(random() % (WIDTH - bmWidth)), uint16_t(random() % (HEIGHT - bmHeight))};
+            Coords bottom{uint16_t(top.x + bmWidth), uint16_t(top.y + bmHeight)};
+            check(random, bitmap, bmWidth, bmHeight, top, bottom);
+        }
+    }
+
+    void sameAsTwoPassUncompressed()
+    {
+        std::mt19937 random(5678);
+
+        for (int i = 0; i < 200; i++)
+        {
+            uint16_t bmWidth = 1 + random() % 40;
+            uint16_t bmHeight = 1 + random() % 20;
+            RawBitmap::Data data(bmWidth * bmHeight);
+            for (auto& pixel : data)
+            {
+                pixel = random() % 2;
+            }
+            RawBitmap bitmap(false, data.data(), data.size());
+
+            Coords top{uint16_t(random() % (WIDTH - bmWidth)), uint16_t(random() % (HEIGHT - bmHeight))};
+            Coords bottom{uint16_t(top.x + bmWidth), uint16_t(top.y + bmHeight)};
+            check(random, bitmap, bmWidth, bmHeight, top, bottom);
+        }
+    }
+
+    void sameAsTwoPassTruncated()
+    {
+        std::mt19937 random(9012);
+
+        for (int i = 0; i < 100; i++)
+        {
+            uint16_t bmWidth = 1 + random() % 40;
+            uint16_t bmHeight = 1 + random() % 20;
+            auto bitmap = makeCompressed(random, bmWidth, bmHeight, true);
+
+            Coords top{uint16_t(random() % (WIDTH - bmWidth)), uint16_t(random() % (HEIGHT - bmHeight))};
+            Coords bottom{uint16_t(top.x + bmWidth), uint16_t(top.y + bmHeight)};
+            check(random, bitmap, bmWidth, bmHeight, top, bottom);
+        }
+    }
+
+    void clippedAtBytemapEnd()
+    {
+        std::mt19937 random(3456);
+
+        for (int i = 0; i < 200; i++)
+        {
+            uint16_t bmWidth = 1 + random() % 40;
+            uint16_t bmHeight = 1 + random() % 20;
+            auto bitmap = makeCompressed(random, bmWidth, bmHeight, false);
+
+            // bitmap (and its shadow) runs over the last bytemap lines
+            Coords top{uint16_t(random() % (WIDTH - bmWidth)), uint16_t(HEIGHT - 1 - random() % bmHeight)};
+            Coords bottom{uint16_t(top.x + bmWidth), uint16_t(top.y + bmHeight)};
+            check(random, bitmap, bmWidth, bmHeight, top, bottom);
+        }
+    }
+
+    void invertedCoordinates()
+    {
+        std::mt19937 random(7890);
+
+        for (int i = 0; i < 100; i++)
+        {
+            uint16_t bmWidth = 1 + random() % 40;
+            uint16_t bmHeight = 1 + random() % 20;
+            auto bitmap = makeCompressed(random, bmWidth, bmHeight, false);
+
+            Coords top{uint16_t(1 + random() % (WIDTH - 1)), uint16_t(1 + random() % (HEIGHT - 1))};
+            Coords bottom{uint16_t(random() % top.x), uint16_t(random() % top.y)};
+            check(random, bitmap, bmWidth, bmHeight, top, bottom);
+        }
+    }
+
+    void zeroLineLength()
+    {
+        std::mt19937 random(1357);
+
+        for (int i = 0; i < 100; i++)
+        {
+            uint16_t bmWidth = 1 + random() % 40;
+            uint16_t bmHeight = 1 + random() % 20;
+            auto bitmap = makeCompressed(random, bmWidth, bmHeight, false);
+
+            Coords top{uint16_t(random() % WIDTH), uint16_t(random() % HEIGHT)};
+            Coords bottom{top.x, uint16_t(top.y + bmHeight)};
+            check(random, bitmap, bmWidth, bmHeight, top, bottom);
+        }
+
+        // previous writer drew a one pixel wide column in this case
+        const uint8_t data[] = {1, 1, 0, 1};
+        RawBitmap bitmap(false, data, sizeof(data));
+        std::vector<uint8_t> bytemap(WIDTH * HEIGHT, COLOR_TRANSPARENT);
+
+        BytemapWriter writer(bytemap.data(), bytemap.size(), WIDTH, Coords{10, 10}, Coords{10, 14}, COLOR_FRAME);
+        RawBitmapDecoder::decode(bitmap, 4, 1, writer);
+
+        CPPUNIT_ASSERT_EQUAL(uint8_t(COLOR_CHARACTER), bytemap[10 * WIDTH + 10]);
+        CPPUNIT_ASSERT_EQUAL(uint8_t(COLOR_CHARACTER), bytemap[11 * WIDTH + 10]);
+        CPPUNIT_ASSERT_EQUAL(uint8_t(COLOR_FRAME), bytemap[12 * WIDTH + 10]);
+        CPPUNIT_ASSERT_EQUAL(uint8_t(COLOR_CHARACTER), bytemap[13 * WIDTH + 10]);
+        CPPUNIT_ASSERT_EQUAL(uint8_t(COLOR_TRANSPARENT), bytemap[10 * WIDTH + 11]);
+    }
+
+    void shadowUnderCharacters()
+    {
+        // 3x2 bitmap, shadow shifted by one pixel right and down
+        const uint8_t data[] = {1, 1, 0,
+                                0, 1, 1};
+        RawBitmap bitmap(false, data, sizeof(data));
+        std::vector<uint8_t> bytemap(WIDTH * HEIGHT, COLOR_TRANSPARENT);
+
+        BytemapWriter writer(bytemap.data(), bytemap.size(), WIDTH, Coords{20, 20}, Coords{23, 22}, COLOR_TRANSPARENT);
+        writer.setShadow(1, 1);
+        RawBitmapDecoder::decode(bitmap, 3, 2, writer);
+
+        const uint8_t expected[3][4] = {
+            {COLOR_CHARACTER, COLOR_CHARACTER, COLOR_TRANSPARENT, COLOR_TRANSPARENT},
+            {COLOR_TRANSPARENT, COLOR_CHARACTER, COLOR_CHARACTER, COLOR_TRANSPARENT},
+            {COLOR_TRANSPARENT, COLOR_TRANSPARENT, COLOR_SHADOW, COLOR_SHADOW},
+        };
+        for (int y = 0; y < 3; y++)
+        {
+            for (int x = 0; x < 4; x++)
+            {
+                CPPUNIT_ASSERT_EQUAL(expected[y][x], bytemap[(20 + y) * WIDTH + 20 + x]);
+            }
+        }
+    }
+
+private:
+    static constexpr std::size_t WIDTH = 64;
+    static constexpr std::size_t HEIGHT = 48;
+
+    /**
+     * Compares the writer against the two pass writer for the same bitmap,
+     * with and without shadow and frame background.
+     */
+    void check(std::mt19937& random, const RawBitmap& bitmap, uint16_t bmWidth, uint16_t bmHeight,
+               Coords top, Coords bottom)
+    {
+        RawBitmap decompressed;
+        decompressed = bitmap;
+        RawBitmapDecoder(decompressed, bmWidth, bmHeight).decompress();
+
+        for (int variant = 0; variant < 4; variant++)
+        {
+            bool shadow = variant & 1;
+            uint8_t bgcolor = (variant & 2) ? COLOR_FRAME : COLOR_TRANSPARENT;
+            uint8_t shR = random() % 8;
+            uint8_t shB = random() % 8;
+
+            auto initial = makeBytemap(random);
+
+            auto expected = initial;
+            TwoPassBytemapWriter twoPass(expected.data(), expected.size(), WIDTH);
+            twoPass.write(decompressed.getRawData(), top, bottom, bgcolor, shadow, shR, shB);
+
+            auto bytemap = initial;
+            BytemapWriter writer(bytemap.data(), bytemap.size(), WIDTH, top, bottom, bgcolor);
+            if (shadow)
+            {
+                writer.setShadow(shR, shB);
+            }
+            RawBitmapDecoder::decode(bitmap, bmWidth, bmHeight, writer);
+
+            CPPUNIT_ASSERT(bytemap == expected);
+        }
+    }
+
+    /**
+     * Creates empty bytemap with optional frame rectangle, the same as
+     * the renderer does.
+     */
+    std::vector<uint8_t> makeBytemap(std::mt19937& random)
+    {
+        std::vector<uint8_t> bytemap(WIDTH * HEIGHT, COLOR_TRANSPARENT);
+        if (random() % 2)
+        {
+            std::size_t left = random() % WIDTH;
+            std::size_t right = left + random() % (WIDTH - left);
+            std::size_t top = random() % HEIGHT;
+            std::size_t bottom = top + random() % (HEIGHT - top);
+            for (auto y = top; y <= bottom; y++)
+            {
+                std::fill(&bytemap[y * WIDTH + left], &bytemap[y * WIDTH + right + 1], COLOR_FRAME);
+            }
+        }
+        return bytemap;
+    }
+
+    /**
+     * Creates random compressed bitmap (SCTE-27 table 5.8 codes). If
+     * truncated, the stream ends before the whole bitmap is coded.
+     */
+    RawBitmap makeCompressed(std::mt19937& random, uint16_t bmWidth, uint16_t bmHeight, bool truncated)
+    {
+        std::vector<bool> bits;
+        auto put = [&bits](uint32_t value, unsigned count)
+        {
+            while (count-- > 0)
+            {
+                bits.push_back((value >> count) & 1);
+            }
+        };
+
+        unsigned bitmapSize = bmWidth * bmHeight;
+        unsigned limit = truncated ? random() % bitmapSize : bitmapSize;
+        for (unsigned i = 0; i < limit;)
+        {
+            switch (random() % 5)
+            {
+            case 0:
+            {
+                // '1' 3 bits on, 5 bits off, zero means 8 / 32
+                unsigned on = random() % 8;
+                unsigned off = random() % 32;
+                put(1, 1);
+                put(on, 3);
+                put(off, 5);
+                i += (on ? on : 8) + (off ? off : 32);
+                break;
+            }
+            case 1:
+            {
+                // '01' 6 bits off, zero means 64
+                unsigned off = random() % 64;
+                put(1, 2);
+                put(off, 6);
+                i += off ? off : 64;
+                break;
+            }
+            case 2:
+            {
+                // '001' 4 bits on, zero means 16
+                unsigned on = random() % 16;
+                put(1, 3);
+                put(on, 4);
+                i += on ? on : 16;
+                break;
+            }
+            case 3:
+                // '00001' end of line
+                put(1, 5);
+                i += bmWidth - (i % bmWidth);
+                break;
+            default:
+                // '00000' no operation
+                put(0, 5);
+                break;
+            }
+        }
+
+        RawBitmap::Data data((bits.size() + 7) / 8);
+        for (std::size_t i = 0; i < bits.size(); i++)
+        {
+            if (bits[i])
+            {
+                data[i / 8] |= 0x80 >> (i % 8);
+            }
+        }
+        if (data.empty())
+        {
+            data.push_back(0);
+        }
+        return RawBitmap(true, data.data(), data.size());
+    }
+};
+
+constexpr std::size_t ScteBytemapWriterTest::WIDTH;
+constexpr std::size_t ScteBytemapWriterTest::HEIGHT;
+
+CPPUNIT_TEST_SUITE_REGISTRATION( ScteBytemapWriterTest );
@@ -0,0 +1,118 @@
+/*****************************************************************************
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:
+*
+* Copyright 2021 Liberty Global Service B.V.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*****************************************************************************/
+
+/*
+ * Benchmark of Outliner::outline() against the previous stamping outliner
+ * on a 720x480 bytemap with two caption lines near the bottom, for outline
+ * thickness 1..15. Not a unit test, run manually:
+ * ScteOutliner_Benchmark [iterations]
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "ScteOutliner.hpp"
+#include "StampingOutliner.hpp"
+
+using namespace subttxrend::scte;
+
+namespace
+{
+
+const uint32_t WIDTH = 720;
+const uint32_t HEIGHT = 480;
+
+/** Glyph-like 3 pixel wide strokes, 20x28 cells, two lines of 28 characters. */
+std::vector<std::uint8_t> buildBytemap()
+{
+    std::vector<std::uint8_t> bytemap(WIDTH * HEIGHT, COLOR_TRANSPARENT);
+    std::mt19937 random(2021);
+
+    for (uint32_t line = 0; line < 2; line++)
+    {
+        const uint32_t top = 360 + line * 40;
+        for (uint32_t cell = 0; cell < 28; cell++)
+        {
+            const uint32_t left = 80 + cell * 20;
+            for (int stroke = 0; stroke < 3; stroke++)
+            {
+                const bool horizontal = (random() % 2) == 0;
+                const uint32_t x0 = left + random() % (horizontal ? 4 : 14);
+                const uint32_t y0 = top + random() % (horizontal ? 25 : 8);
+                const uint32_t x1 = horizontal ? x0 + 12 : x0 + 3;
+                const uint32_t y1 = horizontal ? y0 + 3 : y0 + 20;
+
+                for (uint32_t y = y0; y < y1; y++)
+                {
+                    for (uint32_t x = x0; x < x1; x++)
+                    {
+                        bytemap[y * WIDTH + x] = COLOR_CHARACTER;
+                    }
+                }
+            }
+        }
+    }
+    return bytemap;
+}
+
+template <typename OutlinerType>
+double benchmark(const std::vector<std::uint8_t>& source, unsigned thickness, std::size_t iterations)
+{
+    double best = 0;
+    for (std::size_t i = 0; i < iterations; i++)
+    {
+        auto bytemap = source;
+
+        auto start = std::chrono::steady_clock::now();
+        OutlinerType outliner(bytemap.data(), WIDTH, HEIGHT);
+        outliner.outline(thickness, COLOR_OUTLINE);
+        auto end = std::chrono::steady_clock::now();
+
+        double ms = std::chrono::duration<double, std::milli>(end - start).count();
+        if ((i == 0) || (ms < best))
+        {
+            best = ms;
+        }
+    }
+    return best;
+}
+
+} // namespace <anonymous>
+
+int main(int argc,
+         char* argv[])
+{
+    const std::size_t iterations = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 20;
+    const auto bytemap = buildBytemap();
+
+    std::printf("%ux%u outline, best of %zu\n", WIDTH, HEIGHT, iterations);
+    for (unsigned thickness = 1; thickness <= 15; thickness++)
+    {
+        const double stamping = benchmark<StampingOutliner>(bytemap, thickness, iterations);
+        const double outliner = benchmark<Outliner>(bytemap, thickness, iterations);
+
+        std::printf("thickness %2u stamping %8.3f ms outliner %8.3f ms (x%.1f)\n",
+                    thickness, stamping, outliner, stamping / outliner);
+    }
+    return EXIT_SUCCESS;
+}
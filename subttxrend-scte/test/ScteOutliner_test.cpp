@@ -0,0 +1,193 @@
+/*****************************************************************************
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:
+*
+* Copyright 2021 Liberty Global Service B.V.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*****************************************************************************/
+
+#include <cppunit/extensions/HelperMacros.h>
+#include "ScteOutliner.hpp"
+#include "StampingOutliner.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using namespace subttxrend::scte;
+
+class ScteOutlinerTest : public CppUnit::TestFixture
+{
+CPPUNIT_TEST_SUITE( ScteOutlinerTest );
+    CPPUNIT_TEST(sameAsStamping);
+    CPPUNIT_TEST(sameAsStampingWithRange);
+    CPPUNIT_TEST(onlyTransparentAndFrameRepainted);
+    CPPUNIT_TEST(edgePixelsStayInRow);
+    CPPUNIT_TEST(zeroThickness);
+CPPUNIT_TEST_SUITE_END();
+
+public:
+    void setUp()
+    {
+        // noop
+    }
+
+    void tearDown()
+    {
+        // noop
+    }
+
+    void sameAsStamping()
+    {
+        std::mt19937 random(1234);
+
+        for (unsigned thickness = 1; thickness <= 15; thickness++)
+        {
+            for (int i = 0; i < 4; i++)
+            {
+                auto bytemap = makeBytemap(random);
+
+                auto expected = bytemap;
+                StampingOutliner stamping(expected.data(), WIDTH, HEIGHT);
+                stamping.outline(thickness, COLOR_OUTLINE);
+
+                Outliner outliner(bytemap.data(), WIDTH, HEIGHT);
+                outliner.outline(thickness, COLOR_OUTLINE);
+
+                CPPUNIT_ASSERT(bytemap == expected);
+            }
+        }
+    }
+
+    void sameAsStampingWithRange()
+    {
+        std::mt19937 random(5678);
+        const Coords topLeft{0, 30};
+        const Coords bottomRight{WIDTH - 1, 70};
+
+        for (unsigned thickness = 1; thickness <= 15; thickness++)
+        {
+            auto bytemap = makeBytemap(random);
+
+            auto expected = bytemap;
+            StampingOutliner stamping(expected.data(), WIDTH, HEIGHT);
+            stamping.setRange(topLeft, bottomRight);
+            stamping.outline(thickness, COLOR_OUTLINE);
+
+            Outliner outliner(bytemap.data(), WIDTH, HEIGHT);
+            outliner.setRange(topLeft, bottomRight);
+            outliner.outline(thickness, COLOR_OUTLINE);
+
+            CPPUNIT_ASSERT(bytemap == expected);
+        }
+    }
+
+    void onlyTransparentAndFrameRepainted()
+    {
+        std::vector<std::uint8_t> bytemap(WIDTH * HEIGHT, COLOR_TRANSPARENT);
+        bytemap[50 * WIDTH + 50] = COLOR_CHARACTER;
+        bytemap[50 * WIDTH + 51] = COLOR_SHADOW;
+        bytemap[50 * WIDTH + 49] = COLOR_FRAME;
+
+        Outliner outliner(bytemap.data(), WIDTH, HEIGHT);
+        outliner.outline(2, COLOR_OUTLINE);
+
+        CPPUNIT_ASSERT_EQUAL(std::uint8_t(COLOR_CHARACTER), bytemap[50 * WIDTH + 50]);
+        CPPUNIT_ASSERT_EQUAL(std::uint8_t(COLOR_SHADOW), bytemap[50 * WIDTH + 51]);
+        CPPUNIT_ASSERT_EQUAL(std::uint8_t(COLOR_OUTLINE), bytemap[50 * WIDTH + 49]);
+        CPPUNIT_ASSERT_EQUAL(std::uint8_t(COLOR_OUTLINE), bytemap[52 * WIDTH + 50]);
+        CPPUNIT_ASSERT_EQUAL(std::uint8_t(COLOR_TRANSPARENT), bytemap[52 * WIDTH + 52]);
+    }
+
+    void edgePixelsStayInRow()
+    {
+        std::vector<std::uint8_t> bytemap(WIDTH * HEIGHT, COLOR_TRANSPARENT);
+        bytemap[50 * WIDTH] = COLOR_CHARACTER;
+        bytemap[60 * WIDTH + WIDTH - 1] = COLOR_CHARACTER;
+
+        Outliner outliner(bytemap.data(), WIDTH, HEIGHT);
+        outliner.outline(3, COLOR_OUTLINE);
+
+        for (uint32_t y = 0; y < HEIGHT; y++)
+        {
+            CPPUNIT_ASSERT(bytemap[y * WIDTH + WIDTH - 2] != COLOR_OUTLINE || (y >= 57 && y <= 63));
+            CPPUNIT_ASSERT(bytemap[y * WIDTH + 1] != COLOR_OUTLINE || (y >= 47 && y <= 53));
+        }
+    }
+
+    void zeroThickness()
+    {
+        std::mt19937 random(42);
+        auto bytemap = makeBytemap(random);
+        const auto expected = bytemap;
+
+        Outliner outliner(bytemap.data(), WIDTH, HEIGHT);
+        outliner.outline(0, COLOR_OUTLINE);
+
+        CPPUNIT_ASSERT(bytemap == expected);
+    }
+
+private:
+    static const uint32_t WIDTH = 160;
+    static const uint32_t HEIGHT = 100;
+
+    /*
+     * Character strokes and single pixels on a transparent / framed
+     * background with some shadow pixels. Characters keep MARGIN from the
+     * left and right edge, the stamping outliner wraps around them.
+     */
+    static std::vector<std::uint8_t> makeBytemap(std::mt19937& random)
+    {
+        const uint32_t MARGIN = 16;
+
+        std::vector<std::uint8_t> bytemap(WIDTH * HEIGHT, COLOR_TRANSPARENT);
+        std::uniform_int_distribution<uint32_t> xDist(MARGIN, WIDTH - MARGIN - 1);
+        std::uniform_int_distribution<uint32_t> yDist(0, HEIGHT - 1);
+        std::uniform_int_distribution<uint32_t> lengthDist(1, 12);
+
+        for (uint32_t y = 20; y < 40; y++)
+        {
+            for (uint32_t x = 0; x < WIDTH; x++)
+            {
+                bytemap[y * WIDTH + x] = COLOR_FRAME;
+            }
+        }
+        for (int i = 0; i < 30; i++)
+        {
+            bytemap[yDist(random) * WIDTH + xDist(random)] = COLOR_SHADOW;
+        }
+        for (int i = 0; i < 12; i++)
+        {
+            const uint32_t x = xDist(random);
+            const uint32_t y = yDist(random);
+            const uint32_t length = lengthDist(random);
+            const bool horizontal = (random() % 2) == 0;
+
+            for (uint32_t j = 0; j < length; j++)
+            {
+                const uint32_t px = horizontal ? std::min(x + j, WIDTH - MARGIN - 1) : x;
+                const uint32_t py = horizontal ? y : std::min(y + j, HEIGHT - 1);
+                bytemap[py * WIDTH + px] = COLOR_CHARACTER;
+            }
+        }
+        for (int i = 0; i < 10; i++)
+        {
+            bytemap[yDist(random) * WIDTH + xDist(random)] = COLOR_CHARACTER;
+        }
+        return bytemap;
+    }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION( ScteOutlinerTest );
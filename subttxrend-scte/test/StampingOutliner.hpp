@@ -0,0 +1,116 @@
+/*****************************************************************************
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:
+*
+* Copyright 2021 Liberty Global Service B.V.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*****************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <utility>
+
+#include "ScteSimpleBitmap.hpp"
+
+namespace subttxrend
+{
+namespace scte
+{
+
+/**
+ * Previous outliner implementation, kept as the reference for tests and
+ * benchmarks. Stamps a circle around every character pixel.
+ *
+ * The only change is that the circle is rebuilt on every outline() call
+ * (the original cached it for the first thickness seen).
+ */
+class StampingOutliner
+{
+public:
+    StampingOutliner(std::uint8_t *bytemap, uint32_t width, uint32_t height)
+        : m_bytemap(bytemap), m_width(width), m_height(height), m_range{0, height - 1}
+    {
+    }
+
+    void outline(unsigned outline_thickness, uint32_t value)
+    {
+        initCircle(outline_thickness);
+        for (unsigned by = m_range.first; by < m_range.second + 1; by++)
+        {
+            for (unsigned bx = 0; bx < m_width; bx++)
+            {
+                if (m_bytemap[by * m_width + bx] != 1)
+                {
+                    continue;
+                }
+                drawOutline(bx, by, outline_thickness, value);
+            }
+        }
+    }
+
+    void setRange(const Coords &tl, const Coords &br)
+    {
+        m_range = {tl.y, br.y};
+    }
+
+private:
+    void setPixel(unsigned x, unsigned y, uint32_t color)
+    {
+        auto pos = y * m_width + x;
+        if (pos < m_width * m_height && (m_bytemap[pos] == COLOR_TRANSPARENT || m_bytemap[pos] == COLOR_FRAME))
+        {
+            m_bytemap[pos] = static_cast<uint8_t>(color);
+        }
+    }
+
+    void initCircle(unsigned outline_thickness)
+    {
+        for (unsigned dy = 0; dy <= C_SIZE - 1; dy++)
+        {
+            for (unsigned dx = 0; dx <= C_SIZE -1; dx++)
+            {
+                m_circle[dy][dx] = (dx * dx + dy * dy <= outline_thickness * outline_thickness);
+            }
+        }
+    }
+
+    void drawOutline(unsigned bx, unsigned by, unsigned outline_thickness, uint32_t value)
+    {
+        for (unsigned dy = 0; dy <= outline_thickness; dy++)
+        {
+            for (unsigned dx = 0; dx <= outline_thickness; dx++)
+            {
+                if (m_circle[dy][dx])
+                {
+                    setPixel(bx + dx, by + dy, value);
+                    setPixel(bx - dx, by + dy, value);
+                    setPixel(bx + dx, by - dy, value);
+                    setPixel(bx - dx, by - dy, value);
+                }
+            }
+        }
+    }
+
+private:
+    std::uint8_t *m_bytemap;
+    const uint32_t m_width;
+    const uint32_t m_height;
+    std::pair<uint32_t, uint32_t> m_range;
+    static constexpr unsigned C_SIZE = 16;
+    bool m_circle[C_SIZE][C_SIZE];
+};
+
+} // namespace scte
+} // namespace subttxrend
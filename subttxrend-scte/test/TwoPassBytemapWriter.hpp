@@ -0,0 +1,116 @@
+/*****************************************************************************
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:
+*
+* Copyright 2021 Liberty Global Service B.V.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*****************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "ScteRawBitmap.hpp"
+#include "ScteSimpleBitmap.hpp"
+
+namespace subttxrend
+{
+namespace scte
+{
+
+/**
+ * Previous bytemap writer implementation, kept as the reference for tests.
+ * Draws the decompressed bitmap twice, first the drop shadow shifted by
+ * the shadow offset, then the characters.
+ */
+class TwoPassBytemapWriter
+{
+public:
+    TwoPassBytemapWriter(uint8_t* bytemap, size_t size, size_t width)
+        : bytemap(bytemap), size(size), width(width)
+    {
+    }
+
+    void write(const RawBitmap::Data& bitmap, Coords top, Coords bottom, uint8_t bgcolor,
+               bool shadow, uint8_t shR, uint8_t shB)
+    {
+        if (shadow)
+        {
+            Coords topLeft {static_cast<uint16_t>(top.x + shR), static_cast<uint16_t>(top.y + shB)};
+            Coords bottomRight {static_cast<uint16_t>(bottom.x + shR), static_cast<uint16_t>(bottom.y + shB)};
+            render(bitmap, topLeft, bottomRight, COLOR_SHADOW, bgcolor);
+        }
+        render(bitmap, top, bottom, COLOR_CHARACTER, bgcolor);
+    }
+
+private:
+    class Indexer
+    {
+    public:
+        Indexer(Coords ft, Coords fb, size_t width):
+            idx(ft.y * width + ft.x), line_begin(ft.y * width + ft.x), line_end(ft.y * width + fb.x), width(width)
+        {
+        }
+
+        operator size_t () const
+        {
+            return idx;
+        }
+
+        void operator++()
+        {
+            idx++;
+            if (idx >= line_end)
+            {
+                line_begin += width;
+                line_end += width;
+                idx = line_begin;
+            }
+        }
+    private:
+        size_t idx;
+        size_t line_begin;
+        size_t line_end;
+        size_t width;
+    };
+
+    void render(const RawBitmap::Data& bitmap, Coords topLeft, Coords bottomRight, uint8_t onColor, uint8_t offColor)
+    {
+        Indexer idx(topLeft, bottomRight, width);
+        if (idx >= size)
+        {
+            return;
+        }
+        for (auto& byte: bitmap)
+        {
+            if (byte)
+                bytemap[idx] = onColor;
+            else if (bytemap[idx] == COLOR_TRANSPARENT)
+                bytemap[idx] = offColor;
+            ++idx;
+            if (idx >= size)
+            {
+                break;
+            }
+        }
+    }
+
+    uint8_t* const bytemap;
+    const size_t size;
+    const size_t width;
+};
+
+} // namespace scte
+} // namespace subttxrend
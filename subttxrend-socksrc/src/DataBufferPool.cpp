@@ -0,0 +1,74 @@
+/*****************************************************************************
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:
+*
+* Copyright 2021 Liberty Global Service B.V.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*****************************************************************************/
+
+#include "DataBufferPool.hpp"
+
+namespace subttxrend {
+namespace socksrc {
+
+DataBufferPool::DataBufferPool(std::size_t bufferSize, std::size_t maxFreeBuffers) :
+        m_bufferSize(bufferSize),
+        m_maxFreeBuffers(maxFreeBuffers)
+{
+    m_freeBuffers.reserve(m_maxFreeBuffers);
+}
+
+common::DataBufferPtr DataBufferPool::acquire()
+{
+    std::unique_ptr<common::DataBuffer> buffer;
+    {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        if (!m_freeBuffers.empty()) {
+            buffer = std::move(m_freeBuffers.back());
+            m_freeBuffers.pop_back();
+        }
+    }
+
+    if (buffer) {
+        buffer->resize(m_bufferSize);
+    } else {
+        buffer = std::make_unique<common::DataBuffer>(m_bufferSize);
+    }
+
+    return common::DataBufferPtr(buffer.release(), common::DataBufferDeleter(shared_from_this()));
+}
+
+void DataBufferPool::recycle(common::DataBuffer* buffer)
+{
+    std::unique_ptr<common::DataBuffer> releasedBuffer(buffer);
+
+    if (releasedBuffer->capacity() > m_bufferSize) {
+        // grown outside of the pool, do not keep the extra memory
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock{m_mutex};
+    if (m_freeBuffers.size() < m_maxFreeBuffers) {
+        m_freeBuffers.push_back(std::move(releasedBuffer));
+    }
+}
+
+std::size_t DataBufferPool::getFreeBuffersCount() const
+{
+    std::lock_guard<std::mutex> lock{m_mutex};
+    return m_freeBuffers.size();
+}
+
+} // namespace socksrc
+} // namespace subttxrend
@@ -0,0 +1,92 @@
+/*****************************************************************************
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:
+*
+* Copyright 2021 Liberty Global Service B.V.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*****************************************************************************/
+
+#pragma once
+
+#include <subttxrend/common/DataBuffer.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace subttxrend {
+namespace socksrc {
+
+/**
+ * Pool of fixed size data buffers.
+ *
+ * Buffers handed out by the pool come back to it automatically when the
+ * owning DataBufferPtr is destroyed (e.g. when parsed packet releases its
+ * data), so receiving packets does not allocate memory in steady state.
+ * Buffers may be released from any thread.
+ *
+ * The pool must be owned by std::shared_ptr, buffers keep it alive.
+ */
+class DataBufferPool : public common::DataBufferRecycler,
+                       public std::enable_shared_from_this<DataBufferPool>
+{
+public:
+    /**
+     * Constructor.
+     *
+     * @param bufferSize
+     *      Size of buffers returned by acquire().
+     * @param maxFreeBuffers
+     *      Maximum number of released buffers kept for reuse.
+     */
+    DataBufferPool(std::size_t bufferSize, std::size_t maxFreeBuffers);
+
+    /**
+     * Returns buffer resized to the pool buffer size.
+     *
+     * Buffer contents are not initialized.
+     *
+     * @return
+     *      Buffer that returns to the pool when released.
+     */
+    common::DataBufferPtr acquire();
+
+    /** @copydoc common::DataBufferRecycler::recycle */
+    void recycle(common::DataBuffer* buffer) override;
+
+    /**
+     * Returns number of buffers available for reuse.
+     *
+     * @return
+     *      Number of free buffers.
+     */
+    std::size_t getFreeBuffersCount() const;
+
+private:
+    /** Size of buffers returned by acquire(). */
+    const std::size_t m_bufferSize;
+
+    /** Maximum number of free buffers kept. */
+    const std::size_t m_maxFreeBuffers;
+
+    /** Mutex protecting free buffers. */
+    mutable std::mutex m_mutex;
+
+    /** Buffers available for reuse. */
+    std::vector<std::unique_ptr<common::DataBuffer>> m_freeBuffers;
+};
+
+} // namespace socksrc
+} // namespace subttxrend
@@ -25,6 +25,7 @@
 #include <grp.h>
 #include <sys/socket.h>
 #include <sys/stat.h>
+#include <sys/uio.h>
 #include <sys/un.h>
 
 #include <sys/ioctl.h>
@@ -84,34 +85,36 @@ std::size_t UnixSocket::getSocketBufferSize() const
     return static_cast<std::size_t >(bufferSize);
 }
 
-std::size_t UnixSocket::peekBytes(common::DataBuffer& buffer)
-{
-    return read(buffer, true);
-}
-
-std::size_t UnixSocket::readBytes(common::DataBuffer& buffer)
-{
-    return read(buffer, false);
-}
-
 void UnixSocket::shutdown()
 {
     ::shutdown(*m_socketHandlePtr, SHUT_RDWR);
 }
 
-std::size_t UnixSocket::read(common::DataBuffer& buffer, bool peekOnly)
+std::size_t UnixSocket::receive(common::DataBuffer& buffer, common::DataBuffer& overflowBuffer)
 {
-    std::size_t result{};
-    int flags = (peekOnly ? MSG_PEEK : 0);
-    auto bytesRead = ::recv(*m_socketHandlePtr, buffer.data(), buffer.capacity(), flags);
-    if (bytesRead >= 0) {
-        buffer.resize(bytesRead);
-        result = static_cast<std::size_t>(bytesRead);
-    }
-    else {
+    struct iovec iov[2];
+    iov[0].iov_base = buffer.data();
+    iov[0].iov_len = buffer.size();
+    iov[1].iov_base = overflowBuffer.data();
+    iov[1].iov_len = overflowBuffer.size();
+
+    struct msghdr msg{};
+    msg.msg_iov = iov;
+    msg.msg_iovlen = 2;
+
+    // MSG_TRUNC - return real datagram size even if it does not fit
+    auto bytesRead = ::recvmsg(*m_socketHandlePtr, &msg, MSG_TRUNC);
+    if (bytesRead < 0) {
         auto errorMsg = strerror(errno);
         throw SocketException(std::string("Error reading socket: ") + errorMsg);
     }
+
+    auto result = static_cast<std::size_t>(bytesRead);
+    auto const capacity = buffer.size() + overflowBuffer.size();
+    if ((msg.msg_flags & MSG_TRUNC) && (result <= capacity)) {
+        // kernel did not report the real size
+        result = capacity + 1;
+    }
     return result;
 }
 
@@ -60,20 +60,22 @@ public:
     std::size_t getSocketBufferSize() const;
 
     /**
-     * Blocking call waiting for socket data.
+     * Blocking call receiving single datagram.
      *
-     * @return
-     *      Number of bytes read into the buffer.
-     */
-    std::size_t peekBytes(common::DataBuffer& buffer);
-
-    /**
-     * Read bytes from socket.
+     * Datagram data is stored in the buffer and the part that does not fit
+     * continues in the overflow buffer. Sizes of both buffers are used as
+     * their capacities and are not modified.
+     *
+     * @param buffer
+     *      Buffer for datagram data.
+     * @param overflowBuffer
+     *      Buffer for datagram data not fitting into the buffer.
      *
      * @return
-     *      Number of bytes read into the buffer.
+     *      Size of the datagram. It is larger than total size of buffers
+     *      if the datagram was truncated. Zero when socket is shut down.
      */
-    std::size_t readBytes(common::DataBuffer& buffer);
+    std::size_t receive(common::DataBuffer& buffer, common::DataBuffer& overflowBuffer);
 
     /**
      * Signals socket to shutdown - it will cause pending listener to return.
@@ -82,8 +84,6 @@ public:
 
 private:
 
-    std::size_t read(common::DataBuffer& buffer, bool peekOnly);
-
     struct Handle
     {
         Handle(int _h) : handle(_h)
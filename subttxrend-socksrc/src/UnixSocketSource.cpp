@@ -23,6 +23,7 @@
 
 #include <subttxrend/protocol/Packet.hpp>
 
+#include <algorithm>
 #include <cstring>
 
 namespace subttxrend
@@ -30,10 +31,30 @@ namespace subttxrend
 namespace socksrc
 {
 
+namespace
+{
+
+/** Size of pooled receive buffers, large enough for typical CC and PES packets. */
+auto constexpr POOL_BUFFER_SIZE = 8 * 1024;
+
+/** Number of released receive buffers kept for reuse. */
+auto constexpr POOL_MAX_FREE_BUFFERS = 32;
+
+/**
+ * Size of buffer for data not fitting into pooled buffer.
+ *
+ * Matches the largest send buffer used by clients. The buffer is not
+ * initialized so memory is only committed when large packets arrive.
+ */
+auto constexpr OVERFLOW_BUFFER_SIZE = 8 * 1024 * 1024;
+
+} // namespace <anonymous>
+
 common::Logger UnixSocketSource::m_logger("SockSrc", "UnixSocketSource");
 
 UnixSocketSource::UnixSocketSource(std::string const& socketPath) :
-        m_socketPath(socketPath)
+        m_socketPath(socketPath),
+        m_bufferPool(std::make_shared<DataBufferPool>(POOL_BUFFER_SIZE, POOL_MAX_FREE_BUFFERS))
 {
     // noop
 }
@@ -109,7 +130,9 @@ void UnixSocketSource::sourceLoop()
     using protocol::Packet;
 
     auto const headerSize = Packet::getHeaderSize();
-    common::DataBuffer headerBuffer(headerSize);
+
+    // receives the part of (rare) large packets not fitting into pool buffer
+    common::DataBuffer overflowBuffer(OVERFLOW_BUFFER_SIZE);
 
     createSocket();
     while(m_sourceRunning.load(std::memory_order_relaxed)) {
@@ -122,15 +145,32 @@ void UnixSocketSource::sourceLoop()
         auto socketRestartNeeded = false;
 
         try {
-            auto const bytesPeeked = m_socket->peekBytes(headerBuffer);
-            if (bytesPeeked == headerSize) {
-                auto const packetSize = headerSize + Packet::getSizeFromHeader(headerBuffer);
-                auto buffer = std::make_unique<common::DataBuffer>(packetSize);
-                m_socket->readBytes(*buffer);
+            auto buffer = m_bufferPool->acquire();
+            auto const datagramSize = m_socket->receive(*buffer, overflowBuffer);
+            auto const bufferSize = buffer->size();
+
+            if (datagramSize > bufferSize + overflowBuffer.size()) {
+                m_logger.oserror(__LOGGER_FUNC__, " packet truncated, size: ", datagramSize,
+                        " capacity: ", bufferSize + overflowBuffer.size());
+                // packet is lost, stream validator will detect the gap
+                overflowBuffer.resize(std::max(datagramSize, 2 * overflowBuffer.size()));
+            }
+            else if (datagramSize >= headerSize) {
+                auto const packetSize = std::min<std::size_t>(datagramSize,
+                        headerSize + Packet::getSizeFromHeader(*buffer));
+                if (packetSize <= bufferSize) {
+                    buffer->resize(packetSize);
+                }
+                else {
+                    auto largeBuffer = std::make_unique<common::DataBuffer>(packetSize);
+                    auto const largeBufferEnd = std::copy(buffer->begin(), buffer->end(), largeBuffer->begin());
+                    std::copy_n(overflowBuffer.begin(), packetSize - bufferSize, largeBufferEnd);
+                    buffer = std::move(largeBuffer);
+                }
                 processPacket(std::move(buffer));
             }
-            else if (bytesPeeked != 0) {
-                m_logger.oserror(__LOGGER_FUNC__, " not enough header bytes read: ", bytesPeeked, " of ", headerSize);
+            else if (datagramSize != 0) {
+                m_logger.oserror(__LOGGER_FUNC__, " not enough header bytes read: ", datagramSize, " of ", headerSize);
                 socketRestartNeeded = true;
             }
         }
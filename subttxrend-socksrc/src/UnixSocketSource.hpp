@@ -22,6 +22,7 @@
 #include "Source.hpp"
 #include "PacketReceiver.hpp"
 #include "UnixSocket.hpp"
+#include "DataBufferPool.hpp"
 
 #include <subttxrend/common/Logger.hpp>
 #include <subttxrend/common/DataBuffer.hpp>
@@ -88,6 +89,9 @@ private:
     /** Packet stream validator. */
     protocol::StreamValidator m_validator;
 
+    /** Pool of receive buffers. */
+    std::shared_ptr<DataBufferPool> m_bufferPool;
+
     /** Object to be called when packet is received. */
     PacketReceiver* m_receiver{};
 
@@ -23,6 +23,7 @@
 
 #include <cstdint>
 #include <chrono>
+#include <memory>
 #include <string>
 
 #include <subttxrend/common/ConfigProvider.hpp>
@@ -31,6 +32,11 @@
 
 namespace subttxrend
 {
+namespace gfx
+{
+class PrerenderedFontCache;
+}
+
 namespace ttmlengine
 {
 
@@ -55,10 +61,15 @@ public:
      *      Configuration.
      * @param gfxWindow
      *      Window to draw.
+     * @param properties
+     *      Application properties.
+     * @param fontCache
+     *      Font cache to use (shared with other engines).
      */
     virtual void init(const common::ConfigProvider* configProvider,
                       gfx::Window* gfxWindow,
-                      common::Properties const& properties) = 0;
+                      common::Properties const& properties,
+                      std::shared_ptr<gfx::PrerenderedFontCache> fontCache) = 0;
 
     /**
      * Notifies size of related video content. Used for position and size calculations.
@@ -0,0 +1,136 @@
+/*****************************************************************************
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:
+*
+* Copyright 2021 Liberty Global Service B.V.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*****************************************************************************/
+
+#include "ImageCache.hpp"
+
+namespace subttxrend
+{
+namespace ttmlengine
+{
+
+const std::size_t ImageCache::DEFAULT_BYTE_BUDGET;
+
+ImageCache::ImageCache(std::size_t byteBudget)
+        : m_byteBudget(byteBudget)
+{
+    // noop
+}
+
+void ImageCache::setByteBudget(std::size_t byteBudget)
+{
+    m_byteBudget = byteBudget;
+    evict(m_byteBudget);
+}
+
+std::shared_ptr<gfx::Bitmap> ImageCache::find(const std::string& id,
+                                              std::size_t dataHash)
+{
+    auto iter = findEntry(id, dataHash);
+    if (iter == m_lookup.end())
+    {
+        ++m_statistics.m_misses;
+        return nullptr;
+    }
+
+    ++m_statistics.m_hits;
+
+    // move to front (most recently used)
+    m_entries.splice(m_entries.begin(), m_entries, iter->second);
+
+    return iter->second->m_bitmap;
+}
+
+void ImageCache::insert(const std::string& id,
+                        std::size_t dataHash,
+                        std::shared_ptr<gfx::Bitmap> bitmap)
+{
+    if (!bitmap)
+    {
+        return;
+    }
+
+    const std::size_t size = bitmap->m_buffer.size() + sizeof(gfx::Bitmap) + id.size();
+    if (size > m_byteBudget)
+    {
+        return;
+    }
+
+    auto iter = findEntry(id, dataHash);
+    if (iter != m_lookup.end())
+    {
+        m_statistics.m_usedBytes -= iter->second->m_size;
+        m_entries.erase(iter->second);
+        m_lookup.erase(iter);
+    }
+
+    evict(m_byteBudget - size);
+
+    m_entries.push_front(Entry{id, dataHash, std::move(bitmap), size});
+    m_lookup.emplace(dataHash, m_entries.begin());
+
+    m_statistics.m_usedBytes += size;
+    m_statistics.m_entries = m_entries.size();
+}
+
+void ImageCache::clear()
+{
+    m_lookup.clear();
+    m_entries.clear();
+
+    m_statistics.m_usedBytes = 0;
+    m_statistics.m_entries = 0;
+}
+
+ImageCache::Statistics ImageCache::getStatistics() const
+{
+    return m_statistics;
+}
+
+ImageCache::Lookup::iterator ImageCache::findEntry(const std::string& id,
+                                                  std::size_t dataHash)
+{
+    auto range = m_lookup.equal_range(dataHash);
+    for (auto iter = range.first; iter != range.second; ++iter)
+    {
+        if (iter->second->m_id == id)
+        {
+            return iter;
+        }
+    }
+    return m_lookup.end();
+}
+
+void ImageCache::evict(std::size_t byteBudget)
+{
+    while (!m_entries.empty() && (m_statistics.m_usedBytes > byteBudget))
+    {
+        auto& last = m_entries.back();
+
+        m_statistics.m_usedBytes -= last.m_size;
+        ++m_statistics.m_evictions;
+
+        m_lookup.erase(findEntry(last.m_id, last.m_dataHash));
+        m_entries.pop_back();
+    }
+
+    m_statistics.m_entries = m_entries.size();
+}
+
+} // namespace ttmlengine
+} // namespace subttxrend
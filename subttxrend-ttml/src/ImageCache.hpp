@@ -0,0 +1,191 @@
+/*****************************************************************************
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:
+*
+* Copyright 2021 Liberty Global Service B.V.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*****************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include <subttxrend/gfx/Types.hpp>
+
+namespace subttxrend
+{
+namespace ttmlengine
+{
+
+/**
+ * Cache of decoded TTML images.
+ *
+ * Decoding png of image subtitles is expensive and the same image is
+ * rendered again on every redraw. Decoded bitmaps are kept in least
+ * recently used order and evicted when the byte budget is exceeded.
+ * Images are identified by element id and a hash of the png data, so
+ * an id reused with different contents does not produce stale hits. The
+ * hash is computed once when the image is parsed, the cache never reads
+ * the png data.
+ *
+ * The cache is not synchronized, it is expected to be used from the
+ * rendering thread only.
+ */
+class ImageCache
+{
+public:
+    /** Cache statistics. */
+    struct Statistics
+    {
+        /** Number of lookups that found decoded image. */
+        std::size_t m_hits{};
+
+        /** Number of lookups that did not find decoded image. */
+        std::size_t m_misses{};
+
+        /** Number of images removed to fit byte budget. */
+        std::size_t m_evictions{};
+
+        /** Number of images in the cache. */
+        std::size_t m_entries{};
+
+        /** Number of bytes used by cached images. */
+        std::size_t m_usedBytes{};
+    };
+
+    /** Default byte budget. */
+    static const std::size_t DEFAULT_BYTE_BUDGET = 16 * 1024 * 1024;
+
+    /**
+     * Constructor.
+     *
+     * @param byteBudget
+     *      Maximum number of bytes of cached bitmaps.
+     */
+    explicit ImageCache(std::size_t byteBudget = DEFAULT_BYTE_BUDGET);
+
+    /**
+     * Sets byte budget.
+     *
+     * Images are evicted if needed. Zero disables caching.
+     *
+     * @param byteBudget
+     *      Maximum number of bytes of cached bitmaps.
+     */
+    void setByteBudget(std::size_t byteBudget);
+
+    /**
+     * Looks up decoded image.
+     *
+     * @param id
+     *      Image element id.
+     * @param dataHash
+     *      Hash of the image data (png).
+     *
+     * @return
+     *      Decoded bitmap if found, null pointer otherwise.
+     */
+    std::shared_ptr<gfx::Bitmap> find(const std::string& id,
+                                      std::size_t dataHash);
+
+    /**
+     * Stores decoded image.
+     *
+     * Bitmaps larger than the whole budget are not stored.
+     *
+     * @param id
+     *      Image element id.
+     * @param dataHash
+     *      Hash of the image data (png).
+     * @param bitmap
+     *      Decoded bitmap.
+     */
+    void insert(const std::string& id,
+                std::size_t dataHash,
+                std::shared_ptr<gfx::Bitmap> bitmap);
+
+    /**
+     * Removes all images.
+     *
+     * Statistics counters are not reset.
+     */
+    void clear();
+
+    /**
+     * Returns statistics.
+     *
+     * @return
+     *      Current statistics.
+     */
+    Statistics getStatistics() const;
+
+private:
+    /** Cache entry. */
+    struct Entry
+    {
+        /** Image element id. */
+        std::string m_id;
+
+        /** Hash of the image data. */
+        std::size_t m_dataHash;
+
+        /** Decoded bitmap. */
+        std::shared_ptr<gfx::Bitmap> m_bitmap;
+
+        /** Number of bytes accounted for the entry. */
+        std::size_t m_size;
+    };
+
+    /** Entries list type (most recently used first). */
+    using EntryList = std::list<Entry>;
+
+    /** Entries lookup type, keyed directly by the data hash. */
+    using Lookup = std::unordered_multimap<std::size_t, EntryList::iterator>;
+
+    /**
+     * Finds lookup item of given image.
+     *
+     * @return
+     *      Lookup item, end if not found.
+     */
+    Lookup::iterator findEntry(const std::string& id,
+                               std::size_t dataHash);
+
+    /**
+     * Evicts least recently used entries until budget is satisfied.
+     *
+     * @param byteBudget
+     *      Number of bytes that may be used.
+     */
+    void evict(std::size_t byteBudget);
+
+    /** Maximum number of bytes used. */
+    std::size_t m_byteBudget;
+
+    /** Entries in LRU order. */
+    EntryList m_entries;
+
+    /** Entries lookup. */
+    Lookup m_lookup;
+
+    /** Statistics. */
+    Statistics m_statistics;
+};
+
+} // namespace ttmlengine
+} // namespace subttxrend
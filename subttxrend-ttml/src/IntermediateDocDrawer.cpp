@@ -44,10 +44,11 @@ constexpr auto FALLBACK_FONT_NAME = "Bitstream Vera Sans Mono Bold";
 }//anonymous namespace
 
 IntermediateDocDrawer::IntermediateDocDrawer(const common::ConfigProvider *configProvider,
-                                             const ValueConverter &valueConverter)
+                                             const ValueConverter &valueConverter,
+                                             std::shared_ptr<gfx::PrerenderedFontCache> fontCache)
         :
         m_logger("TtmlEngine", "IntermediateDocDrawer", this),
-        m_fontCache(),
+        m_fontCache(std::move(fontCache)),
         m_valueConverter(valueConverter)
 {
     if (configProvider) {
@@ -132,7 +133,7 @@ void IntermediateDocDrawer::drawEntity(const IntermediateDocument::Entity& entit
             {
                 if (!textLine.empty())
                 {
-                    auto const& style = textLine.front().m_style;
+                    auto const& style = *textLine.front().m_style;
                     auto const cellHeightPx = m_valueConverter.getCellHeight();
                     auto const fontSize = m_valueConverter.sizeToPixels(style.getFontSize(), cellHeightPx);
                     auto const lineHeight = m_valueConverter.sizeToPixels(style.getLineHeight(), fontSize);
@@ -144,7 +145,7 @@ void IntermediateDocDrawer::drawEntity(const IntermediateDocument::Entity& entit
             auto const& firstLine = entity.m_textLines.front();
             auto const& lastLine = entity.m_textLines.back();
 
-            auto const displayAlign = (!firstLine.empty()) ? firstLine.front().m_style.getDisplayAlign() : StyleSet::DisplayAlign::BEFORE;
+            auto const displayAlign = (!firstLine.empty()) ? firstLine.front().m_style->getDisplayAlign() : StyleSet::DisplayAlign::BEFORE;
 
             std::int32_t margin = 0;
             if (displayAlign == StyleSet::DisplayAlign::BEFORE) {
@@ -176,7 +177,7 @@ bool IntermediateDocDrawer::drawLine(const IntermediateDocument::TextLine& textL
     {
         //Font is based on the style of the first text chunk of the line
         // all subsequent text chunks use the same font
-        const StyleSet& style = textLine[0].m_style;
+        const StyleSet& style = *textLine[0].m_style;
         const auto cellHeightPx = m_valueConverter.getCellHeight();
         drawingState.m_fontSize = m_valueConverter.sizeToPixels(style.getFontSize(), cellHeightPx);
         drawingState.m_font = getFont(style.getFontFamily(), drawingState.m_fontSize);
@@ -267,7 +268,7 @@ std::shared_ptr<gfx::PrerenderedFont> IntermediateDocDrawer::getFont(std::string
     auto const fontFamily = m_forcedFont.empty() ? requestedfontFamily : m_forcedFont;
     try
     {
-        font = m_fontCache.getFont(fontFamily, fontSize, true);
+        font = m_fontCache->getFont(fontFamily, fontSize, true);
     }
     catch (...)
     {
@@ -275,7 +276,7 @@ std::shared_ptr<gfx::PrerenderedFont> IntermediateDocDrawer::getFont(std::string
         {
             m_logger.oswarning(
                     __LOGGER_FUNC__, " loading requested font \'", fontFamily, "\' failed, trying fallback font");
-            font = m_fontCache.getFont(FALLBACK_FONT_NAME, fontSize);
+            font = m_fontCache->getFont(FALLBACK_FONT_NAME, fontSize);
         }
         catch (...)
         {
@@ -402,7 +403,7 @@ bool IntermediateDocDrawer::drawChunk(const IntermediateDocument::TextChunk& chu
         }
         else
         {
-            const StyleSet& style = chunk.m_style;
+            const StyleSet& style = *chunk.m_style;
             const gfx::ColorArgb& fgColor = style.getColor();
 
             const gfx::Rectangle rectangle = {
@@ -447,7 +448,8 @@ bool IntermediateDocDrawer::drawChunk(const IntermediateDocument::TextChunk& chu
 
 void IntermediateDocDrawer::clearState()
 {
-    m_fontCache.clear();
+    // noop - fonts stay in the shared cache, so they are ready for the next
+    // document (or selection); the cache owner is responsible for its size
 }
 
 std::int32_t IntermediateDocDrawer::getMargin(IntermediateDocument::TextLine const& line)
@@ -455,9 +457,9 @@ std::int32_t IntermediateDocDrawer::getMargin(IntermediateDocument::TextLine con
     int32_t margin = 0;
 
     if (!line.empty()) {
-        auto const outlineSize = line.front().m_style.getOutline().getThickness();
+        auto const outlineSize = line.front().m_style->getOutline().getThickness();
         auto const cellHeightPx = m_valueConverter.getCellHeight();
-        auto const fontSize = m_valueConverter.sizeToPixels(line.front().m_style.getFontSize(), cellHeightPx);
+        auto const fontSize = m_valueConverter.sizeToPixels(line.front().m_style->getFontSize(), cellHeightPx);
         margin = m_valueConverter.sizeToPixels(outlineSize, fontSize);
     }
 
@@ -51,7 +51,8 @@ class IntermediateDocDrawer
 public:
 
     IntermediateDocDrawer(const common::ConfigProvider *configProvider,
-                          const ValueConverter &valueConverter);
+                          const ValueConverter &valueConverter,
+                          std::shared_ptr<gfx::PrerenderedFontCache> fontCache);
 
     /**
      * Draws document on window.
@@ -189,8 +190,8 @@ private:
     /** Logger object. */
     subttxrend::common::Logger m_logger;
 
-    /** Cached font. */
-    gfx::PrerenderedFontCache m_fontCache;
+    /** Font cache (shared, fonts are kept between documents and selections). */
+    std::shared_ptr<gfx::PrerenderedFontCache> m_fontCache;
 
     /** Value converter. */
     const ValueConverter& m_valueConverter;
@@ -19,10 +19,22 @@
 
 #include "DocumentInstance.hpp"
 
+#include <algorithm>
+#include <set>
+
 namespace subttxrend
 {
 namespace ttmlengine
 {
+
+namespace
+{
+
+/** Maximum number of distinct styles kept in the pool between documents. */
+constexpr std::size_t MAX_POOLED_STYLES = 256;
+
+} // namespace anonymous
+
 DocumentInstance::DocumentInstance() :
         m_styles(),
         m_regions(),
@@ -159,6 +171,10 @@ void DocumentInstance::endElement(bool copyTopElement)
         m_content.push_back(copyElement);
     }
 
+    if (m_currentImageElement)
+    {
+        m_currentImageElement->finalize();
+    }
     m_currentImageElement = std::shared_ptr<ImageElement>();
 }
 
@@ -254,88 +270,87 @@ std::list<IntermediateDocument> DocumentInstance::generateTimeline() const
 
     if (m_root)
     {
+        // styles stay shared with the documents generated before, unless there are too many
+        if (m_stylePool.size() > MAX_POOLED_STYLES)
+        {
+            m_stylePool.clear();
+        }
+
         auto timings = generateTimings();
-        updateStyleAttributes();
-        updateRegionAttributes();
 
-        for (auto &timing : timings)
+        const auto styles = indexById(m_styles);
+        const auto regions = indexById(m_regions);
+        updateStyleAttributes(styles, regions);
+        updateRegionAttributes(styles);
+
+        const auto contents = resolveContent(regions, indexById(m_images));
+
+        // content becomes active in the first timing it overlaps and inactive after the last one
+        struct Event
         {
-            m_logger.ostrace(__LOGGER_FUNC__, ' ', timing.toStr());
+            std::size_t timingIndex;
+            std::size_t contentIndex;
+            bool begin;
+        };
+        std::vector<Event> events;
 
-            std::vector<IntermediateDocument::Entity> entities;
+        for (std::size_t contentIndex = 0; contentIndex < contents.size(); ++contentIndex)
+        {
+            const auto contentTiming = contents[contentIndex].m_content->getTiming();
+            const auto& begin = contentTiming.getStartTimeRef();
+            const auto& end = contentTiming.getEndTimeRef();
 
-            for (auto &content : m_content)
+            if (begin < end)
             {
-                assert(content.get() != nullptr);
+                auto first = std::upper_bound(timings.begin(), timings.end(), begin,
+                                              [](const TimePoint& time, const Timing& timing)
+                                              {   return time < timing.getEndTimeRef();});
+                auto last = std::lower_bound(first, timings.end(), end,
+                                             [](const Timing& timing, const TimePoint& time)
+                                             {   return timing.getStartTimeRef() < time;});
+                if (first != last)
+                {
+                    events.push_back(Event{static_cast<std::size_t>(first - timings.begin()), contentIndex, true});
+                    events.push_back(Event{static_cast<std::size_t>(last - timings.begin()), contentIndex, false});
+                }
+            }
+        }
+
+        std::sort(events.begin(), events.end(),
+                  [](const Event& lhs, const Event& rhs)
+                  {   return lhs.timingIndex < rhs.timingIndex;});
 
-                if (content->getTiming().isOverlapping(timing))
+        // active content ordered as in the document
+        std::set<std::size_t> active;
+        auto event = events.begin();
+
+        for (std::size_t timingIndex = 0; timingIndex < timings.size(); ++timingIndex)
+        {
+            const auto& timing = timings[timingIndex];
+            if (m_logger.isEnabled(subttxrend::common::LoggerLevel::TRACE))
+            {
+                m_logger.ostrace(__LOGGER_FUNC__, ' ', timing.toStr());
+            }
+
+            for (; (event != events.end()) && (event->timingIndex == timingIndex); ++event)
+            {
+                if (event->begin)
                 {
-                    if (entities.empty())
-                    {
-                        //Add new Entity on timing change
-                        newEntity(entities, "document start");
-                    }
-                    auto region = findRegion(content->getRegionId());
-                    if (region != nullptr)
-                    {
-                        //Create a new entity if the current one is not empty and is not in the same
-                        //region.
-                        //Otherwise just update the region
-                        if ((!entities.back().empty()) &&
-                            ((entities.back().m_region == nullptr) ||
-                            (entities.back().m_region->getId() != content->getRegionId())))
-                        {
-                            newEntity(entities, "region");
-                        }
-                        entities.back().m_region = std::move(region);
-                    }
-
-                    auto image = findImage(content->getBackgroundImageId());
-                    if (image != nullptr)
-                    {
-                        //image based subtitles - IntermediateDocument should hold single image
-                        entities.back().m_imageChunk.m_image = std::move(image);
-                        if (entities.size() > 1)
-                        {
-                            m_logger.oswarning("Subtitles with multiple images or mixed image and text not supported");
-                        }
-                    }
-                    else
-                    {
-                        //text based subtitles - IntermediateDocument::Entity represents single region to render
-                        // it may consists of more than one BodyElement-s
-                        const auto& contextLines = content->getTextLines();
-
-                        for (const auto& textLine : contextLines)
-                        {
-                            if (!textLine.text.empty())
-                            {
-                                if (entities.back().m_textLines.empty())
-                                {
-                                    newLine(entities.back());
-                                }
-
-                                auto& currentLine = entities.back().m_textLines.back();
-                                currentLine.emplace_back();
-                                auto& textChunk = currentLine.back();
-                                textChunk.m_text = textLine.text;
-                                textChunk.m_whitespaceHandling = content->getWhiteSpaceHandling();
-
-                                auto styleId = content->getStyleId();
-                                textChunk.m_style.setStyleId(styleId);
-                                textChunk.m_style.merge(content->getStyleAttributes());
-
-                                m_logger.ostrace(__LOGGER_FUNC__, " chunk: \'", textChunk.m_text, "\'", ", style: ", textChunk.m_style.toStr());
-                            }
-                            //If TTML contained new line mark - add new line to render
-                            if (textLine.isForcedLine == true && !entities.back().empty())
-                            {
-                                newLine(entities.back());
-                            }
-                        }
-                    }
+                    active.insert(event->contentIndex);
                 }
+                else
+                {
+                    active.erase(event->contentIndex);
+                }
+            }
+
+            std::vector<IntermediateDocument::Entity> entities;
+
+            for (auto contentIndex : active)
+            {
+                addContent(entities, contents[contentIndex]);
             }
+
             if (!entities.empty())
             {
                 if (!entities.back().m_textLines.empty())
@@ -361,8 +376,104 @@ std::list<IntermediateDocument> DocumentInstance::generateTimeline() const
     return timeline;
 }
 
+std::vector<DocumentInstance::ResolvedContent> DocumentInstance::resolveContent(const IdMap<RegionElement>& regions,
+                                                                                const IdMap<ImageElement>& images) const
+{
+    std::vector<ResolvedContent> contents;
+    contents.reserve(m_content.size());
+
+    for (auto& content : m_content)
+    {
+        assert(content.get() != nullptr);
+
+        ResolvedContent resolved;
+        resolved.m_content = content;
+        resolved.m_region = find(content->getRegionId(), regions);
+        resolved.m_image = find(content->getBackgroundImageId(), images);
+        if ((resolved.m_image == nullptr) && !content->getTextLines().empty())
+        {
+            resolved.m_style = m_stylePool.get(content->getStyleId(), content->getStyleAttributes());
+        }
+        contents.push_back(std::move(resolved));
+    }
+
+    return contents;
+}
+
+void DocumentInstance::addContent(std::vector<IntermediateDocument::Entity>& entities,
+                                  const ResolvedContent& content) const
+{
+    if (entities.empty())
+    {
+        //Add new Entity on timing change
+        newEntity(entities, "document start");
+    }
+    if (content.m_region != nullptr)
+    {
+        //Create a new entity if the current one is not empty and is not in the same
+        //region.
+        //Otherwise just update the region
+        if ((!entities.back().empty()) &&
+            ((entities.back().m_region == nullptr) ||
+            (entities.back().m_region->getId() != content.m_region->getId())))
+        {
+            newEntity(entities, "region");
+        }
+        entities.back().m_region = content.m_region;
+    }
+
+    if (content.m_image != nullptr)
+    {
+        //image based subtitles - IntermediateDocument should hold single image
+        entities.back().m_imageChunk.m_image = content.m_image;
+        if (entities.size() > 1)
+        {
+            m_logger.oswarning("Subtitles with multiple images or mixed image and text not supported");
+        }
+    }
+    else
+    {
+        //text based subtitles - IntermediateDocument::Entity represents single region to render
+        // it may consists of more than one BodyElement-s
+        const auto& contextLines = content.m_content->getTextLines();
+
+        for (const auto& textLine : contextLines)
+        {
+            if (!textLine.text.empty())
+            {
+                if (entities.back().m_textLines.empty())
+                {
+                    newLine(entities.back());
+                }
+
+                auto& currentLine = entities.back().m_textLines.back();
+                currentLine.emplace_back();
+                auto& textChunk = currentLine.back();
+                textChunk.m_text = textLine.text;
+                textChunk.m_whitespaceHandling = content.m_content->getWhiteSpaceHandling();
+                textChunk.m_style = content.m_style;
+
+                if (m_logger.isEnabled(subttxrend::common::LoggerLevel::TRACE))
+                {
+                    m_logger.ostrace(__LOGGER_FUNC__, " chunk: \'", textChunk.m_text, "\'", ", style: ", textChunk.m_style->toStr());
+                }
+            }
+            //If TTML contained new line mark - add new line to render
+            if (textLine.isForcedLine == true && !entities.back().empty())
+            {
+                newLine(entities.back());
+            }
+        }
+    }
+}
+
 void DocumentInstance::dump() const
 {
+    if (!m_logger.isEnabled(subttxrend::common::LoggerLevel::TRACE))
+    {
+        return;
+    }
+
     m_logger.ostrace("--------- STYLES -----------");
     for (auto &style : m_styles)
     {
@@ -392,48 +503,35 @@ void DocumentInstance::dump() const
     }
 }
 
-std::shared_ptr<StyleElement> DocumentInstance::findStyle(const std::string& styleId) const
-{
-    auto retVal = find(styleId, m_styles);
-    if (retVal == nullptr) {
-        retVal = std::make_shared<StyleElement>();
-    }
-    return retVal;
-}
-
-std::shared_ptr<RegionElement> DocumentInstance::findRegion(const std::string& regionId) const
-{
-    return find(regionId, m_regions);
-}
-
-std::shared_ptr<ImageElement> DocumentInstance::findImage(const std::string& imageId) const
-{
-    return find(imageId, m_images);
-}
-
 std::vector<Timing> DocumentInstance::generateTimings() const
 {
-    std::set<TimePoint> timepoints;
+    std::vector<TimePoint> timepoints;
 
     // first create sorted list of unique points in time...
     for (auto &content : m_content)
     {
-        std::string contentStr;
+        if (m_logger.isEnabled(subttxrend::common::LoggerLevel::TRACE))
+        {
+            std::string contentStr;
 
-        for (auto& line : content->getTextLines()) {
-            contentStr.append("[");
-            contentStr.append(line.text);
-                    contentStr.append("]");
+            for (auto& line : content->getTextLines()) {
+                contentStr.append("[");
+                contentStr.append(line.text);
+                contentStr.append("]");
+            }
+            m_logger.ostrace(
+                    __LOGGER_FUNC__, " some content, with texts[", content->getTextLines().size(), "]: ", contentStr);
         }
-        m_logger.ostrace(
-                __LOGGER_FUNC__, " some content, with texts[", content->getTextLines().size(), "]: ", contentStr);
 
         if (!(content->getTextLines().empty() && content->getBackgroundImageId().empty()))
         {
-            timepoints.insert(content->getTiming().getStartTimeRef());
-            timepoints.insert(content->getTiming().getEndTimeRef());
+            const auto timing = content->getTiming();
+            timepoints.push_back(timing.getStartTimeRef());
+            timepoints.push_back(timing.getEndTimeRef());
         }
     }
+    std::sort(timepoints.begin(), timepoints.end());
+    timepoints.erase(std::unique(timepoints.begin(), timepoints.end()), timepoints.end());
 
     // than generate time periods for every neighboring timepoints
     std::vector<Timing> result;
@@ -453,15 +551,19 @@ std::vector<Timing> DocumentInstance::generateTimings() const
         }
     }
 
-    for (auto x : result)
+    if (m_logger.isEnabled(subttxrend::common::LoggerLevel::TRACE))
     {
-        m_logger.ostrace(__LOGGER_FUNC__, " result: ", x.toStr());
+        for (auto x : result)
+        {
+            m_logger.ostrace(__LOGGER_FUNC__, " result: ", x.toStr());
+        }
     }
 
     return result;
 }
 
-void DocumentInstance::updateStyleAttributes() const
+void DocumentInstance::updateStyleAttributes(const IdMap<StyleElement>& styles,
+                                             const IdMap<RegionElement>& regions) const
 {
     for (auto& content : m_content)
     {
@@ -476,16 +578,22 @@ void DocumentInstance::updateStyleAttributes() const
             mergeAttributes(styleAttrs, parent->getStyleAttributes());
         }
 
-        const auto& style = findStyle(content->getStyleId());
-        //merge style attributes from element style
-        mergeAttributes(styleAttrs, style->getStyleAttributes());
+        const auto style = find(content->getStyleId(), styles);
+        if (style != nullptr)
+        {
+            //merge style attributes from element style
+            mergeAttributes(styleAttrs, style->getStyleAttributes());
+        }
 
-        const auto& region = findRegion(content->getRegionId());
+        const auto region = find(content->getRegionId(), regions);
         if (region != nullptr)
         {
-            const auto& regionStyle = findStyle(region->getStyleId());
-            //merge style attributes from region style
-            mergeAttributes(styleAttrs, regionStyle->getStyleAttributes());
+            const auto regionStyle = find(region->getStyleId(), styles);
+            if (regionStyle != nullptr)
+            {
+                //merge style attributes from region style
+                mergeAttributes(styleAttrs, regionStyle->getStyleAttributes());
+            }
 
             //merge style attributes from region
             mergeAttributes(styleAttrs, region->getStyleAttributes());
@@ -499,9 +607,12 @@ void DocumentInstance::updateStyleAttributes() const
 
         content->set(std::move(styleAttrs));
 
-        std::ostringstream stream;
-        stream << content->getStyleAttributes();
-        m_logger.ostrace(__LOGGER_FUNC__, " content style attributes: ", stream.str());
+        if (m_logger.isEnabled(subttxrend::common::LoggerLevel::TRACE))
+        {
+            std::ostringstream stream;
+            stream << content->getStyleAttributes();
+            m_logger.ostrace(__LOGGER_FUNC__, " content style attributes: ", stream.str());
+        }
     }
 }
 
@@ -510,15 +621,18 @@ void DocumentInstance::setStyleOverrideAttributes(const Attributes& styleAttribu
     m_overrideStyleAttributes = styleAttributes;
 }
 
-void DocumentInstance::updateRegionAttributes() const
+void DocumentInstance::updateRegionAttributes(const IdMap<StyleElement>& styles) const
 {
     for (auto& region : m_regions)
     {
-        const auto& regionStyle = findStyle(region->getStyleId());
-        //merge style attributes from region style
-        const auto& regionStyleAttrs = regionStyle->getStyleAttributes();
-        for (auto& styleAttr : regionStyleAttrs) {
-            region->addAttribute(styleAttr.first, styleAttr.second);
+        const auto regionStyle = find(region->getStyleId(), styles);
+        if (regionStyle != nullptr)
+        {
+            //merge style attributes from region style
+            const auto& regionStyleAttrs = regionStyle->getStyleAttributes();
+            for (auto& styleAttr : regionStyleAttrs) {
+                region->addAttribute(styleAttr.first, styleAttr.second);
+            }
         }
 
         m_logger.ostrace(__LOGGER_FUNC__, " region: ", region->toStr());
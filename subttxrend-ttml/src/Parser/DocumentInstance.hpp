@@ -24,6 +24,7 @@
 #include <list>
 #include <memory>
 #include <stack>
+#include <unordered_map>
 
 #include <subttxrend/common/Logger.hpp>
 
@@ -105,6 +106,9 @@ public:
      * New IntermediateDocument::Entity is created when given BodyElement has it's own region defined.
      * New IntermediateDocument::TextLine is created when new line is forced - <br> element.
      *
+     * Time periods are swept in order. A BodyElement becomes active in the first period it overlaps
+     * and inactive after the last one, so each period visits only the BodyElement-s it shows.
+     *
      * @return
      *      Timelined list of text content and it's properties.
      */
@@ -117,59 +121,87 @@ public:
 
 private:
 
+    /** Items of a set indexed by their id. */
+    template<typename T>
+    using IdMap = std::unordered_map<std::string, std::shared_ptr<T> >;
+
     /**
-     * Template method for finding items in sets by their id.
-     *
-     * @param itemId
-     *      Item id to find.
+     * Content element with its references resolved, used while generating the timeline.
+     */
+    struct ResolvedContent
+    {
+        /** Content element. */
+        std::shared_ptr<BodyElement> m_content;
+
+        /** Referenced region, nullptr if none. */
+        std::shared_ptr<RegionElement> m_region;
+
+        /** Referenced image, nullptr if none. */
+        std::shared_ptr<ImageElement> m_image;
+
+        /** Style of the text chunks (style id and resolved style attributes). */
+        std::shared_ptr<const StyleSet> m_style;
+    };
+
+    /**
+     * Indexes items of a set by their id.
      *
+     * @param container
+     *      Set of items.
      * @return
-     *      T type element instance with given id, default element if not found.
+     *      Map of items, for repeated ids the first item in the set is used.
      */
     template<typename T>
-    std::shared_ptr<T> find(const std::string& itemId, const std::set< std::shared_ptr<T> >& container) const
+    static IdMap<T> indexById(const std::set< std::shared_ptr<T> >& container)
     {
-        auto result = std::find_if(container.begin(),
-                                   container.end(),
-                                   [&itemId](const std::shared_ptr<T>& elem)
-                                   {   return elem->getId() == itemId;});
-
-        if (result != container.end())
+        IdMap<T> items;
+        for (const auto& item : container)
         {
-            return *result;
+            items.emplace(item->getId(), item);
         }
-        return nullptr;
+        return items;
     }
 
     /**
-     * Finds style with given id.
+     * Finds item with given id.
      *
-     * @param styleId
-     *      Style id to find.
+     * @param itemId
+     *      Item id to find.
+     * @param items
+     *      Items indexed by id.
      * @return
-     *      StyleElement instance with given id, default style if not found.
+     *      Item with given id, nullptr if not found.
      */
-    std::shared_ptr<StyleElement> findStyle(const std::string& styleId) const;
+    template<typename T>
+    static std::shared_ptr<T> find(const std::string& itemId, const IdMap<T>& items)
+    {
+        auto result = items.find(itemId);
+        return (result != items.end()) ? result->second : nullptr;
+    }
 
     /**
-     * Finds region with given region id.
+     * Resolves region, image and style references of the content elements.
      *
-     * @param regionId
-     *      RegionId of region to find.
+     * @param regions
+     *      Regions indexed by id.
+     * @param images
+     *      Images indexed by id.
      * @return
-     *      RegionElement instance with given id, nullptr if not found.
+     *      Resolved content, in the same order as m_content.
      */
-    std::shared_ptr<RegionElement> findRegion(const std::string& regionId) const;
+    std::vector<ResolvedContent> resolveContent(const IdMap<RegionElement>& regions,
+                                                const IdMap<ImageElement>& images) const;
 
     /**
-     * Finds image with given id.
+     * Adds content element to the entities of the IntermediateDocument being generated.
      *
-     * @param imageId
-     *      Image id to find.
-     * @return
-     *      ImageElement instance with given id, nullptr if not found.
+     * @param entities
+     *      Entities of the IntermediateDocument.
+     * @param content
+     *      Content element active within the document timing.
      */
-    std::shared_ptr<ImageElement> findImage(const std::string& imageId) const;
+    void addContent(std::vector<IntermediateDocument::Entity>& entities,
+                    const ResolvedContent& content) const;
 
     /**
      * Generates list of time periods within which subtitle content does not change.
@@ -187,15 +219,24 @@ private:
      * - region style
      * - region
      * - "self"
+     *
+     * @param styles
+     *      Styles indexed by id.
+     * @param regions
+     *      Regions indexed by id.
      */
-    void updateStyleAttributes() const;
+    void updateStyleAttributes(const IdMap<StyleElement>& styles,
+                               const IdMap<RegionElement>& regions) const;
 
     /**
      * Add style attributes referenced by the region into region
      * As a result, all attributes referenced by style become attributes of region
      * among others "tts:extent" and "tts:origin"
+     *
+     * @param styles
+     *      Styles indexed by id.
      */
-    void updateRegionAttributes() const;
+    void updateRegionAttributes(const IdMap<StyleElement>& styles) const;
 
 private:
     /** TT root element */
@@ -207,7 +248,7 @@ private:
     /** Set of regions defined in the document. Each region may be referenced by multiple content elements. */
     std::set<std::shared_ptr<RegionElement> > m_regions;
 
-    // maps imageid -> image data (base64 encoded string)
+    // maps imageid -> image data (decoded png)
     std::set<std::shared_ptr<ImageElement>> m_images;
 
     /** Current element stack. Used to keep track of current element mainly for children nodes to inherit
@@ -222,6 +263,9 @@ private:
     /** The styling attributes to use as overrides for all other styles */
     Attributes m_overrideStyleAttributes;
 
+    /** Styles of the text chunks, shared between the generated documents. */
+    mutable StyleSetPool m_stylePool;
+
     /** Logger object. */
     mutable subttxrend::common::Logger m_logger;
 };
@@ -25,11 +25,14 @@
 #include "Utils.hpp"
 
 #include <cassert>
+#include <cstdint>
 #include <memory>
 #include <regex>
 #include <set>
 #include <unordered_map>
+#include <vector>
 
+#include <subttxrend/gfx/Base64Decoder.hpp>
 #include <subttxrend/gfx/Types.hpp>
 
 namespace subttxrend
@@ -385,6 +388,9 @@ private:
 
 /**
  * Class representing ttml image data.
+ *
+ * Base64 text of the image is decoded as it arrives, only the binary
+ * (png) data is kept.
  */
 class ImageElement : public Element
 {
@@ -394,7 +400,7 @@ public:
      * Constructor.
      */
     ImageElement() :
-            m_base64ImageData(std::make_shared<std::string>())
+            m_imageData(std::make_shared<std::vector<std::uint8_t>>())
     {
         // noop
     }
@@ -408,27 +414,56 @@ public:
     /** @copydoc Element::appendText */
     virtual void appendText(const std::string& text) override
     {
-        m_base64ImageData->append(text);
+        m_base64Decoder.decode(text.data(), text.size(), *m_imageData);
+    }
+
+    /**
+     * Finalizes the element once all image data is appended.
+     *
+     * Releases memory reserved for more data and computes the data hash,
+     * the data does not change afterwards.
+     */
+    void finalize()
+    {
+        m_base64Decoder.reset();
+        m_imageData->shrink_to_fit();
+
+        // FNV-1a
+        std::uint64_t hash = 14695981039346656037ULL;
+        for (auto byte : *m_imageData)
+        {
+            hash = (hash ^ byte) * 1099511628211ULL;
+        }
+        m_imageDataHash = static_cast<std::size_t>(hash);
     }
 
     /**
      * Image data getter.
      *
      * @return
-     *      Base64 encoded string containing image data.
+     *      Decoded image data (png).
      */
-    const std::shared_ptr<std::string> getBase64Data()
+    std::shared_ptr<const std::vector<std::uint8_t>> getImageData() const
     {
-        return m_base64ImageData;
+        return m_imageData;
+    }
+
+    /**
+     * Image data hash getter.
+     *
+     * @return
+     *      Hash of the decoded image data, computed by finalize().
+     */
+    std::size_t getImageDataHash() const
+    {
+        return m_imageDataHash;
     }
 
     bool isSameImage(std::shared_ptr<ImageElement> const& other) const
     {
-        auto isSame{false};
-        if (other && (getId() == other->getId()) && (m_base64ImageData->size() == other->m_base64ImageData->size())) {
-            isSame = !m_base64ImageData->compare(*(other->m_base64ImageData));
-        }
-        return isSame;
+        return other && (getId() == other->getId())
+                && ((m_imageData == other->m_imageData)
+                        || ((m_imageDataHash == other->m_imageDataHash) && (*m_imageData == *(other->m_imageData))));
     }
 
     /**
@@ -442,7 +477,7 @@ public:
     friend bool operator==(const ImageElement& lhs,
                            const ImageElement& rhs)
     {
-        return ((lhs.getId() == rhs.getId()) && (lhs.m_base64ImageData == rhs.m_base64ImageData));
+        return ((lhs.getId() == rhs.getId()) && (lhs.m_imageData == rhs.m_imageData));
     }
 
 protected:
@@ -456,8 +491,14 @@ protected:
 
 private:
 
-    /** Image data as presented in document - base64 encoded. */
-    std::shared_ptr<std::string> m_base64ImageData;
+    /** Decoder of the base64 text of the document. */
+    gfx::Base64Decoder m_base64Decoder;
+
+    /** Decoded image data. */
+    std::shared_ptr<std::vector<std::uint8_t>> m_imageData;
+
+    /** Hash of the decoded image data. */
+    std::size_t m_imageDataHash{0};
 };
 
 /**
@@ -85,15 +85,15 @@ public:
         friend bool operator==(const TextChunk& lhs,
                                const TextChunk& rhs)
         {
-            return ((lhs.m_text == rhs.m_text) && (lhs.m_style == rhs.m_style)
+            return ((lhs.m_text == rhs.m_text) && sharedPtrObjectsEqual(lhs.m_style, rhs.m_style)
                     && (lhs.m_forceNewline == rhs.m_forceNewline));
         }
 
         /** Text content. */
         std::string m_text;
 
-        /** Text style attributes. */
-        StyleSet m_style;
+        /** Text style attributes, shared by chunks with the same style. */
+        std::shared_ptr<const StyleSet> m_style{StyleSet::getDefault()};
 
         /** Force newline flag. */
         bool m_forceNewline = false;
@@ -240,6 +240,41 @@ void StyleSet::setStyleId(const std::string& styleId)
 {
     m_styleId = styleId;
 }
+
+const std::shared_ptr<const StyleSet>& StyleSet::getDefault()
+{
+    static const std::shared_ptr<const StyleSet> defaultStyleSet = std::make_shared<const StyleSet>();
+    return defaultStyleSet;
+}
+
+std::size_t StyleSet::hash() const
+{
+    auto hashColor = [](const ColorArgb& color)
+    {
+        return (std::uint32_t{color.m_a} << 24) | (std::uint32_t{color.m_r} << 16)
+                | (std::uint32_t{color.m_g} << 8) | color.m_b;
+    };
+    auto hashValue = [](const DomainValue& value)
+    {
+        return static_cast<std::size_t>(value.getValue()) * 4 + static_cast<std::size_t>(value.getType());
+    };
+
+    std::size_t result = std::hash<std::string>()(m_styleId);
+    for (std::size_t value : {static_cast<std::size_t>(hashColor(m_color)),
+                              static_cast<std::size_t>(hashColor(m_backgroundColor)),
+                              std::hash<std::string>()(m_fontFamily),
+                              hashValue(m_fontSize),
+                              static_cast<std::size_t>(m_textAlign),
+                              static_cast<std::size_t>(m_displayAlign),
+                              hashValue(m_lineHeight),
+                              static_cast<std::size_t>(hashColor(m_textOutline.getColor())),
+                              hashValue(m_textOutline.getThickness())})
+    {
+        result = result * 31 + value;
+    }
+    return result;
+}
+
 void StyleSet::merge(const Attributes& attributes)
 {
     for (const auto& attr : attributes) {
@@ -294,6 +329,38 @@ void StyleSet::parseAttribute(const std::string& name,
     }
 }
 
+std::shared_ptr<const StyleSet> StyleSetPool::get(const std::string& styleId,
+                                                  const Attributes& attributes)
+{
+    auto& resolved = m_resolved[styleId];
+
+    auto iter = resolved.find(attributes);
+    if (iter != resolved.end())
+    {
+        return iter->second;
+    }
+
+    auto styleSet = std::make_shared<StyleSet>();
+    styleSet->setStyleId(styleId);
+    styleSet->merge(attributes);
+
+    // same values may come from different attributes (e.g. 'white' and '#ffffff')
+    auto shared = *m_styleSets.insert(std::move(styleSet)).first;
+    resolved.emplace(attributes, shared);
+    return shared;
+}
+
+std::size_t StyleSetPool::size() const
+{
+    return m_styleSets.size();
+}
+
+void StyleSetPool::clear()
+{
+    m_resolved.clear();
+    m_styleSets.clear();
+}
+
 std::ostream& operator<<(std::ostream& out, const StyleSet::TextAlign textAlign)
 {
     switch (textAlign) {
@@ -328,7 +395,7 @@ std::ostream& operator<<(std::ostream& out, const StyleSet::DisplayAlign display
     return out;
 }
 
-std::string StyleSet::toStr()
+std::string StyleSet::toStr() const
 {
     std::ostringstream str;
 
@@ -25,7 +25,11 @@
 #include "Outline.hpp"
 
 #include <subttxrend/gfx/ColorArgb.hpp>
+#include <map>
+#include <memory>
 #include <set>
+#include <string>
+#include <unordered_set>
 
 namespace subttxrend
 {
@@ -72,7 +76,17 @@ public:
     void setStyleId(const std::string& styleId);
     void merge(const Attributes& attributes);
 
-    std::string toStr();
+    /**
+     * Returns shared default style set.
+     */
+    static const std::shared_ptr<const StyleSet>& getDefault();
+
+    /**
+     * Hash of the values compared by operator== and the style id.
+     */
+    std::size_t hash() const;
+
+    std::string toStr() const;
 
     friend bool operator==(const StyleSet& lhs,
                            const StyleSet& rhs);
@@ -92,6 +106,64 @@ private:
     std::string m_styleId;
 };
 
+/**
+ * Pool of shared immutable style sets (hash-consing).
+ *
+ * Style set resolved from given style id and attributes is built once and
+ * style sets with the same values are represented by a single object, so
+ * text chunks share their styles and equal styles have equal pointers.
+ */
+class StyleSetPool
+{
+public:
+    /**
+     * Returns style set resolved from given style id and attributes.
+     *
+     * @param styleId
+     *      Style id.
+     * @param attributes
+     *      Resolved style attributes.
+     * @return
+     *      Shared style set.
+     */
+    std::shared_ptr<const StyleSet> get(const std::string& styleId,
+                                        const Attributes& attributes);
+
+    /**
+     * Returns number of distinct style sets in the pool.
+     */
+    std::size_t size() const;
+
+    /**
+     * Removes all style sets. Style sets in use stay valid.
+     */
+    void clear();
+
+private:
+    struct Hash
+    {
+        std::size_t operator()(const std::shared_ptr<const StyleSet>& styleSet) const
+        {
+            return styleSet->hash();
+        }
+    };
+
+    struct Equal
+    {
+        bool operator()(const std::shared_ptr<const StyleSet>& lhs,
+                        const std::shared_ptr<const StyleSet>& rhs) const
+        {
+            return (*lhs == *rhs) && (lhs->getStyleId() == rhs->getStyleId());
+        }
+    };
+
+    /** Style sets by style id and attributes they were resolved from. */
+    std::map<std::string, std::map<Attributes, std::shared_ptr<const StyleSet>>> m_resolved;
+
+    /** Distinct style sets. */
+    std::unordered_set<std::shared_ptr<const StyleSet>, Hash, Equal> m_styleSets;
+};
+
 std::ostream& operator<<(std::ostream& out, const StyleSet::TextAlign textAlign);
 std::ostream& operator<<(std::ostream& out, const StyleSet::DisplayAlign displayAlign);
 
@@ -25,6 +25,14 @@ namespace subttxrend
 namespace ttmlengine
 {
 
+namespace
+{
+
+/** Interned names are dropped on reset when there are more (unusual documents). */
+constexpr std::size_t MAX_INTERNED_NAMES = 256;
+
+} // namespace anonymous
+
 SaxParser::SaxParser(SaxCallbacks& callbacks) :
         m_saxHandler(), m_parserCtxPtr(nullptr), m_saxCallbacks(callbacks), m_logger("TtmlEngine", "SaxParser")
 {
@@ -55,6 +63,11 @@ void SaxParser::reset()
 {
     cleanup();
     init();
+
+    if (m_names.size() > MAX_INTERNED_NAMES)
+    {
+        m_names.clear();
+    }
 }
 
 void SaxParser::init()
@@ -116,32 +129,39 @@ void SaxParser::onStartElementNs(void * ctx,
 {
     auto thiz = cast(ctx);
 
-    std::vector<SaxCallbacks::Attribute> attributesVector{static_cast<std::size_t>(nb_attributes)};
-    unsigned int index = 0;
-    for (int indexAttribute = 0; indexAttribute < nb_attributes; ++indexAttribute, index += 5)
+    const auto count = static_cast<std::size_t>(nb_attributes);
+    auto& attributesVector = thiz->m_attributes;
+    auto& values = thiz->m_values;
+
+    // values are resized first, attributes refer to them
+    attributesVector.clear();
+    if (values.size() < count)
+    {
+        values.resize(count);
+    }
+
+    for (std::size_t indexAttribute = 0, index = 0; indexAttribute < count; ++indexAttribute, index += 5)
     {
         // name should always be present
         assert(attributes[index]);
-        std::string attrName = std::string(reinterpret_cast<const char*>(attributes[index]));
-
-        // prefix is optional
-        auto attrPrefixPtr = reinterpret_cast<const char*>(attributes[index + 1]);
-        std::string attrPrefix = std::string(attrPrefixPtr ? attrPrefixPtr : "");
 
         // value should be present
         assert(attributes[index + 3]);
         assert(attributes[index + 4]);
         auto valueBegin = reinterpret_cast<const char*>(attributes[index + 3]);
         auto valueEnd = reinterpret_cast<const char*>(attributes[index + 4]);
-        std::string value(valueBegin, valueEnd);
+        values[indexAttribute].assign(valueBegin, valueEnd);
 
-        attributesVector.emplace_back(SaxCallbacks::Attribute{attrPrefix, attrName, value});
+        // prefix is optional
+        attributesVector.push_back(SaxCallbacks::Attribute{thiz->intern(attributes[index + 1]),
+                                                           thiz->intern(attributes[index]),
+                                                           values[indexAttribute]});
     }
 
     assert(localname != nullptr);
-    thiz->m_saxCallbacks.onStartElementNs(reinterpret_cast<const char*>(localname),
-        prefix != nullptr ? reinterpret_cast<const char*>(prefix) : "",
-        URI != nullptr ? reinterpret_cast<const char*>(URI) : "",
+    thiz->m_saxCallbacks.onStartElementNs(thiz->intern(localname),
+        thiz->intern(prefix),
+        thiz->intern(URI),
         attributesVector);
 }
 
@@ -152,9 +172,9 @@ void SaxParser::onEndElementNs(void * ctx,
 {
     auto thiz = cast(ctx);
     assert(localname != nullptr);
-    thiz->m_saxCallbacks.onEndElementNs(reinterpret_cast<const char*>(localname),
-        prefix != nullptr ? reinterpret_cast<const char*>(prefix) : "",
-        URI != nullptr ? reinterpret_cast<const char*>(URI) : "");
+    thiz->m_saxCallbacks.onEndElementNs(thiz->intern(localname),
+        thiz->intern(prefix),
+        thiz->intern(URI));
 }
 
 void SaxParser::onError(void * ctx,
@@ -178,7 +198,20 @@ void SaxParser::onCharacters(void *ctx,
                          int len)
 {
     auto thiz = cast(ctx);
-    thiz->m_saxCallbacks.onCharacters(std::string{ch, ch + len});
+    thiz->m_characters.assign(ch, ch + len);
+    thiz->m_saxCallbacks.onCharacters(thiz->m_characters);
+}
+
+const std::string& SaxParser::intern(const xmlChar* name)
+{
+    const char* text = name ? reinterpret_cast<const char*>(name) : "";
+
+    auto iter = m_names.find(text);
+    if (iter == m_names.end())
+    {
+        iter = m_names.emplace(text).first;
+    }
+    return *iter;
 }
 
 
@@ -25,6 +25,8 @@
 #include <libxml/SAX.h>
 
 #include <subttxrend/common/Logger.hpp>
+#include <functional>
+#include <set>
 #include <string>
 #include <cstdint>
 #include <vector>
@@ -41,11 +43,16 @@ class SaxCallbacks
 {
 public:
 
+    /**
+     * Element attribute.
+     *
+     * Refers to the parser's strings, valid only during the callback.
+     */
     struct Attribute
     {
-        std::string prefix;
-        std::string name;
-        std::string value;
+        const std::string& prefix;
+        const std::string& name;
+        const std::string& value;
     };
 
     /**
@@ -294,6 +301,19 @@ private:
                              const xmlChar *ch,
                              int len);
 
+    /**
+     * Returns interned copy of a name.
+     *
+     * Element and attribute names, prefixes and URIs repeat throughout the
+     * document, each one is converted to std::string once per parser.
+     *
+     * @param name
+     *      Name, null pointer is treated as empty name.
+     * @return
+     *      Interned string, valid until the parser is reset.
+     */
+    const std::string& intern(const xmlChar* name);
+
     /** xmlLib sax handler. */
     xmlSAXHandler m_saxHandler;
 
@@ -303,6 +323,18 @@ private:
     /** Registered callbacks handler. */
     SaxCallbacks& m_saxCallbacks;
 
+    /** Interned names. */
+    std::set<std::string, std::less<>> m_names;
+
+    /** Attributes of the current element. */
+    std::vector<SaxCallbacks::Attribute> m_attributes;
+
+    /** Attribute values of the current element, reused to keep the string buffers. */
+    std::vector<std::string> m_values;
+
+    /** Characters passed to the callback, reused to keep the string buffer. */
+    std::string m_characters;
+
     /** Logger object. */
     subttxrend::common::Logger m_logger;
 };
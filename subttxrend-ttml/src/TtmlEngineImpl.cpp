@@ -17,6 +17,7 @@
 * limitations under the License.
 *****************************************************************************/
 
+#include <algorithm>
 #include <cassert>
 
 #include <inttypes.h>
@@ -66,9 +67,22 @@ void TtmlEngineImpl::clear()
     m_pauseTimeMs = 0;
 }
 
+void TtmlEngineImpl::logImageCacheStatistics() const
+{
+    auto const stats = m_imageCache.getStatistics();
+
+    m_logger.osinfo(__LOGGER_FUNC__,
+            " hits: ", stats.m_hits,
+            " misses: ", stats.m_misses,
+            " evictions: ", stats.m_evictions,
+            " entries: ", stats.m_entries,
+            " bytes: ", stats.m_usedBytes);
+}
+
 void TtmlEngineImpl::init(const common::ConfigProvider* configProvider,
                           gfx::Window* gfxWindow,
-                          common::Properties const& properties)
+                          common::Properties const& properties,
+                          std::shared_ptr<gfx::PrerenderedFontCache> fontCache)
 {
     m_logger.osinfo(__LOGGER_FUNC__);
 
@@ -82,8 +96,18 @@ void TtmlEngineImpl::init(const common::ConfigProvider* configProvider,
         createTimingDoc();
     }
 
+    const auto imageCacheSizeKb = configProvider->getInt("IMAGE_CACHE_SIZE_KB",
+            ImageCache::DEFAULT_BYTE_BUDGET / 1024);
+    m_imageCache.setByteBudget(static_cast<std::size_t>(std::max(imageCacheSizeKb, 0)) * 1024);
+
     m_parser = std::make_unique<Parser>();
-    m_renderer = std::make_unique<TtmlRenderer>(configProvider, gfxWindow, m_dataDumper);
+    if (!fontCache)
+    {
+        fontCache = std::make_shared<gfx::PrerenderedFontCache>();
+    }
+
+    m_renderer = std::make_unique<TtmlRenderer>(configProvider, gfxWindow, m_dataDumper, m_imageCache,
+            std::move(fontCache));
 
     m_docTransformer.setProperties(properties);
     m_pathTtmlFromFile = configProvider->get("READ_FROM_FILE");
@@ -114,6 +138,9 @@ void TtmlEngineImpl::stop()
     std::lock_guard<std::mutex> lock{m_mutex};
     clear();
     m_renderer->hide();
+
+    logImageCacheStatistics();
+    m_imageCache.clear();
 }
 
 void TtmlEngineImpl::flush()
@@ -397,39 +424,51 @@ void TtmlEngineImpl::process()
 
 std::chrono::milliseconds TtmlEngineImpl::getWaitTime() const
 {
-    auto waitTime = std::chrono::milliseconds::zero();
+    using namespace std::chrono;
 
-    auto anythingToDraw = !m_timeline.empty();
-    auto anythingToHide = !m_shownDocuments.empty() || m_startTimer;
+    static constexpr milliseconds MIN_WAIT_TIME{1};
+    static constexpr milliseconds MAX_WAIT_TIME{1000};
+    static constexpr milliseconds MEDIATIME_REFRESH_TIME{25};
+
+    auto waitTime = milliseconds::max();
 
     {
         std::lock_guard<std::mutex> lock{m_mutex};
-        if ((m_lastMediatimeMs != -1) && (anythingToDraw || anythingToHide)) {
-            // TimePoint const currentMediaTime = getCurrentMediatime();
-
-            // if (anythingToDraw) {
-            //     TimePoint const& start = m_timeline.front().m_timing.getStartTimeRef();
-
-            //     if (currentMediaTime < start) {
-            //         waitTime = start.toMilliseconds() - currentMediaTime.toMilliseconds();
-            //     }
-            // }
-
-            // for_each(m_shownDocuments.begin(), m_shownDocuments.end(), [&waitTime,
-            //                                                             currentMediaTime](const IntermediateDocument &doc) {
-            //     TimePoint const& end = doc.m_timing.getEndTimeRef();
-            //     auto hideTime = end.toMilliseconds() - currentMediaTime.toMilliseconds();
-            //     if (hideTime < waitTime) {
-            //         waitTime = hideTime;
-            //     }
-            // });
-
-            auto static constexpr MIN_WAIT_TIME = 25ms;
-            // if (waitTime < MIN_WAIT_TIME) {
-                waitTime = MIN_WAIT_TIME;
-            // }
+        if ((m_lastMediatimeMs != -1) && (!m_paused)) {
+            auto const currentMediaTimeMs = getCurrentMediatime().toMilliseconds();
+
+            if (!m_timeline.empty()) {
+                auto const start = m_timeline.front().m_timing.getStartTimeRef().toMilliseconds();
+                waitTime = std::min(waitTime, start - currentMediaTimeMs);
+            }
+
+            for (auto const& doc : m_shownDocuments) {
+                auto const end = doc.m_timing.getEndTimeRef().toMilliseconds();
+                waitTime = std::min(waitTime, end - currentMediaTimeMs);
+            }
+
+            // forced redraw done by process() once display timeout expires
+            if (m_startTimer) {
+                auto const timerExpiry = m_displayTime + seconds(DISPLAY_TIMEOUT + 1);
+                auto const now = steady_clock::now();
+                if (timerExpiry > now) {
+                    waitTime = std::min(waitTime, duration_cast<milliseconds>(timerExpiry - now) + MIN_WAIT_TIME);
+                }
+            }
+
+            if (m_showMediatime) {
+                waitTime = std::min(waitTime, MEDIATIME_REFRESH_TIME);
+            }
         }
     }
+
+    if (waitTime == milliseconds::max()) {
+        // nothing scheduled, wait for new data or timestamp
+        waitTime = milliseconds::zero();
+    } else {
+        waitTime = std::max(MIN_WAIT_TIME, std::min(waitTime, MAX_WAIT_TIME));
+    }
+
     m_logger.osdebug(__LOGGER_FUNC__, " waitTime: ", waitTime.count());
     return waitTime;
 }
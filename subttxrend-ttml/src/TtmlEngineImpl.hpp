@@ -59,7 +59,8 @@ public:
     /** @copydoc TtmlEngine::init */
     virtual void init(const common::ConfigProvider* configProvider,
                       gfx::Window*  gfxEngine,
-                      common::Properties const& properties) override;
+                      common::Properties const& properties,
+                      std::shared_ptr<gfx::PrerenderedFontCache> fontCache) override;
 
     /** @copydoc TtmlEngine::setRelatedVideoSize */
     virtual void setRelatedVideoSize(gfx::Size relatedVideoSize) override;
@@ -107,6 +108,11 @@ private:
 
     void clear();
 
+    /**
+     * Logs decoded images cache statistics.
+     */
+    void logImageCacheStatistics() const;
+
     /**
      * Calculates current media time taking into account time passed media time was received.
      *
@@ -162,6 +168,9 @@ private:
     /** Data dumper - used for debugging purposes. */
     DataDumper m_dataDumper;
 
+    /** Decoded images shared by all rendered documents. */
+    ImageCache m_imageCache;
+
     /** Debug feature - show current media time on screen. */
     bool m_showMediatime{false};
 
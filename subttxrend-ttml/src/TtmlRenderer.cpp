@@ -47,10 +47,13 @@ bool isFullScreen(gfx::Rectangle const& rect, gfx::Size const& windowSize)
 
 TtmlRenderer::TtmlRenderer(const common::ConfigProvider *configProvider,
                            gfx::Window* gfxWindow,
-                           const DataDumper& dataDumper)
+                           const DataDumper& dataDumper,
+                           ImageCache& imageCache,
+                           std::shared_ptr<gfx::PrerenderedFontCache> fontCache)
         : m_gfxWindow(gfxWindow),
-          m_docDrawer(configProvider,m_valueConverter),
-          m_dataDumper(dataDumper)
+          m_docDrawer(configProvider,m_valueConverter,std::move(fontCache)),
+          m_dataDumper(dataDumper),
+          m_imageCache(imageCache)
 {
     assert(m_gfxWindow);
 }
@@ -84,10 +87,19 @@ void TtmlRenderer::decodeImages(IntermediateDocument &doc)
 {
     for (auto &entity : doc.m_entites) {
         if (entity.m_imageChunk.m_image && entity.m_imageChunk.m_image->getId() != "") {
-            auto b64 = entity.m_imageChunk.m_image->getBase64Data();
-            auto pngCallback = preparePngCallback(entity.m_imageChunk.m_image->getId(), doc.m_timing.toStr());
+            auto const& id = entity.m_imageChunk.m_image->getId();
+            auto png = entity.m_imageChunk.m_image->getImageData();
+            auto const pngHash = entity.m_imageChunk.m_image->getImageDataHash();
 
-            entity.m_imageChunk.m_bmp = gfx::base64toPixmap(*b64, true, pngCallback);
+            std::shared_ptr<gfx::Bitmap> bmp = m_imageCache.find(id, pngHash);
+            if (!bmp) {
+                auto pngCallback = preparePngCallback(id, doc.m_timing.toStr());
+
+                bmp = gfx::pngToPixmap(png->data(), png->size(), true, pngCallback);
+                m_imageCache.insert(id, pngHash, bmp);
+            }
+
+            entity.m_imageChunk.m_bmp = std::move(bmp);
         }
     }
 }
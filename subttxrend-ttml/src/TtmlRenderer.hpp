@@ -20,6 +20,7 @@
 #pragma once
 
 #include "DataDumper.h"
+#include "ImageCache.hpp"
 #include "IntermediateDocDrawer.hpp"
 
 #include "Parser/DocumentInstance.hpp"
@@ -45,7 +46,9 @@ public:
 
     TtmlRenderer(const common::ConfigProvider *configProvider,
                  gfx::Window *gfxWindow,
-                 const DataDumper &dataDumper);
+                 const DataDumper &dataDumper,
+                 ImageCache &imageCache,
+                 std::shared_ptr<gfx::PrerenderedFontCache> fontCache);
 
     /**
      *  Sets releated video
@@ -122,6 +125,9 @@ private:
     /** Debug data dumper. */
     const DataDumper& m_dataDumper;
 
+    /** Decoded images cache. */
+    ImageCache& m_imageCache;
+
 };
 
 }   // namespace ttmlengine
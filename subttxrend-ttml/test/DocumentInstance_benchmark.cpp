@@ -0,0 +1,288 @@
+/*****************************************************************************
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:
+*
+* Copyright 2021 Liberty Global Service B.V.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*****************************************************************************/
+
+/*
+ * Benchmark of DocumentInstance::generateTimeline() and of parsing whole
+ * TTML text through SaxParser (Parser::parse()) on full-movie documents.
+ *
+ * Each <p> lasts 2 seconds and every third one overlaps the next, p-s
+ * reference one of a few regions and styles and have two spans. Parsing
+ * reports number of heap allocations and memory used by the generated
+ * timeline (IntermediateDocument-s). Not a unit test, run manually:
+ * DocumentInstance_Benchmark [paragraphs] [iterations]
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+
+#include "Parser/DocumentInstance.hpp"
+#include "Parser/Parser.hpp"
+
+using namespace subttxrend::ttmlengine;
+
+namespace
+{
+
+/** Allocated blocks start with their size, so live bytes can be tracked. */
+constexpr std::size_t ALLOCATION_HEADER = alignof(std::max_align_t);
+
+std::atomic<std::size_t> g_allocations{0};
+std::atomic<std::size_t> g_liveBytes{0};
+
+std::string toTimeExpression(int ms)
+{
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%02d:%02d:%02d.%03d",
+                  ms / 3600000, ms / 60000 % 60, ms / 1000 % 60, ms % 1000);
+    return buffer;
+}
+
+void buildDocument(DocumentInstance& doc,
+                   int paragraphs)
+{
+    const int count = 4;
+
+    doc.startElement("tt");
+
+    for (int i = 0; i < count; ++i)
+    {
+        auto style = doc.startElement("style");
+        style->parseAttribute("xml", "id", "style" + std::to_string(i));
+        style->parseAttribute("tts", "color", (i % 2) ? "yellow" : "white");
+        style->parseAttribute("tts", "fontSize", "1c");
+        doc.endElement(); // style
+    }
+
+    for (int i = 0; i < count; ++i)
+    {
+        auto region = doc.startElement("region");
+        region->parseAttribute("xml", "id", "region" + std::to_string(i));
+        region->parseAttribute("tts", "origin", "10% " + std::to_string(10 + i * 20) + "%");
+        region->parseAttribute("tts", "extent", "80% 15%");
+        doc.endElement(); // region
+    }
+
+    doc.startElement("body");
+    doc.startElement("div");
+
+    for (int i = 0; i < paragraphs; ++i)
+    {
+        const int begin = i * 2000;
+        const int end = begin + ((i % 3 == 0) ? 3000 : 1800);
+
+        auto pElem = doc.startElement("p");
+        pElem->parseAttribute("", "begin", toTimeExpression(begin));
+        pElem->parseAttribute("", "end", toTimeExpression(end));
+        pElem->parseAttribute("", "region", "region" + std::to_string(i % count));
+        pElem->parseAttribute("", "style", "style" + std::to_string(i % count));
+
+        auto span1 = doc.startElement("span");
+        span1->appendText("Subtitle number " + std::to_string(i));
+        doc.endElement(); // span
+
+        doc.startElement("br");
+        doc.endElement(); // br
+
+        auto span2 = doc.startElement("span");
+        span2->parseAttribute("tts", "fontStyle", "italic");
+        span2->appendText("second line");
+        doc.endElement(); // span
+
+        doc.endElement(); // p
+    }
+
+    doc.endElement(); // div
+    doc.endElement(); // body
+    doc.endElement(); // tt
+}
+
+std::string buildTtml(int paragraphs)
+{
+    const int count = 4;
+
+    std::string text = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+            "<tt xmlns=\"http://www.w3.org/ns/ttml\" xmlns:tts=\"http://www.w3.org/ns/ttml#styling\""
+            " xmlns:ttp=\"http://www.w3.org/ns/ttml#parameter\" ttp:cellResolution=\"40 19\">"
+            "<head><styling>";
+
+    for (int i = 0; i < count; ++i)
+    {
+        text += "<style xml:id=\"style" + std::to_string(i) + "\" tts:color=\"" + ((i % 2) ? "yellow" : "white")
+                + "\" tts:fontSize=\"1c\" tts:textOutline=\"black 2px\"/>";
+    }
+
+    text += "</styling><layout>";
+
+    for (int i = 0; i < count; ++i)
+    {
+        text += "<region xml:id=\"region" + std::to_string(i) + "\" tts:origin=\"10% " + std::to_string(10 + i * 20)
+                + "%\" tts:extent=\"80% 15%\"/>";
+    }
+
+    text += "</layout></head><body><div>";
+
+    for (int i = 0; i < paragraphs; ++i)
+    {
+        const int begin = i * 2000;
+        const int end = begin + ((i % 3 == 0) ? 3000 : 1800);
+
+        text += "<p begin=\"" + toTimeExpression(begin) + "\" end=\"" + toTimeExpression(end)
+                + "\" region=\"region" + std::to_string(i % count) + "\" style=\"style" + std::to_string(i % count)
+                + "\"><span>Subtitle number " + std::to_string(i)
+                + "</span><br/><span tts:fontStyle=\"italic\">second line</span></p>\n";
+    }
+
+    text += "</div></body></tt>\n";
+    return text;
+}
+
+void benchmarkParse(int paragraphs,
+                    std::size_t iterations)
+{
+    const auto text = buildTtml(paragraphs);
+
+    Parser parser;
+    double best = 0;
+    std::size_t allocations = 0;
+    std::size_t timelineBytes = 0;
+    std::size_t documents = 0;
+
+    for (std::size_t i = 0; i < iterations; ++i)
+    {
+        std::size_t allocationsBefore = g_allocations;
+        std::size_t liveBytes = 0;
+
+        auto start = std::chrono::steady_clock::now();
+        {
+            auto timeline = parser.parse(reinterpret_cast<const std::uint8_t*>(text.data()), text.size());
+            auto end = std::chrono::steady_clock::now();
+
+            allocations = g_allocations - allocationsBefore;
+            documents = timeline.size();
+            liveBytes = g_liveBytes;
+
+            double ms = std::chrono::duration<double, std::milli>(end - start).count();
+            if (i == 0 || ms < best)
+            {
+                best = ms;
+            }
+        }
+        // memory released with the timeline
+        timelineBytes = liveBytes - g_liveBytes;
+    }
+
+    std::printf("%6d paragraphs %10.2f ms %7zu documents %9zu allocations %9.1f KiB timeline (%zu B/document)\n",
+                paragraphs, best, documents, allocations, timelineBytes / 1024.0,
+                documents ? timelineBytes / documents : 0);
+}
+
+void benchmark(int paragraphs,
+               std::size_t iterations)
+{
+    double best = 0;
+    std::size_t documents = 0;
+
+    for (std::size_t i = 0; i < iterations; ++i)
+    {
+        DocumentInstance doc;
+        buildDocument(doc, paragraphs);
+
+        auto start = std::chrono::steady_clock::now();
+        documents = doc.generateTimeline().size();
+        auto end = std::chrono::steady_clock::now();
+
+        double ms = std::chrono::duration<double, std::milli>(end - start).count();
+        if (i == 0 || ms < best)
+        {
+            best = ms;
+        }
+    }
+
+    std::printf("%6d paragraphs %10.2f ms %7zu documents\n", paragraphs, best, documents);
+}
+
+} // namespace
+
+void* operator new(std::size_t size)
+{
+    ++g_allocations;
+    g_liveBytes += size;
+    if (auto ptr = static_cast<char*>(std::malloc(size + ALLOCATION_HEADER)))
+    {
+        *reinterpret_cast<std::size_t*>(ptr) = size;
+        return ptr + ALLOCATION_HEADER;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept
+{
+    if (ptr)
+    {
+        auto block = static_cast<char*>(ptr) - ALLOCATION_HEADER;
+        g_liveBytes -= *reinterpret_cast<std::size_t*>(block);
+        std::free(block);
+    }
+}
+
+void operator delete(void* ptr,
+                     std::size_t) noexcept
+{
+    operator delete(ptr);
+}
+
+int main(int argc,
+         char* argv[])
+{
+    int paragraphs = (argc > 1) ? std::atoi(argv[1]) : 0;
+    std::size_t iterations = (argc > 2) ? std::strtoul(argv[2], nullptr, 10) : 3;
+
+    std::printf("generateTimeline, best of %zu\n", iterations);
+    if (paragraphs > 0)
+    {
+        benchmark(paragraphs, iterations);
+    }
+    else
+    {
+        for (int count : {1000, 5000, 10000, 20000})
+        {
+            benchmark(count, iterations);
+        }
+    }
+
+    std::printf("parse through SaxParser, best of %zu\n", iterations);
+    if (paragraphs > 0)
+    {
+        benchmarkParse(paragraphs, iterations);
+    }
+    else
+    {
+        for (int count : {1000, 5000, 10000, 20000})
+        {
+            benchmarkParse(count, iterations);
+        }
+    }
+
+    return 0;
+}
@@ -41,6 +41,9 @@ CPPUNIT_TEST_SUITE( DocumentInstanceTest );
     CPPUNIT_TEST(multiSpanRegionCase1);
     CPPUNIT_TEST(multiSpanRegionCase2);
     CPPUNIT_TEST(defaultWhitespaceHandling);
+    CPPUNIT_TEST(overlappingContent);
+    CPPUNIT_TEST(imageData);
+    CPPUNIT_TEST(sharedStyles);
 CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -127,7 +130,7 @@ public:
         auto textChunk = firstLine[0];
         CPPUNIT_ASSERT(textChunk.m_text == "text");
 
-        CPPUNIT_ASSERT(textChunk.m_style == StyleSet{});
+        CPPUNIT_ASSERT(*textChunk.m_style == StyleSet{});
     }
 
     void referredStyle()
@@ -168,8 +171,8 @@ public:
         auto textChunk = firstLine[0];
         CPPUNIT_ASSERT(textChunk.m_text == "text");
 
-        CPPUNIT_ASSERT(!(textChunk.m_style == StyleSet{}));
-        CPPUNIT_ASSERT(textChunk.m_style.getFontFamily() == std::string{testFontName});
+        CPPUNIT_ASSERT(!(*textChunk.m_style == StyleSet{}));
+        CPPUNIT_ASSERT(textChunk.m_style->getFontFamily() == std::string{testFontName});
     }
 
     void styleInheritanceFromParent()
@@ -208,11 +211,11 @@ public:
 
         auto firstChunk = firstLine[0];
         CPPUNIT_ASSERT(firstChunk.m_text == "div_text");
-        CPPUNIT_ASSERT(firstChunk.m_style.getTextAlign() == StyleSet::TextAlign::CENTER);
+        CPPUNIT_ASSERT(firstChunk.m_style->getTextAlign() == StyleSet::TextAlign::CENTER);
 
         auto secondChunk = firstLine[1];
         CPPUNIT_ASSERT(secondChunk.m_text == "p_text");
-        CPPUNIT_ASSERT(firstChunk.m_style.getTextAlign() == StyleSet::TextAlign::CENTER);
+        CPPUNIT_ASSERT(firstChunk.m_style->getTextAlign() == StyleSet::TextAlign::CENTER);
     }
 
     void styleInheritanceRegionOverStyle()
@@ -257,7 +260,7 @@ public:
         auto textChunk = firstLine[0];
         CPPUNIT_ASSERT(textChunk.m_text == "text");
 
-        CPPUNIT_ASSERT(textChunk.m_style.getTextAlign() == StyleSet::TextAlign::CENTER);
+        CPPUNIT_ASSERT(textChunk.m_style->getTextAlign() == StyleSet::TextAlign::CENTER);
     }
 
     void styleInheritanceRegionStyleOverStyle()
@@ -307,7 +310,7 @@ public:
         auto textChunk = firstLine[0];
         CPPUNIT_ASSERT(textChunk.m_text == "text");
 
-        CPPUNIT_ASSERT(textChunk.m_style.getTextAlign() == StyleSet::TextAlign::CENTER);
+        CPPUNIT_ASSERT(textChunk.m_style->getTextAlign() == StyleSet::TextAlign::CENTER);
     }
 
     void styleInheritanceRegionOverRegionStyle()
@@ -358,7 +361,7 @@ public:
         auto textChunk = firstLine[0];
         CPPUNIT_ASSERT(textChunk.m_text == "text");
 
-        CPPUNIT_ASSERT(textChunk.m_style.getTextAlign() == StyleSet::TextAlign::CENTER);
+        CPPUNIT_ASSERT(textChunk.m_style->getTextAlign() == StyleSet::TextAlign::CENTER);
     }
 
     void styleInheritanceElementOverRegion()
@@ -410,7 +413,7 @@ public:
       auto textChunk = firstLine[0];
       CPPUNIT_ASSERT(textChunk.m_text == "text");
 
-      CPPUNIT_ASSERT(textChunk.m_style.getTextAlign() == StyleSet::TextAlign::CENTER);
+      CPPUNIT_ASSERT(textChunk.m_style->getTextAlign() == StyleSet::TextAlign::CENTER);
     }
 
     /**
@@ -477,7 +480,7 @@ public:
 
         auto firstChunk = firstLine[0];
         CPPUNIT_ASSERT(firstChunk.m_text == "p_text");
-        CPPUNIT_ASSERT(firstChunk.m_style.getTextAlign() == StyleSet::TextAlign::CENTER);
+        CPPUNIT_ASSERT(firstChunk.m_style->getTextAlign() == StyleSet::TextAlign::CENTER);
     }
 
     /**
@@ -549,7 +552,7 @@ public:
 
         auto firstChunk = firstLine[0];
         CPPUNIT_ASSERT(firstChunk.m_text == "p_text");
-        CPPUNIT_ASSERT(firstChunk.m_style.getTextAlign() == StyleSet::TextAlign::CENTER);
+        CPPUNIT_ASSERT(firstChunk.m_style->getTextAlign() == StyleSet::TextAlign::CENTER);
     }
 
     /**
@@ -646,21 +649,21 @@ public:
 
         auto firstChunk = firstLine[0];
         CPPUNIT_ASSERT(firstChunk.m_text == "Span 1");
-        CPPUNIT_ASSERT(firstChunk.m_style.getTextAlign() == StyleSet::TextAlign::CENTER);
+        CPPUNIT_ASSERT(firstChunk.m_style->getTextAlign() == StyleSet::TextAlign::CENTER);
 
         auto secondLine = firstEntity.m_textLines[1];
         CPPUNIT_ASSERT(secondLine.size() == 1);
 
         auto secondChunk = secondLine[0];
         CPPUNIT_ASSERT(secondChunk.m_text == "-Span 2-");
-        CPPUNIT_ASSERT(secondChunk.m_style.getTextAlign() == StyleSet::TextAlign::CENTER);
+        CPPUNIT_ASSERT(secondChunk.m_style->getTextAlign() == StyleSet::TextAlign::CENTER);
 
         auto thirdLine = firstEntity.m_textLines[2];
         CPPUNIT_ASSERT(thirdLine.size() == 1);
 
         auto thirdChunk = thirdLine[0];
         CPPUNIT_ASSERT(thirdChunk.m_text == "--Span 3--");
-        CPPUNIT_ASSERT(thirdChunk.m_style.getTextAlign() == StyleSet::TextAlign::CENTER);
+        CPPUNIT_ASSERT(thirdChunk.m_style->getTextAlign() == StyleSet::TextAlign::CENTER);
     }
 
     /**
@@ -749,15 +752,15 @@ public:
 
         auto firstChunk = firstLine[0];
         CPPUNIT_ASSERT(firstChunk.m_text == "Span 1");
-        CPPUNIT_ASSERT(firstChunk.m_style.getTextAlign() == StyleSet::TextAlign::CENTER);
+        CPPUNIT_ASSERT(firstChunk.m_style->getTextAlign() == StyleSet::TextAlign::CENTER);
 
         auto secondChunk = firstLine[1];
         CPPUNIT_ASSERT(secondChunk.m_text == "-Span 2-");
-        CPPUNIT_ASSERT(secondChunk.m_style.getTextAlign() == StyleSet::TextAlign::CENTER);
+        CPPUNIT_ASSERT(secondChunk.m_style->getTextAlign() == StyleSet::TextAlign::CENTER);
 
         auto thirdChunk = firstLine[2];
         CPPUNIT_ASSERT(thirdChunk.m_text == "--Span 3--");
-        CPPUNIT_ASSERT(thirdChunk.m_style.getTextAlign() == StyleSet::TextAlign::CENTER);
+        CPPUNIT_ASSERT(thirdChunk.m_style->getTextAlign() == StyleSet::TextAlign::CENTER);
     }
 
     void styleInheritanceOverrideOverElement()
@@ -814,8 +817,8 @@ public:
       auto textChunk = firstLine[0];
       CPPUNIT_ASSERT(textChunk.m_text == "text");
 
-      CPPUNIT_ASSERT(textChunk.m_style.getTextAlign() == StyleSet::TextAlign::LEFT);
-      CPPUNIT_ASSERT(subttxrend::gfx::ColorArgb::BLUE == textChunk.m_style.getColor());
+      CPPUNIT_ASSERT(textChunk.m_style->getTextAlign() == StyleSet::TextAlign::LEFT);
+      CPPUNIT_ASSERT(subttxrend::gfx::ColorArgb::BLUE == textChunk.m_style->getColor());
     }
 
     void defaultWhitespaceHandling()
@@ -885,6 +888,183 @@ public:
       CPPUNIT_ASSERT(fifthChunk.m_text == "456");
     }
 
+    void overlappingContent()
+    {
+        DocumentInstance doc{};
+
+        doc.startElement("tt");
+
+        auto region = doc.startElement("region");
+        region->parseAttribute("xml", "id", "bottom");
+        region->parseAttribute("tts", "origin", "10% 80%");
+        doc.endElement(); // region
+
+        doc.startElement("body");
+
+        // p1: 0-6s, p2: 2-4s (in region), p3: 4-8s, p4: 9-10s, p5: 5-5s (empty period)
+        const char* timings[][2] = {
+            {"00:00:00.000", "00:00:06.000"},
+            {"00:00:02.000", "00:00:04.000"},
+            {"00:00:04.000", "00:00:08.000"},
+            {"00:00:09.000", "00:00:10.000"},
+            {"00:00:05.000", "00:00:05.000"},
+        };
+        for (int i = 0; i < 5; ++i)
+        {
+            auto pElem = doc.startElement("p");
+            pElem->parseAttribute("", "begin", timings[i][0]);
+            pElem->parseAttribute("", "end", timings[i][1]);
+            if (i == 1)
+            {
+                pElem->parseAttribute("", "region", "bottom");
+            }
+            pElem->appendText("p" + std::to_string(i + 1));
+            doc.endElement(); // p
+        }
+
+        doc.endElement(); // body
+        doc.endElement(); // tt
+
+        auto timeline = doc.generateTimeline();
+
+        // periods: 0-2 p1, 2-4 p1 + p2, 4-5 and 5-6 p1 + p3, 6-8 p3, 9-10 p4 (nothing in 8-9)
+        const std::vector<std::vector<std::string>> expectedTexts = {
+            {"p1"}, {"p1", "p2"}, {"p1", "p3"}, {"p1", "p3"}, {"p3"}, {"p4"}};
+        const std::uint64_t expectedStarts[] = {0, 2000, 4000, 5000, 6000, 9000};
+
+        CPPUNIT_ASSERT_EQUAL(expectedTexts.size(), timeline.size());
+
+        std::size_t index = 0;
+        for (const auto& document : timeline)
+        {
+            CPPUNIT_ASSERT(document.m_timing.getStartTimeRef() == TimePoint(expectedStarts[index]));
+
+            std::vector<std::string> texts;
+            for (const auto& entity : document.m_entites)
+            {
+                for (const auto& line : entity.m_textLines)
+                {
+                    for (const auto& chunk : line)
+                    {
+                        texts.push_back(chunk.m_text);
+                    }
+                }
+            }
+            CPPUNIT_ASSERT(texts == expectedTexts[index]);
+            ++index;
+        }
+
+        // p2 has its own region, so it is a separate entity
+        auto second = std::next(timeline.begin());
+        CPPUNIT_ASSERT_EQUAL(std::size_t(2), second->m_entites.size());
+        CPPUNIT_ASSERT(second->m_entites[1].m_region->getId() == "bottom");
+    }
+
+    void imageData()
+    {
+        DocumentInstance doc{};
+
+        doc.startElement("tt");
+
+        // base64 text comes in chunks split anywhere, with whitespace
+        auto image = doc.startElement("image");
+        image->parseAttribute("xml", "id", "img1");
+        image->appendText("\n    iVBO");
+        image->appendText("Rw0K\n    G");
+        image->appendText("go=\n");
+        doc.endElement(); // image
+
+        auto sameImage = doc.startElement("image");
+        sameImage->parseAttribute("xml", "id", "img2");
+        sameImage->appendText("iVBORw0KGgo=");
+        doc.endElement(); // image
+
+        auto otherImage = doc.startElement("image");
+        otherImage->parseAttribute("xml", "id", "img3");
+        otherImage->appendText("iVBORw0KGho=");
+        doc.endElement(); // image
+
+        doc.startElement("body");
+        auto div = doc.startElement("div");
+        div->parseAttribute("", "begin", "00:00:01.000");
+        div->parseAttribute("", "end", "00:00:02.000");
+        div->parseAttribute("smpte", "backgroundImage", "#img1");
+        doc.endElement(); // div
+        doc.endElement(); // body
+        doc.endElement(); // tt
+
+        auto timeline = doc.generateTimeline();
+
+        CPPUNIT_ASSERT_EQUAL(std::size_t(1), timeline.size());
+        CPPUNIT_ASSERT_EQUAL(std::size_t(1), timeline.front().m_entites.size());
+
+        auto const& chunk = timeline.front().m_entites.front().m_imageChunk;
+        CPPUNIT_ASSERT(chunk.m_image);
+        CPPUNIT_ASSERT_EQUAL(std::string("img1"), chunk.m_image->getId());
+
+        // png signature
+        const std::vector<std::uint8_t> expected = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+        CPPUNIT_ASSERT(*chunk.m_image->getImageData() == expected);
+
+        // hash computed once the image element ends
+        auto hash = [](const std::shared_ptr<Element>& element)
+        {
+            return std::static_pointer_cast<ImageElement>(element)->getImageDataHash();
+        };
+        CPPUNIT_ASSERT_EQUAL(hash(image), chunk.m_image->getImageDataHash());
+        CPPUNIT_ASSERT_EQUAL(hash(image), hash(sameImage));
+        CPPUNIT_ASSERT(hash(image) != hash(otherImage));
+    }
+
+    void sharedStyles()
+    {
+        DocumentInstance doc{};
+
+        doc.startElement("tt");
+
+        auto style = doc.startElement("style");
+        style->parseAttribute("xml", "id", "s1");
+        style->parseAttribute("tts", "color", "yellow");
+        doc.endElement(); // style
+
+        doc.startElement("body");
+        doc.startElement("div");
+
+        for (int i = 0; i < 2; ++i)
+        {
+            auto pElem = doc.startElement("p");
+            pElem->parseAttribute("", "begin", i ? "00:00:02.000" : "00:00:01.000");
+            pElem->parseAttribute("", "end", i ? "00:00:03.000" : "00:00:02.000");
+            pElem->parseAttribute("", "style", "s1");
+
+            auto span1 = doc.startElement("span");
+            span1->appendText("first");
+            doc.endElement(); // span
+
+            auto span2 = doc.startElement("span");
+            span2->parseAttribute("tts", "color", "#ffff00");
+            span2->appendText("second");
+            doc.endElement(); // span
+
+            doc.endElement(); // p
+        }
+
+        doc.endElement(); // div
+        doc.endElement(); // body
+        doc.endElement(); // tt
+
+        auto timeline = doc.generateTimeline();
+        CPPUNIT_ASSERT_EQUAL(std::size_t(2), timeline.size());
+
+        // chunks with the same style values share one style set, also between documents
+        auto const& firstLine = timeline.front().m_entites.at(0).m_textLines.at(0);
+        auto const& secondLine = std::next(timeline.begin())->m_entites.at(0).m_textLines.at(0);
+        CPPUNIT_ASSERT_EQUAL(std::size_t(2), firstLine.size());
+        CPPUNIT_ASSERT(firstLine[0].m_style->getColor() == subttxrend::gfx::ColorArgb::YELLOW);
+        CPPUNIT_ASSERT(firstLine[0].m_style == firstLine[1].m_style);
+        CPPUNIT_ASSERT(firstLine[0].m_style == secondLine[0].m_style);
+    }
+
 };
 
 // Registers the fixture into the 'registry'
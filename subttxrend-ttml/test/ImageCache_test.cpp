@@ -0,0 +1,180 @@
+/*****************************************************************************
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:
+*
+* Copyright 2021 Liberty Global Service B.V.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*****************************************************************************/
+
+#include <cppunit/extensions/HelperMacros.h>
+#include "ImageCache.hpp"
+
+#include <functional>
+#include <string>
+
+using namespace subttxrend::ttmlengine;
+using subttxrend::gfx::Bitmap;
+
+class ImageCacheTest : public CppUnit::TestFixture
+{
+CPPUNIT_TEST_SUITE( ImageCacheTest );
+    CPPUNIT_TEST(hitAndMiss);
+    CPPUNIT_TEST(sameIdDifferentData);
+    CPPUNIT_TEST(sameDataDifferentId);
+    CPPUNIT_TEST(lruEviction);
+    CPPUNIT_TEST(budgetChange);
+    CPPUNIT_TEST(tooLargeNotStored);
+CPPUNIT_TEST_SUITE_END();
+
+public:
+    void setUp()
+    {
+        // noop
+    }
+
+    void tearDown()
+    {
+        // noop
+    }
+
+    void hitAndMiss()
+    {
+        ImageCache cache;
+
+        CPPUNIT_ASSERT(!cache.find("img1", hash("AAAA")));
+
+        auto bitmap = makeBitmap(10, 10);
+        cache.insert("img1", hash("AAAA"), bitmap);
+
+        CPPUNIT_ASSERT(cache.find("img1", hash("AAAA")) == bitmap);
+        CPPUNIT_ASSERT(!cache.find("img2", hash("AAAA")));
+
+        auto stats = cache.getStatistics();
+        CPPUNIT_ASSERT_EQUAL(std::size_t(1), stats.m_hits);
+        CPPUNIT_ASSERT_EQUAL(std::size_t(2), stats.m_misses);
+        CPPUNIT_ASSERT_EQUAL(std::size_t(0), stats.m_evictions);
+        CPPUNIT_ASSERT_EQUAL(std::size_t(1), stats.m_entries);
+        CPPUNIT_ASSERT(stats.m_usedBytes >= bitmap->m_buffer.size());
+
+        cache.clear();
+        CPPUNIT_ASSERT(!cache.find("img1", hash("AAAA")));
+        CPPUNIT_ASSERT_EQUAL(std::size_t(0), cache.getStatistics().m_usedBytes);
+    }
+
+    void sameIdDifferentData()
+    {
+        ImageCache cache;
+
+        auto bitmap1 = makeBitmap(10, 10);
+        auto bitmap2 = makeBitmap(10, 10);
+        cache.insert("img", hash("AAAA"), bitmap1);
+        cache.insert("img", hash("BBBB"), bitmap2);
+
+        CPPUNIT_ASSERT(cache.find("img", hash("AAAA")) == bitmap1);
+        CPPUNIT_ASSERT(cache.find("img", hash("BBBB")) == bitmap2);
+        CPPUNIT_ASSERT(!cache.find("img", hash("CCCC")));
+    }
+
+    void sameDataDifferentId()
+    {
+        auto bitmap1 = makeBitmap(100, 100);
+        auto bitmap2 = makeBitmap(100, 100);
+
+        // room for one bitmap only
+        ImageCache cache(bitmap1->m_buffer.size() + 1024);
+
+        cache.insert("img1", hash("AAAA"), bitmap1);
+        CPPUNIT_ASSERT(!cache.find("img2", hash("AAAA")));
+
+        cache.insert("img2", hash("AAAA"), bitmap2);
+        CPPUNIT_ASSERT(!cache.find("img1", hash("AAAA")));
+        CPPUNIT_ASSERT(cache.find("img2", hash("AAAA")) == bitmap2);
+
+        auto stats = cache.getStatistics();
+        CPPUNIT_ASSERT_EQUAL(std::size_t(1), stats.m_evictions);
+        CPPUNIT_ASSERT_EQUAL(std::size_t(1), stats.m_entries);
+    }
+
+    void lruEviction()
+    {
+        auto bitmap1 = makeBitmap(100, 100);
+        auto bitmap2 = makeBitmap(100, 100);
+        auto bitmap3 = makeBitmap(100, 100);
+
+        // room for two bitmaps only
+        ImageCache cache(2 * bitmap1->m_buffer.size() + 1024);
+
+        cache.insert("img1", hash("1"), bitmap1);
+        cache.insert("img2", hash("2"), bitmap2);
+
+        // make img1 most recently used
+        CPPUNIT_ASSERT(cache.find("img1", hash("1")));
+
+        cache.insert("img3", hash("3"), bitmap3);
+
+        CPPUNIT_ASSERT(cache.find("img1", hash("1")) == bitmap1);
+        CPPUNIT_ASSERT(!cache.find("img2", hash("2")));
+        CPPUNIT_ASSERT(cache.find("img3", hash("3")) == bitmap3);
+
+        auto stats = cache.getStatistics();
+        CPPUNIT_ASSERT_EQUAL(std::size_t(1), stats.m_evictions);
+        CPPUNIT_ASSERT_EQUAL(std::size_t(2), stats.m_entries);
+    }
+
+    void budgetChange()
+    {
+        ImageCache cache;
+
+        cache.insert("img1", hash("1"), makeBitmap(100, 100));
+        cache.insert("img2", hash("2"), makeBitmap(100, 100));
+
+        cache.setByteBudget(0);
+
+        auto stats = cache.getStatistics();
+        CPPUNIT_ASSERT_EQUAL(std::size_t(2), stats.m_evictions);
+        CPPUNIT_ASSERT_EQUAL(std::size_t(0), stats.m_entries);
+        CPPUNIT_ASSERT_EQUAL(std::size_t(0), stats.m_usedBytes);
+
+        // caching disabled
+        cache.insert("img1", hash("1"), makeBitmap(1, 1));
+        CPPUNIT_ASSERT(!cache.find("img1", hash("1")));
+    }
+
+    void tooLargeNotStored()
+    {
+        ImageCache cache(1024);
+
+        auto small = makeBitmap(4, 4);
+        cache.insert("small", hash("S"), small);
+        cache.insert("large", hash("L"), makeBitmap(100, 100));
+
+        CPPUNIT_ASSERT(cache.find("small", hash("S")) == small);
+        CPPUNIT_ASSERT(!cache.find("large", hash("L")));
+        CPPUNIT_ASSERT_EQUAL(std::size_t(0), cache.getStatistics().m_evictions);
+    }
+
+private:
+    static std::size_t hash(const std::string& text)
+    {
+        return std::hash<std::string>()(text);
+    }
+
+    static std::shared_ptr<Bitmap> makeBitmap(std::int32_t width,
+                                              std::int32_t height)
+    {
+        return std::make_shared<Bitmap>(width, height, width * 4);
+    }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION( ImageCacheTest );
@@ -29,6 +29,7 @@ class StyleSetTest : public CppUnit::TestFixture
 CPPUNIT_TEST_SUITE( StyleSetTest );
     CPPUNIT_TEST(checkDefaults);
     CPPUNIT_TEST(merging);
+    CPPUNIT_TEST(pooling);
 CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -161,6 +162,39 @@ public:
         CPPUNIT_ASSERT((styleSet.getOutline() == outline));
     }
 
+    void pooling()
+    {
+        StyleSetPool pool;
+
+        Attributes white = {
+                {"color", "white"},
+                {"fontSize", "50%"},
+        };
+        Attributes whiteRgb = {
+                {"color", "#ffffff"},
+                {"fontSize", "50%"},
+        };
+        Attributes yellow = {
+                {"color", "yellow"},
+        };
+
+        auto first = pool.get("s1", white);
+        CPPUNIT_ASSERT(first->getStyleId() == "s1");
+        CPPUNIT_ASSERT((first->getFontSize() == DomainValue{DomainValue::Type::PERCENTAGE_HUNDREDTHS, 5000}));
+
+        CPPUNIT_ASSERT(pool.get("s1", white) == first);
+        CPPUNIT_ASSERT(pool.get("s1", whiteRgb) == first);
+        CPPUNIT_ASSERT(pool.get("s2", white) != first);
+        CPPUNIT_ASSERT(pool.get("s1", yellow) != first);
+        CPPUNIT_ASSERT_EQUAL(std::size_t{3}, pool.size());
+
+        pool.clear();
+        CPPUNIT_ASSERT_EQUAL(std::size_t{0}, pool.size());
+        CPPUNIT_ASSERT(first->getColor() == subttxrend::gfx::ColorArgb::WHITE);
+        CPPUNIT_ASSERT(pool.get("s1", white) != first);
+        CPPUNIT_ASSERT(*pool.get("s1", white) == *first);
+    }
+
 };
 
 // Registers the fixture into the 'registry'
@@ -0,0 +1,211 @@
+/*****************************************************************************
+* If not stated otherwise in this file or this component's LICENSE file the
+* following copyright and licenses apply:
+*
+* Copyright 2021 Liberty Global Service B.V.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*****************************************************************************/
+
+#include <cppunit/extensions/HelperMacros.h>
+#include "Parser/XmlLibSaxParserWrapper.hpp"
+
+#include <string>
+#include <vector>
+
+using namespace subttxrend::ttmlengine;
+
+namespace
+{
+
+/** Callbacks keeping copies of what they received. */
+class RecordingCallbacks : public SaxCallbacks
+{
+public:
+    struct Element
+    {
+        std::string localname;
+        std::string prefix;
+        std::string URI;
+        std::vector<std::vector<std::string>> attributes;
+
+        /** Address of the name string passed, interned names are shared. */
+        const std::string* localnamePtr;
+    };
+
+    virtual void onStartDocument() override
+    {
+        ++m_documents;
+    }
+
+    virtual void onEndDocument() override
+    {
+        // noop
+    }
+
+    virtual void onStartElementNs(const std::string& localname,
+                                  const std::string& prefix,
+                                  const std::string& URI,
+                                  const std::vector<Attribute>& attributes) override
+    {
+        Element element{localname, prefix, URI, {}, &localname};
+        for (const auto& attribute : attributes)
+        {
+            element.attributes.push_back({attribute.prefix, attribute.name, attribute.value});
+        }
+        m_elements.push_back(element);
+    }
+
+    virtual void onEndElementNs(const std::string& localname,
+                                const std::string&,
+                                const std::string&) override
+    {
+        m_ended.push_back(localname);
+    }
+
+    virtual void onError(const char*,
+                         ...) override
+    {
+        // noop
+    }
+
+    virtual void onWarning(const char*,
+                           ...) override
+    {
+        // noop
+    }
+
+    virtual void onCharacters(const std::string& content) override
+    {
+        m_characters += content;
+    }
+
+    int m_documents{0};
+    std::vector<Element> m_elements;
+    std::vector<std::string> m_ended;
+    std::string m_characters;
+};
+
+} // namespace anonymous
+
+class XmlLibSaxParserWrapperTest : public CppUnit::TestFixture
+{
+CPPUNIT_TEST_SUITE( XmlLibSaxParserWrapperTest );
+    CPPUNIT_TEST(attributes);
+    CPPUNIT_TEST(internedNames);
+    CPPUNIT_TEST(reuseAfterReset);
+CPPUNIT_TEST_SUITE_END();
+
+public:
+    void setUp()
+    {
+        // noop
+    }
+
+    void tearDown()
+    {
+        // noop
+    }
+
+    void attributes()
+    {
+        RecordingCallbacks callbacks;
+        SaxParser parser(callbacks);
+
+        parse(parser, "<tt xmlns=\"http://www.w3.org/ns/ttml\" xmlns:tts=\"http://www.w3.org/ns/ttml#styling\" xml:lang=\"en\">"
+                      "<p begin=\"00:00:01.000\" tts:color=\"red\" end=\"2s\">text &amp; more</p>"
+                      "<br/>"
+                      "</tt>");
+
+        CPPUNIT_ASSERT_EQUAL(1, callbacks.m_documents);
+        CPPUNIT_ASSERT_EQUAL(std::size_t(3), callbacks.m_elements.size());
+
+        // namespace declarations are not attributes
+        const auto& tt = callbacks.m_elements[0];
+        CPPUNIT_ASSERT_EQUAL(std::string("tt"), tt.localname);
+        CPPUNIT_ASSERT_EQUAL(std::string(""), tt.prefix);
+        CPPUNIT_ASSERT_EQUAL(std::string("http://www.w3.org/ns/ttml"), tt.URI);
+        CPPUNIT_ASSERT_EQUAL(std::size_t(1), tt.attributes.size());
+        checkAttribute(tt.attributes[0], "xml", "lang", "en");
+
+        const auto& p = callbacks.m_elements[1];
+        CPPUNIT_ASSERT_EQUAL(std::string("p"), p.localname);
+        CPPUNIT_ASSERT_EQUAL(std::size_t(3), p.attributes.size());
+        checkAttribute(p.attributes[0], "", "begin", "00:00:01.000");
+        checkAttribute(p.attributes[1], "tts", "color", "red");
+        checkAttribute(p.attributes[2], "", "end", "2s");
+
+        const auto& br = callbacks.m_elements[2];
+        CPPUNIT_ASSERT_EQUAL(std::string("br"), br.localname);
+        CPPUNIT_ASSERT(br.attributes.empty());
+
+        CPPUNIT_ASSERT_EQUAL(std::string("text & more"), callbacks.m_characters);
+
+        const std::vector<std::string> ended{"p", "br", "tt"};
+        CPPUNIT_ASSERT(callbacks.m_ended == ended);
+    }
+
+    void internedNames()
+    {
+        RecordingCallbacks callbacks;
+        SaxParser parser(callbacks);
+
+        parse(parser, "<tt><p/><span/><p/></tt>");
+
+        CPPUNIT_ASSERT_EQUAL(std::size_t(4), callbacks.m_elements.size());
+        CPPUNIT_ASSERT(callbacks.m_elements[1].localnamePtr == callbacks.m_elements[3].localnamePtr);
+        CPPUNIT_ASSERT(callbacks.m_elements[1].localnamePtr != callbacks.m_elements[2].localnamePtr);
+    }
+
+    void reuseAfterReset()
+    {
+        RecordingCallbacks callbacks;
+        SaxParser parser(callbacks);
+
+        parse(parser, "<tt><p a=\"1\" b=\"22\" c=\"333\"/></tt>");
+        parser.reset();
+
+        // fewer attributes than before, no leftovers of the previous element
+        parse(parser, "<tt><p d=\"4\"/></tt>");
+
+        CPPUNIT_ASSERT_EQUAL(2, callbacks.m_documents);
+        CPPUNIT_ASSERT_EQUAL(std::size_t(4), callbacks.m_elements.size());
+        CPPUNIT_ASSERT_EQUAL(std::size_t(3), callbacks.m_elements[1].attributes.size());
+        checkAttribute(callbacks.m_elements[1].attributes[2], "", "c", "333");
+
+        const auto& p = callbacks.m_elements[3];
+        CPPUNIT_ASSERT_EQUAL(std::size_t(1), p.attributes.size());
+        checkAttribute(p.attributes[0], "", "d", "4");
+    }
+
+private:
+    static void parse(SaxParser& parser,
+                      const std::string& text)
+    {
+        parser.parse(reinterpret_cast<const std::uint8_t*>(text.data()), text.size());
+    }
+
+    static void checkAttribute(const std::vector<std::string>& attribute,
+                               const std::string& prefix,
+                               const std::string& name,
+                               const std::string& value)
+    {
+        CPPUNIT_ASSERT_EQUAL(std::size_t(3), attribute.size());
+        CPPUNIT_ASSERT_EQUAL(prefix, attribute[0]);
+        CPPUNIT_ASSERT_EQUAL(name, attribute[1]);
+        CPPUNIT_ASSERT_EQUAL(value, attribute[2]);
+    }
+};
+
+// Registers the fixture into the 'registry'
+CPPUNIT_TEST_SUITE_REGISTRATION( XmlLibSaxParserWrapperTest );
@@ -28,6 +28,11 @@
 
 namespace subttxrend
 {
+namespace gfx
+{
+class PrerenderedFontCache;
+}
+
 namespace webvttengine
 {
 
@@ -54,9 +59,12 @@ public:
      *      Configuration.
      * @param gfxWindow
      *      Window to draw.
+     * @param fontCache
+     *      Font cache to use (shared with other engines).
      */
     virtual void init(const common::ConfigProvider* configProvider,
-                      std::weak_ptr<gfx::Window> gfxWindow) = 0;
+                      std::weak_ptr<gfx::Window> gfxWindow,
+                      std::shared_ptr<gfx::PrerenderedFontCache> fontCache) = 0;
 
     /**
      * Notifies size of related video content. Used for position and size calculations.
@@ -120,6 +128,13 @@ public:
     virtual void addData(const std::uint8_t* buffer,
                  std::size_t dataSize, std::int64_t displayOffsetMs) = 0;
 
+    /**
+     * Returns wait time to next process() call.
+     *
+     * @return
+     *      Time to wait before next call to process(). std::chrono::milliseconds::zero()
+     *      for unknown time - when there is no data queued or in paused state.
+     */
     virtual std::chrono::milliseconds getWaitTime() const = 0;
 
     /**
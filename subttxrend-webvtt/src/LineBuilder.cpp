@@ -18,7 +18,6 @@
 */
 #include <algorithm>
 #include <unordered_map>
-#include <map>
 
 #include <subttxrend/gfx/Types.hpp>
 
@@ -93,291 +92,6 @@ LineList splitLinesByScreenWidth(const Line& tokens, int maxWidthPx) {
     return lines;
 }
 
-gfx::ColorArgb getTextColourFromMap(std::string textColour) {
-    static const std::map<std::string, gfx::ColorArgb> textmap {
-        { "white", Style::kWhite },
-        { "lime", Style::kLime },
-        { "cyan", Style::kCyan },
-        { "red", Style::kRed },
-        { "yellow", Style::kYellow },
-        { "magenta", Style::kMagenta },
-        { "blue", Style::kBlue },
-        { "black", Style::kBlack },
-    };
-
-    if (textmap.count(textColour)) {
-        return textmap.at(textColour);
-    } else {
-        g_logger.info("Style %s not found - returning WHITE", textColour.c_str());
-        return Style::kWhite;
-    }
-}
-
-gfx::ColorArgb getBgColourFromMap(std::string bgColour) {
-    static const std::map<std::string, gfx::ColorArgb> textmap {
-        { "bg_white", Style::kWhite },
-        { "bg_lime", Style::kLime },
-        { "bg_cyan", Style::kCyan },
-        { "bg_red", Style::kRed },
-        { "bg_yellow", Style::kYellow },
-        { "bg_magenta", Style::kMagenta },
-        { "bg_blue", Style::kBlue },
-        { "bg_black", Style::kBlack },
-    };
-
-    if (textmap.count(bgColour)) {
-        return textmap.at(bgColour);
-    } else {
-        g_logger.info("Style %s not found - returning BLACK", bgColour.c_str());
-        return Style::kBlack;
-    }
-}
-
-/**
- * @brief Colour tags can be eg: <c.lime.cyan.bg_white.bg_yellow> and last in the list
- *        takes precedence, so the above would be cyan on a yellow background
- *
- * @param styleString
- * @param style
- * @return Style
- */
-Style addColourToStyle(const std::string& styleString, Style style) {
-    std::istringstream iss(styleString);
-    std::string colourClass;
-    gfx::ColorArgb colour;
-
-    while (std::getline(iss, colourClass, '.')) {
-        if (colourClass == "c")
-            continue;
-
-        if (colourClass.find("bg_") != std::string::npos)
-            style.bgColour(getBgColourFromMap(colourClass));
-        else
-            style.textColour(getTextColourFromMap(colourClass));
-    }
-
-    return style;
-}
-
-Style getStyleFromMap(std::string styleString) {
-    static const std::map<std::string, Style> styleMap {
-        { "i", { Style::kDefaultFontFamilyString, Style::FontStyleType::kItalic, Style::kDefaultTextColour, Style::kDefaultBgColour } },
-        { "b", { Style::kDefaultFontFamilyString, Style::FontStyleType::kBold, Style::kDefaultTextColour, Style::kDefaultBgColour } },
-        { "u", { Style::kDefaultFontFamilyString, Style::FontStyleType::kUnderline, Style::kDefaultTextColour, Style::kDefaultBgColour } },
-    };
-
-    if (styleMap.count(styleString)) {
-        return styleMap.at(styleString);
-    } else {
-        g_logger.trace("Style %s not found - returning default", styleString.c_str());
-        return Style {};
-    }
-}
-
-/**
- * @brief Add Style to and existing Style object
- *
- * @param styleString Style to add
- * @param style reference
- */
-void addStyle(const std::string& styleString, Style &style) {
-    g_logger.ostrace(__LOGGER_FUNC__, " - stylestring ", styleString);
-    if (styleString.empty()) {
-        return;
-    }
-
-    switch (styleString[0]) {
-    case 'i':
-        style.fontStyle(Style::FontStyleType::kItalic);
-        break;
-    case 'b':
-        style.fontStyle(Style::FontStyleType::kBold);
-        break;
-    case 'u':
-        style.fontStyle(Style::FontStyleType::kUnderline);
-        break;
-    case 'c':
-        style = addColourToStyle(styleString, style);
-        break;
-    default:
-        g_logger.info("Unsupported style class");
-        break;
-    }
-}
-
-/**
- * @brief Regex-ish method to parse a tag and move the index to one after the end tag
- *
- * @param search
- * @param tag
- * @return std::size_t One after the end tag
- */
-std::size_t getTagAndRemainder(std::string search, std::string& tag) {
-    std::istringstream iss(search);
-    std::string remainder;
-    std::size_t index = search.find('>');
-
-    if (index != std::string::npos) {
-        tag = search.substr(0, index);
-        remainder = search.substr(index + 1);
-        g_logger.ostrace(__LOGGER_FUNC__, " - tag:", tag, " remainder:", remainder);
-        return index + 1;
-    }
-    return 0;
-}
-
-static void findAndReplace(std::string &in_string, const std::string &findString, const std::string &replaceString) {
-    std::size_t pos = 0;
-    
-    while ((pos = in_string.find(findString, pos)) != std::string::npos) {
-        in_string.replace(pos, (int)findString.length(), replaceString);
-        pos += replaceString.length();
-    }
-}
-
-/**
- * @brief Replace escaped unicode chars <, >, &, ", ' in the string
- * 
- * @param editString 
- */
-static void replaceEscapedCharacters(std::string &editString) {
-    std::map<std::string, std::string> findReplace {
-        {"&lt;", "<"}, {"&gt;", ">"}, {"&amp;", "&"}, {"&quot;", "\""}, {"&apos;", "\'"}
-    };
-
-    std::for_each(findReplace.begin(), findReplace.end(),
-                    [&editString](const std::pair<std::string, std::string> item) {
-                        findAndReplace(editString, item.first, item.second);
-                    });
-}
-
-/**
- * @brief Recursive method to parse an HTML-formatted string (ie one<b>two<i>three</i>four</b>)
- * Handles simple classes only - i, b, u, c.textColour
- * As it unwinds, it creates Result objects with a text string and a Style object.  Also replaces
- * escaped characters in the text string (&lt;, &gt; etc)
- * 
- * @param search 
- * @param results 
- * @param style_list 
- * @return std::string 
- */
-std::string searchTag(const std::string& search, std::vector<Result>& results, std::list<std::string>& styleList) {
-    std::string prefix, suffix, tag;
-    std::list<std::string> localList;
-    Result result;
-    Style style;
-    std::size_t index = search.find('<');
-    prefix = search.substr(0, index);
-
-    try {
-        if (index != std::string::npos) {
-            index++;
-            bool close_tag = (search[index] == '/');
-            if (close_tag) index++;
-
-            index += getTagAndRemainder(search.substr(index), tag);
-            suffix = search.substr(index);
-
-            if (!close_tag)
-                styleList.push_back(tag);
-            else
-                styleList.remove(tag);
-
-            g_logger.osdebug(__LOGGER_FUNC__, " - prefix:", prefix,
-                                              " suffix:", suffix,
-                                              " tag:", tag,
-                                              " close_tag:", close_tag,
-                                              " local_list.size:", localList.size(),
-                                              " styleList.size:", styleList.size());
-
-            localList = styleList;
-            result.text = searchTag(suffix, results, styleList);
-
-            for (const auto& styleString : localList)
-                addStyle(styleString, style);
-
-            result.style = std::move(style);
-            if (!result.text.empty()) {
-                g_logger.osdebug(__LOGGER_FUNC__, " - push_back t:", result.text, " s:", result.style.getStyleName());
-                results.push_back(std::move(result));
-            }
-        }
-        // I know - I want to ensure that the caller has the opportunity to
-        //always return something
-    }
-    catch (...) {
-        throw ParserException("Error in recursive function for " + search);
-    }
-
-    replaceEscapedCharacters(prefix);
-
-    return prefix;
-}
-
-/**
- * @brief Just strip the tags from str without attempting to parse them
- * 
- * @param str 
- */
-void stripHtmlTags(std::string& str) {
-    size_t startpos = std::string::npos, endpos = std::string::npos;
-
-    do {
-        startpos = str.find_first_of('<');
-        if (startpos != std::string::npos) {
-            endpos = str.find_first_of('>');
-            if (endpos != std::string::npos) {
-                str.erase(startpos, endpos - startpos + 1);
-                continue;
-            }
-        }
-        break;
-    } while (true);
-}
-
-/**
- * @brief Calls the searchTag recursive method to parse all the styles from
- * a formatted string.  If there are errors it will just return a simple string
- * with the tags stripped.
- * 
- * @param line 
- * @return std::vector<Result> 
- */
-std::vector<Result> parseStyles(const std::string &line) {
-    std::string search, res;
-    std::vector<Result> results;
-    Result result;
-
-    try {
-        std::list<std::string> styleList{};
-        result.style = Style{};
-        result.text = searchTag(line, results, styleList);
-        if (!result.text.empty()) {
-            if (styleList.size() > 0) {
-                for (const auto& styleString : styleList)
-                    addStyle(styleString, result.style);
-            }
-            results.push_back(std::move(result));
-        }
-
-        std::reverse(results.begin(), results.end());
-
-        for(const auto &res : results) {
-            g_logger.ostrace(__LOGGER_FUNC__, " - text:", res.text, " style:", res.style.getFontStyle());
-        }
-    }
-    catch (const ParserException& e) {
-        results.clear();
-        std::string stripped = line;
-        stripHtmlTags(stripped);
-        results.emplace_back(Result{std::move(stripped), Style{}});
-        g_logger.info("Badly formed tags in %s", line.c_str());
-    }
-    
-    return results;
-}
-
 /**
  * @brief Special case - all boxes are off the screen so we need to switch the adjustment direction
  * 
@@ -464,7 +178,7 @@ gfx::ColorArgb setOpacity(gfx::ColorArgb color, WebVTTAttributes::Opacity opacit
  * @param line 
  * @return WebVTTDraw::Line 
  */
-Line LineBuilder::buildTokensForLine(const std::vector<Result> &lineSegments) {
+Line LineBuilder::buildTokensForLine(const std::vector<CueTextSpan> &lineSegments) {
     Line currentLineTokens;
     auto lineWidthPx = 0;
     
@@ -475,7 +189,7 @@ Line LineBuilder::buildTokensForLine(const std::vector<Result> &lineSegments) {
         auto fontname = m_fontFamily + " " + style.getFontStyle();
         auto fontSize = m_converter.fontSizePixels();
         auto font = getFont(std::move(fontname), fontSize);
-        for (const auto &token : font->textToTokens(lineSegment.text)) {
+        for (const auto &token : font->textToTokens(lineSegment.text.str())) {
             auto tokenWidth = static_cast<int>(token.totalAdvanceX);
             g_logger.osdebug(__LOGGER_FUNC__, " - token width:", tokenWidth);
             chunkTokens.emplace_back(Token {
@@ -510,7 +224,7 @@ Line LineBuilder::buildTokensForLine(const std::vector<Result> &lineSegments) {
 std::list<Line> LineBuilder::buildLines(const std::vector<std::string> line_strings, int maxLineSize) {
     std::list<Line> lines;
     for (const auto &cue_line : line_strings) {
-        auto lineSegments = parseStyles(cue_line);
+        const auto& lineSegments = m_cueTextTokenizer.tokenize(cue_line);
         auto fullLine = buildTokensForLine(lineSegments);
         
         g_logger.osdebug(__LOGGER_FUNC__, " lineWidth:", fullLine.lineWidth, " max:", maxLineSize);
@@ -0,0 +1,293 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2021 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
+#include <subttxrend/common/Logger.hpp>
+
+#include <CueTextTokenizer.hpp>
+
+namespace subttxrend {
+namespace webvttengine {
+
+namespace {
+common::Logger g_logger("WebvttEngine", "CueTextTokenizer");
+
+/** Interned tags are dropped when there are more (ie karaoke timestamps are all different) */
+constexpr std::size_t MAX_INTERNED_TAGS = 256;
+
+struct ColourClass {
+    const char*     name;
+    gfx::ColorArgb  colour;
+};
+
+struct Entity {
+    const char*     name;
+    char            character;
+};
+
+/** Escaped characters, without the leading '&' */
+const Entity ENTITIES[] = {
+    { "amp;", '&' },
+    { "apos;", '\'' },
+    { "gt;", '>' },
+    { "lt;", '<' },
+    { "quot;", '\"' },
+};
+
+bool findColour(StringView name, const ColourClass* begin, const ColourClass* end, gfx::ColorArgb& colour) {
+    for (auto current = begin; current != end; ++current) {
+        if (name == current->name) {
+            colour = current->colour;
+            return true;
+        }
+    }
+    return false;
+}
+
+gfx::ColorArgb getTextColour(StringView name) {
+    static const ColourClass colours[] {
+        { "white", Style::kWhite },
+        { "lime", Style::kLime },
+        { "cyan", Style::kCyan },
+        { "red", Style::kRed },
+        { "yellow", Style::kYellow },
+        { "magenta", Style::kMagenta },
+        { "blue", Style::kBlue },
+        { "black", Style::kBlack },
+    };
+
+    gfx::ColorArgb colour;
+    if (!findColour(name, std::begin(colours), std::end(colours), colour)) {
+        g_logger.info("Style %s not found - returning WHITE", name.str().c_str());
+        colour = Style::kWhite;
+    }
+    return colour;
+}
+
+gfx::ColorArgb getBgColour(StringView name) {
+    static const ColourClass colours[] {
+        { "bg_white", Style::kWhite },
+        { "bg_lime", Style::kLime },
+        { "bg_cyan", Style::kCyan },
+        { "bg_red", Style::kRed },
+        { "bg_yellow", Style::kYellow },
+        { "bg_magenta", Style::kMagenta },
+        { "bg_blue", Style::kBlue },
+        { "bg_black", Style::kBlack },
+    };
+
+    gfx::ColorArgb colour;
+    if (!findColour(name, std::begin(colours), std::end(colours), colour)) {
+        g_logger.info("Style %s not found - returning BLACK", name.str().c_str());
+        colour = Style::kBlack;
+    }
+    return colour;
+}
+
+/**
+ * @brief Returns the escaped character at the start of text (just after the '&')
+ *
+ * @param text
+ * @param character replacement
+ * @return std::size_t length of the entity name, 0 if there is none
+ */
+std::size_t matchEntity(StringView text, char& character) {
+    for (const auto& entity : ENTITIES) {
+        if (text.startsWith(entity.name)) {
+            character = entity.character;
+            return std::strlen(entity.name);
+        }
+    }
+    return 0;
+}
+
+}
+
+const std::vector<CueTextSpan>& CueTextTokenizer::tokenize(StringView line) {
+    m_spans.clear();
+    m_openTags.clear();
+    m_decoded.clear();
+    // decoded text is never longer than the line, so the views into it stay valid
+    m_decoded.reserve(line.size());
+
+    if (m_tagStyles.size() > MAX_INTERNED_TAGS) {
+        m_tagIds.clear();
+        m_tagStyles.clear();
+    }
+
+    std::size_t index = line.find('<');
+    addSpan(decode(line.substr(0, index)));
+    bool hasLeadingSpan = !m_spans.empty();
+
+    while (index != StringView::npos) {
+        ++index;
+        bool closeTag = (index < line.size()) && (line[index] == '/');
+        if (closeTag) {
+            ++index;
+        }
+
+        // without '>' the tag is empty and the text goes on just after the '<'
+        StringView tag;
+        std::size_t tagEnd = line.find('>', index);
+        if (tagEnd != StringView::npos) {
+            tag = line.substr(index, tagEnd - index);
+            index = tagEnd + 1;
+        }
+
+        if (!closeTag) {
+            m_openTags.push_back(internTag(tag));
+        } else {
+            std::size_t id = findTag(tag);
+            if (id != NO_TAG) {
+                m_openTags.erase(std::remove(m_openTags.begin(), m_openTags.end(), id), m_openTags.end());
+            }
+        }
+
+        std::size_t next = line.find('<', index);
+        addSpan(decode(line.substr(index, next - index)));
+        index = next;
+    }
+
+    if (hasLeadingSpan) {
+        m_spans.front().style = resolveStyle();
+    }
+
+    return m_spans;
+}
+
+std::size_t CueTextTokenizer::internTag(StringView tag) {
+    std::size_t id = findTag(tag);
+    if (id != NO_TAG) {
+        return id;
+    }
+
+    TagStyle tagStyle;
+    if (!tag.empty()) {
+        switch (tag[0]) {
+        case 'i':
+            tagStyle.hasFontStyle = true;
+            tagStyle.fontStyle = Style::FontStyleType::kItalic;
+            break;
+        case 'b':
+            tagStyle.hasFontStyle = true;
+            tagStyle.fontStyle = Style::FontStyleType::kBold;
+            break;
+        case 'u':
+            tagStyle.hasFontStyle = true;
+            tagStyle.fontStyle = Style::FontStyleType::kUnderline;
+            break;
+        case 'c':
+            // eg: <c.lime.cyan.bg_white.bg_yellow> - last in the list takes precedence
+            for (std::size_t begin = 0; begin < tag.size();) {
+                std::size_t end = std::min(tag.find('.', begin), tag.size());
+                StringView colourClass = tag.substr(begin, end - begin);
+                begin = end + 1;
+
+                if (colourClass == "c") {
+                    continue;
+                }
+                if (colourClass.find("bg_") != StringView::npos) {
+                    tagStyle.hasBgColour = true;
+                    tagStyle.bgColour = getBgColour(colourClass);
+                } else {
+                    tagStyle.hasTextColour = true;
+                    tagStyle.textColour = getTextColour(colourClass);
+                }
+            }
+            break;
+        default:
+            g_logger.info("Unsupported style class");
+            break;
+        }
+    }
+
+    id = m_tagStyles.size();
+    m_tagStyles.push_back(tagStyle);
+    m_tagIds.emplace(m_tagKey, id);
+    return id;
+}
+
+std::size_t CueTextTokenizer::findTag(StringView tag) {
+    m_tagKey.assign(tag.data(), tag.size());
+    auto found = m_tagIds.find(m_tagKey);
+    return (found != m_tagIds.end()) ? found->second : NO_TAG;
+}
+
+Style CueTextTokenizer::resolveStyle() const {
+    Style style;
+    for (auto id : m_openTags) {
+        const auto& tagStyle = m_tagStyles[id];
+        if (tagStyle.hasFontStyle) {
+            style.fontStyle(tagStyle.fontStyle);
+        }
+        if (tagStyle.hasTextColour) {
+            style.textColour(tagStyle.textColour);
+        }
+        if (tagStyle.hasBgColour) {
+            style.bgColour(tagStyle.bgColour);
+        }
+    }
+    return style;
+}
+
+StringView CueTextTokenizer::decode(StringView text) {
+    std::size_t amp = text.find('&');
+    if (amp == StringView::npos) {
+        return text;
+    }
+
+    std::size_t start = m_decoded.size();
+    std::size_t position = 0;
+
+    while (amp != StringView::npos) {
+        m_decoded.append(text.data() + position, amp - position);
+        position = amp + 1;
+
+        char character = '&';
+        std::size_t length = matchEntity(text.substr(position), character);
+        if ((length > 0) && (character == '&')) {
+            // "&amp;lt;" gives '<', the entities used to be replaced one after another
+            // starting with "&amp;"
+            char escaped = 0;
+            std::size_t escapedLength = matchEntity(text.substr(position + length), escaped);
+            if ((escapedLength > 0) && (escaped != '&')) {
+                character = escaped;
+                length += escapedLength;
+            }
+        }
+        position += length;
+        m_decoded.push_back(character);
+
+        amp = text.find('&', position);
+    }
+    m_decoded.append(text.data() + position, text.size() - position);
+
+    return StringView(m_decoded.data() + start, m_decoded.size() - start);
+}
+
+void CueTextTokenizer::addSpan(StringView text) {
+    if (!text.empty()) {
+        m_spans.push_back(CueTextSpan{text, resolveStyle()});
+    }
+}
+
+}
+}
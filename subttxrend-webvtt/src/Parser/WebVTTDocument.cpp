@@ -16,11 +16,11 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
 */
-#include <sstream>
 #include <string>
-#include <fstream>
+#include <cctype>
 #include <cmath>
-#include <regex>
+#include <iterator>
+#include <limits>
 
 #include <WebVTTDocument.hpp>
 #include <WebVTTExceptions.hpp>
@@ -42,7 +42,7 @@ int parsePercentageHundredths(std::string value) {
     int percent;
 
     try {
-        if (value.back() == '%') {
+        if (!value.empty() && value.back() == '%') {
             float fpercent = std::stof(value);
             fpercent *= 100.0;
             percent = std::floor(fpercent + 0.5);
@@ -67,16 +67,15 @@ int parsePercentageHundredths(std::string value) {
  * @param position_string 
  * @return WebVTTCue::Position 
  */
-static Region::Position parsePosition(std::string position_string) {
-    std::string token;
-    std::istringstream iss(position_string);
+static Region::Position parsePosition(StringView position_string) {
     Region::Position position{0,10000};
-    int x, y;
-    
-    if (std::getline(iss, token, ',')) {
-        x = parsePercentageHundredths(token);
-        if (std::getline(iss, token, ',')) {
-            y = parsePercentageHundredths(std::move(token));
+
+    if (!position_string.empty()) {
+        std::size_t comma = position_string.find(',');
+        int x = parsePercentageHundredths(position_string.substr(0, comma).str());
+        if (comma != StringView::npos && comma + 1 < position_string.size()) {
+            StringView token = position_string.substr(comma + 1);
+            int y = parsePercentageHundredths(token.substr(0, token.find(',')).str());
             position = {x, y};
         }
     }
@@ -85,34 +84,69 @@ static Region::Position parsePosition(std::string position_string) {
 }
 
 /**
- * @brief Regex-based time parser to get time in HHH:MM:SS:MS format
+ * @brief Parses decimal digits
+ *
+ * @param digits
+ * @param value
+ * @return false if empty, not all digits or out of int range
+ */
+bool parseDigits(StringView digits, int& value) {
+    if (digits.empty()) {
+        return false;
+    }
+    long long result = 0;
+    for (std::size_t i = 0; i < digits.size(); ++i) {
+        if (digits[i] < '0' || digits[i] > '9') {
+            return false;
+        }
+        result = result * 10 + (digits[i] - '0');
+        if (result > std::numeric_limits<int>::max()) {
+            return false;
+        }
+    }
+    value = static_cast<int>(result);
+    return true;
+}
+
+/**
+ * @brief Time parser to get time in HHH:MM:SS.MS format
+ *        Works with no hours and/or no ms. Mins and secs are required
+ *        (same as the regex "(?:([0-9]*):)?([0-9][0-9]):([0-9][0-9])(?:\.([0-9][0-9][0-9]))?")
  *
  * @param hhmmss
  * @throws ParserException if time is invalid
  * @return std::uint64_t
  */
-Time parseHHMMSS(std::string hhmmss) {
+Time parseHHMMSS(StringView hhmmss) {
     Time timeInHHMMSS = {0,0,0,0};
-    try {
-        bool matched = false;
-        //Regex still works with no hours and/or no ms. Mins and secs are required
-        std::regex re("(?:([0-9]*):)?([0-9][0-9]):([0-9][0-9])(?:\\.([0-9][0-9][0-9]))?");
-        std::smatch match;
-        matched = std::regex_match(hhmmss, match, re);
-
-        if (matched) {
-
-            if (!match.str(1).empty()) timeInHHMMSS.hours = std::stoi(match.str(1));
-            if (!match.str(2).empty()) timeInHHMMSS.minutes = std::stoi(match.str(2));
-            if (!match.str(3).empty()) timeInHHMMSS.seconds = std::stoi(match.str(3));
-            if (!match.str(4).empty()) timeInHHMMSS.milliseconds = std::stoi(match.str(4));
-        }
-        else {
-            throw ParserException("Failed to parse time: " + hhmmss);
+    StringView rest = hhmmss;
+    bool matched = true;
+
+    std::size_t dot = rest.find('.');
+    if (dot != StringView::npos) {
+        StringView fraction = rest.substr(dot + 1);
+        matched = (fraction.size() == 3) && parseDigits(fraction, timeInHHMMSS.milliseconds);
+        rest = rest.substr(0, dot);
+    }
+
+    // [hours:]MM:SS - minutes and seconds are always two digits
+    if (matched && rest.size() >= 5 && rest[rest.size() - 3] == ':') {
+        StringView minutesSeconds = rest.substr(rest.size() - 5);
+        StringView hours = rest.substr(0, rest.size() - 5);
+        matched = minutesSeconds[2] == ':' &&
+                  parseDigits(minutesSeconds.substr(0, 2), timeInHHMMSS.minutes) &&
+                  parseDigits(minutesSeconds.substr(3, 2), timeInHHMMSS.seconds);
+        if (matched && !hours.empty()) {
+            matched = hours.back() == ':' &&
+                      (hours.size() == 1 || parseDigits(hours.substr(0, hours.size() - 1), timeInHHMMSS.hours));
         }
     }
-    catch (std::regex_error& e) {
-        throw ParserException("Regex error " + std::to_string(e.code()) + " from time " + hhmmss);
+    else {
+        matched = false;
+    }
+
+    if (!matched) {
+        throw ParserException("Failed to parse time: " + hhmmss.str());
     }
 
     return timeInHHMMSS;
@@ -156,79 +190,36 @@ uint64_t calculateRelativeTime(Time actualTime, Time localTime)
  * @return true
  * @return false
  */
-bool parsePropertyValuePair(const std::string& input, std::pair<std::string, std::string>& propValPair) {
-    std::istringstream iss(input);
-    std::string property, value;
+bool parsePropertyValuePair(StringView input, std::pair<std::string, std::string>& propValPair) {
     bool valid = false;
 
-    if (std::getline(iss, property, ':')) {
-        //Gets rest of line (needed because timestamps use ':')
-        std::getline(iss, value);
-        if (!value.empty()) {
-            propValPair = { property, value };
-            valid = true;
-        }
+    std::size_t colon = input.find(':');
+    //Value is the rest of line (needed because timestamps use ':')
+    if (colon != StringView::npos && colon + 1 < input.size()) {
+        propValPair = { input.substr(0, colon).str(), input.substr(colon + 1).str() };
+        valid = true;
     }
 
     return valid;
 }
 
-std::vector<std::string> getTokenVector(std::string line, char separator) {
-    std::vector<std::string> tokens;
-    if (line.find(separator) != std::string::npos) {
-        std::istringstream iss(line);
-        std::string token;
-        while (std::getline(iss, token, separator)) {
-            tokens.emplace_back(token);
-        }
-    }
-    else {
-        tokens.emplace_back(line);
-    }
-    return tokens;
-}
-
-/**
- * @brief Peek ahead in the stream to check for term in next line, then
- * restore the istream to the previous location
- * 
- * @param ifile 
- * @param searchString 
- * @return true 
- * @return false 
- */
-bool findInNextLine(std::istream &ifile, std::string searchString) {
-    std::string line;
-    bool found = false;
-    
-    //Get current position, seek to next line, search, then seek back to original position
-    std::streampos sp = ifile.tellg();
-    if (std::getline(ifile, line)) {
-        if (line.find(searchString) != std::string::npos)
-            found = true;
-    }
-    ifile.seekg(sp);
-    
-    return found;
-}
-
 /**
- * @brief Move the stream to the next not empty lne (duh)
+ * @brief Move the scanner to the next not empty lne (duh)
  * Passes out the position of the previous line so you can go back if needed
  * 
- * @param is 
+ * @param scanner 
  * @param lastLinePos 
- * @return std::string 
+ * @return StringView 
  */
-std::string getNextNotEmptyLine(std::istream& is, std::streampos &lastLinePos) {
-    std::string line;
+StringView getNextNotEmptyLine(LineScanner& scanner, std::size_t &lastLinePos) {
+    StringView line;
     
-    lastLinePos = is.tellg();
-    while (std::getline(is, line)) {
+    lastLinePos = scanner.tell();
+    while (scanner.getLine(line)) {
         if (!line.empty()) {
             return line;
         } else {
-            lastLinePos = is.tellg();
+            lastLinePos = scanner.tell();
         }
     }
     throw EndOfFileException("End of file reached");
@@ -241,18 +232,18 @@ std::string getNextNotEmptyLine(std::istream& is, std::streampos &lastLinePos) {
  * @return true
  * @return false
  */
-bool isNote(std::string line) {
-    return (line.substr(0, 4) == "NOTE" ? true : false);
+bool isNote(StringView line) {
+    return line.startsWith("NOTE");
 }
 
 /**
- * @brief Move the istream forwards to the next empty line
+ * @brief Move the scanner forwards to the next empty line
  * 
- * @param is 
+ * @param scanner 
  */
-void nextEmptyLine(std::istream& is) {
-    std::string line;
-    while (std::getline(is, line)) {
+void nextEmptyLine(LineScanner& scanner) {
+    StringView line;
+    while (scanner.getLine(line)) {
         if (line.empty()) {
             break;
         }
@@ -267,28 +258,27 @@ void nextEmptyLine(std::istream& is) {
  *        and an optional comment
  *        Needs to be present for a valid WebVTT file
  *
- * @param ifile
+ * @param scanner
  */
-void WebVTTDocument::checkValidWebVTTHeader(std::istream& ifile) {
-    std::string line;
+void WebVTTDocument::checkValidWebVTTHeader(LineScanner& scanner) {
+    StringView line;
 
-    std::getline(ifile, line);
-    if (!line.empty() && (unsigned char)line[0] == 0xEF && (unsigned char)line[1] == 0xBB && (unsigned char)line[2] == 0xBF) {
-        line.erase(0, 3);
+    scanner.getLine(line);
+    if (line.startsWith("\xEF\xBB\xBF")) {
+        line = line.substr(3);
     }
 
-    if (line.substr(0, 6) != "WEBVTT" ||
-        (line.length() > 6 && !std::isspace(line[6])) ) {
+    if (!line.startsWith("WEBVTT") ||
+        (line.size() > 6 && !std::isspace(static_cast<unsigned char>(line[6]))) ) {
         throw InvalidCueException("Bad WEBVTT header");
     }
 }
 
-SettingsMap WebVTTDocument::parseRegionSettings(std::istream &is) {
-    std::string line;
-    std::string id;
+SettingsMap WebVTTDocument::parseRegionSettings(LineScanner& scanner) {
+    StringView line;
     SettingsMap regionSettings;
     
-    while (std::getline(is, line) && !line.empty()) {
+    while (scanner.getLine(line) && !line.empty()) {
         SettingsItem item;
         if (parsePropertyValuePair(line, item)) {
             regionSettings.insert(std::move(item));
@@ -303,28 +293,28 @@ SettingsMap WebVTTDocument::parseRegionSettings(std::istream &is) {
  *        PTS offset and should match the AV content
  *
  * @param line
- * @param ptsOffset
- * @return true
- * @return false
+ * @return std::uint64_t
  */
-std::uint64_t WebVTTDocument::parseXTimestampMap(std::string line) {
-    std::istringstream iss(line);
-    std::string token;
+std::uint64_t WebVTTDocument::parseXTimestampMap(StringView line) {
     std::uint64_t ptsOffset = 0;
+    std::size_t separator = line.find('=');
 
-    if (std::getline(iss, token, '=') && token == "X-TIMESTAMP-MAP") {
-        std::getline(iss, token, '=');
+    if (line.substr(0, separator) == "X-TIMESTAMP-MAP") {
+        StringView value = (separator == StringView::npos) ? StringView() : line.substr(separator + 1);
+        value = value.substr(0, value.find('='));
         SettingsMap settingsMap;
         std::uint64_t mpegts = 0;
         Time localtime = {0,0,0,0};
 
         //Settings are in the format SETTING:VALUE,SETTING:VALUE
         //So split on ',' first, then use the standard methods
-        for (const auto& setting : getTokenVector(std::move(token), ',')) {
+        while (!value.empty()) {
+            std::size_t comma = value.find(',');
             SettingsItem propValPair;
-            if (parsePropertyValuePair(setting, propValPair)) {
+            if (parsePropertyValuePair(value.substr(0, comma), propValPair)) {
                 settingsMap.insert(std::move(propValPair));
             }
+            value = (comma == StringView::npos) ? StringView() : value.substr(comma + 1);
         }
 
         for (const auto& setting : settingsMap) {
@@ -365,13 +355,12 @@ std::uint64_t WebVTTDocument::parseXTimestampMap(std::string line) {
  * @return true
  * @return false
  */
-bool WebVTTDocument::parseWebVTTCueHeader(const std::string& headerLine, Timing& timing, SettingsMap& settings) {
-    std::istringstream iss(headerLine);
+bool WebVTTDocument::parseWebVTTCueHeader(StringView headerLine, Timing& timing, SettingsMap& settings) {
     bool ret = true;
 
     try {
-        timing = parseWebVTTCueTime(iss);
-        settings = parseWebVTTCueSettings(iss);
+        timing = parseWebVTTCueTime(headerLine);
+        settings = parseWebVTTCueSettings(headerLine);
     }
     catch (const InvalidCueException& e) {
         g_logger.warning("%s", e.what());
@@ -385,19 +374,18 @@ bool WebVTTDocument::parseWebVTTCueHeader(const std::string& headerLine, Timing&
  * @brief Will throw an InvalidCueException on any error - must be correct for
  *        the cue to be valid
  *
- * @param iss
+ * @param line Cue header, advanced past the timing
  * @throws InvalidCueException
  * @return Timing
  */
-Timing WebVTTDocument::parseWebVTTCueTime(std::istringstream& iss) {
-    bool ret = false;
+Timing WebVTTDocument::parseWebVTTCueTime(StringView& line) {
     TimePoint start, end;
-    std::string token;
+    StringView token;
 
     try {
-        if (iss.str().find("-->") != std::string::npos) {
+        if (line.find("-->") != StringView::npos) {
             // Get start time
-            iss >> token;
+            nextToken(line, token);
             try {
                 std::uint64_t startTimeMs;
                 Time startTime = parseHHMMSS(token);
@@ -405,20 +393,20 @@ Timing WebVTTDocument::parseWebVTTCueTime(std::istringstream& iss) {
                 start = TimePoint(startTimeMs);
             }
             catch (const ParserException&) {
-                throw ParserException("Bad start time " + token);
+                throw ParserException("Bad start time " + token.str());
             }
 
             // Check for -->
-            iss >> token;
+            nextToken(line, token);
             if (token != "-->") {
                 throw ParserException("Bad --> delimiter");
             }
 
             // Get end time
-            iss >> token;
+            nextToken(line, token);
             try {
                 std::uint64_t endTimeMs;
-                Time endTime = parseHHMMSS(std::move(token));
+                Time endTime = parseHHMMSS(token);
                 endTimeMs = calculateRelativeTime(endTime, m_localTime);
                 end = TimePoint(endTimeMs);
             }
@@ -440,66 +428,55 @@ Timing WebVTTDocument::parseWebVTTCueTime(std::istringstream& iss) {
 /**
  * @brief Parses the optional settings into a std::map
  *
- * @param iss
+ * @param line
  * @return SettingsMap
  */
-SettingsMap WebVTTDocument::parseWebVTTCueSettings(std::istringstream& iss) {
+SettingsMap WebVTTDocument::parseWebVTTCueSettings(StringView& line) {
     SettingsMap settingsMap;
-    std::string token;
+    StringView token;
 
-    while (iss) {
-        iss >> token;
-        if (!token.empty()) {
-            try {
-                SettingsItem propValPair;
-                if (parsePropertyValuePair(token, propValPair)) {
-                    settingsMap.insert(std::move(propValPair));
-                }
-            }
-            catch (const ParserException& e) {
-                g_logger.warning("Error %s - clear settings map and return", e.what());
-                settingsMap.clear();
-                break;
-            }
+    while (nextToken(line, token)) {
+        SettingsItem propValPair;
+        if (parsePropertyValuePair(token, propValPair)) {
+            settingsMap.insert(std::move(propValPair));
         }
-    };
+    }
 
     return settingsMap;
 }
 
 
 /**
- * @brief Returns the next WebVTTCue object in the stream
+ * @brief Returns the next WebVTTCue object in the text
  *        Will parse header, settings and all cue text into a WebVTTCue
  *        object and return
  *
- * @param is Input stream
+ * @param scanner Input lines
  * @param cue WebVTTCue object
  * @throws ParserException
  * @throws InvalidCueException
  * @return true
  * @return false
  */
-bool WebVTTDocument::nextCue(std::istream& is, CuePtr& cue) {
-    std::string line, id;
+bool WebVTTDocument::nextCue(LineScanner& scanner, CuePtr& cue) {
+    StringView line;
     Timing cueTime;
     SettingsMap settings;
     bool ret = false;
 
-    if (std::getline(is, line)) {
+    if (scanner.getLine(line)) {
         if (isNote(line)) {
             g_logger.info("NOTE: found in WebVTT file");
-            nextEmptyLine(is);
-            if (!std::getline(is, line)) {
+            nextEmptyLine(scanner);
+            if (!scanner.getLine(line)) {
                 return false;
             }
-            g_logger.debug("Line after NOTE: %s", line.c_str());
+            g_logger.debug("Line after NOTE: %s", line.str().c_str());
         }
 
         //If first line of cue is not the timeline, it's the ID
-        if (line.find("-->") == std::string::npos) {
-            id = line;
-            if (!std::getline(is, line)) {
+        if (line.find("-->") == StringView::npos) {
+            if (!scanner.getLine(line)) {
                 return false;
             }
         }
@@ -509,10 +486,11 @@ bool WebVTTDocument::nextCue(std::istream& is, CuePtr& cue) {
             cue = std::make_unique<WebVTTCue>(cueTime);
             cue->addCueSettings(settings);
 
-            while (std::getline(is, line)) {
+            while (scanner.getLine(line)) {
                 if (!line.empty()) {
-                    g_logger.debug("Adding text \"%s\" length %d last char 0x%X", line.c_str(), (int)line.length(), line.back());
-                    cue->addTextLine(line);
+                    std::string text = line.str();
+                    g_logger.debug("Adding text \"%s\" length %d last char 0x%X", text.c_str(), (int)text.length(), text.back());
+                    cue->addTextLine(text);
                 }
                 else {
                     // Delimited by empty line so break
@@ -558,13 +536,13 @@ Region ParseRegion(const SettingsMap& regionSettings) {
             }
         } else if (!property.compare("regionanchor")) {
             try {
-                region.region_anchor = parsePosition(std::move(value));
+                region.region_anchor = parsePosition(value);
             } catch (const ParserException &e) {
                 g_logger.osinfo(__LOGGER_FUNC__, "Failed to parse region anchor: ", e.what());
             }
         } else if (!property.compare("viewportanchor")) {
             try {
-                region.viewport_anchor = parsePosition(std::move(value));
+                region.viewport_anchor = parsePosition(value);
             } catch (const ParserException &e) {
                 g_logger.osinfo(__LOGGER_FUNC__, "Failed to parse viewport anchor: ", e.what());
             }
@@ -590,59 +568,74 @@ Region ParseRegion(const SettingsMap& regionSettings) {
  */
 std::tuple<CueList, RegionMap> WebVTTDocument::parseCueList(std::istream& ifile, 
                                                             std::uint64_t ptsOffsetMs) {
-    std::string line;
+    std::string text{std::istreambuf_iterator<char>(ifile), std::istreambuf_iterator<char>()};
+
+    return parseCueList(StringView(text), ptsOffsetMs);
+}
+
+/**
+ * @brief Parses the whole text into a std::list of WebVTTCue objects and
+ * a map of Region objects. Only the cue text and settings are copied.
+ *
+ * @param text
+ * @return CueList
+ */
+std::tuple<CueList, RegionMap> WebVTTDocument::parseCueList(StringView text,
+                                                            std::uint64_t ptsOffsetMs) {
+    LineScanner scanner(text);
+    StringView line;
     uint64_t offset = 0;
     CuePtr cue;
     CueList list;
     RegionMap regionMap;
 
-    checkValidWebVTTHeader(ifile);
+    checkValidWebVTTHeader(scanner);
     
     do {
         try {
-            std::streampos prevLinePosition = ifile.tellg();
-            line = getNextNotEmptyLine(ifile, prevLinePosition);
-            if (line.find("X-TIMESTAMP-MAP") != std::string::npos) {
+            std::size_t prevLinePosition = scanner.tell();
+            line = getNextNotEmptyLine(scanner, prevLinePosition);
+            if (line.find("X-TIMESTAMP-MAP") != StringView::npos) {
                 offset = parseXTimestampMap(line);
                 m_timeOffset = offset - ptsOffsetMs;
                 g_logger.osinfo(__LOGGER_FUNC__, " - offset from index file:", offset, 
                                                 " offset from data packet:", ptsOffsetMs,
                                                 " Overall offset to apply: ", m_timeOffset);
-            } else if (line.find("REGION") != std::string::npos) {
-                SettingsMap regionSettings = parseRegionSettings(ifile);
+            } else if (line.find("REGION") != StringView::npos) {
+                SettingsMap regionSettings = parseRegionSettings(scanner);
                 Region region = ParseRegion(regionSettings);
                 regionMap.emplace(region.id, region);
-            } else if (line.find("STYLE") != std::string::npos) {
+            } else if (line.find("STYLE") != StringView::npos) {
                 //Not implemented - just skip
                 g_logger.osinfo(__LOGGER_FUNC__, " - Found STYLE block but not feature not yet implemented");
-                nextEmptyLine(ifile);
-            } else if (line.find("NOTE") != std::string::npos) {
+                nextEmptyLine(scanner);
+            } else if (line.find("NOTE") != StringView::npos) {
                 g_logger.osinfo(__LOGGER_FUNC__, " - Found NOTE block - skipping");
-                nextEmptyLine(ifile);
-            } else if (line.find("-->") != std::string::npos || findInNextLine(ifile, "-->")) {
+                nextEmptyLine(scanner);
+            } else if (line.find("-->") != StringView::npos || scanner.findInNextLine("-->")) {
                 //Finished parsing the various headers
                 //Go back a line and break so we can parse the cues
-                ifile.seekg(prevLinePosition);
+                scanner.seek(prevLinePosition);
                 break;
             }
         } catch (const EndOfFileException &e) {
             g_logger.osinfo(__LOGGER_FUNC__, " - ", e.what());
             break;
         }
-    } while (ifile);
+    } while (!scanner.atEnd());
     
     
     //Now have a list of Regions
     
     
-    while (ifile) {
+    while (!scanner.atEnd()) {
         try {
-            if (nextCue(ifile, cue)) {
+            if (nextCue(scanner, cue)) {
                 list.emplace_back(std::move(cue));
             }
         } catch (const InvalidCueException& e) {
             g_logger.info("%s", e.what());
-            nextEmptyLine(ifile);
+            nextEmptyLine(scanner);
         }
     }
 
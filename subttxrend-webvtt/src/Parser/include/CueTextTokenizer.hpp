@@ -0,0 +1,93 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2021 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <StringScanner.hpp>
+#include <WebVTTStyle.hpp>
+
+namespace subttxrend {
+namespace webvttengine {
+
+/**
+ * @brief Part of a cue text line drawn with a single style
+ */
+struct CueTextSpan {
+    StringView  text;
+    Style       style;
+};
+
+/**
+ * @brief Splits a line of cue text (ie one<b>two<i>three</i>four</b>) into styled spans
+ * in a single pass.
+ *
+ * Handles simple classes only - i, b, u, c.textColour.bg_colour. Open tags are kept on
+ * a stack of interned tag ids, each id caches the style changes of its tag so the tag
+ * string is parsed once. A closing tag removes all open tags with the same name.
+ * Text between tags gets the style of the tags open after the preceding tag, text
+ * before the first tag the style of the tags still open at the end of the line.
+ *
+ * Span texts point into the line or, when escaped characters (&lt;, &gt; etc) were
+ * replaced, into the tokenizer; they are valid until the next tokenize() call.
+ */
+class CueTextTokenizer {
+public:
+    /**
+     * @brief Splits the line into styled spans, empty spans are skipped
+     *
+     * @param line
+     * @return const std::vector<CueTextSpan>&
+     */
+    const std::vector<CueTextSpan>& tokenize(StringView line);
+
+private:
+    /**
+     * @brief Style changes made by a tag
+     */
+    struct TagStyle {
+        bool                    hasFontStyle {false};
+        Style::FontStyleType    fontStyle {Style::kDefaultFontStyle};
+        bool                    hasTextColour {false};
+        gfx::ColorArgb          textColour;
+        bool                    hasBgColour {false};
+        gfx::ColorArgb          bgColour;
+    };
+
+    static constexpr std::size_t NO_TAG = static_cast<std::size_t>(-1);
+
+    std::size_t     internTag(StringView tag);
+    std::size_t     findTag(StringView tag);
+    Style           resolveStyle() const;
+    StringView      decode(StringView text);
+    void            addSpan(StringView text);
+
+    std::unordered_map<std::string, std::size_t>    m_tagIds;
+    std::vector<TagStyle>                           m_tagStyles;
+    std::string                                     m_tagKey;
+    std::vector<std::size_t>                        m_openTags;
+    std::string                                     m_decoded;
+    std::vector<CueTextSpan>                        m_spans;
+};
+
+}
+}
@@ -0,0 +1,187 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2021 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+#pragma once
+
+#include <algorithm>
+#include <cctype>
+#include <cstddef>
+#include <cstring>
+#include <string>
+
+namespace subttxrend {
+namespace webvttengine {
+
+/**
+ * @brief Non-owning reference to a range of characters (C++14 stand-in for
+ * std::string_view, only the operations the parser needs)
+ */
+class StringView {
+public:
+    static constexpr std::size_t npos = std::string::npos;
+
+    StringView() = default;
+
+    StringView(const char* data, std::size_t size) : m_data(data), m_size(size) {}
+
+    StringView(const char* str) : m_data(str), m_size(std::strlen(str)) {}
+
+    StringView(const std::string& str) : m_data(str.data()), m_size(str.size()) {}
+
+    const char*     data() const { return m_data; }
+    std::size_t     size() const { return m_size; }
+    bool            empty() const { return m_size == 0; }
+    char            operator[](std::size_t pos) const { return m_data[pos]; }
+    char            front() const { return m_data[0]; }
+    char            back() const { return m_data[m_size - 1]; }
+    std::string     str() const { return std::string(m_data, m_size); }
+
+    StringView substr(std::size_t pos, std::size_t count = npos) const {
+        pos = std::min(pos, m_size);
+        return StringView(m_data + pos, std::min(count, m_size - pos));
+    }
+
+    std::size_t find(char c, std::size_t pos = 0) const {
+        if (pos >= m_size) {
+            return npos;
+        }
+        auto found = static_cast<const char*>(std::memchr(m_data + pos, c, m_size - pos));
+        return found ? static_cast<std::size_t>(found - m_data) : npos;
+    }
+
+    std::size_t find(StringView needle, std::size_t pos = 0) const {
+        if (needle.empty()) {
+            return pos <= m_size ? pos : npos;
+        }
+        while ((pos = find(needle.front(), pos)) != npos) {
+            if (m_size - pos < needle.size()) {
+                return npos;
+            }
+            if (std::memcmp(m_data + pos, needle.data(), needle.size()) == 0) {
+                return pos;
+            }
+            ++pos;
+        }
+        return npos;
+    }
+
+    bool startsWith(StringView prefix) const {
+        return m_size >= prefix.size() && std::memcmp(m_data, prefix.data(), prefix.size()) == 0;
+    }
+
+    friend bool operator==(StringView lhs, StringView rhs) {
+        return lhs.size() == rhs.size() && std::memcmp(lhs.data(), rhs.data(), lhs.size()) == 0;
+    }
+
+    friend bool operator!=(StringView lhs, StringView rhs) {
+        return !(lhs == rhs);
+    }
+
+private:
+    const char*     m_data {""};
+    std::size_t     m_size {0};
+};
+
+/**
+ * @brief Splits text into lines like std::getline, without copying
+ *
+ * Line endings are normalized on the fly: all carriage returns are dropped,
+ * so both CRLF and LF end a line. A CR in the middle of a line is removed
+ * (the only case that needs a copy).
+ */
+class LineScanner {
+public:
+    explicit LineScanner(StringView text) : m_text(text) {}
+
+    /**
+     * @brief Returns the next line, the view is valid until the next call
+     *
+     * @param line
+     * @return false if there are no more lines
+     */
+    bool getLine(StringView& line) {
+        if (m_position >= m_text.size()) {
+            return false;
+        }
+
+        std::size_t end = m_text.find('\n', m_position);
+        std::size_t next = end + 1;
+        if (end == StringView::npos) {
+            end = m_text.size();
+            next = end;
+        }
+
+        line = m_text.substr(m_position, end - m_position);
+        m_position = next;
+
+        while (!line.empty() && line.back() == '\r') {
+            line = line.substr(0, line.size() - 1);
+        }
+        if (line.find('\r') != StringView::npos) {
+            m_scratch.assign(line.data(), line.size());
+            m_scratch.erase(std::remove(m_scratch.begin(), m_scratch.end(), '\r'), m_scratch.end());
+            line = m_scratch;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Checks if the next line starting at current position contains searchString
+     * (position is not changed)
+     */
+    bool findInNextLine(StringView searchString) {
+        std::size_t position = m_position;
+        StringView line;
+        bool found = getLine(line) && line.find(searchString) != StringView::npos;
+        m_position = position;
+        return found;
+    }
+
+    bool            atEnd() const { return m_position >= m_text.size(); }
+    std::size_t     tell() const { return m_position; }
+    void            seek(std::size_t position) { m_position = position; }
+
+private:
+    StringView      m_text;
+    std::size_t     m_position {0};
+    std::string     m_scratch;
+};
+
+/**
+ * @brief Returns the next whitespace separated token (like operator>> into a string)
+ *
+ * @param text remaining text, advanced past the token
+ * @param token
+ * @return false if there are no more tokens
+ */
+inline bool nextToken(StringView& text, StringView& token) {
+    std::size_t begin = 0;
+    while (begin < text.size() && std::isspace(static_cast<unsigned char>(text[begin]))) {
+        ++begin;
+    }
+    std::size_t end = begin;
+    while (end < text.size() && !std::isspace(static_cast<unsigned char>(text[end]))) {
+        ++end;
+    }
+    token = text.substr(begin, end - begin);
+    text = text.substr(end);
+    return !token.empty();
+}
+
+}
+}
@@ -20,10 +20,14 @@
 
 #include <string>
 #include <fstream>
+#include <iterator>
+#include <sstream>
+#include <tuple>
 
 #include <subttxrend/common/Logger.hpp>
 
 #include <WebVTTCue.hpp>
+#include <StringScanner.hpp>
 
 namespace subttxrend {
 namespace webvttengine {
@@ -68,16 +72,17 @@ class WebVTTDocument {
 public:
     WebVTTDocument() = default;
     std::tuple<CueList, RegionMap>  parseCueList(std::istream& ifile, std::uint64_t ptsOffsetMs = 0);
+    std::tuple<CueList, RegionMap>  parseCueList(StringView text, std::uint64_t ptsOffsetMs = 0);
 
 //These are protected for unit testing (see test fixture below)
 protected:
-    std::uint64_t                   parseXTimestampMap(std::string line);
-    Timing                          parseWebVTTCueTime(std::istringstream &iss);
-    SettingsMap                     parseWebVTTCueSettings(std::istringstream &iss);
-    bool                            parseWebVTTCueHeader(const std::string &header_line, Timing &timing, SettingsMap &settings);
-    void                            checkValidWebVTTHeader(std::istream& ifile);
-    SettingsMap                     parseRegionSettings(std::istream &is);
-    bool                            nextCue(std::istream& is, CuePtr& cue);
+    std::uint64_t                   parseXTimestampMap(StringView line);
+    Timing                          parseWebVTTCueTime(StringView &line);
+    SettingsMap                     parseWebVTTCueSettings(StringView &line);
+    bool                            parseWebVTTCueHeader(StringView header_line, Timing &timing, SettingsMap &settings);
+    void                            checkValidWebVTTHeader(LineScanner& scanner);
+    SettingsMap                     parseRegionSettings(LineScanner& scanner);
+    bool                            nextCue(LineScanner& scanner, CuePtr& cue);
     
     std::uint64_t                   m_timeOffset {0};
     Time                            m_localTime {0,0,0,0};
@@ -93,16 +98,22 @@ public:
     using WebVTTDocument::WebVTTDocument;
 
     SettingsMap parseWebVTTCueSettings(std::istringstream& iss) {
-        return WebVTTDocument::parseWebVTTCueSettings(iss);
+        std::string text = iss.str();
+        StringView line(text);
+        return WebVTTDocument::parseWebVTTCueSettings(line);
     }
     std::uint64_t parseXTimestampMap(std::string line) {
         return WebVTTDocument::parseXTimestampMap(line);
     }
     Timing parseWebVTTCueTime(std::istringstream& iss) {
-        return WebVTTDocument::parseWebVTTCueTime(iss);
+        std::string text = iss.str();
+        StringView line(text);
+        return WebVTTDocument::parseWebVTTCueTime(line);
     }
     void checkValidWebVTTHeader(std::istream& is) {
-        WebVTTDocument::checkValidWebVTTHeader(is);
+        std::string text{std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>()};
+        LineScanner scanner(text);
+        WebVTTDocument::checkValidWebVTTHeader(scanner);
     }
 };  //DocTest
 
@@ -16,8 +16,11 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
 */
+#include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <iterator>
+#include <vector>
 
 #include <WebVTTRenderer.hpp>
 #include <WebVTTExceptions.hpp>
@@ -33,7 +36,67 @@ namespace subttxrend
 namespace webvttengine
 {
 
-namespace { common::Logger g_logger("WebvttEngine", "WebVTTRenderer"); } // anonymous
+namespace
+{
+
+common::Logger g_logger("WebvttEngine", "WebVTTRenderer");
+
+/** Maximum offset of text drawn with edge style. */
+const int MAX_EDGE_OFFSET = 2;
+
+/**
+ * Returns area where the line may be drawn.
+ *
+ * Glyphs are not clipped to the line rectangle (accents, italics), so
+ * the area includes half of the line height around it.
+ */
+gfx::Rectangle getLineArea(const linebuilder::Line &line)
+{
+    const auto &rect = line.lineRectangle;
+    const auto margin = rect.m_h / 2 + MAX_EDGE_OFFSET;
+
+    return gfx::Rectangle(rect.m_x - margin, rect.m_y - margin, rect.m_w + 2 * margin, rect.m_h + 2 * margin);
+}
+
+bool intersects(const gfx::Rectangle &a, const gfx::Rectangle &b)
+{
+    return (a.m_x < b.m_x + b.m_w) && (b.m_x < a.m_x + a.m_w) &&
+           (a.m_y < b.m_y + b.m_h) && (b.m_y < a.m_y + a.m_h);
+}
+
+bool sameRectangle(const gfx::Rectangle &a, const gfx::Rectangle &b)
+{
+    return (a.m_x == b.m_x) && (a.m_y == b.m_y) && (a.m_w == b.m_w) && (a.m_h == b.m_h);
+}
+
+bool sameGlyphs(const std::vector<gfx::GlyphData> &a, const std::vector<gfx::GlyphData> &b)
+{
+    return std::equal(a.begin(), a.end(), b.begin(), b.end(),
+            [](const gfx::GlyphData &lhs, const gfx::GlyphData &rhs) {
+                return (lhs.glyphIndex == rhs.glyphIndex) && (lhs.codepoint == rhs.codepoint) &&
+                       (lhs.xOffset == rhs.xOffset) && (lhs.advanceX == rhs.advanceX);
+            });
+}
+
+/**
+ * Checks if lines would be drawn the same way.
+ */
+bool sameLine(const linebuilder::Line &a, const linebuilder::Line &b)
+{
+    if (!sameRectangle(a.lineRectangle, b.lineRectangle) || (a.linePaddingX != b.linePaddingX) ||
+        (a.tokenVector.size() != b.tokenVector.size()))
+    {
+        return false;
+    }
+
+    return std::equal(a.tokenVector.begin(), a.tokenVector.end(), b.tokenVector.begin(),
+            [](const linebuilder::Token &lhs, const linebuilder::Token &rhs) {
+                return (lhs.width == rhs.width) && (lhs.style == rhs.style) && (lhs.font == rhs.font) &&
+                       lhs.token && rhs.token && sameGlyphs(lhs.token->glyphs, rhs.token->glyphs);
+            });
+}
+
+} // anonymous
 
 inline std::shared_ptr<gfx::Window> lockGfxPtr(WinPtr ptr) {
     if (auto shptr = ptr.lock())
@@ -46,12 +109,25 @@ inline std::shared_ptr<gfx::Window> lockGfxPtr(WinPtr ptr) {
     }
 }
 
-WebVTTRenderer::WebVTTRenderer(WinPtr gfxWindow, const WebVTTConfig &config)
+WebVTTRenderer::WebVTTRenderer(WinPtr gfxWindow, const WebVTTConfig &config, linebuilder::FontCachePtr fontCache)
         : m_gfxPtr(gfxWindow),
           m_config(config),
-          m_reset(false) {
+          m_reset(false),
+          m_fontCache(std::move(fontCache)),
+          m_redrawAll(true) {
     assert(m_gfxPtr.lock());
-    lockGfxPtr(m_gfxPtr)->setVisible(true);
+    assert(m_fontCache);
+    auto gfxPtr = lockGfxPtr(m_gfxPtr);
+    gfxPtr->setRetainedMode(true);
+    gfxPtr->setVisible(true);
+}
+
+WebVTTRenderer::~WebVTTRenderer() {
+    // window is shared with other renderers
+    if (auto gfxPtr = m_gfxPtr.lock())
+    {
+        gfxPtr->setRetainedMode(false);
+    }
 }
 
 
@@ -68,6 +144,8 @@ void WebVTTRenderer::update() {
 void WebVTTRenderer::clearscreen() {
     g_logger.osdebug(__LOGGER_FUNC__);
     lockGfxPtr(m_gfxPtr)->clear();
+    m_drawnLines.clear();
+    m_redrawAll = false;
 }
 
 void WebVTTRenderer::resizeWindow() {
@@ -76,6 +154,7 @@ void WebVTTRenderer::resizeWindow() {
     if (m_surfaceSize != gfxPtr->getSize())
     {
         gfxPtr->setSize(m_surfaceSize);
+        m_redrawAll = true;
     }
 }
 
@@ -251,8 +330,8 @@ void WebVTTRenderer::renderDocument(const CueSharedList &webvtt_list, const Regi
     g_logger.osinfo(__LOGGER_FUNC__, " - preferred size ", preferred_size.m_w, "x", preferred_size.m_h);
     resizeWindow();
     
-    linebuilder::LineBuilder builder {preferred_size.m_w, preferred_size.m_h, m_config, m_attributes};
-    RenderCues(builder.buildOutputLines(webvtt_list, regions), gfxPtr->getDrawContext(), m_attributes);
+    linebuilder::LineBuilder builder {preferred_size.m_w, preferred_size.m_h, m_config, m_attributes, m_fontCache};
+    drawLines(builder.buildOutputLines(webvtt_list, regions), *gfxPtr);
     
     if (m_reset) {
         g_logger.osinfo(__LOGGER_FUNC__, " - calling clearscreen after render");
@@ -260,6 +339,103 @@ void WebVTTRenderer::renderDocument(const CueSharedList &webvtt_list, const Regi
     }
 }
 
+/**
+ * @brief Draws lines that changed since the previous call.
+ * Lines drawn before and not changed are kept on the window (retained
+ * mode), unless a changed line may overlap them. Areas of the removed
+ * and changed lines are cleared before drawing.
+ *
+ * @param lines Lines to show.
+ * @param window Window to draw on.
+ */
+void WebVTTRenderer::drawLines(const linebuilder::LineList &lines, gfx::Window &window) {
+    if (m_redrawAll)
+    {
+        window.clear();
+        m_drawnLines.clear();
+        m_redrawAll = false;
+    }
+
+    // unchanged lines are kept if in the same order as drawn
+    std::vector<bool> kept(lines.size(), false);
+    std::vector<bool> drawnKept(m_drawnLines.size(), false);
+    auto drawnBegin = m_drawnLines.begin();
+    std::size_t index = 0;
+    for (const auto &line : lines)
+    {
+        auto drawn = std::find_if(drawnBegin, m_drawnLines.end(),
+                [&line](const linebuilder::Line &drawnLine) { return sameLine(drawnLine, line); });
+        if (drawn != m_drawnLines.end())
+        {
+            kept[index] = true;
+            drawnKept[std::distance(m_drawnLines.begin(), drawn)] = true;
+            drawnBegin = std::next(drawn);
+        }
+        ++index;
+    }
+
+    std::vector<gfx::Rectangle> dirtyAreas;
+    index = 0;
+    for (const auto &drawnLine : m_drawnLines)
+    {
+        if (!drawnKept[index++])
+        {
+            dirtyAreas.push_back(getLineArea(drawnLine));
+        }
+    }
+    index = 0;
+    for (const auto &line : lines)
+    {
+        if (!kept[index++])
+        {
+            dirtyAreas.push_back(getLineArea(line));
+        }
+    }
+
+    // kept lines overlapping the cleared or drawn areas are redrawn too
+    bool changed = true;
+    while (changed)
+    {
+        changed = false;
+        index = 0;
+        for (const auto &line : lines)
+        {
+            if (kept[index])
+            {
+                const auto area = getLineArea(line);
+                if (std::any_of(dirtyAreas.begin(), dirtyAreas.end(),
+                        [&area](const gfx::Rectangle &dirty) { return intersects(area, dirty); }))
+                {
+                    kept[index] = false;
+                    dirtyAreas.push_back(area);
+                    changed = true;
+                }
+            }
+            ++index;
+        }
+    }
+
+    for (const auto &area : dirtyAreas)
+    {
+        window.clearRectangle(area);
+    }
+
+    linebuilder::LineList changedLines;
+    index = 0;
+    for (const auto &line : lines)
+    {
+        if (!kept[index++])
+        {
+            changedLines.push_back(line);
+        }
+    }
+    g_logger.osdebug(__LOGGER_FUNC__, " - lines: ", lines.size(), " drawn: ", changedLines.size());
+
+    RenderCues(changedLines, window.getDrawContext(), m_attributes);
+
+    m_drawnLines = lines;
+}
+
 void WebVTTRenderer::show() {
     g_logger.osdebug(__LOGGER_FUNC__);
     m_reset.exchange(false);
@@ -279,6 +455,7 @@ void WebVTTRenderer::clearState() {
 
 void WebVTTRenderer::setAttributes(const WebVTTAttributes &attributes) {
     m_attributes.update(attributes);
+    m_redrawAll = true;
 }
 
 }   // namespace webvttengine
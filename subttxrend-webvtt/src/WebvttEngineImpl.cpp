@@ -68,14 +68,15 @@ void WebvttEngineImpl::clear()
 }
 
 void WebvttEngineImpl::init(const common::ConfigProvider* configProvider,
-                          std::weak_ptr<gfx::Window> gfxWindowPtr)
+                          std::weak_ptr<gfx::Window> gfxWindowPtr,
+                          std::shared_ptr<gfx::PrerenderedFontCache> fontCache)
 {
     g_logger.osinfo(__LOGGER_FUNC__);
 
     assert(configProvider);
     m_config.init(configProvider);
 
-    m_renderer = std::make_unique<WebVTTRenderer>(gfxWindowPtr, m_config);
+    m_renderer = std::make_unique<WebVTTRenderer>(gfxWindowPtr, m_config, std::move(fontCache));
 
     clear();
 }
@@ -144,21 +145,6 @@ void WebvttEngineImpl::setAttributes(const WebVTTAttributes &attributes)
     m_renderer->setAttributes(attributes);
 }
 
-/**
- * @brief Simple string helper method
- * 
- * @param str 
- * @param find 
- * @param replace 
- */
-void ReplaceAll(std::string & str, const std::string &find, const std::string &replace) {
-    std::size_t pos = 0;
-    while ((pos = str.find(find, pos)) != std::string::npos) {
-        str.replace(pos, find.length(), replace);
-        pos += replace.length();
-    };
-}
-
 /**
  * @brief Gets a map of Regions. The list returned from the current file might not have regions
  * for cues from previous files, so this checks those too.
@@ -218,24 +204,18 @@ void WebvttEngineImpl::addData(const std::uint8_t* buffer,
         auto preParseTimeLineSize = m_timeline.size();
 
         try {
-            std::string buffer_string = std::string(buffer, buffer + bufferSize);
-            
-            //Fix line endings
-            if (buffer_string.find("\r") != std::string::npos) {
-                ReplaceAll(buffer_string, "\r\n", "\n");
-                ReplaceAll(buffer_string, "\r", "");
-            }
-            //Trim padding NULLs from end
-            while (buffer_string.back() == '\0') 
-                buffer_string.pop_back();
+            //Trim padding NULLs from end (line endings are fixed by the parser,
+            //which drops all CRs)
+            auto text = reinterpret_cast<const char*>(buffer);
+            while (bufferSize > 0 && (text[bufferSize - 1] == '\0' || text[bufferSize - 1] == '\r'))
+                --bufferSize;
 
-            std::istringstream ss(buffer_string);
             WebVTTDocument documentParser;
             CueList documentCueList;
             RegionMap regionMap;
             
             //Get list of cues and regions from the incoming WebVTT file
-            std::tie(documentCueList, regionMap) = documentParser.parseCueList(ss, displayOffsetMs);
+            std::tie(documentCueList, regionMap) = documentParser.parseCueList(StringView(text, bufferSize), displayOffsetMs);
            
            //Merge incoming cues and regions with cache
             m_timeline.merge(documentCueList, [](const CuePtr &a, const CuePtr &b) -> bool { return *a < *b; });
@@ -260,9 +240,13 @@ void WebvttEngineImpl::addData(const std::uint8_t* buffer,
  */
 void WebvttEngineImpl::currentMediatime(const std::uint64_t mediatimeMs)
 {
-    m_lastMediatimeMs = mediatimeMs;
-    m_lastMediatimeTimestamp = std::chrono::system_clock::now();
-    m_pauseTimeMs = 0;
+    {
+        std::lock_guard<std::mutex> lock{m_mutex};
+
+        m_lastMediatimeMs = mediatimeMs;
+        m_lastMediatimeTimestamp = std::chrono::system_clock::now();
+        m_pauseTimeMs = 0;
+    }
 
     g_logger.osinfo(__LOGGER_FUNC__, " mediatime=", getCurrentMediatime(), " (mediaTimeMs=", mediatimeMs, ")");
 }
@@ -331,10 +315,6 @@ void WebvttEngineImpl::process()
 
     // update the view, if necessary
     if (needUpdate) {
-        {
-            auto t = g_logger.timing("renderer->clearscreen");
-            m_renderer->clearscreen();
-        }
         {
             g_logger.osinfo("renderer->renderDocument - cue number:", shownCues.size());
             auto t = g_logger.timing("renderer->renderDocument");
@@ -358,40 +338,35 @@ TimePoint WebvttEngineImpl::getCurrentMediatime() const
 
 std::chrono::milliseconds WebvttEngineImpl::getWaitTime() const
 {
-    auto waitTime = std::chrono::milliseconds::zero();
-
-    auto anythingToDraw = !m_timeline.empty();
-    auto anythingToHide = !m_shownDocuments.empty();
-
-    if ((anythingToDraw || anythingToHide) && (m_lastMediatimeMs != -1) && (!m_paused)) {
-        // TimePoint const currentMediaTime = getCurrentMediatime();
-
-        // if (anythingToDraw) {
-        //     TimePoint const& start = m_timeline.front()->startTime();
-
-        //     if (currentMediaTime < start) {
-        //         waitTime = start.toMilliseconds() - currentMediaTime.toMilliseconds();
-        //     }
-        // }
-
-        // for_each(m_shownDocuments.begin(), m_shownDocuments.end(), [&waitTime,
-        //                                                             currentMediaTime](const CueSharedPtr &doc) {
-        //     TimePoint const& end = doc->endTime();
-        //     auto hideTime = end.toMilliseconds() - currentMediaTime.toMilliseconds();
-        //     if (hideTime < waitTime || waitTime == std::chrono::milliseconds::zero()) {
-        //         waitTime = hideTime;
-        //     }
-        // });
-
-        auto static constexpr MIN_WAIT_TIME = 25ms;
-        // if (waitTime < MIN_WAIT_TIME) {
-            waitTime = MIN_WAIT_TIME;
-        // }
-    }
-    else if (m_paused)
+    using namespace std::chrono;
+
+    static constexpr milliseconds MIN_WAIT_TIME{1};
+    static constexpr milliseconds MAX_WAIT_TIME{1000};
+
+    auto waitTime = milliseconds::max();
+
     {
-       auto static constexpr MIN_WAIT_TIME = 250ms;
-       waitTime = MIN_WAIT_TIME;
+        std::lock_guard<std::mutex> lock{m_mutex};
+        if ((m_lastMediatimeMs != -1) && (!m_paused)) {
+            auto const currentMediaTimeMs = getCurrentMediatime().toMilliseconds();
+
+            if (!m_timeline.empty()) {
+                auto const start = m_timeline.front()->startTime().toMilliseconds();
+                waitTime = std::min(waitTime, start - currentMediaTimeMs);
+            }
+
+            for (auto const& doc : m_shownDocuments) {
+                auto const end = doc->endTime().toMilliseconds();
+                waitTime = std::min(waitTime, end - currentMediaTimeMs);
+            }
+        }
+    }
+
+    if (waitTime == milliseconds::max()) {
+        // nothing scheduled or paused, wait for new data, timestamp or resume
+        waitTime = milliseconds::zero();
+    } else {
+        waitTime = std::max(MIN_WAIT_TIME, std::min(waitTime, MAX_WAIT_TIME));
     }
 
     g_logger.osdebug(__LOGGER_FUNC__, " waitTime: ", waitTime.count(), ", paused: ", m_paused);
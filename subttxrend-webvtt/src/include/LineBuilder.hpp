@@ -18,6 +18,7 @@
 */
 #pragma once
 
+#include <CueTextTokenizer.hpp>
 #include <WebVTTConverter.hpp>
 #include <WebVTTCue.hpp>
 #include <WebVTTStyle.hpp>
@@ -30,7 +31,7 @@ namespace subttxrend {
 namespace webvttengine {
 namespace linebuilder {
 
-using FontCachePtr = std::unique_ptr<gfx::PrerenderedFontCache>;
+using FontCachePtr = std::shared_ptr<gfx::PrerenderedFontCache>;
 using FontPtr = std::shared_ptr<gfx::PrerenderedFont>;
 using TokenPtr = std::shared_ptr<gfx::TextTokenData>;
 
@@ -89,12 +90,6 @@ struct Line {
     gfx::Rectangle      lineRectangle;
 };
 
-struct Result {
-    std::string text;
-    Style       style;
-};
-
-
 using LineList = std::list<Line>;
 
 /**
@@ -113,7 +108,12 @@ public:
                 m_converter(viewportWidth, viewportHeight) {}
 
     LineBuilder(int viewportWidth, int viewportHeight, const WebVTTConfig &config, const WebVTTAttributes &attributes) :
-                m_converter(viewportWidth, viewportHeight, config, attributes)
+                LineBuilder(viewportWidth, viewportHeight, config, attributes, std::make_shared<gfx::PrerenderedFontCache>()) {}
+
+    LineBuilder(int viewportWidth, int viewportHeight, const WebVTTConfig &config, const WebVTTAttributes &attributes,
+                FontCachePtr fontCache) :
+                m_converter(viewportWidth, viewportHeight, config, attributes),
+                m_fontCache(std::move(fontCache))
     {
         m_attributes.update(attributes);
         m_fontFamily = getFontFamily(config);
@@ -127,17 +127,18 @@ private:
     LineList        getOutputLines(const CueSharedList &cueList);
     void            linePositionsBeforeAdjustment(std::list<Line> &boxes, WebVTTCue::AlignType align, 
                                                   int startingY, int positionPx, bool setY);
-    Line            buildTokensForLine(const std::vector<Result> &line_segments);
+    Line            buildTokensForLine(const std::vector<CueTextSpan> &line_segments);
     LineList        buildLines(const std::vector<std::string> lineStrings, int maximumSize);
     FontPtr         getFont(std::string fontFamily, std::uint32_t size);
     std::string     getFontFamily(WebVTTConfig config);
     void            getUserDefinedColorAttributes(Style &style);
 
     Converter       m_converter {1280, 720};
-    FontCachePtr    m_fontCache {std::make_unique<gfx::PrerenderedFontCache>()};
+    FontCachePtr    m_fontCache {std::make_shared<gfx::PrerenderedFontCache>()};
     
     std::string     m_fontFamily {"Cinecav Sans"};
     WebVTTAttributes    m_attributes;
+    CueTextTokenizer    m_cueTextTokenizer;
 };
 
 }
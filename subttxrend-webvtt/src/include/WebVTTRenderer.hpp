@@ -45,8 +45,17 @@ public:
      *
      * @param gfxWindow
      *      Window to draw on.
+     * @param config
+     *      WebVTT configuration.
+     * @param fontCache
+     *      Font cache, kept between rendered documents.
      */
-    WebVTTRenderer(WinPtr gfxWindow, const WebVTTConfig &config);
+    WebVTTRenderer(WinPtr gfxWindow, const WebVTTConfig &config, linebuilder::FontCachePtr fontCache);
+
+    /**
+     * Destructor.
+     */
+    ~WebVTTRenderer();
 
     /**
      *  Sets releated video
@@ -68,6 +77,9 @@ public:
     /**
      * Renders given window WebVTT surface.
      *
+     * Only lines that changed since the previous call are redrawn, the
+     * window is not cleared before.
+     *
      * @param doc
      *      Document to render.
      */
@@ -98,6 +110,7 @@ public:
 
 private:
     void resizeWindow();
+    void drawLines(const linebuilder::LineList &lines, gfx::Window &window);
 
     WinPtr              m_gfxPtr;
 
@@ -107,6 +120,12 @@ private:
 
     std::atomic<bool>   m_reset;
     WebVTTAttributes    m_attributes;
+    linebuilder::FontCachePtr m_fontCache;
+
+    /** Lines on the window, in drawing order. */
+    linebuilder::LineList m_drawnLines;
+    /** Flag indicating that the whole window has to be redrawn. */
+    bool                m_redrawAll;
 };
 
 }   // namespace webvttengine
@@ -58,7 +58,8 @@ public:
 
     /** @copydoc WebvttEngine::init */
     virtual void init(const common::ConfigProvider* configProvider,
-                      std::weak_ptr<gfx::Window> gfxWindowPtr) override;
+                      std::weak_ptr<gfx::Window> gfxWindowPtr,
+                      std::shared_ptr<gfx::PrerenderedFontCache> fontCache) override;
 
     /** @copydoc WebvttEngine::setRelatedVideoSize */
     virtual void setRelatedVideoSize(gfx::Size relatedVideoSize) override;
@@ -129,7 +130,7 @@ private:
     std::uint64_t                           m_pauseTimeMs{};
 
     /** Ordered list of subtitles. */
-    std::mutex                              m_mutex;
+    mutable std::mutex                      m_mutex;
     CueList                                 m_timeline;
     std::list<CueSharedPtr>                 m_shownDocuments;
     RegionMap                               m_cachedRegionMap;
@@ -0,0 +1,146 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2021 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+/*
+ * Benchmark of cue text markup tokenizing on heavily styled karaoke cues.
+ *
+ * Every word of a karaoke cue line has its own timestamp tag, colour class
+ * and font style, plus some escaped characters. Reports time and number of
+ * heap allocations per line. Not a unit test, run manually:
+ * CueTextTokenizer_Benchmark [words per line] [iterations]
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+#include <CueTextTokenizer.hpp>
+
+using namespace subttxrend::webvttengine;
+
+namespace {
+
+std::atomic<std::size_t> g_allocations{0};
+
+std::string buildKaraokeLine(int words, int seed) {
+    static const char* colours[] = {"c.yellow", "c.cyan.bg_blue", "c.lime", "c.magenta.bg_black"};
+    static const char* styles[] = {"b", "i", "u"};
+    std::string line;
+    char timestamp[32];
+
+    line += "<v Singer><c.white.bg_black>";
+    for (int word = 0; word < words; ++word) {
+        int ms = (seed * words + word) * 250;
+        std::snprintf(timestamp, sizeof(timestamp), "<%02d:%02d:%02d.%03d>",
+                      ms / 3600000, ms / 60000 % 60, ms / 1000 % 60, ms % 1000);
+        const char* colour = colours[(seed + word) % 4];
+        const char* style = styles[word % 3];
+
+        line += timestamp;
+        line += "<";
+        line += colour;
+        line += "><";
+        line += style;
+        line += ">";
+        line += (word % 7 == 0) ? "rock&amp;roll" : "word";
+        line += "</";
+        line += style;
+        line += "></";
+        line += colour;
+        line += "> ";
+    }
+    line += "</c.white.bg_black></v>";
+    return line;
+}
+
+void benchmark(int words, std::size_t iterations) {
+    const int lineCount = 1000;
+    std::vector<std::string> lines;
+    std::size_t bytes = 0;
+    for (int i = 0; i < lineCount; ++i) {
+        lines.push_back(buildKaraokeLine(words, i));
+        bytes += lines.back().size();
+    }
+
+    CueTextTokenizer tokenizer;
+    double best = 0;
+    std::size_t allocations = 0;
+    std::size_t spans = 0;
+
+    for (std::size_t i = 0; i < iterations; ++i) {
+        std::size_t allocationsBefore = g_allocations;
+        spans = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (const auto& line : lines) {
+            spans += tokenizer.tokenize(line).size();
+        }
+        auto end = std::chrono::steady_clock::now();
+        allocations = g_allocations - allocationsBefore;
+
+        double ms = std::chrono::duration<double, std::milli>(end - start).count();
+        if (i == 0 || ms < best) {
+            best = ms;
+        }
+    }
+
+    std::printf("%3d words (%5zu bytes/line) %9.2f us/line %8.2f allocations/line %6zu spans/line\n",
+                words, bytes / lineCount, best * 1000.0 / lineCount,
+                static_cast<double>(allocations) / lineCount, spans / lineCount);
+}
+
+}
+
+void* operator new(std::size_t size) {
+    ++g_allocations;
+    if (void* ptr = std::malloc(size ? size : 1)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+int main(int argc, char* argv[]) {
+    int words = (argc > 1) ? std::atoi(argv[1]) : 0;
+    std::size_t iterations = (argc > 2) ? std::strtoul(argv[2], nullptr, 10) : 5;
+
+    // test logger prints to std::cout, keep the output readable
+    std::cout.setstate(std::ios::badbit);
+
+    std::printf("1000 karaoke lines, best of %zu\n", iterations);
+    if (words > 0) {
+        benchmark(words, iterations);
+    } else {
+        for (int lineWords : {4, 16, 64}) {
+            benchmark(lineWords, iterations);
+        }
+    }
+
+    return 0;
+}
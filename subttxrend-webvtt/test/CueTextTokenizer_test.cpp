@@ -0,0 +1,209 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2021 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+#include <string>
+#include <vector>
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestCase.h>
+
+#include <CueTextTokenizer.hpp>
+
+using namespace subttxrend;
+using namespace subttxrend::webvttengine;
+
+class CueTextTokenizerTest : public CppUnit::TestFixture {
+
+CPPUNIT_TEST_SUITE(CueTextTokenizerTest);
+CPPUNIT_TEST(testPlainText);
+CPPUNIT_TEST(testNestedTags);
+CPPUNIT_TEST(testColours);
+CPPUNIT_TEST(testUnclosedTags);
+CPPUNIT_TEST(testEscapedCharacters);
+CPPUNIT_TEST(testBadlyFormedTags);
+CPPUNIT_TEST(testKaraoke);
+CPPUNIT_TEST(testReuse);
+CPPUNIT_TEST_SUITE_END();
+
+public:
+    struct Expected {
+        std::string     text;
+        Style           style;
+    };
+
+    static Style buildStyle(Style::FontStyleType fontStyle,
+                            gfx::ColorArgb textColour = Style::kDefaultTextColour,
+                            gfx::ColorArgb bgColour = Style::kDefaultBgColour)
+    {
+        Style style;
+        style.fontStyle(fontStyle);
+        style.textColour(textColour);
+        style.bgColour(bgColour);
+        return style;
+    }
+
+    void checkSpans(const std::string& line, const std::vector<Expected>& expected)
+    {
+        const auto& spans = m_tokenizer.tokenize(line);
+
+        CPPUNIT_ASSERT_EQUAL_MESSAGE(line, expected.size(), spans.size());
+        for (std::size_t i = 0; i < expected.size(); ++i) {
+            CPPUNIT_ASSERT_EQUAL_MESSAGE(line, expected[i].text, spans[i].text.str());
+            CPPUNIT_ASSERT_MESSAGE(line + " - style of " + expected[i].text, expected[i].style == spans[i].style);
+        }
+    }
+
+    void setUp()
+    {
+        m_tokenizer = CueTextTokenizer();
+    }
+
+    void tearDown()
+    {
+
+    }
+
+    void testPlainText()
+    {
+        std::string line("Simple line of text");
+        const auto& spans = m_tokenizer.tokenize(line);
+
+        CPPUNIT_ASSERT_EQUAL(std::size_t(1), spans.size());
+        CPPUNIT_ASSERT(spans[0].text.data() == line.data());
+        CPPUNIT_ASSERT_EQUAL(line.size(), spans[0].text.size());
+        CPPUNIT_ASSERT(Style() == spans[0].style);
+
+        CPPUNIT_ASSERT(m_tokenizer.tokenize("").empty());
+    }
+
+    void testNestedTags()
+    {
+        using Type = Style::FontStyleType;
+
+        checkSpans("one<b>two<i>three</i>four</b>five", {
+            {"one", buildStyle(Type::kNormal)},
+            {"two", buildStyle(Type::kBold)},
+            {"three", buildStyle(Type::kItalic)},
+            {"four", buildStyle(Type::kBold)},
+            {"five", buildStyle(Type::kNormal)}});
+
+        // closing tag removes all open tags with the same name
+        checkSpans("<u>a<b>b<u>c</u>d</b>e", {
+            {"a", buildStyle(Type::kUnderline)},
+            {"b", buildStyle(Type::kBold)},
+            {"c", buildStyle(Type::kUnderline)},
+            {"d", buildStyle(Type::kBold)},
+            {"e", buildStyle(Type::kNormal)}});
+
+        // empty spans are skipped
+        checkSpans("<b></b><i> </i>", {
+            {" ", buildStyle(Type::kItalic)}});
+    }
+
+    void testColours()
+    {
+        using Type = Style::FontStyleType;
+
+        checkSpans("<c.lime.cyan.bg_white.bg_yellow>text</c.lime.cyan.bg_white.bg_yellow>", {
+            {"text", buildStyle(Type::kNormal, Style::kCyan, Style::kYellow)}});
+
+        checkSpans("<c.red><i>red italic</i> red <c.bg_blue>on blue", {
+            {"red italic", buildStyle(Type::kItalic, Style::kRed)},
+            {" red ", buildStyle(Type::kNormal, Style::kRed)},
+            {"on blue", buildStyle(Type::kNormal, Style::kRed, Style::kBlue)}});
+
+        // unknown classes
+        checkSpans("<c.purple.bg_grey>text", {
+            {"text", buildStyle(Type::kNormal, Style::kWhite, Style::kBlack)}});
+    }
+
+    void testUnclosedTags()
+    {
+        using Type = Style::FontStyleType;
+
+        // text before the first tag gets the tags still open at the end
+        checkSpans("one <b>two <u>three", {
+            {"one ", buildStyle(Type::kUnderline)},
+            {"two ", buildStyle(Type::kBold)},
+            {"three", buildStyle(Type::kUnderline)}});
+    }
+
+    void testEscapedCharacters()
+    {
+        using Type = Style::FontStyleType;
+
+        checkSpans("&lt;tag&gt; &amp; &quot;quoted&quot; &apos;single&apos; &nbsp; & &am", {
+            {"<tag> & \"quoted\" 'single' &nbsp; & &am", buildStyle(Type::kNormal)}});
+
+        checkSpans("a&amp;lt;b<b>&amp;amp;</b>&amp;&amp;gt;", {
+            {"a<b", buildStyle(Type::kNormal)},
+            {"&amp;", buildStyle(Type::kBold)},
+            {"&>", buildStyle(Type::kNormal)}});
+    }
+
+    void testBadlyFormedTags()
+    {
+        using Type = Style::FontStyleType;
+
+        // '<' without '>' is an empty tag
+        checkSpans("a < b", {
+            {"a ", buildStyle(Type::kNormal)},
+            {" b", buildStyle(Type::kNormal)}});
+
+        checkSpans("<b>bold</", {
+            {"bold", buildStyle(Type::kBold)}});
+
+        checkSpans("<>x</>y<", {
+            {"x", buildStyle(Type::kNormal)},
+            {"y", buildStyle(Type::kNormal)}});
+    }
+
+    void testKaraoke()
+    {
+        using Type = Style::FontStyleType;
+
+        checkSpans("<c.yellow>Never <00:00:01.000>gonna <00:00:01.500><b>give</b> <00:00:02.000>you up</c.yellow>", {
+            {"Never ", buildStyle(Type::kNormal, Style::kYellow)},
+            {"gonna ", buildStyle(Type::kNormal, Style::kYellow)},
+            {"give", buildStyle(Type::kBold, Style::kYellow)},
+            {" ", buildStyle(Type::kNormal, Style::kYellow)},
+            {"you up", buildStyle(Type::kNormal, Style::kYellow)}});
+    }
+
+    void testReuse()
+    {
+        using Type = Style::FontStyleType;
+
+        // more distinct tags than are kept interned
+        for (int i = 0; i < 1000; ++i) {
+            checkSpans("<" + std::to_string(i) + "><i>" + std::to_string(i) + "</i>", {
+                {std::to_string(i), buildStyle(Type::kItalic)}});
+        }
+
+        // open tags are not carried over to the next line
+        checkSpans("<b>bold", {
+            {"bold", buildStyle(Type::kBold)}});
+        checkSpans("plain", {
+            {"plain", buildStyle(Type::kNormal)}});
+    }
+
+private:
+    CueTextTokenizer m_tokenizer;
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(CueTextTokenizerTest);
@@ -0,0 +1,146 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2021 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+/*
+ * Benchmark of WebVTT document parsing on multi-hour documents.
+ *
+ * Reports parse time and number of heap allocations for the StringView
+ * entry point (used by the engine) and the std::istream one (copies the
+ * stream first). Allocations include the messages formatted by the test
+ * logger stub. Not a unit test, run manually:
+ * WebVTTDocument_Benchmark [hours] [iterations]
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <string>
+
+#include <WebVTTDocument.hpp>
+
+using namespace subttxrend::webvttengine;
+
+namespace {
+
+std::atomic<std::size_t> g_allocations{0};
+
+std::string buildDocument(int hours, const char* newline) {
+    std::ostringstream oss;
+    char timing[64];
+
+    oss << "WEBVTT" << newline << "X-TIMESTAMP-MAP=MPEGTS:900000,LOCAL:00:00:00.000" << newline << newline;
+
+    // one cue every 2 seconds, half of them with settings, some with ids
+    for (int cue = 0; cue < hours * 1800; ++cue) {
+        int start = cue * 2000;
+        int end = start + 1800;
+        if (cue % 5 == 0) {
+            oss << "cue-" << cue << newline;
+        }
+        std::snprintf(timing, sizeof(timing), "%02d:%02d:%02d.%03d --> %02d:%02d:%02d.%03d",
+                      start / 3600000, start / 60000 % 60, start / 1000 % 60, start % 1000,
+                      end / 3600000, end / 60000 % 60, end / 1000 % 60, end % 1000);
+        oss << timing;
+        if (cue % 2 == 0) {
+            oss << " align:start line:90% position:10% size:80%";
+        }
+        oss << newline << "Subtitle line number " << cue << newline;
+        if (cue % 3 == 0) {
+            oss << "<i>second</i> line with some more text" << newline;
+        }
+        oss << newline;
+    }
+    return oss.str();
+}
+
+template<typename Function>
+void measure(const char* name, std::size_t iterations, Function function) {
+    double best = 0;
+    std::size_t allocations = 0;
+    std::size_t cues = 0;
+
+    for (std::size_t i = 0; i < iterations; ++i) {
+        std::size_t allocationsBefore = g_allocations;
+        auto start = std::chrono::steady_clock::now();
+        cues = function();
+        auto end = std::chrono::steady_clock::now();
+        allocations = g_allocations - allocationsBefore;
+
+        double ms = std::chrono::duration<double, std::milli>(end - start).count();
+        if (i == 0 || ms < best) {
+            best = ms;
+        }
+    }
+
+    std::printf("%-24s %8.2f ms %10zu allocations %6zu cues\n", name, best, allocations, cues);
+}
+
+void benchmark(const char* name, const std::string& document, std::size_t iterations) {
+    std::printf("%s (%zu bytes)\n", name, document.size());
+
+    measure("  string view", iterations, [&document]() {
+        WebVTTDocument parser;
+        CueList list;
+        std::tie(list, std::ignore) = parser.parseCueList(StringView(document));
+        return list.size();
+    });
+
+    measure("  istream", iterations, [&document]() {
+        std::istringstream iss(document);
+        WebVTTDocument parser;
+        CueList list;
+        std::tie(list, std::ignore) = parser.parseCueList(iss);
+        return list.size();
+    });
+}
+
+}
+
+void* operator new(std::size_t size) {
+    ++g_allocations;
+    if (void* ptr = std::malloc(size ? size : 1)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+int main(int argc, char* argv[]) {
+    int hours = (argc > 1) ? std::atoi(argv[1]) : 3;
+    std::size_t iterations = (argc > 2) ? std::strtoul(argv[2], nullptr, 10) : 5;
+
+    // test logger prints to std::cout, keep the output readable
+    std::cout.setstate(std::ios::badbit);
+
+    std::printf("%d hour document, best of %zu\n", hours, iterations);
+    benchmark("LF line endings", buildDocument(hours, "\n"), iterations);
+    benchmark("CRLF line endings", buildDocument(hours, "\r\n"), iterations);
+
+    return 0;
+}
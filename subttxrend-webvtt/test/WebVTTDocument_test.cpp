@@ -43,6 +43,7 @@ CPPUNIT_TEST(testTwoSpaces);
 CPPUNIT_TEST(testTimeOffset);
 CPPUNIT_TEST(testRegion);
 CPPUNIT_TEST(testStyle);
+CPPUNIT_TEST(testLineEndings);
 CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -93,6 +94,33 @@ line:75%
         CPPUNIT_ASSERT_EQUAL((std::size_t)1, list.size());
     }
     
+    void testLineEndings()
+    {
+        // CRLF and stray CRs are dropped, same as LF only document
+        const std::string crlf =
+            "WEBVTT\r\n"
+            "X-TIMESTAMP-MAP=MPEGTS:0,LOCAL:00:00:00\r\n"
+            "\r\n"
+            "00:01:29.000 --> 00:01:31.000 line:75%\r\n"
+            "first line\r\n"
+            "sec\rond line\r\n"
+            "\r\n"
+            "00:01:31.000 --> 00:01:33.000\r\n"
+            "last\r";
+        CueList list;
+        WebVTTDocument doc;
+
+        CPPUNIT_ASSERT_NO_THROW(std::tie(list, std::ignore) = doc.parseCueList(StringView(crlf)));
+        CPPUNIT_ASSERT_EQUAL((std::size_t)2, list.size());
+
+        auto lines = list.front()->lines();
+        CPPUNIT_ASSERT_EQUAL((std::size_t)2, lines.size());
+        CPPUNIT_ASSERT_EQUAL(std::string("first line"), lines[0]);
+        CPPUNIT_ASSERT_EQUAL(std::string("second line"), lines[1]);
+        CPPUNIT_ASSERT(TimePoint(91000) == list.back()->startTime());
+        CPPUNIT_ASSERT_EQUAL(std::string("last"), list.back()->lines().at(0));
+    }
+
     void testTwoSpaces()
     {
 std::istringstream twospaces(